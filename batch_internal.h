@@ -0,0 +1,62 @@
+/* batch_internal.h
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Definitions shared by the routines for batches of small matrices in
+   linalg/ and eigen/... not meant for client consumption.
+
+   A batch of n-by-n matrices is stored one below the other in an
+   (nbatch*n)-by-n matrix. The kernels are generated by including a
+   batch_source.c file once for each size with BATCH_N and
+   BATCH_SUFFIX defined, and once more with both set to n for the
+   general case. The kernel for size n of an operation op is then
+   selected from the table op_kernels[BATCH_MAX_N + 1] or op_n. */
+
+#ifndef __GSL_BATCH_INTERNAL_H__
+#define __GSL_BATCH_INTERNAL_H__
+
+#include <gsl/gsl_matrix.h>
+
+#define CONCAT2x(a,b) a ## _ ## b
+#define CONCAT2(a,b) CONCAT2x(a,b)
+#define FUNCTION(name) CONCAT2(name,BATCH_SUFFIX)
+
+/* kernel for n-by-n matrices */
+#define BATCH_KERNEL(name,n) (((n) <= BATCH_MAX_N) ? name ## _kernels[n] : name ## _n)
+
+/* check that A is a stack of square matrices and return their number;
+ * a 0-by-0 matrix is an empty batch */
+
+static int
+batch_check (const gsl_matrix * A, size_t * nbatch)
+{
+  const size_t n = A->size2;
+
+  if (n == 0)
+    {
+      *nbatch = 0;
+      return (A->size1 != 0);
+    }
+
+  if (A->size1 % n != 0)
+    return 1;
+
+  *nbatch = A->size1 / n;
+
+  return 0;
+}
+
+#endif /* __GSL_BATCH_INTERNAL_H__ */
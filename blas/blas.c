@@ -24,6 +24,7 @@
 #include <config.h>
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_errno.h>
+#include <gsl/gsl_sys.h>
 #include <gsl/gsl_cblas.h>
 #include <gsl/gsl_cblas.h>
 #include <gsl/gsl_blas_types.h>
@@ -1356,6 +1357,191 @@ gsl_blas_dgemm (CBLAS_TRANSPOSE_t TransA, CBLAS_TRANSPOSE_t TransB,
 }
 
 
+/* Batched GEMM.  For small matrices the cost of a call to cblas_dgemm
+   is dominated by the argument checking, so products with all
+   dimensions up to GEMM_SMALL_MAX and fewer than GEMM_SMALL_MAX_WORK
+   multiply-adds are computed directly, with fully unrolled versions
+   for the common square sizes 2, 3 and 4.  Larger products go through
+   cblas_dgemm, which has a faster blocked kernel for them.  The
+   products of a batch are divided among threads when the total work
+   exceeds GEMM_BATCH_MIN_WORK multiply-adds. */
+
+#define GEMM_SMALL_MAX 32
+#define GEMM_SMALL_MAX_WORK 32768.0
+#define GEMM_BATCH_MIN_WORK 65536.0
+
+/* C := alpha op(A) op(B) + beta C for an M x N x K product, with the
+   elements op(A)_il = A[i*ars + l*acs] and op(B)_lj = B[l*brs + j*BCS].
+   Each row of the product is accumulated in t before being stored, so
+   C is not read when beta = 0, as in cblas_dgemm. */
+
+#define GEMM_SMALL_BODY(M,N,K,BCS)                                      \
+  do {                                                                  \
+    size_t i, j, l;                                                     \
+    for (i = 0; i < (M); i++)                                           \
+      {                                                                 \
+        double t[GEMM_SMALL_MAX];                                       \
+        for (j = 0; j < (N); j++)                                       \
+          t[j] = 0.0;                                                   \
+        for (l = 0; l < (K); l++)                                       \
+          {                                                             \
+            const double a = A[i * ars + l * acs];                      \
+            for (j = 0; j < (N); j++)                                   \
+              t[j] += a * B[l * brs + j * (BCS)];                       \
+          }                                                             \
+        if (beta == 0.0)                                                \
+          {                                                             \
+            for (j = 0; j < (N); j++)                                   \
+              C[i * ldc + j] = alpha * t[j];                            \
+          }                                                             \
+        else                                                            \
+          {                                                             \
+            for (j = 0; j < (N); j++)                                   \
+              C[i * ldc + j] = alpha * t[j] + beta * C[i * ldc + j];    \
+          }                                                             \
+      }                                                                 \
+  } while (0)
+
+static void
+dgemm_small (CBLAS_TRANSPOSE_t TransA, CBLAS_TRANSPOSE_t TransB,
+             const size_t M, const size_t N, const size_t K,
+             const double alpha, const double *A, const size_t lda,
+             const double *B, const size_t ldb,
+             const double beta, double *C, const size_t ldc)
+{
+  const size_t ars = (TransA == CblasNoTrans) ? lda : 1;
+  const size_t acs = (TransA == CblasNoTrans) ? 1 : lda;
+  const size_t brs = (TransB == CblasNoTrans) ? ldb : 1;
+  const size_t bcs = (TransB == CblasNoTrans) ? 1 : ldb;
+
+  if (alpha == 0.0 || K == 0)
+    {
+      size_t i, j;
+
+      for (i = 0; i < M; i++)
+        for (j = 0; j < N; j++)
+          C[i * ldc + j] = (beta == 0.0) ? 0.0 : beta * C[i * ldc + j];
+    }
+  else if (bcs != 1)
+    GEMM_SMALL_BODY (M, N, K, bcs);
+  else if (M == N && N == K && M == 2)
+    GEMM_SMALL_BODY (2, 2, 2, 1);
+  else if (M == N && N == K && M == 3)
+    GEMM_SMALL_BODY (3, 3, 3, 1);
+  else if (M == N && N == K && M == 4)
+    GEMM_SMALL_BODY (4, 4, 4, 1);
+  else
+    GEMM_SMALL_BODY (M, N, K, 1);
+}
+
+/* computes one product of a batch */
+
+static void
+dgemm_one (CBLAS_TRANSPOSE_t TransA, CBLAS_TRANSPOSE_t TransB,
+           const size_t M, const size_t N, const size_t K,
+           const double alpha, const double *A, const size_t lda,
+           const double *B, const size_t ldb,
+           const double beta, double *C, const size_t ldc)
+{
+  if (M <= GEMM_SMALL_MAX && N <= GEMM_SMALL_MAX && K <= GEMM_SMALL_MAX
+      && (double) M * N * K < GEMM_SMALL_MAX_WORK)
+    {
+      dgemm_small (TransA, TransB, M, N, K, alpha, A, lda, B, ldb,
+                   beta, C, ldc);
+    }
+  else
+    {
+      cblas_dgemm (CblasRowMajor, TransA, TransB, INT (M), INT (N), INT (K),
+                   alpha, A, INT (lda), B, INT (ldb), beta, C, INT (ldc));
+    }
+}
+
+int
+gsl_blas_dgemm_batch_strided (CBLAS_TRANSPOSE_t TransA,
+                              CBLAS_TRANSPOSE_t TransB,
+                              const size_t M, const size_t N,
+                              const size_t K, double alpha,
+                              const double *A, const size_t lda,
+                              const size_t strideA,
+                              const double *B, const size_t ldb,
+                              const size_t strideB, double beta,
+                              double *C, const size_t ldc,
+                              const size_t strideC,
+                              const size_t batch_count)
+{
+  const size_t ncolA = (TransA == CblasNoTrans) ? K : M;
+  const size_t ncolB = (TransB == CblasNoTrans) ? N : K;
+
+  if (lda < GSL_MAX (ncolA, 1) || ldb < GSL_MAX (ncolB, 1)
+      || ldc < GSL_MAX (N, 1))
+    {
+      GSL_ERROR ("invalid leading dimension", GSL_EINVAL);
+    }
+  else
+    {
+      const double work = (double) batch_count * M * N * K;
+      const int nthreads = gsl_get_num_threads ();
+      long b;
+
+#pragma omp parallel for num_threads(nthreads) if(nthreads > 1 && work > GEMM_BATCH_MIN_WORK) schedule(static)
+      for (b = 0; b < (long) batch_count; b++)
+        {
+          dgemm_one (TransA, TransB, M, N, K, alpha,
+                     A + b * strideA, lda, B + b * strideB, ldb,
+                     beta, C + b * strideC, ldc);
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+int
+gsl_blas_dgemm_batch (CBLAS_TRANSPOSE_t TransA, CBLAS_TRANSPOSE_t TransB,
+                      double alpha, const gsl_matrix * const A[],
+                      const gsl_matrix * const B[], double beta,
+                      gsl_matrix * const C[], const size_t batch_count)
+{
+  double work = 0.0;
+  size_t i;
+
+  for (i = 0; i < batch_count; i++)
+    {
+      const size_t M = C[i]->size1;
+      const size_t N = C[i]->size2;
+      const size_t MA = (TransA == CblasNoTrans) ? A[i]->size1 : A[i]->size2;
+      const size_t NA = (TransA == CblasNoTrans) ? A[i]->size2 : A[i]->size1;
+      const size_t MB = (TransB == CblasNoTrans) ? B[i]->size1 : B[i]->size2;
+      const size_t NB = (TransB == CblasNoTrans) ? B[i]->size2 : B[i]->size1;
+
+      if (M != MA || N != NB || NA != MB)   /* [MxN] = [MAxNA][MBxNB] */
+        {
+          GSL_ERROR ("invalid length", GSL_EBADLEN);
+        }
+
+      work += (double) M * N * NA;
+    }
+
+  {
+    const int nthreads = gsl_get_num_threads ();
+    long b;
+
+#pragma omp parallel for num_threads(nthreads) if(nthreads > 1 && work > GEMM_BATCH_MIN_WORK) schedule(static)
+    for (b = 0; b < (long) batch_count; b++)
+      {
+        const gsl_matrix *Ab = A[b], *Bb = B[b];
+        gsl_matrix *Cb = C[b];
+        const size_t K = (TransA == CblasNoTrans) ? Ab->size2 : Ab->size1;
+
+        dgemm_one (TransA, TransB, Cb->size1, Cb->size2, K, alpha,
+                   Ab->data, Ab->tda, Bb->data, Bb->tda,
+                   beta, Cb->data, Cb->tda);
+      }
+  }
+
+  return GSL_SUCCESS;
+}
+
+
 int
 gsl_blas_cgemm (CBLAS_TRANSPOSE_t TransA, CBLAS_TRANSPOSE_t TransB,
                 const gsl_complex_float alpha,
@@ -420,6 +420,27 @@ int  gsl_blas_dgemm (CBLAS_TRANSPOSE_t TransA,
                      double beta,
                      gsl_matrix * C);
 
+int  gsl_blas_dgemm_batch_strided (CBLAS_TRANSPOSE_t TransA,
+                                   CBLAS_TRANSPOSE_t TransB,
+                                   const size_t M, const size_t N,
+                                   const size_t K, double alpha,
+                                   const double * A, const size_t lda,
+                                   const size_t strideA,
+                                   const double * B, const size_t ldb,
+                                   const size_t strideB, double beta,
+                                   double * C, const size_t ldc,
+                                   const size_t strideC,
+                                   const size_t batch_count);
+
+int  gsl_blas_dgemm_batch (CBLAS_TRANSPOSE_t TransA,
+                           CBLAS_TRANSPOSE_t TransB,
+                           double alpha,
+                           const gsl_matrix * const A[],
+                           const gsl_matrix * const B[],
+                           double beta,
+                           gsl_matrix * const C[],
+                           const size_t batch_count);
+
 int  gsl_blas_dsymm (CBLAS_SIDE_t Side,
                      CBLAS_UPLO_t Uplo,
                      double alpha,
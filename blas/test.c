@@ -0,0 +1,289 @@
+/* blas/test.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Tests of the batched GEMM routines against a loop over gsl_blas_dgemm.
+   The individual level 1-3 routines are tested through cblas. */
+
+#include <config.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <math.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_nan.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_test.h>
+#include <gsl/gsl_ieee_utils.h>
+
+#define BATCH_COUNT 3
+
+/* fill m with reproducible values in [-1,1) from a linear
+   congruential sequence */
+static void
+fill_matrix (gsl_matrix * m, unsigned long * seed)
+{
+  size_t i, j;
+
+  for (i = 0; i < m->size1; i++)
+    {
+      for (j = 0; j < m->size2; j++)
+        {
+          *seed = (*seed * 1103515245UL + 12345UL) & 0x7fffffffUL;
+          gsl_matrix_set (m, i, j, 2.0 * (*seed / 2147483648.0) - 1.0);
+        }
+    }
+}
+
+static const char *
+trans_name (CBLAS_TRANSPOSE_t Trans)
+{
+  return (Trans == CblasNoTrans) ? "N" : "T";
+}
+
+/* compare C against Cref for a product of inner dimension K; the
+   entries of A, B and C are bounded by 1 */
+static int
+test_gemm_result (const gsl_matrix * C, const gsl_matrix * Cref,
+                  const size_t K, const double alpha, const double beta,
+                  const char * desc, const size_t b)
+{
+  const double tol = 8.0 * (K + 1) * GSL_DBL_EPSILON
+                     * (fabs (alpha) * K + fabs (beta) + 1.0);
+  int s = 0;
+  size_t i, j;
+
+  for (i = 0; i < C->size1; i++)
+    {
+      for (j = 0; j < C->size2; j++)
+        {
+          double cij = gsl_matrix_get (C, i, j);
+          double rij = gsl_matrix_get (Cref, i, j);
+          int f = !(fabs (cij - rij) <= tol);
+
+          gsl_test (f, "%s batch %u [%u,%u]: %.18e %.18e", desc,
+                    (unsigned) b, (unsigned) i, (unsigned) j, cij, rij);
+          s += f;
+        }
+    }
+
+  return s;
+}
+
+static int
+test_gemm_batch_dim (CBLAS_TRANSPOSE_t TransA, CBLAS_TRANSPOSE_t TransB,
+                     const size_t M, const size_t N, const size_t K,
+                     const double alpha, const double beta)
+{
+  const size_t rowsA = (TransA == CblasNoTrans) ? M : K;
+  const size_t colsA = (TransA == CblasNoTrans) ? K : M;
+  const size_t rowsB = (TransB == CblasNoTrans) ? K : N;
+  const size_t colsB = (TransB == CblasNoTrans) ? N : K;
+
+  /* padded leading dimensions and strides for the strided batch */
+  const size_t lda = colsA + 2, ldb = colsB + 1, ldc = N + 3;
+  const size_t strideA = rowsA * lda + 5;
+  const size_t strideB = rowsB * ldb + 1;
+  const size_t strideC = M * ldc + 7;
+
+  double * Adata = malloc (BATCH_COUNT * strideA * sizeof (double));
+  double * Bdata = malloc (BATCH_COUNT * strideB * sizeof (double));
+  double * Cdata = malloc (BATCH_COUNT * strideC * sizeof (double));
+  gsl_matrix * A[BATCH_COUNT], * B[BATCH_COUNT];
+  gsl_matrix * C[BATCH_COUNT], * Cref[BATCH_COUNT];
+  unsigned long seed = 1 + M + 10 * N + 100 * K;
+  char desc[128];
+  int s = 0, status;
+  size_t b, i;
+
+  sprintf (desc, "dgemm_batch %s%s M=%u N=%u K=%u alpha=%g beta=%g",
+           trans_name (TransA), trans_name (TransB),
+           (unsigned) M, (unsigned) N, (unsigned) K, alpha, beta);
+
+  for (b = 0; b < BATCH_COUNT; b++)
+    {
+      A[b] = gsl_matrix_alloc (rowsA, colsA);
+      B[b] = gsl_matrix_alloc (rowsB, colsB);
+      C[b] = gsl_matrix_alloc (M, N);
+      Cref[b] = gsl_matrix_alloc (M, N);
+
+      fill_matrix (A[b], &seed);
+      fill_matrix (B[b], &seed);
+      fill_matrix (Cref[b], &seed);
+
+      /* with beta = 0 the input C must not be read */
+      if (beta == 0.0)
+        gsl_matrix_set_all (C[b], GSL_NAN);
+      else
+        gsl_matrix_memcpy (C[b], Cref[b]);
+    }
+
+  /* strided copies, with the padding set to NaN */
+  for (i = 0; i < BATCH_COUNT * strideC; i++)
+    Cdata[i] = GSL_NAN;
+
+  for (b = 0; b < BATCH_COUNT; b++)
+    {
+      gsl_matrix_view Ab = gsl_matrix_view_array_with_tda (Adata + b * strideA, rowsA, colsA, lda);
+      gsl_matrix_view Bb = gsl_matrix_view_array_with_tda (Bdata + b * strideB, rowsB, colsB, ldb);
+      gsl_matrix_view Cb = gsl_matrix_view_array_with_tda (Cdata + b * strideC, M, N, ldc);
+
+      gsl_matrix_memcpy (&Ab.matrix, A[b]);
+      gsl_matrix_memcpy (&Bb.matrix, B[b]);
+      gsl_matrix_memcpy (&Cb.matrix, C[b]);
+    }
+
+  for (b = 0; b < BATCH_COUNT; b++)
+    {
+      if (beta == 0.0)
+        gsl_matrix_set_zero (Cref[b]);
+
+      gsl_blas_dgemm (TransA, TransB, alpha, A[b], B[b], beta, Cref[b]);
+    }
+
+  status = gsl_blas_dgemm_batch (TransA, TransB, alpha,
+                                 (const gsl_matrix * const *) A,
+                                 (const gsl_matrix * const *) B,
+                                 beta, C, BATCH_COUNT);
+  gsl_test (status, "%s status", desc);
+  s += (status != GSL_SUCCESS);
+
+  for (b = 0; b < BATCH_COUNT; b++)
+    s += test_gemm_result (C[b], Cref[b], K, alpha, beta, desc, b);
+
+  sprintf (desc, "dgemm_batch_strided %s%s M=%u N=%u K=%u alpha=%g beta=%g",
+           trans_name (TransA), trans_name (TransB),
+           (unsigned) M, (unsigned) N, (unsigned) K, alpha, beta);
+
+  status = gsl_blas_dgemm_batch_strided (TransA, TransB, M, N, K, alpha,
+                                         Adata, lda, strideA,
+                                         Bdata, ldb, strideB, beta,
+                                         Cdata, ldc, strideC, BATCH_COUNT);
+  gsl_test (status, "%s status", desc);
+  s += (status != GSL_SUCCESS);
+
+  for (b = 0; b < BATCH_COUNT; b++)
+    {
+      gsl_matrix_view Cb = gsl_matrix_view_array_with_tda (Cdata + b * strideC, M, N, ldc);
+
+      s += test_gemm_result (&Cb.matrix, Cref[b], K, alpha, beta, desc, b);
+    }
+
+  for (b = 0; b < BATCH_COUNT; b++)
+    {
+      gsl_matrix_free (A[b]);
+      gsl_matrix_free (B[b]);
+      gsl_matrix_free (C[b]);
+      gsl_matrix_free (Cref[b]);
+    }
+
+  free (Adata);
+  free (Bdata);
+  free (Cdata);
+
+  return s;
+}
+
+static int
+test_gemm_batch (void)
+{
+  /* the square sizes 2, 3 and 4 use the unrolled kernels, the other
+     small sizes the generic one and the last size cblas_dgemm */
+  const size_t dims[][3] = { { 1, 1, 1 }, { 2, 2, 2 }, { 3, 3, 3 },
+                             { 4, 4, 4 }, { 2, 3, 4 }, { 5, 3, 7 },
+                             { 4, 4, 1 }, { 17, 9, 13 }, { 32, 32, 32 },
+                             { 40, 33, 37 } };
+  const CBLAS_TRANSPOSE_t trans[] = { CblasNoTrans, CblasTrans };
+  const double betas[] = { 0.0, 1.0, -0.75 };
+  int s = 0;
+  size_t i, ta, tb, k;
+
+  for (i = 0; i < sizeof (dims) / sizeof (dims[0]); i++)
+    {
+      for (ta = 0; ta < 2; ta++)
+        {
+          for (tb = 0; tb < 2; tb++)
+            {
+              for (k = 0; k < sizeof (betas) / sizeof (betas[0]); k++)
+                {
+                  s += test_gemm_batch_dim (trans[ta], trans[tb],
+                                            dims[i][0], dims[i][1],
+                                            dims[i][2], 1.5, betas[k]);
+                }
+            }
+        }
+    }
+
+  /* alpha = 0 only scales C */
+  s += test_gemm_batch_dim (CblasNoTrans, CblasNoTrans, 3, 3, 3, 0.0, 0.5);
+  s += test_gemm_batch_dim (CblasTrans, CblasNoTrans, 4, 2, 5, 0.0, 0.0);
+
+  /* an empty batch is a no-op */
+  {
+    int status;
+
+    status = gsl_blas_dgemm_batch (CblasNoTrans, CblasNoTrans, 1.0,
+                                   NULL, NULL, 0.0, NULL, 0);
+    gsl_test (status, "dgemm_batch empty batch");
+    s += (status != GSL_SUCCESS);
+
+    status = gsl_blas_dgemm_batch_strided (CblasNoTrans, CblasNoTrans,
+                                           4, 4, 4, 1.0, NULL, 4, 16,
+                                           NULL, 4, 16, 0.0, NULL, 4, 16, 0);
+    gsl_test (status, "dgemm_batch_strided empty batch");
+    s += (status != GSL_SUCCESS);
+  }
+
+  /* invalid arguments */
+  {
+    gsl_matrix * A = gsl_matrix_calloc (3, 2);
+    gsl_matrix * B = gsl_matrix_calloc (3, 2);
+    gsl_matrix * C = gsl_matrix_calloc (3, 2);
+    double work[6];
+    int status;
+
+    status = gsl_blas_dgemm_batch (CblasNoTrans, CblasNoTrans, 1.0,
+                                   (const gsl_matrix * const *) &A,
+                                   (const gsl_matrix * const *) &B,
+                                   0.0, &C, 1);
+    gsl_test (status != GSL_EBADLEN, "dgemm_batch nonconformant dimensions");
+    s += (status != GSL_EBADLEN);
+
+    status = gsl_blas_dgemm_batch_strided (CblasNoTrans, CblasNoTrans,
+                                           2, 2, 3, 1.0, work, 2, 6,
+                                           work, 2, 6, 0.0, work, 2, 6, 1);
+    gsl_test (status != GSL_EINVAL, "dgemm_batch_strided invalid lda");
+    s += (status != GSL_EINVAL);
+
+    gsl_matrix_free (A);
+    gsl_matrix_free (B);
+    gsl_matrix_free (C);
+  }
+
+  return s;
+}
+
+int
+main (void)
+{
+  gsl_ieee_env_setup ();
+  gsl_set_error_handler_off ();
+
+  gsl_test (test_gemm_batch (), "Batched GEMM");
+
+  exit (gsl_test_summary ());
+}
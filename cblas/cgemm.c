@@ -2,6 +2,8 @@
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
 #include "error_cblas_l3.h"
+#include "parallel.h"
+#include "gemm_packed.h"
 
 void
 cblas_cgemm (const enum CBLAS_ORDER Order, const enum CBLAS_TRANSPOSE TransA,
@@ -11,6 +13,12 @@ cblas_cgemm (const enum CBLAS_ORDER Order, const enum CBLAS_TRANSPOSE TransA,
              const int ldc)
 {
 #define BASE float
+#define SELF cblas_cgemm
+#define PACKED_GEMM gsl_cblas_cgemm_packed
+#define PACKED_METHOD GEMM_4M
 #include "source_gemm_c.h"
+#undef PACKED_METHOD
+#undef PACKED_GEMM
+#undef SELF
 #undef BASE
 }
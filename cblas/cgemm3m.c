@@ -0,0 +1,24 @@
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_cblas.h>
+#include "cblas.h"
+#include "error_cblas_l3.h"
+#include "parallel.h"
+#include "gemm_packed.h"
+
+void
+cblas_cgemm3m (const enum CBLAS_ORDER Order, const enum CBLAS_TRANSPOSE TransA,
+               const enum CBLAS_TRANSPOSE TransB, const int M, const int N,
+               const int K, const void *alpha, const void *A, const int lda,
+               const void *B, const int ldb, const void *beta, void *C,
+               const int ldc)
+{
+#define BASE float
+#define SELF cblas_cgemm3m
+#define PACKED_GEMM gsl_cblas_cgemm_packed
+#define PACKED_METHOD GEMM_3M
+#include "source_gemm_c.h"
+#undef PACKED_METHOD
+#undef PACKED_GEMM
+#undef SELF
+#undef BASE
+}
@@ -2,6 +2,7 @@
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
 #include "error_cblas_l3.h"
+#include "parallel.h"
 
 void
 cblas_chemm (const enum CBLAS_ORDER Order, const enum CBLAS_SIDE Side,
@@ -10,6 +11,8 @@ cblas_chemm (const enum CBLAS_ORDER Order, const enum CBLAS_SIDE Side,
              const int ldb, const void *beta, void *C, const int ldc)
 {
 #define BASE float
+#define SELF cblas_chemm
 #include "source_hemm.h"
+#undef SELF
 #undef BASE
 }
@@ -2,6 +2,7 @@
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
 #include "error_cblas_l3.h"
+#include "parallel.h"
 
 void
 cblas_csyrk (const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo,
@@ -10,6 +11,10 @@ cblas_csyrk (const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo,
              const void *beta, void *C, const int ldc)
 {
 #define BASE float
+#define SELF cblas_csyrk
+#define GEMM cblas_cgemm
 #include "source_syrk_c.h"
+#undef GEMM
+#undef SELF
 #undef BASE
 }
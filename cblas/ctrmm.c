@@ -2,6 +2,8 @@
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
 #include "error_cblas_l3.h"
+#include "gemm_packed.h"
+#include "parallel.h"
 
 void
 cblas_ctrmm (const enum CBLAS_ORDER Order, const enum CBLAS_SIDE Side,
@@ -11,6 +13,10 @@ cblas_ctrmm (const enum CBLAS_ORDER Order, const enum CBLAS_SIDE Side,
              const int ldb)
 {
 #define BASE float
+#define SELF cblas_ctrmm
+#define GEMM cblas_cgemm
 #include "source_trmm_c.h"
+#undef GEMM
+#undef SELF
 #undef BASE
 }
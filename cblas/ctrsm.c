@@ -2,6 +2,8 @@
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
 #include "error_cblas_l3.h"
+#include "gemm_packed.h"
+#include "parallel.h"
 
 #include "hypot.c"
 
@@ -13,6 +15,10 @@ cblas_ctrsm (const enum CBLAS_ORDER Order, const enum CBLAS_SIDE Side,
              const int ldb)
 {
 #define BASE float
+#define SELF cblas_ctrsm
+#define GEMM cblas_cgemm
 #include "source_trsm_c.h"
+#undef GEMM
+#undef SELF
 #undef BASE
 }
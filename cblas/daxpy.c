@@ -1,12 +1,17 @@
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
+#include "kernels.h"
 
 void
 cblas_daxpy (const int N, const double alpha, const double *X, const int incX,
              double *Y, const int incY)
 {
+  const gsl_cblas_dkernels *kernels = gsl_cblas_dkernels_get ();
+
+#define KERNELS kernels
 #define BASE double
 #include "source_axpy_r.h"
 #undef BASE
+#undef KERNELS
 }
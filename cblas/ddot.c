@@ -1,11 +1,15 @@
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
+#include "kernels.h"
 
 double
 cblas_ddot (const int N, const double *X, const int incX, const double *Y,
             const int incY)
 {
+  const gsl_cblas_dkernels *kernels = gsl_cblas_dkernels_get ();
+
+#define KERNELS kernels
 #define INIT_VAL  0.0
 #define ACC_TYPE  double
 #define BASE double
@@ -13,4 +17,5 @@ cblas_ddot (const int N, const double *X, const int incX, const double *Y,
 #undef ACC_TYPE
 #undef BASE
 #undef INIT_VAL
+#undef KERNELS
 }
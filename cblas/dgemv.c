@@ -2,6 +2,7 @@
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
 #include "error_cblas_l2.h"
+#include "kernels.h"
 
 void
 cblas_dgemv (const enum CBLAS_ORDER order, const enum CBLAS_TRANSPOSE TransA,
@@ -9,7 +10,11 @@ cblas_dgemv (const enum CBLAS_ORDER order, const enum CBLAS_TRANSPOSE TransA,
              const int lda, const double *X, const int incX,
              const double beta, double *Y, const int incY)
 {
+  const gsl_cblas_dkernels *kernels = gsl_cblas_dkernels_get ();
+
+#define KERNELS kernels
 #define BASE double
 #include "source_gemv_r.h"
 #undef BASE
+#undef KERNELS
 }
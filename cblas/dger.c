@@ -2,13 +2,18 @@
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
 #include "error_cblas_l2.h"
+#include "kernels.h"
 
 void
 cblas_dger (const enum CBLAS_ORDER order, const int M, const int N,
             const double alpha, const double *X, const int incX,
             const double *Y, const int incY, double *A, const int lda)
 {
+  const gsl_cblas_dkernels *kernels = gsl_cblas_dkernels_get ();
+
+#define KERNELS kernels
 #define BASE double
 #include "source_ger.h"
 #undef BASE
+#undef KERNELS
 }
@@ -1,11 +1,16 @@
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
+#include "kernels.h"
 
 void
 cblas_dscal (const int N, const double alpha, double *X, const int incX)
 {
+  const gsl_cblas_dkernels *kernels = gsl_cblas_dkernels_get ();
+
+#define KERNELS kernels
 #define BASE double
 #include "source_scal_r.h"
 #undef BASE
+#undef KERNELS
 }
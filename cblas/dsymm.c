@@ -2,6 +2,7 @@
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
 #include "error_cblas_l3.h"
+#include "gemm_packed.h"
 
 void
 cblas_dsymm (const enum CBLAS_ORDER Order, const enum CBLAS_SIDE Side,
@@ -11,6 +12,8 @@ cblas_dsymm (const enum CBLAS_ORDER Order, const enum CBLAS_SIDE Side,
              const int ldc)
 {
 #define BASE double
+#define PACKED_GEMM gsl_cblas_dgemm_packed
 #include "source_symm_r.h"
+#undef PACKED_GEMM
 #undef BASE
 }
@@ -2,6 +2,7 @@
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
 #include "error_cblas_l2.h"
+#include "kernels.h"
 
 void
 cblas_dsymv (const enum CBLAS_ORDER order, const enum CBLAS_UPLO Uplo,
@@ -9,7 +10,11 @@ cblas_dsymv (const enum CBLAS_ORDER order, const enum CBLAS_UPLO Uplo,
              const double *X, const int incX, const double beta, double *Y,
              const int incY)
 {
+  const gsl_cblas_dkernels *kernels = gsl_cblas_dkernels_get ();
+
+#define KERNELS kernels
 #define BASE double
 #include "source_symv.h"
 #undef BASE
+#undef KERNELS
 }
@@ -2,6 +2,7 @@
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
 #include "error_cblas_l3.h"
+#include "gemm_packed.h"
 
 void
 cblas_dsyr2k (const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo,
@@ -11,6 +12,8 @@ cblas_dsyr2k (const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo,
               const int ldc)
 {
 #define BASE double
+#define PACKED_GEMM gsl_cblas_dgemm_packed
 #include "source_syr2k_r.h"
+#undef PACKED_GEMM
 #undef BASE
 }
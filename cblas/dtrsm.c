@@ -2,6 +2,8 @@
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
 #include "error_cblas_l3.h"
+#include "gemm_packed.h"
+#include "parallel.h"
 
 void
 cblas_dtrsm (const enum CBLAS_ORDER Order, const enum CBLAS_SIDE Side,
@@ -11,6 +13,10 @@ cblas_dtrsm (const enum CBLAS_ORDER Order, const enum CBLAS_SIDE Side,
              const int ldb)
 {
 #define BASE double
+#define SELF cblas_dtrsm
+#define GEMM cblas_dgemm
 #include "source_trsm_r.h"
+#undef GEMM
+#undef SELF
 #undef BASE
 }
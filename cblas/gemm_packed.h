@@ -0,0 +1,113 @@
+/* cblas/gemm_packed.h
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Internal interface to the cache-blocked, packed GEMM engine used by
+ * the level 3 routines.  All operands are in the row-major
+ * orientation produced by the CBLAS wrappers, and the engine computes
+ *
+ *   C := alpha * op(F) * op(G) + C
+ *
+ * where op(F) is M-by-K and op(G) is K-by-N.  Scaling by beta is the
+ * responsibility of the caller.
+ *
+ * The kind arguments describe how the operands are stored: CblasNoTrans
+ * and CblasTrans select a general matrix, while CblasUpper and
+ * CblasLower select a symmetric matrix of which only the indicated
+ * triangle is referenced (used by SYMM).
+ *
+ * The complex functions compute
+ *
+ *   C := alpha * op(F) * op(G) + beta * C
+ *
+ * by real products of the real and imaginary parts with the real
+ * engine, using four real products (GEMM_4M) or three (GEMM_3M, the
+ * Gauss form).  conjF and conjG are -1 to conjugate op(F) and op(G),
+ * and 1 otherwise, and alpha and beta point to complex scalars.
+ *
+ * The functions return 0 on success, or -1 if the packing buffers
+ * could not be allocated, in which case C is unchanged and the caller
+ * should fall back to the reference loops. */
+
+#ifndef __GSL_CBLAS_GEMM_PACKED_H__
+#define __GSL_CBLAS_GEMM_PACKED_H__
+
+/* cache blocking parameters: an MC-by-KC block of op(F) is packed
+   to stay resident in L2, and a KC-by-NC panel of op(G) in L3 */
+
+#define GEMM_MC 128
+#define GEMM_KC 256
+#define GEMM_NC 2048
+
+/* problems smaller than this (in multiply-adds) are handled by the
+   reference loops, where packing does not pay off */
+
+#define GEMM_PACKED_MIN_FLOPS 32768.0
+
+#define GEMM_USE_PACKED(M,N,K) \
+  ((M) >= 4 && (N) >= 4 && (K) >= 4 \
+   && (double) (M) * (double) (N) * (double) (K) >= GEMM_PACKED_MIN_FLOPS)
+
+/* diagonal block size used by the blocked SYRK and SYR2K */
+
+#define SYRK_NB 64
+
+/* triangular block size below which the recursive TRSM and TRMM
+   switch to the reference loops */
+
+#define TRSM_NB 64
+
+/* methods for the complex products */
+
+#define GEMM_3M 3
+#define GEMM_4M 4
+
+/* components of a complex operand read by the real engine */
+
+#define GEMM_PART_NONE 0        /* real operand */
+#define GEMM_PART_REAL 1
+#define GEMM_PART_IMAG 2
+#define GEMM_PART_SUM 3         /* real part plus imaginary part */
+
+int gsl_cblas_dgemm_packed (const int kindF, const int kindG,
+                            const int M, const int N, const int K,
+                            const double alpha, const double *F,
+                            const int ldf, const double *G, const int ldg,
+                            double *C, const int ldc);
+
+int gsl_cblas_sgemm_packed (const int kindF, const int kindG,
+                            const int M, const int N, const int K,
+                            const float alpha, const float *F,
+                            const int ldf, const float *G, const int ldg,
+                            float *C, const int ldc);
+
+int gsl_cblas_zgemm_packed (const int method, const int kindF,
+                            const int conjF, const int kindG,
+                            const int conjG, const int M, const int N,
+                            const int K, const double *alpha,
+                            const double *F, const int ldf,
+                            const double *G, const int ldg,
+                            const double *beta, double *C, const int ldc);
+
+int gsl_cblas_cgemm_packed (const int method, const int kindF,
+                            const int conjF, const int kindG,
+                            const int conjG, const int M, const int N,
+                            const int K, const float *alpha,
+                            const float *F, const int ldf,
+                            const float *G, const int ldg,
+                            const float *beta, float *C, const int ldc);
+
+#endif /* __GSL_CBLAS_GEMM_PACKED_H__ */
@@ -599,6 +599,30 @@ void cblas_zher2k(const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo,
                   const void *B, const int ldb, const double beta,
                   void *C, const int ldc);
 
+/*
+ * ===========================================================================
+ * Complex matrix products with three real products (GSL extension)
+ * ===========================================================================
+ */
+void cblas_cgemm3m(const enum CBLAS_ORDER Order, const enum CBLAS_TRANSPOSE TransA,
+                   const enum CBLAS_TRANSPOSE TransB, const int M, const int N,
+                   const int K, const void *alpha, const void *A,
+                   const int lda, const void *B, const int ldb,
+                   const void *beta, void *C, const int ldc);
+void cblas_zgemm3m(const enum CBLAS_ORDER Order, const enum CBLAS_TRANSPOSE TransA,
+                   const enum CBLAS_TRANSPOSE TransB, const int M, const int N,
+                   const int K, const void *alpha, const void *A,
+                   const int lda, const void *B, const int ldb,
+                   const void *beta, void *C, const int ldc);
+
+/*
+ * ===========================================================================
+ * Thread control for the level 3 routines (GSL extension)
+ * ===========================================================================
+ */
+void gsl_cblas_set_num_threads(const int n);
+int gsl_cblas_get_num_threads(void);
+
 void cblas_xerbla(int p, const char *rout, const char *form, ...);
 
 __END_DECLS
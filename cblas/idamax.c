@@ -1,11 +1,16 @@
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
+#include "kernels.h"
 
 CBLAS_INDEX
 cblas_idamax (const int N, const double *X, const int incX)
 {
+  const gsl_cblas_dkernels *kernels = gsl_cblas_dkernels_get ();
+
+#define KERNELS kernels
 #define BASE double
 #include "source_iamax_r.h"
 #undef BASE
+#undef KERNELS
 }
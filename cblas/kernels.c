@@ -0,0 +1,236 @@
+/* cblas/kernels.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_cblas.h>
+#include "cblas.h"
+#include "kernels.h"
+
+/* The kernels for each instruction set are compiled with a function
+   target attribute, independently of the compiler flags, so this
+   requires a compiler supporting target attributes and intrinsics in
+   target functions.  Elsewhere the reference loops are used. */
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) \
+  && (defined(__clang__) || __GNUC__ >= 5)
+#define HAVE_X86_KERNELS 1
+#endif
+
+#ifdef HAVE_X86_KERNELS
+
+#include <cpuid.h>
+#include <immintrin.h>
+
+/* SSE2 */
+
+#define TARGET __attribute__ ((target ("sse2")))
+#define KFUNC(name) name ## _sse2
+#define KNAME "sse2"
+#define VEC __m128d
+#define VLEN 2
+#define VZERO() _mm_setzero_pd()
+#define VLOAD(p) _mm_loadu_pd(p)
+#define VSTORE(p,x) _mm_storeu_pd((p),(x))
+#define VSET1(x) _mm_set1_pd(x)
+#define VADD(a,b) _mm_add_pd((a),(b))
+#define VSUB(a,b) _mm_sub_pd((a),(b))
+#define VMUL(a,b) _mm_mul_pd((a),(b))
+#define VMAX(a,b) _mm_max_pd((a),(b))
+#define VFMA(a,b,c) _mm_add_pd(_mm_mul_pd((a),(b)),(c))
+#define VEND() ((void) 0)
+#include "source_kernels.h"
+#undef VEND
+#undef VFMA
+#undef VMAX
+#undef VMUL
+#undef VSUB
+#undef VADD
+#undef VSET1
+#undef VSTORE
+#undef VLOAD
+#undef VZERO
+#undef VLEN
+#undef VEC
+#undef KNAME
+#undef KFUNC
+#undef TARGET
+
+/* AVX2 with FMA */
+
+#define TARGET __attribute__ ((target ("avx2,fma")))
+#define KFUNC(name) name ## _avx2
+#define KNAME "avx2"
+#define VEC __m256d
+#define VLEN 4
+#define VZERO() _mm256_setzero_pd()
+#define VLOAD(p) _mm256_loadu_pd(p)
+#define VSTORE(p,x) _mm256_storeu_pd((p),(x))
+#define VSET1(x) _mm256_set1_pd(x)
+#define VADD(a,b) _mm256_add_pd((a),(b))
+#define VSUB(a,b) _mm256_sub_pd((a),(b))
+#define VMUL(a,b) _mm256_mul_pd((a),(b))
+#define VMAX(a,b) _mm256_max_pd((a),(b))
+#define VFMA(a,b,c) _mm256_fmadd_pd((a),(b),(c))
+#define VEND() _mm256_zeroupper()
+#include "source_kernels.h"
+#undef VEND
+#undef VFMA
+#undef VMAX
+#undef VMUL
+#undef VSUB
+#undef VADD
+#undef VSET1
+#undef VSTORE
+#undef VLOAD
+#undef VZERO
+#undef VLEN
+#undef VEC
+#undef KNAME
+#undef KFUNC
+#undef TARGET
+
+/* AVX-512 */
+
+#define TARGET __attribute__ ((target ("avx512f")))
+#define KFUNC(name) name ## _avx512
+#define KNAME "avx512"
+#define VEC __m512d
+#define VLEN 8
+#define VZERO() _mm512_setzero_pd()
+#define VLOAD(p) _mm512_loadu_pd(p)
+#define VSTORE(p,x) _mm512_storeu_pd((p),(x))
+#define VSET1(x) _mm512_set1_pd(x)
+#define VADD(a,b) _mm512_add_pd((a),(b))
+#define VSUB(a,b) _mm512_sub_pd((a),(b))
+#define VMUL(a,b) _mm512_mul_pd((a),(b))
+#define VMAX(a,b) _mm512_max_pd((a),(b))
+#define VFMA(a,b,c) _mm512_fmadd_pd((a),(b),(c))
+#define VEND() _mm256_zeroupper()
+#include "source_kernels.h"
+#undef VEND
+#undef VFMA
+#undef VMAX
+#undef VMUL
+#undef VSUB
+#undef VADD
+#undef VSET1
+#undef VSTORE
+#undef VLOAD
+#undef VZERO
+#undef VLEN
+#undef VEC
+#undef KNAME
+#undef KFUNC
+#undef TARGET
+
+/* read the extended control register XCR0, which tells which vector
+   register states are saved by the operating system */
+
+static unsigned long
+xgetbv0 (void)
+{
+  unsigned int lo, hi;
+  __asm__ __volatile__ ("xgetbv" : "=a" (lo), "=d" (hi) : "c" (0));
+  (void) hi;
+  return lo;
+}
+
+static int
+detect_arch (void)
+{
+  unsigned int eax, ebx, ecx, edx;
+  const unsigned int max_leaf = __get_cpuid_max (0, 0);
+  int arch = KERNELS_GENERIC;
+
+  if (max_leaf < 1)
+    return arch;
+
+  __cpuid (1, eax, ebx, ecx, edx);
+
+  if (edx & (1u << 26))
+    arch = KERNELS_SSE2;
+
+  /* AVX2 and AVX-512 need the OSXSAVE, AVX and FMA bits of leaf 1,
+     the feature bits of leaf 7, and the corresponding register
+     states enabled in XCR0 */
+
+  if (max_leaf >= 7 && (ecx & (1u << 27)) && (ecx & (1u << 28))
+      && (ecx & (1u << 12)))
+    {
+      const unsigned long xcr0 = xgetbv0 ();
+
+      __cpuid_count (7, 0, eax, ebx, ecx, edx);
+
+      if ((xcr0 & 0x06) == 0x06 && (ebx & (1u << 5)))
+        arch = KERNELS_AVX2;
+
+      if ((xcr0 & 0xe6) == 0xe6 && (ebx & (1u << 16)))
+        arch = KERNELS_AVX512;
+    }
+
+  return arch;
+}
+
+#else
+
+static int
+detect_arch (void)
+{
+  return KERNELS_GENERIC;
+}
+
+#endif /* HAVE_X86_KERNELS */
+
+/* instruction set supported by the processor, -1 until the first
+   call.  Concurrent first calls store the same value. */
+
+static int cpu_arch = -1;
+
+const gsl_cblas_dkernels *
+gsl_cblas_dkernels_arch (const int arch)
+{
+  if (cpu_arch < 0)
+    cpu_arch = detect_arch ();
+
+  if (arch > cpu_arch)
+    return NULL;
+
+  switch (arch)
+    {
+#ifdef HAVE_X86_KERNELS
+    case KERNELS_SSE2:
+      return &kernels_sse2;
+    case KERNELS_AVX2:
+      return &kernels_avx2;
+    case KERNELS_AVX512:
+      return &kernels_avx512;
+#endif
+    default:
+      return NULL;
+    }
+}
+
+const gsl_cblas_dkernels *
+gsl_cblas_dkernels_get (void)
+{
+  if (cpu_arch < 0)
+    cpu_arch = detect_arch ();
+
+  return gsl_cblas_dkernels_arch (cpu_arch);
+}
@@ -0,0 +1,89 @@
+/* cblas/kernels.h
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Internal interface to the vectorized double precision level 1 and
+ * level 2 kernels.  The kernels are compiled for several instruction
+ * sets and the best one supported by the processor is selected at run
+ * time.  All vectors passed to the kernels have unit stride unless a
+ * stride argument is given.
+ *
+ * The routines using the kernels define KERNELS before including
+ * their source template, and fall back to the reference loops when
+ * KERNELS is NULL (no vector unit available) or the strides do not
+ * allow the kernels to be used. */
+
+#ifndef __GSL_CBLAS_KERNELS_H__
+#define __GSL_CBLAS_KERNELS_H__
+
+/* instruction sets, in increasing order of preference */
+
+#define KERNELS_GENERIC 0
+#define KERNELS_SSE2    1
+#define KERNELS_AVX2    2
+#define KERNELS_AVX512  3
+
+typedef struct
+{
+  const char *name;
+
+  /* returns x'y */
+  double (*dot) (const int N, const double *x, const double *y);
+
+  /* y := alpha * x + y */
+  void (*axpy) (const int N, const double alpha, const double *x, double *y);
+
+  /* x := alpha * x */
+  void (*scal) (const int N, const double alpha, double *x);
+
+  /* returns the index of the first element of largest |x_i|, with the
+     same conventions as the reference idamax */
+  CBLAS_INDEX (*iamax) (const int N, const double *x);
+
+  /* returns max |x_i|, ignoring NaNs */
+  double (*amax) (const int N, const double *x);
+
+  /* returns sum (scale * x_i)^2 */
+  double (*ssq) (const int N, const double scale, const double *x);
+
+  /* y_i := alpha * A_i x + y_i for the M rows of the row-major matrix
+     A, with y_i stored at y[i * incy] */
+  void (*gemv_n) (const int M, const int N, const double alpha,
+                  const double *A, const int lda, const double *x,
+                  double *y, const int incy);
+
+  /* y := alpha * A' x + y for the row-major M-by-N matrix A, with x_i
+     stored at x[i * incx]; rows with alpha * x_i = 0 are skipped */
+  void (*gemv_t) (const int M, const int N, const double alpha,
+                  const double *A, const int lda, const double *x,
+                  const int incx, double *y);
+
+  /* y := alpha * a + y and returns a'x, used for one row of symv */
+  double (*symv_row) (const int N, const double alpha, const double *a,
+                      const double *x, double *y);
+} gsl_cblas_dkernels;
+
+/* returns the kernels for the best instruction set supported by the
+   processor, or NULL if the reference loops should be used */
+
+const gsl_cblas_dkernels *gsl_cblas_dkernels_get (void);
+
+/* returns the kernels for the given instruction set, or NULL if it is
+   not supported by the compiler or the processor */
+
+const gsl_cblas_dkernels *gsl_cblas_dkernels_arch (const int arch);
+
+#endif /* __GSL_CBLAS_KERNELS_H__ */
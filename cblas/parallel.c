@@ -0,0 +1,95 @@
+/* cblas/parallel.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <math.h>
+#include <gsl/gsl_cblas.h>
+#include "cblas.h"
+#include "parallel.h"
+
+#include "sys/threads_source.c"
+
+/* number of threads used by the level 3 routines, 0 until the first
+   call which reads the default from the environment */
+
+static int num_threads = 0;
+
+void
+gsl_cblas_set_num_threads (const int n)
+{
+  threads_set (&num_threads, n);
+}
+
+int
+gsl_cblas_get_num_threads (void)
+{
+  return threads_get (&num_threads);
+}
+
+/* number of threads to use for an operation of the given number of
+   multiply-adds */
+
+int
+gsl_cblas_threads (const double work)
+{
+#ifdef _OPENMP
+  int n;
+
+  if (omp_in_parallel ())
+    return 1;
+
+  n = gsl_cblas_get_num_threads ();
+
+  if (work < n * PARALLEL_MIN_WORK)
+    n = (int) (work / PARALLEL_MIN_WORK);
+
+  return (n > 1) ? n : 1;
+#else
+  (void) work;
+  return 1;
+#endif
+}
+
+/* choose a tm-by-tn grid of nthreads tiles for an M-by-N matrix, with
+   tiles as close to square as possible */
+
+void
+gsl_cblas_grid (const int nthreads, const int M, const int N, int *tm,
+                int *tn)
+{
+  double best = 0.0;
+  int d;
+
+  *tm = nthreads;
+  *tn = 1;
+
+  for (d = 1; d <= nthreads; d++)
+    {
+      if (nthreads % d == 0)
+        {
+          const double r = fabs (log (((double) M / d) / ((double) N * d / nthreads)));
+
+          if (d == 1 || r < best)
+            {
+              best = r;
+              *tm = d;
+              *tn = nthreads / d;
+            }
+        }
+    }
+}
@@ -0,0 +1,42 @@
+/* cblas/parallel.h
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Internal support for the multithreaded level 3 routines.
+ *
+ * The level 3 routines split their work into independent tiles of the
+ * output matrix, each of which is computed by a serial call, and
+ * distribute the tiles over OpenMP threads.  Calls made from inside a
+ * parallel region, or too small to benefit, run serially. */
+
+#ifndef __GSL_CBLAS_PARALLEL_H__
+#define __GSL_CBLAS_PARALLEL_H__
+
+/* minimum number of multiply-adds per thread */
+
+#define PARALLEL_MIN_WORK 2.0e6
+
+/* start of part p when n items are split into nparts */
+
+#define PART_START(n,nparts,p) \
+  ((INDEX) (((long) (n) * (long) (p)) / (long) (nparts)))
+
+int gsl_cblas_threads (const double work);
+
+void gsl_cblas_grid (const int nthreads, const int M, const int N,
+                     int *tm, int *tn);
+
+#endif /* __GSL_CBLAS_PARALLEL_H__ */
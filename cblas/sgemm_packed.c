@@ -0,0 +1,69 @@
+/* cblas/sgemm_packed.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_cblas.h>
+#include "cblas.h"
+#include "gemm_packed.h"
+#include "parallel.h"
+
+/* select the widest vector unit enabled at compile time */
+
+#if defined(__AVX512F__)
+#include <immintrin.h>
+#define VEC __m512
+#define VLEN 16
+#define VZERO() _mm512_setzero_ps()
+#define VLOAD(p) _mm512_loadu_ps(p)
+#define VSTORE(p,x) _mm512_storeu_ps((p),(x))
+#define VSET1(x) _mm512_set1_ps(x)
+#define VFMA(a,b,c) _mm512_fmadd_ps((a),(b),(c))
+#elif defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define VEC __m256
+#define VLEN 8
+#define VZERO() _mm256_setzero_ps()
+#define VLOAD(p) _mm256_loadu_ps(p)
+#define VSTORE(p,x) _mm256_storeu_ps((p),(x))
+#define VSET1(x) _mm256_set1_ps(x)
+#define VFMA(a,b,c) _mm256_fmadd_ps((a),(b),(c))
+#elif defined(__SSE__)
+#include <xmmintrin.h>
+#define VEC __m128
+#define VLEN 4
+#define VZERO() _mm_setzero_ps()
+#define VLOAD(p) _mm_loadu_ps(p)
+#define VSTORE(p,x) _mm_storeu_ps((p),(x))
+#define VSET1(x) _mm_set1_ps(x)
+#define VFMA(a,b,c) _mm_add_ps(_mm_mul_ps((a),(b)),(c))
+#endif
+
+#define BASE float
+#define PACKED_GEMM gsl_cblas_sgemm_packed
+#include "source_gemm_packed.h"
+#undef PACKED_GEMM
+#undef BASE
+
+/* complex products on the real engine */
+
+#define BASE float
+#define PACKED_GEMM_C gsl_cblas_cgemm_packed
+#include "source_gemm_packed_c.h"
+#undef PACKED_GEMM_C
+#undef BASE
@@ -27,6 +27,13 @@
   if (incX == 1 && incY == 1) {
     const INDEX m = N % 4;
 
+#ifdef KERNELS
+    if (KERNELS != NULL) {
+      KERNELS->axpy(N, alpha, X, Y);
+      return;
+    }
+#endif
+
     for (i = 0; i < m; i++) {
       Y[i] += alpha * X[i];
     }
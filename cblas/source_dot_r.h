@@ -23,6 +23,12 @@
   INDEX ix = OFFSET(N, incX);
   INDEX iy = OFFSET(N, incY);
 
+#ifdef KERNELS
+  if (KERNELS != NULL && incX == 1 && incY == 1) {
+    return KERNELS->dot(N, X, Y);
+  }
+#endif
+
   for (i = 0; i < N; i++) {
     r += X[ix] * Y[iy];
     ix += incX;
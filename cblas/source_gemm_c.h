@@ -61,6 +61,44 @@
       TransG = (TransA == CblasNoTrans) ? CblasNoTrans : CblasTrans;
     }
 
+    /* large products go through the real cache-blocked engine, which
+       also takes care of beta and of the threads */
+    if (!(alpha_real == 0.0 && alpha_imag == 0.0)
+        && GEMM_USE_PACKED(n1, n2, K)
+        && PACKED_GEMM(PACKED_METHOD, TransF, conjF, TransG, conjG, n1, n2, K,
+                       (const BASE *) alpha, F, ldf, G, ldg,
+                       (const BASE *) beta, (BASE *) C, ldc) == 0)
+      return;
+
+    {
+      /* split C into a grid of tiles, one per thread, and compute each
+         tile serially */
+      const int nthreads = gsl_cblas_threads (4.0 * n1 * n2 * K);
+
+      if (nthreads > 1) {
+        const int transF = (Order == CblasRowMajor) ? TransA : TransB;
+        const int transG = (Order == CblasRowMajor) ? TransB : TransA;
+        int t, tm, tn;
+
+        gsl_cblas_grid (nthreads, n1, n2, &tm, &tn);
+
+#pragma omp parallel for num_threads(nthreads) schedule(static)
+        for (t = 0; t < nthreads; t++) {
+          const INDEX i0 = PART_START(n1, tm, t / tn);
+          const INDEX i1 = PART_START(n1, tm, t / tn + 1);
+          const INDEX j0 = PART_START(n2, tn, t % tn);
+          const INDEX j1 = PART_START(n2, tn, t % tn + 1);
+          const BASE *Fi = F
+            + 2 * ((TransF == CblasNoTrans) ? ldf * i0 : i0);
+          const BASE *Gj = G
+            + 2 * ((TransG == CblasNoTrans) ? j0 : ldg * j0);
+          SELF(CblasRowMajor, transF, transG, i1 - i0, j1 - j0, K, alpha,
+               Fi, ldf, Gj, ldg, beta, (BASE *) C + 2 * (ldc * i0 + j0), ldc);
+        }
+        return;
+      }
+    }
+
     /* form  y := beta*y */
     if (beta_real == 0.0 && beta_imag == 0.0) {
       for (i = 0; i < n1; i++) {
@@ -0,0 +1,524 @@
+/* cblas/source_gemm_packed.h
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Packed GEMM engine, see gemm_packed.h for the interface.
+ *
+ * The including file defines BASE, PACKED_GEMM (the name of the
+ * exported function) and, optionally, a vector instruction set through
+ * the macros VEC, VLEN, VZERO, VLOAD, VSTORE, VSET1 and VFMA.  When VEC
+ * is not defined a portable scalar microkernel is used.
+ *
+ * The product is split into a grid of tiles of C, one per thread.
+ * Within each tile the algorithm follows the usual three-level
+ * blocking: op(G) is packed in KC-by-NC panels of NR-wide column
+ * slivers, op(F) in MC-by-KC blocks of MR-high row slivers, and a
+ * register-blocked MR-by-NR microkernel computes the product of one
+ * sliver of each.  Partial slivers at the edges are padded with zeros
+ * so that the microkernel always runs on full tiles.
+ *
+ * The complex products of source_gemm_packed_c.h use the same engine:
+ * an operand may be one real component of an interleaved complex
+ * matrix, which is extracted while packing, and a product may be added
+ * with a complex coefficient to an interleaved complex C.  Several
+ * products can be run over the same tiles with one set of packing
+ * buffers. */
+
+#define MR 4
+
+#ifdef VEC
+#define NR (2 * VLEN)
+#else
+#define NR 4
+#endif
+
+/* an operand: the real matrix X (part = GEMM_PART_NONE), or the real
+   part, the imaginary part times conj, or the sum of both, of the
+   complex matrix X with interleaved storage; ld is in elements, and
+   kind is one of the storage kinds in gemm_packed.h (only CblasNoTrans
+   and CblasTrans for complex matrices) */
+
+typedef struct
+{
+  const BASE *X;
+  int ld;
+  int kind;
+  int part;
+  int conj;
+} packed_operand;
+
+/* a destination: C := C + alpha * product for a real C, or
+   Re C := Re C + alpha_real * product and Im C := Im C + alpha_imag *
+   product for a complex C with interleaved storage */
+
+typedef struct
+{
+  BASE *C;
+  int ldc;
+  int cplx;
+  BASE alpha_real;
+  BASE alpha_imag;
+} packed_result;
+
+/* packing buffers of all threads, and the grid of tiles of C */
+
+typedef struct
+{
+  BASE *work;
+  size_t fsize;
+  size_t gsize;
+  int nthreads;
+  int tm;
+  int tn;
+} packed_workspace;
+
+/* element (i,j) of op(X) for the storage kinds in gemm_packed.h */
+
+#define PACKED_ELEM(X,ld,kind,i,j) \
+  (((kind) == CblasNoTrans \
+    || ((kind) == CblasUpper && (i) <= (j)) \
+    || ((kind) == CblasLower && (i) >= (j))) \
+   ? (X)[(ld) * (i) + (j)] : (X)[(ld) * (j) + (i)])
+
+/* the selected component of the complex element at x */
+
+#define PACKED_PART(op,x) \
+  (((op)->part == GEMM_PART_REAL) ? (x)[0] \
+   : ((op)->part == GEMM_PART_IMAG) ? (op)->conj * (x)[1] \
+   : (x)[0] + (op)->conj * (x)[1])
+
+/* pack rows i0..i0+mc-1 and columns p0..p0+kc-1 of op(F) into
+   consecutive MR-by-kc slivers, each stored column by column */
+
+static void
+pack_F (const packed_operand * op, const int i0, const int p0,
+        const int mc, const int kc, BASE * buf)
+{
+  const int kindF = op->kind, ldf = op->ld;
+  const BASE *F = op->X;
+  int ir, r, p;
+
+  for (ir = 0; ir < mc; ir += MR)
+    {
+      const int mr = GSL_MIN (MR, mc - ir);
+      const int i = i0 + ir;
+
+      if (op->part != GEMM_PART_NONE)
+        {
+          for (p = 0; p < kc; p++)
+            {
+              for (r = 0; r < mr; r++)
+                {
+                  const BASE *x = (kindF == CblasNoTrans)
+                    ? F + 2 * (ldf * (i + r) + p0 + p)
+                    : F + 2 * (ldf * (p0 + p) + i + r);
+                  buf[p * MR + r] = PACKED_PART (op, x);
+                }
+              for (; r < MR; r++)
+                buf[p * MR + r] = 0.0;
+            }
+        }
+      else if (kindF == CblasNoTrans)
+        {
+          for (p = 0; p < kc; p++)
+            {
+              for (r = 0; r < mr; r++)
+                buf[p * MR + r] = F[ldf * (i + r) + p0 + p];
+              for (; r < MR; r++)
+                buf[p * MR + r] = 0.0;
+            }
+        }
+      else if (kindF == CblasTrans)
+        {
+          for (p = 0; p < kc; p++)
+            {
+              const BASE *Fp = F + ldf * (p0 + p) + i;
+              for (r = 0; r < mr; r++)
+                buf[p * MR + r] = Fp[r];
+              for (; r < MR; r++)
+                buf[p * MR + r] = 0.0;
+            }
+        }
+      else
+        {
+          for (p = 0; p < kc; p++)
+            {
+              for (r = 0; r < mr; r++)
+                buf[p * MR + r] = PACKED_ELEM (F, ldf, kindF, i + r, p0 + p);
+              for (; r < MR; r++)
+                buf[p * MR + r] = 0.0;
+            }
+        }
+
+      buf += MR * kc;
+    }
+}
+
+/* pack rows p0..p0+kc-1 and columns j0..j0+nc-1 of op(G) into
+   consecutive kc-by-NR slivers, each stored row by row */
+
+static void
+pack_G (const packed_operand * op, const int p0, const int j0,
+        const int kc, const int nc, BASE * buf)
+{
+  const int kindG = op->kind, ldg = op->ld;
+  const BASE *G = op->X;
+  int jr, c, p;
+
+  for (jr = 0; jr < nc; jr += NR)
+    {
+      const int nr = GSL_MIN (NR, nc - jr);
+      const int j = j0 + jr;
+
+      if (op->part != GEMM_PART_NONE)
+        {
+          for (p = 0; p < kc; p++)
+            {
+              for (c = 0; c < nr; c++)
+                {
+                  const BASE *x = (kindG == CblasNoTrans)
+                    ? G + 2 * (ldg * (p0 + p) + j + c)
+                    : G + 2 * (ldg * (j + c) + p0 + p);
+                  buf[p * NR + c] = PACKED_PART (op, x);
+                }
+              for (; c < NR; c++)
+                buf[p * NR + c] = 0.0;
+            }
+        }
+      else if (kindG == CblasNoTrans)
+        {
+          for (p = 0; p < kc; p++)
+            {
+              const BASE *Gp = G + ldg * (p0 + p) + j;
+              for (c = 0; c < nr; c++)
+                buf[p * NR + c] = Gp[c];
+              for (; c < NR; c++)
+                buf[p * NR + c] = 0.0;
+            }
+        }
+      else if (kindG == CblasTrans)
+        {
+          for (p = 0; p < kc; p++)
+            {
+              for (c = 0; c < nr; c++)
+                buf[p * NR + c] = G[ldg * (j + c) + p0 + p];
+              for (; c < NR; c++)
+                buf[p * NR + c] = 0.0;
+            }
+        }
+      else
+        {
+          for (p = 0; p < kc; p++)
+            {
+              for (c = 0; c < nr; c++)
+                buf[p * NR + c] = PACKED_ELEM (G, ldg, kindG, p0 + p, j + c);
+              for (; c < NR; c++)
+                buf[p * NR + c] = 0.0;
+            }
+        }
+
+      buf += NR * kc;
+    }
+}
+
+/* microkernel: ab := a * b, where a is an MR-by-kc sliver and b a
+   kc-by-NR sliver, with the MR-by-NR result stored row by row */
+
+#ifdef VEC
+
+static void
+micro_kernel (const int kc, const BASE * a, const BASE * b, BASE * ab)
+{
+  VEC c00 = VZERO (), c01 = VZERO ();
+  VEC c10 = VZERO (), c11 = VZERO ();
+  VEC c20 = VZERO (), c21 = VZERO ();
+  VEC c30 = VZERO (), c31 = VZERO ();
+  int p;
+
+  for (p = 0; p < kc; p++)
+    {
+      const VEC b0 = VLOAD (b);
+      const VEC b1 = VLOAD (b + VLEN);
+      VEC ar;
+
+      ar = VSET1 (a[0]);
+      c00 = VFMA (ar, b0, c00);
+      c01 = VFMA (ar, b1, c01);
+
+      ar = VSET1 (a[1]);
+      c10 = VFMA (ar, b0, c10);
+      c11 = VFMA (ar, b1, c11);
+
+      ar = VSET1 (a[2]);
+      c20 = VFMA (ar, b0, c20);
+      c21 = VFMA (ar, b1, c21);
+
+      ar = VSET1 (a[3]);
+      c30 = VFMA (ar, b0, c30);
+      c31 = VFMA (ar, b1, c31);
+
+      a += MR;
+      b += NR;
+    }
+
+  VSTORE (ab, c00);
+  VSTORE (ab + VLEN, c01);
+  VSTORE (ab + NR, c10);
+  VSTORE (ab + NR + VLEN, c11);
+  VSTORE (ab + 2 * NR, c20);
+  VSTORE (ab + 2 * NR + VLEN, c21);
+  VSTORE (ab + 3 * NR, c30);
+  VSTORE (ab + 3 * NR + VLEN, c31);
+}
+
+#else
+
+static void
+micro_kernel (const int kc, const BASE * a, const BASE * b, BASE * ab)
+{
+  BASE c00 = 0.0, c01 = 0.0, c02 = 0.0, c03 = 0.0;
+  BASE c10 = 0.0, c11 = 0.0, c12 = 0.0, c13 = 0.0;
+  BASE c20 = 0.0, c21 = 0.0, c22 = 0.0, c23 = 0.0;
+  BASE c30 = 0.0, c31 = 0.0, c32 = 0.0, c33 = 0.0;
+  int p;
+
+  for (p = 0; p < kc; p++)
+    {
+      const BASE b0 = b[0], b1 = b[1], b2 = b[2], b3 = b[3];
+      BASE ar;
+
+      ar = a[0];
+      c00 += ar * b0; c01 += ar * b1; c02 += ar * b2; c03 += ar * b3;
+      ar = a[1];
+      c10 += ar * b0; c11 += ar * b1; c12 += ar * b2; c13 += ar * b3;
+      ar = a[2];
+      c20 += ar * b0; c21 += ar * b1; c22 += ar * b2; c23 += ar * b3;
+      ar = a[3];
+      c30 += ar * b0; c31 += ar * b1; c32 += ar * b2; c33 += ar * b3;
+
+      a += MR;
+      b += NR;
+    }
+
+  ab[0] = c00; ab[1] = c01; ab[2] = c02; ab[3] = c03;
+  ab[4] = c10; ab[5] = c11; ab[6] = c12; ab[7] = c13;
+  ab[8] = c20; ab[9] = c21; ab[10] = c22; ab[11] = c23;
+  ab[12] = c30; ab[13] = c31; ab[14] = c32; ab[15] = c33;
+}
+
+#endif
+
+/* add Fbuf * Gbuf to the mc-by-nc block of the destination R starting
+   at row i0 and column j0, for one packed mc-by-kc block of op(F) and
+   one packed kc-by-nc panel of op(G) */
+
+static void
+macro_kernel (const int mc, const int nc, const int kc, const BASE * Fbuf,
+              const BASE * Gbuf, const packed_result * R, const int i0,
+              const int j0)
+{
+  const int ldc = R->ldc;
+  const BASE alpha_real = R->alpha_real, alpha_imag = R->alpha_imag;
+  BASE ab[MR * NR];
+  int ir, jr, r, c;
+
+  for (jr = 0; jr < nc; jr += NR)
+    {
+      const int nr = GSL_MIN (NR, nc - jr);
+
+      for (ir = 0; ir < mc; ir += MR)
+        {
+          const int mr = GSL_MIN (MR, mc - ir);
+
+          micro_kernel (kc, Fbuf + ir * kc, Gbuf + jr * kc, ab);
+
+          for (r = 0; r < mr; r++)
+            {
+              const int i = i0 + ir + r, j = j0 + jr;
+
+              if (!R->cplx)
+                {
+                  BASE *Cr = R->C + ldc * i + j;
+                  for (c = 0; c < nr; c++)
+                    Cr[c] += alpha_real * ab[r * NR + c];
+                }
+              else
+                {
+                  BASE *Cr = R->C + 2 * (ldc * i + j);
+
+                  /* a zero coefficient must not turn an infinite
+                     product into a NaN */
+                  if (alpha_real != 0.0)
+                    for (c = 0; c < nr; c++)
+                      Cr[2 * c] += alpha_real * ab[r * NR + c];
+
+                  if (alpha_imag != 0.0)
+                    for (c = 0; c < nr; c++)
+                      Cr[2 * c + 1] += alpha_imag * ab[r * NR + c];
+                }
+            }
+        }
+    }
+}
+
+/* R := R + op(F) * op(G) for the m-by-n block of C starting at row i0
+   and column j0, using the packing buffers Fbuf and Gbuf */
+
+static void
+gemm_block (const packed_operand * F, const packed_operand * G,
+            const packed_result * R, const int i0, const int j0,
+            const int m, const int n, const int K, BASE * Fbuf, BASE * Gbuf)
+{
+  int ic, jc, pc;
+
+  for (jc = 0; jc < n; jc += GEMM_NC)
+    {
+      const int nc = GSL_MIN (GEMM_NC, n - jc);
+
+      for (pc = 0; pc < K; pc += GEMM_KC)
+        {
+          const int kc = GSL_MIN (GEMM_KC, K - pc);
+
+          pack_G (G, pc, j0 + jc, kc, nc, Gbuf);
+
+          for (ic = 0; ic < m; ic += GEMM_MC)
+            {
+              const int mc = GSL_MIN (GEMM_MC, m - ic);
+
+              pack_F (F, i0 + ic, pc, mc, kc, Fbuf);
+              macro_kernel (mc, nc, kc, Fbuf, Gbuf, R, i0 + ic, j0 + jc);
+            }
+        }
+    }
+}
+
+/* allocate the packing buffers for an M-by-N-by-K product, one pair per
+   thread; returns -1 if there is not enough memory even for one thread */
+
+static int
+packed_alloc (const int M, const int N, const int K, packed_workspace * w)
+{
+  const size_t kcmax = GSL_MIN (K, GEMM_KC);
+  int nthreads = gsl_cblas_threads ((double) M * (double) N * (double) K);
+  int tm = 1, tn = 1;
+  size_t mcmax, ncmax, fsize, gsize;
+  BASE *work;
+
+  if (nthreads > 1)
+    gsl_cblas_grid (nthreads, M, N, &tm, &tn);
+
+  /* each thread works on a tile of C with its own packing buffers */
+
+  mcmax = MR * ((GSL_MIN ((M + tm - 1) / tm, GEMM_MC) + MR - 1) / MR);
+  ncmax = NR * ((GSL_MIN ((N + tn - 1) / tn, GEMM_NC) + NR - 1) / NR);
+  fsize = mcmax * kcmax;
+  gsize = kcmax * ncmax;
+
+  work = malloc (sizeof (BASE) * (fsize + gsize) * nthreads);
+
+  if (work == 0 && nthreads > 1)
+    {
+      /* not enough memory for all threads, try serially */
+      nthreads = tm = tn = 1;
+      mcmax = MR * ((GSL_MIN (M, GEMM_MC) + MR - 1) / MR);
+      ncmax = NR * ((GSL_MIN (N, GEMM_NC) + NR - 1) / NR);
+      fsize = mcmax * kcmax;
+      gsize = kcmax * ncmax;
+      work = malloc (sizeof (BASE) * (fsize + gsize));
+    }
+
+  if (work == 0)
+    return -1;
+
+  w->work = work;
+  w->fsize = fsize;
+  w->gsize = gsize;
+  w->nthreads = nthreads;
+  w->tm = tm;
+  w->tn = tn;
+
+  return 0;
+}
+
+/* R[k] := R[k] + op(F[k]) * op(G[k]) for k = 0, ..., nprod - 1, where
+   all products are M-by-N-by-K; each thread runs all the products on
+   its own tile of C */
+
+static void
+packed_run (const int M, const int N, const int K, const int nprod,
+            const packed_operand * F, const packed_operand * G,
+            const packed_result * R, const packed_workspace * w)
+{
+  const int nthreads = w->nthreads, tm = w->tm, tn = w->tn;
+  int t;
+
+#pragma omp parallel for num_threads(nthreads) schedule(static)
+  for (t = 0; t < nthreads; t++)
+    {
+      const int ti = t / tn, tj = t % tn;
+      const int i0 = PART_START (M, tm, ti), i1 = PART_START (M, tm, ti + 1);
+      const int j0 = PART_START (N, tn, tj), j1 = PART_START (N, tn, tj + 1);
+      BASE *Fbuf = w->work + (w->fsize + w->gsize) * t;
+      BASE *Gbuf = Fbuf + w->fsize;
+      int k;
+
+      for (k = 0; k < nprod; k++)
+        gemm_block (&F[k], &G[k], &R[k], i0, j0, i1 - i0, j1 - j0, K,
+                    Fbuf, Gbuf);
+    }
+}
+
+int
+PACKED_GEMM (const int kindF, const int kindG, const int M, const int N,
+             const int K, const BASE alpha, const BASE * F, const int ldf,
+             const BASE * G, const int ldg, BASE * C, const int ldc)
+{
+  packed_workspace w;
+  packed_operand opF, opG;
+  packed_result R;
+
+  if (packed_alloc (M, N, K, &w))
+    return -1;
+
+  opF.X = F;
+  opF.ld = ldf;
+  opF.kind = kindF;
+  opF.part = GEMM_PART_NONE;
+  opF.conj = 1;
+
+  opG.X = G;
+  opG.ld = ldg;
+  opG.kind = kindG;
+  opG.part = GEMM_PART_NONE;
+  opG.conj = 1;
+
+  R.C = C;
+  R.ldc = ldc;
+  R.cplx = 0;
+  R.alpha_real = alpha;
+  R.alpha_imag = 0.0;
+
+  packed_run (M, N, K, 1, &opF, &opG, &R, &w);
+
+  free (w.work);
+
+  return 0;
+}
+
+#undef MR
+#undef NR
+#undef PACKED_ELEM
+#undef PACKED_PART
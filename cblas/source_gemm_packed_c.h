@@ -0,0 +1,151 @@
+/* cblas/source_gemm_packed_c.h
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Complex GEMM on top of the real packed engine, see gemm_packed.h for
+ * the interface.  The including file defines BASE and PACKED_GEMM_C
+ * (the name of the exported function), after including
+ * source_gemm_packed.h for the same BASE.
+ *
+ * The product T = op(F) op(G) is formed from real products of the real
+ * and imaginary parts Fr, Fi, Gr, Gi, conjugated if requested:
+ *
+ *   4M:  Re T = Fr Gr - Fi Gi,  Im T = Fr Gi + Fi Gr
+ *
+ *   3M:  P1 = Fr Gr,  P2 = Fi Gi,  P3 = (Fr + Fi) (Gr + Gi)
+ *        Re T = P1 - P2,  Im T = P3 - P1 - P2
+ *
+ * The 3M form saves a quarter of the multiplications, but the error in
+ * Im T is bounded in terms of |Fr| + |Fi| and |Gr| + |Gi| rather than
+ * the magnitudes of the individual terms, so it may be much larger
+ * than for 4M when Im T is small compared to Re T.
+ *
+ * The components are extracted from the complex operands into the
+ * packing buffers of the engine, one block at a time, and each real
+ * product P with weight w in T is added to C with the complex
+ * coefficient alpha w, after C has been scaled by beta.  No copies of
+ * the operands or of T are made. */
+
+/* set the destination R of a real product with weight (w_real, w_imag)
+   in T */
+
+static void
+complex_result (BASE * C, const int ldc, const BASE * alpha,
+                const BASE w_real, const BASE w_imag, packed_result * R)
+{
+  R->C = C;
+  R->ldc = ldc;
+  R->cplx = 1;
+  R->alpha_real = alpha[0] * w_real - alpha[1] * w_imag;
+  R->alpha_imag = alpha[0] * w_imag + alpha[1] * w_real;
+}
+
+static void
+complex_operand (const BASE * X, const int ld, const int kind,
+                 const int part, const int conj, packed_operand * op)
+{
+  op->X = X;
+  op->ld = ld;
+  op->kind = kind;
+  op->part = part;
+  op->conj = conj;
+}
+
+int
+PACKED_GEMM_C (const int method, const int kindF, const int conjF,
+               const int kindG, const int conjG, const int M, const int N,
+               const int K, const BASE * alpha, const BASE * F,
+               const int ldf, const BASE * G, const int ldg,
+               const BASE * beta, BASE * C, const int ldc)
+{
+  const BASE beta_real = beta[0], beta_imag = beta[1];
+  packed_workspace w;
+  packed_operand opF[4], opG[4];
+  packed_result R[4];
+  int nprod, i, j;
+
+  /* allocate first, so that C is unchanged on failure */
+  if (packed_alloc (M, N, K, &w))
+    return -1;
+
+  /* C := beta*C */
+
+  for (i = 0; i < M; i++)
+    {
+      BASE *Ci = C + 2 * ldc * i;
+
+      for (j = 0; j < N; j++)
+        {
+          if (beta_real == 0.0 && beta_imag == 0.0)
+            {
+              Ci[2 * j] = 0.0;
+              Ci[2 * j + 1] = 0.0;
+            }
+          else
+            {
+              const BASE Cij_real = Ci[2 * j];
+              const BASE Cij_imag = Ci[2 * j + 1];
+              Ci[2 * j] = beta_real * Cij_real - beta_imag * Cij_imag;
+              Ci[2 * j + 1] = beta_real * Cij_imag + beta_imag * Cij_real;
+            }
+        }
+    }
+
+  if (method == GEMM_3M)
+    {
+      /* P1 with weight 1 - i, P2 with -1 - i, P3 with i */
+      complex_operand (F, ldf, kindF, GEMM_PART_REAL, conjF, &opF[0]);
+      complex_operand (G, ldg, kindG, GEMM_PART_REAL, conjG, &opG[0]);
+      complex_result (C, ldc, alpha, 1.0, -1.0, &R[0]);
+
+      complex_operand (F, ldf, kindF, GEMM_PART_IMAG, conjF, &opF[1]);
+      complex_operand (G, ldg, kindG, GEMM_PART_IMAG, conjG, &opG[1]);
+      complex_result (C, ldc, alpha, -1.0, -1.0, &R[1]);
+
+      complex_operand (F, ldf, kindF, GEMM_PART_SUM, conjF, &opF[2]);
+      complex_operand (G, ldg, kindG, GEMM_PART_SUM, conjG, &opG[2]);
+      complex_result (C, ldc, alpha, 0.0, 1.0, &R[2]);
+
+      nprod = 3;
+    }
+  else
+    {
+      /* Fr Gr with weight 1, Fi Gi with -1, Fr Gi and Fi Gr with i */
+      complex_operand (F, ldf, kindF, GEMM_PART_REAL, conjF, &opF[0]);
+      complex_operand (G, ldg, kindG, GEMM_PART_REAL, conjG, &opG[0]);
+      complex_result (C, ldc, alpha, 1.0, 0.0, &R[0]);
+
+      complex_operand (F, ldf, kindF, GEMM_PART_IMAG, conjF, &opF[1]);
+      complex_operand (G, ldg, kindG, GEMM_PART_IMAG, conjG, &opG[1]);
+      complex_result (C, ldc, alpha, -1.0, 0.0, &R[1]);
+
+      complex_operand (F, ldf, kindF, GEMM_PART_REAL, conjF, &opF[2]);
+      complex_operand (G, ldg, kindG, GEMM_PART_IMAG, conjG, &opG[2]);
+      complex_result (C, ldc, alpha, 0.0, 1.0, &R[2]);
+
+      complex_operand (F, ldf, kindF, GEMM_PART_IMAG, conjF, &opF[3]);
+      complex_operand (G, ldg, kindG, GEMM_PART_REAL, conjG, &opG[3]);
+      complex_result (C, ldc, alpha, 0.0, 1.0, &R[3]);
+
+      nprod = 4;
+    }
+
+  packed_run (M, N, K, nprod, opF, opG, R, &w);
+
+  free (w.work);
+
+  return 0;
+}
@@ -67,6 +67,12 @@
   if (alpha == 0.0)
     return;
 
+  /* large products go through the cache-blocked engine */
+  if (GEMM_USE_PACKED(n1, n2, K)
+      && PACKED_GEMM(TransF, TransG, n1, n2, K, alpha, F, ldf, G, ldg, C,
+                     ldc) == 0)
+    return;
+
   if (TransF == CblasNoTrans && TransG == CblasNoTrans) {
 
     /* form  C := alpha*A*B + C */
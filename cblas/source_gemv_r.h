@@ -61,6 +61,12 @@
       || (order == CblasColMajor && Trans == CblasTrans)) {
     /* form  y := alpha*A*x + y */
     INDEX iy = OFFSET(lenY, incY);
+#ifdef KERNELS
+    if (KERNELS != NULL && incX == 1) {
+      KERNELS->gemv_n(lenY, lenX, alpha, A, lda, X, Y + iy, incY);
+      return;
+    }
+#endif
     for (i = 0; i < lenY; i++) {
       BASE temp = 0.0;
       INDEX ix = OFFSET(lenX, incX);
@@ -75,6 +81,12 @@
              || (order == CblasColMajor && Trans == CblasNoTrans)) {
     /* form  y := alpha*A'*x + y */
     INDEX ix = OFFSET(lenX, incX);
+#ifdef KERNELS
+    if (KERNELS != NULL && incY == 1) {
+      KERNELS->gemv_t(lenX, lenY, alpha, A, lda, X + ix, incX, Y);
+      return;
+    }
+#endif
     for (j = 0; j < lenX; j++) {
       const BASE temp = alpha * X[ix];
       if (temp != 0.0) {
@@ -24,6 +24,15 @@
 
   if (order == CblasRowMajor) {
     INDEX ix = OFFSET(M, incX);
+#ifdef KERNELS
+    if (KERNELS != NULL && incY == 1) {
+      for (i = 0; i < M; i++) {
+        KERNELS->axpy(N, alpha * X[ix], Y, A + lda * i);
+        ix += incX;
+      }
+      return;
+    }
+#endif
     for (i = 0; i < M; i++) {
       const BASE tmp = alpha * X[ix];
       INDEX jy = OFFSET(N, incY);
@@ -35,6 +44,15 @@
     }
   } else if (order == CblasColMajor) {
     INDEX jy = OFFSET(N, incY);
+#ifdef KERNELS
+    if (KERNELS != NULL && incX == 1) {
+      for (j = 0; j < N; j++) {
+        KERNELS->axpy(M, alpha * Y[jy], X, A + lda * j);
+        jy += incY;
+      }
+      return;
+    }
+#endif
     for (j = 0; j < N; j++) {
       const BASE tmp = alpha * Y[jy];
       INDEX ix = OFFSET(M, incX);
@@ -39,6 +39,56 @@
       alpha_imag *= -1;           /* conjugate alpha */
     }
 
+    {
+      /* split the uplo triangle of C into a triangle of p-by-p tiles: the
+         diagonal tiles are computed by serial calls to this routine, and
+         the off-diagonal tiles by serial calls to the general product */
+      const int nthreads = gsl_cblas_threads (4.0 * N * N * K);
+
+      if (nthreads > 1) {
+        BASE calpha[2], cbeta[2], calpha_conj[2];
+        const BASE one[2] = { 1.0, 0.0 };
+        const int transF = (trans == CblasNoTrans) ? CblasNoTrans : CblasConjTrans;
+        const int transG = (trans == CblasNoTrans) ? CblasConjTrans : CblasNoTrans;
+        const int p = GSL_MIN(N, (int) ceil (sqrt (4.0 * nthreads)));
+        int t;
+
+        calpha[0] = alpha_real;
+        calpha[1] = alpha_imag;
+        calpha_conj[0] = alpha_real;
+        calpha_conj[1] = -alpha_imag;
+        cbeta[0] = beta;
+        cbeta[1] = 0.0;
+
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic)
+        for (t = 0; t < p * p; t++) {
+          const INDEX ti = t / p, tj = t % p;
+          const INDEX i0 = PART_START(N, p, ti), i1 = PART_START(N, p, ti + 1);
+          const INDEX j0 = PART_START(N, p, tj), j1 = PART_START(N, p, tj + 1);
+          const BASE *Ai = (const BASE *) A
+            + 2 * ((trans == CblasNoTrans) ? lda * i0 : i0);
+          const BASE *Aj = (const BASE *) A
+            + 2 * ((trans == CblasNoTrans) ? lda * j0 : j0);
+          const BASE *Bi = (const BASE *) B
+            + 2 * ((trans == CblasNoTrans) ? ldb * i0 : i0);
+          const BASE *Bj = (const BASE *) B
+            + 2 * ((trans == CblasNoTrans) ? ldb * j0 : j0);
+          BASE *Cij = (BASE *) C + 2 * (ldc * i0 + j0);
+
+          if (ti == tj) {
+            SELF(CblasRowMajor, uplo, trans, i1 - i0, K, calpha, Ai, lda,
+                 Bi, ldb, beta, Cij, ldc);
+          } else if ((uplo == CblasUpper) == (ti < tj)) {
+            GEMM(CblasRowMajor, transF, transG, i1 - i0, j1 - j0, K, calpha,
+                 Ai, lda, Bj, ldb, cbeta, Cij, ldc);
+            GEMM(CblasRowMajor, transF, transG, i1 - i0, j1 - j0, K,
+                 calpha_conj, Bi, ldb, Aj, lda, one, Cij, ldc);
+          }
+        }
+        return;
+      }
+    }
+
     /* form  C := beta*C */
 
     if (beta == 0.0) {
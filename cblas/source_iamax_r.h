@@ -27,6 +27,12 @@
     return 0;
   }
 
+#ifdef KERNELS
+  if (KERNELS != NULL && incX == 1) {
+    return KERNELS->iamax(N, X);
+  }
+#endif
+
   for (i = 0; i < N; i++) {
     if (fabs(X[ix]) > max) {
       max = fabs(X[ix]);
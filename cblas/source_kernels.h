@@ -0,0 +1,370 @@
+/* cblas/source_kernels.h
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Vectorized level 1 and level 2 kernels, instantiated once for each
+ * instruction set.  The includer defines
+ *
+ *   TARGET              function attribute enabling the instruction set
+ *   KFUNC(name)         name of the instantiated function
+ *   KNAME               name of the instruction set
+ *   VEC, VLEN           vector type and its number of doubles
+ *   VZERO, VLOAD, VSTORE, VSET1, VADD, VSUB, VMUL, VMAX, VFMA, VEND
+ *
+ * where VMAX(a,b) returns a where a > b and b otherwise (so that a NaN
+ * in a is ignored), VFMA(a,b,c) = a*b + c, and VEND() is called on
+ * exit from each kernel to clear the upper halves of the AVX registers,
+ * which otherwise slow down the SSE code of the caller.
+ *
+ * The elementwise updates (axpy, the transposed gemv and the vector
+ * update in symv) use a multiply and add in the order of the reference
+ * loops, but in the functions built for FMA the compiler may contract
+ * them into fused multiply-adds, so the results agree with the
+ * reference loops to rounding rather than exactly.  The reductions are
+ * also reordered. */
+
+static TARGET double
+KFUNC(hsum) (const VEC v)
+{
+  double t[VLEN], r = 0.0;
+  int i;
+
+  VSTORE (t, v);
+
+  for (i = 0; i < VLEN; i++)
+    r += t[i];
+
+  return r;
+}
+
+static TARGET double
+KFUNC(hmax) (const VEC v)
+{
+  double t[VLEN], r = 0.0;
+  int i;
+
+  VSTORE (t, v);
+
+  for (i = 0; i < VLEN; i++)
+    if (t[i] > r)
+      r = t[i];
+
+  return r;
+}
+
+static TARGET double
+KFUNC(dot) (const int N, const double *x, const double *y)
+{
+  VEC s0 = VZERO (), s1 = VZERO (), s2 = VZERO (), s3 = VZERO ();
+  double r;
+  int i = 0;
+
+  for (; i + 4 * VLEN <= N; i += 4 * VLEN) {
+    s0 = VFMA (VLOAD (x + i), VLOAD (y + i), s0);
+    s1 = VFMA (VLOAD (x + i + VLEN), VLOAD (y + i + VLEN), s1);
+    s2 = VFMA (VLOAD (x + i + 2 * VLEN), VLOAD (y + i + 2 * VLEN), s2);
+    s3 = VFMA (VLOAD (x + i + 3 * VLEN), VLOAD (y + i + 3 * VLEN), s3);
+  }
+
+  for (; i + VLEN <= N; i += VLEN) {
+    s0 = VFMA (VLOAD (x + i), VLOAD (y + i), s0);
+  }
+
+  r = KFUNC(hsum) (VADD (VADD (s0, s1), VADD (s2, s3)));
+
+  for (; i < N; i++) {
+    r += x[i] * y[i];
+  }
+
+  VEND ();
+
+  return r;
+}
+
+static TARGET void
+KFUNC(axpy) (const int N, const double alpha, const double *x, double *y)
+{
+  const VEC a = VSET1 (alpha);
+  int i = 0;
+
+  for (; i + 2 * VLEN <= N; i += 2 * VLEN) {
+    const VEC y0 = VADD (VLOAD (y + i), VMUL (a, VLOAD (x + i)));
+    const VEC y1 = VADD (VLOAD (y + i + VLEN), VMUL (a, VLOAD (x + i + VLEN)));
+    VSTORE (y + i, y0);
+    VSTORE (y + i + VLEN, y1);
+  }
+
+  for (; i < N; i++) {
+    y[i] += alpha * x[i];
+  }
+
+  VEND ();
+}
+
+static TARGET void
+KFUNC(scal) (const int N, const double alpha, double *x)
+{
+  const VEC a = VSET1 (alpha);
+  int i = 0;
+
+  for (; i + 2 * VLEN <= N; i += 2 * VLEN) {
+    VSTORE (x + i, VMUL (a, VLOAD (x + i)));
+    VSTORE (x + i + VLEN, VMUL (a, VLOAD (x + i + VLEN)));
+  }
+
+  for (; i < N; i++) {
+    x[i] *= alpha;
+  }
+
+  VEND ();
+}
+
+/* |x| as max(-x, x) */
+#define VABS(v) VMAX (VSUB (VZERO (), (v)), (v))
+
+static TARGET double
+KFUNC(amax) (const int N, const double *x)
+{
+  VEC m0 = VZERO (), m1 = VZERO ();
+  double r;
+  int i = 0;
+
+  for (; i + 2 * VLEN <= N; i += 2 * VLEN) {
+    m0 = VMAX (VABS (VLOAD (x + i)), m0);
+    m1 = VMAX (VABS (VLOAD (x + i + VLEN)), m1);
+  }
+
+  r = KFUNC(hmax) (VMAX (m0, m1));
+
+  for (; i < N; i++) {
+    if (fabs (x[i]) > r)
+      r = fabs (x[i]);
+  }
+
+  VEND ();
+
+  return r;
+}
+
+/* the maximum is located block by block, and a block is only scanned
+   element by element when it contains a new maximum */
+
+#define IAMAX_BLOCK 256
+
+static TARGET CBLAS_INDEX
+KFUNC(iamax) (const int N, const double *x)
+{
+  double max = 0.0;
+  CBLAS_INDEX result = 0;
+  int i0;
+
+  for (i0 = 0; i0 < N; i0 += IAMAX_BLOCK) {
+    const int nb = GSL_MIN (IAMAX_BLOCK, N - i0);
+
+    if (KFUNC(amax) (nb, x + i0) > max) {
+      int i;
+
+      for (i = i0; i < i0 + nb; i++) {
+        if (fabs (x[i]) > max) {
+          max = fabs (x[i]);
+          result = i;
+        }
+      }
+    }
+  }
+
+  return result;
+}
+
+static TARGET double
+KFUNC(ssq) (const int N, const double scale, const double *x)
+{
+  const VEC s = VSET1 (scale);
+  VEC s0 = VZERO (), s1 = VZERO ();
+  double r;
+  int i = 0;
+
+  for (; i + 2 * VLEN <= N; i += 2 * VLEN) {
+    const VEC t0 = VMUL (s, VLOAD (x + i));
+    const VEC t1 = VMUL (s, VLOAD (x + i + VLEN));
+    s0 = VFMA (t0, t0, s0);
+    s1 = VFMA (t1, t1, s1);
+  }
+
+  r = KFUNC(hsum) (VADD (s0, s1));
+
+  for (; i < N; i++) {
+    const double t = scale * x[i];
+    r += t * t;
+  }
+
+  VEND ();
+
+  return r;
+}
+
+/* four rows are processed per pass, so that each load of x is shared
+   between four dot products */
+
+static TARGET void
+KFUNC(gemv_n) (const int M, const int N, const double alpha,
+               const double *A, const int lda, const double *x,
+               double *y, const int incy)
+{
+  int i = 0, j;
+
+  for (; i + 4 <= M; i += 4) {
+    const double *a0 = A + lda * i;
+    const double *a1 = a0 + lda;
+    const double *a2 = a1 + lda;
+    const double *a3 = a2 + lda;
+    VEC s0 = VZERO (), s1 = VZERO (), s2 = VZERO (), s3 = VZERO ();
+    double t0, t1, t2, t3;
+
+    for (j = 0; j + VLEN <= N; j += VLEN) {
+      const VEC xv = VLOAD (x + j);
+      s0 = VFMA (VLOAD (a0 + j), xv, s0);
+      s1 = VFMA (VLOAD (a1 + j), xv, s1);
+      s2 = VFMA (VLOAD (a2 + j), xv, s2);
+      s3 = VFMA (VLOAD (a3 + j), xv, s3);
+    }
+
+    t0 = KFUNC(hsum) (s0);
+    t1 = KFUNC(hsum) (s1);
+    t2 = KFUNC(hsum) (s2);
+    t3 = KFUNC(hsum) (s3);
+
+    for (; j < N; j++) {
+      t0 += a0[j] * x[j];
+      t1 += a1[j] * x[j];
+      t2 += a2[j] * x[j];
+      t3 += a3[j] * x[j];
+    }
+
+    y[incy * i] += alpha * t0;
+    y[incy * (i + 1)] += alpha * t1;
+    y[incy * (i + 2)] += alpha * t2;
+    y[incy * (i + 3)] += alpha * t3;
+  }
+
+  for (; i < M; i++) {
+    y[incy * i] += alpha * KFUNC(dot) (N, A + lda * i, x);
+  }
+
+  VEND ();
+}
+
+/* four rows with nonzero alpha * x_i are accumulated per pass, so that y is
+   loaded and stored once for every four rows */
+
+static TARGET void
+KFUNC(gemv_t) (const int M, const int N, const double alpha,
+               const double *A, const int lda, const double *x,
+               const int incx, double *y)
+{
+  int rows[4];
+  int i, j, n = 0;
+
+  for (i = 0; i < M; i++) {
+    if (alpha * x[incx * i] == 0.0)
+      continue;
+
+    rows[n++] = i;
+
+    if (n == 4) {
+      const double *a0 = A + lda * rows[0];
+      const double *a1 = A + lda * rows[1];
+      const double *a2 = A + lda * rows[2];
+      const double *a3 = A + lda * rows[3];
+      const double c0 = alpha * x[incx * rows[0]];
+      const double c1 = alpha * x[incx * rows[1]];
+      const double c2 = alpha * x[incx * rows[2]];
+      const double c3 = alpha * x[incx * rows[3]];
+      const VEC v0 = VSET1 (c0), v1 = VSET1 (c1);
+      const VEC v2 = VSET1 (c2), v3 = VSET1 (c3);
+
+      for (j = 0; j + VLEN <= N; j += VLEN) {
+        VEC yv = VLOAD (y + j);
+        yv = VADD (yv, VMUL (v0, VLOAD (a0 + j)));
+        yv = VADD (yv, VMUL (v1, VLOAD (a1 + j)));
+        yv = VADD (yv, VMUL (v2, VLOAD (a2 + j)));
+        yv = VADD (yv, VMUL (v3, VLOAD (a3 + j)));
+        VSTORE (y + j, yv);
+      }
+
+      for (; j < N; j++) {
+        y[j] += c0 * a0[j];
+        y[j] += c1 * a1[j];
+        y[j] += c2 * a2[j];
+        y[j] += c3 * a3[j];
+      }
+
+      n = 0;
+    }
+  }
+
+  for (i = 0; i < n; i++) {
+    KFUNC(axpy) (N, alpha * x[incx * rows[i]], A + lda * rows[i], y);
+  }
+
+  VEND ();
+}
+
+static TARGET double
+KFUNC(symv_row) (const int N, const double alpha, const double *a,
+                 const double *x, double *y)
+{
+  const VEC t = VSET1 (alpha);
+  VEC s0 = VZERO (), s1 = VZERO ();
+  double r;
+  int i = 0;
+
+  for (; i + 2 * VLEN <= N; i += 2 * VLEN) {
+    const VEC a0 = VLOAD (a + i);
+    const VEC a1 = VLOAD (a + i + VLEN);
+    VSTORE (y + i, VADD (VLOAD (y + i), VMUL (t, a0)));
+    VSTORE (y + i + VLEN, VADD (VLOAD (y + i + VLEN), VMUL (t, a1)));
+    s0 = VFMA (a0, VLOAD (x + i), s0);
+    s1 = VFMA (a1, VLOAD (x + i + VLEN), s1);
+  }
+
+  r = KFUNC(hsum) (VADD (s0, s1));
+
+  for (; i < N; i++) {
+    y[i] += alpha * a[i];
+    r += a[i] * x[i];
+  }
+
+  VEND ();
+
+  return r;
+}
+
+#undef IAMAX_BLOCK
+#undef VABS
+
+static const gsl_cblas_dkernels KFUNC(kernels) = {
+  KNAME,
+  KFUNC(dot),
+  KFUNC(axpy),
+  KFUNC(scal),
+  KFUNC(iamax),
+  KFUNC(amax),
+  KFUNC(ssq),
+  KFUNC(gemv_n),
+  KFUNC(gemv_t),
+  KFUNC(symv_row)
+};
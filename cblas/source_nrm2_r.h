@@ -29,6 +29,19 @@
     return fabs(X[0]);
   }
 
+#ifdef KERNELS
+  if (KERNELS != NULL && incX == 1) {
+    /* two passes: find the largest element, then sum the squares
+       scaled by it.  Zero, subnormal or infinite maxima are left to
+       the one-pass loop below. */
+    const BASE amax = KERNELS->amax(N, X);
+
+    if (amax >= GSL_DBL_MIN && amax <= GSL_DBL_MAX) {
+      return amax * sqrt(KERNELS->ssq(N, 1.0 / amax, X));
+    }
+  }
+#endif
+
   for (i = 0; i < N; i++) {
     const BASE x = X[ix];
 
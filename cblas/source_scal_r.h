@@ -25,6 +25,13 @@
     return;
   }
 
+#ifdef KERNELS
+  if (KERNELS != NULL && incX == 1) {
+    KERNELS->scal(N, alpha, X);
+    return;
+  }
+#endif
+
   for (i = 0; i < N; i++) {
     X[ix] *= alpha;
     ix += incX;
@@ -46,6 +46,33 @@
       side = (Side == CblasLeft) ? CblasRight : CblasLeft;
     }
 
+    {
+      /* the columns (side = left) or rows (side = right) of B and C are
+         independent, so split them between threads */
+      const int nthreads =
+        gsl_cblas_threads (4.0 * n1 * n2 * ((side == CblasLeft) ? n1 : n2));
+
+      if (nthreads > 1) {
+        int t;
+#pragma omp parallel for num_threads(nthreads) schedule(static)
+        for (t = 0; t < nthreads; t++) {
+          if (side == CblasLeft) {
+            const INDEX j0 = PART_START(n2, nthreads, t);
+            const INDEX j1 = PART_START(n2, nthreads, t + 1);
+            SELF(CblasRowMajor, CblasLeft, uplo, n1, j1 - j0, alpha, A, lda,
+                 (const BASE *) B + 2 * j0, ldb, beta, (BASE *) C + 2 * j0, ldc);
+          } else {
+            const INDEX i0 = PART_START(n1, nthreads, t);
+            const INDEX i1 = PART_START(n1, nthreads, t + 1);
+            SELF(CblasRowMajor, CblasRight, uplo, i1 - i0, n2, alpha, A, lda,
+                 (const BASE *) B + 2 * ldb * i0, ldb, beta,
+                 (BASE *) C + 2 * ldc * i0, ldc);
+          }
+        }
+        return;
+      }
+    }
+
     /* form  y := beta*y */
     if (beta_real == 0.0 && beta_imag == 0.0) {
       for (i = 0; i < n1; i++) {
@@ -57,6 +57,20 @@
   if (alpha == 0.0)
     return;
 
+  /* large products go through the cache-blocked engine, which reads
+     the referenced triangle of A directly while packing */
+  if (side == CblasLeft) {
+    if (GEMM_USE_PACKED(n1, n2, n1)
+        && PACKED_GEMM(uplo, CblasNoTrans, n1, n2, n1, alpha, A, lda, B, ldb,
+                       C, ldc) == 0)
+      return;
+  } else {
+    if (GEMM_USE_PACKED(n1, n2, n2)
+        && PACKED_GEMM(CblasNoTrans, uplo, n1, n2, n2, alpha, B, ldb, A, lda,
+                       C, ldc) == 0)
+      return;
+  }
+
   if (side == CblasLeft && uplo == CblasUpper) {
 
     /* form  C := alpha*A*B + C */
@@ -45,6 +45,26 @@
 
   /* form  y := alpha*A*x + y */
 
+#ifdef KERNELS
+  if (KERNELS != NULL && incX == 1 && incY == 1) {
+    /* rows are visited in the same order as in the loops below */
+    const int upper = ((order == CblasRowMajor && Uplo == CblasUpper)
+                       || (order == CblasColMajor && Uplo == CblasLower));
+    for (i = 0; i < N; i++) {
+      const INDEX r = upper ? i : N - 1 - i;
+      const BASE temp1 = alpha * X[r];
+      const INDEX j_min = upper ? r + 1 : 0;
+      const INDEX j_max = upper ? N : r;
+      BASE temp2;
+      Y[r] += temp1 * A[lda * r + r];
+      temp2 = KERNELS->symv_row(j_max - j_min, temp1, A + lda * r + j_min,
+                                X + j_min, Y + j_min);
+      Y[r] += alpha * temp2;
+    }
+    return;
+  }
+#endif
+
   if ((order == CblasRowMajor && Uplo == CblasUpper)
       || (order == CblasColMajor && Uplo == CblasLower)) {
     INDEX ix = OFFSET(N, incX);
@@ -43,6 +43,41 @@
       trans = (Trans == CblasNoTrans) ? CblasTrans : CblasNoTrans;
     }
 
+    {
+      /* split the uplo triangle of C into a triangle of p-by-p tiles: the
+         diagonal tiles are computed by serial calls to this routine, and
+         the off-diagonal tiles by serial calls to the general product */
+      const int nthreads = gsl_cblas_threads (2.0 * N * N * K);
+
+      if (nthreads > 1) {
+        const int transF = (trans == CblasNoTrans) ? CblasNoTrans : CblasTrans;
+        const int transG = (trans == CblasNoTrans) ? CblasTrans : CblasNoTrans;
+        const int p = GSL_MIN(N, (int) ceil (sqrt (4.0 * nthreads)));
+        int t;
+
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic)
+        for (t = 0; t < p * p; t++) {
+          const INDEX ti = t / p, tj = t % p;
+          const INDEX i0 = PART_START(N, p, ti), i1 = PART_START(N, p, ti + 1);
+          const INDEX j0 = PART_START(N, p, tj), j1 = PART_START(N, p, tj + 1);
+          const BASE *Ai = (const BASE *) A
+            + 2 * ((trans == CblasNoTrans) ? lda * i0 : i0);
+          const BASE *Aj = (const BASE *) A
+            + 2 * ((trans == CblasNoTrans) ? lda * j0 : j0);
+          BASE *Cij = (BASE *) C + 2 * (ldc * i0 + j0);
+
+          if (ti == tj) {
+            SELF(CblasRowMajor, uplo, trans, i1 - i0, K, alpha, Ai, lda, beta,
+                 Cij, ldc);
+          } else if ((uplo == CblasUpper) == (ti < tj)) {
+            GEMM(CblasRowMajor, transF, transG, i1 - i0, j1 - j0, K, alpha,
+                 Ai, lda, Aj, lda, beta, Cij, ldc);
+          }
+        }
+        return;
+      }
+    }
+
     /* form  y := beta*y */
     if (beta_real == 0.0 && beta_imag == 0.0) {
       if (uplo == CblasUpper) {
@@ -73,7 +73,46 @@
   if (alpha == 0.0)
     return;
 
-  if (uplo == CblasUpper && trans == CblasNoTrans) {
+  if (N > SYRK_NB && GEMM_USE_PACKED(N, N, K)) {
+
+    /* blocked version: the off-diagonal part of each block row of C
+       goes through the cache-blocked engine, the diagonal block is
+       formed directly */
+
+    const int kindF = (trans == CblasNoTrans) ? CblasNoTrans : CblasTrans;
+    const int kindG = (trans == CblasNoTrans) ? CblasTrans : CblasNoTrans;
+    INDEX ib;
+
+    for (ib = 0; ib < N; ib += SYRK_NB) {
+      const INDEX nb = GSL_MIN(SYRK_NB, N - ib);
+      const INDEX jb = (uplo == CblasUpper) ? ib + nb : 0;
+      const INDEX je = (uplo == CblasUpper) ? N : ib;
+      const BASE *Ai = (trans == CblasNoTrans) ? A + lda * ib : A + ib;
+      const BASE *Aj = (trans == CblasNoTrans) ? A + lda * jb : A + jb;
+      const int packed = (je == jb)
+        || PACKED_GEMM(kindF, kindG, nb, je - jb, K, alpha, Ai, lda, Aj, lda,
+                       C + ldc * ib + jb, ldc) == 0;
+
+      for (i = ib; i < ib + nb; i++) {
+        const INDEX j1 = (uplo == CblasUpper) ? i : (packed ? ib : 0);
+        const INDEX j2 = (uplo == CblasUpper) ? (packed ? ib + nb : N) : i + 1;
+        for (j = j1; j < j2; j++) {
+          BASE temp = 0.0;
+          if (trans == CblasNoTrans) {
+            for (k = 0; k < K; k++) {
+              temp += A[i * lda + k] * A[j * lda + k];
+            }
+          } else {
+            for (k = 0; k < K; k++) {
+              temp += A[k * lda + i] * A[k * lda + j];
+            }
+          }
+          C[i * ldc + j] += alpha * temp;
+        }
+      }
+    }
+
+  } else if (uplo == CblasUpper && trans == CblasNoTrans) {
 
     for (i = 0; i < N; i++) {
       for (j = i; j < N; j++) {
@@ -40,6 +40,94 @@
     trans = (TransA == CblasConjTrans) ? CblasTrans : TransA;
   }
 
+  {
+    /* the right-hand sides are independent, so split them between
+       threads and solve each part serially */
+    const double work = 0.5 * n1 * n2 * ((side == CblasLeft) ? n1 : n2);
+    const int nthreads = gsl_cblas_threads (work);
+
+    if (nthreads > 1) {
+      int t;
+#pragma omp parallel for num_threads(nthreads) schedule(static)
+      for (t = 0; t < nthreads; t++) {
+        if (side == CblasLeft) {
+          const INDEX j0 = PART_START(n2, nthreads, t);
+          const INDEX j1 = PART_START(n2, nthreads, t + 1);
+          SELF(CblasRowMajor, CblasLeft, uplo, TransA, Diag, n1, j1 - j0,
+               alpha, A, lda, B + j0, ldb);
+        } else {
+          const INDEX i0 = PART_START(n1, nthreads, t);
+          const INDEX i1 = PART_START(n1, nthreads, t + 1);
+          SELF(CblasRowMajor, CblasRight, uplo, TransA, Diag, i1 - i0, n2,
+               alpha, A, lda, B + ldb * i0, ldb);
+        }
+      }
+      return;
+    }
+  }
+
+  {
+    /* recursive blocked algorithm: partition op(A) into 2x2 blocks,
+       solve with the diagonal blocks by recursion down to the loops
+       below and apply the off-diagonal block with GEMM, which also
+       scales the remaining part of B by alpha */
+    const INDEX nt = (side == CblasLeft) ? n1 : n2;
+    const INDEX nr = (side == CblasLeft) ? n2 : n1;
+
+    if (nt > TRSM_NB && nr >= 4) {
+      const INDEX k = nt / 2;
+      const INDEX m = nt - k;
+      const int upper = ((uplo == CblasUpper) == (trans == CblasNoTrans));
+      const BASE *A11 = A;
+      const BASE *A22 = A + lda * k + k;
+      const BASE *A0 = (uplo == CblasUpper) ? A + k : A + lda * k;
+
+      /* A0 is the stored off-diagonal block of A, so that op(A0) is
+         the off-diagonal block of op(A) */
+
+      if (side == CblasLeft) {
+        BASE *B1 = B;
+        BASE *B2 = B + ldb * k;
+
+        if (upper) {
+          SELF(CblasRowMajor, CblasLeft, uplo, TransA, Diag, m, n2, alpha,
+               A22, lda, B2, ldb);
+          GEMM(CblasRowMajor, trans, CblasNoTrans, k, n2, m, -1.0, A0, lda,
+               B2, ldb, alpha, B1, ldb);
+          SELF(CblasRowMajor, CblasLeft, uplo, TransA, Diag, k, n2, 1.0, A11,
+               lda, B1, ldb);
+        } else {
+          SELF(CblasRowMajor, CblasLeft, uplo, TransA, Diag, k, n2, alpha,
+               A11, lda, B1, ldb);
+          GEMM(CblasRowMajor, trans, CblasNoTrans, m, n2, k, -1.0, A0, lda,
+               B1, ldb, alpha, B2, ldb);
+          SELF(CblasRowMajor, CblasLeft, uplo, TransA, Diag, m, n2, 1.0, A22,
+               lda, B2, ldb);
+        }
+      } else {
+        BASE *B1 = B;
+        BASE *B2 = B + k;
+
+        if (upper) {
+          SELF(CblasRowMajor, CblasRight, uplo, TransA, Diag, n1, k, alpha,
+               A11, lda, B1, ldb);
+          GEMM(CblasRowMajor, CblasNoTrans, trans, n1, m, k, -1.0, B1, ldb,
+               A0, lda, alpha, B2, ldb);
+          SELF(CblasRowMajor, CblasRight, uplo, TransA, Diag, n1, m, 1.0, A22,
+               lda, B2, ldb);
+        } else {
+          SELF(CblasRowMajor, CblasRight, uplo, TransA, Diag, n1, m, alpha,
+               A22, lda, B2, ldb);
+          GEMM(CblasRowMajor, CblasNoTrans, trans, n1, k, m, -1.0, B2, ldb,
+               A0, lda, alpha, B1, ldb);
+          SELF(CblasRowMajor, CblasRight, uplo, TransA, Diag, n1, k, 1.0, A11,
+               lda, B1, ldb);
+        }
+      }
+      return;
+    }
+  }
+
   if (side == CblasLeft && uplo == CblasUpper && trans == CblasNoTrans) {
 
     /* form  B := alpha * inv(TriU(A)) *B */
@@ -2,6 +2,8 @@
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
 #include "error_cblas_l3.h"
+#include "gemm_packed.h"
+#include "parallel.h"
 
 void
 cblas_strmm (const enum CBLAS_ORDER Order, const enum CBLAS_SIDE Side,
@@ -11,6 +13,10 @@ cblas_strmm (const enum CBLAS_ORDER Order, const enum CBLAS_SIDE Side,
              const int ldb)
 {
 #define BASE float
+#define SELF cblas_strmm
+#define GEMM cblas_sgemm
 #include "source_trmm_r.h"
+#undef GEMM
+#undef SELF
 #undef BASE
 }
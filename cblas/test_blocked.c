@@ -0,0 +1,850 @@
+/* cblas/test_blocked.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* The generated tests only use tiny matrices, which are handled by the
+ * reference loops.  These tests use sizes large enough to go through
+ * the blocked level 3 code paths, and compare against a direct
+ * evaluation of the defining formula. */
+
+#include <stdlib.h>
+#include <gsl/gsl_test.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_cblas.h>
+
+#include "tests.h"
+
+static const int orders[] = { CblasRowMajor, CblasColMajor };
+static const int transes[] = { CblasNoTrans, CblasTrans };
+static const int uplos[] = { CblasUpper, CblasLower };
+static const int sides[] = { CblasLeft, CblasRight };
+
+static double
+urand (unsigned long *seed)
+{
+  *seed = (*seed * 1103515245UL + 12345UL) & 0x7fffffffUL;
+  return (double) *seed / 2147483648.0 - 0.5;
+}
+
+static double *
+random_array (const size_t n, unsigned long *seed)
+{
+  double *a = malloc (n * sizeof (double));
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    a[i] = urand (seed);
+
+  return a;
+}
+
+/* address of element (i,j) of a matrix stored in the given order */
+
+#define IDX(order,i,j,ld) ((order) == CblasRowMajor ? (i) * (ld) + (j) : (j) * (ld) + (i))
+
+/* element (i,j) of op(A) */
+
+static double
+op_elem (const int order, const int trans, const double *A, const int lda,
+         const int i, const int j)
+{
+  return (trans == CblasNoTrans) ? A[IDX (order, i, j, lda)] : A[IDX (order, j, i, lda)];
+}
+
+/* element (i,j) of a symmetric matrix stored in the uplo triangle */
+
+static double
+sym_elem (const int order, const int uplo, const double *A, const int lda,
+          const int i, const int j)
+{
+  if ((uplo == CblasUpper) == (i <= j))
+    return A[IDX (order, i, j, lda)];
+  else
+    return A[IDX (order, j, i, lda)];
+}
+
+/* maximum difference between C and Cref over the M-by-N matrix,
+   relative to the largest element of Cref */
+
+static double
+max_rel_diff (const int order, const int M, const int N, const double *C,
+              const double *Cref, const int ldc)
+{
+  double dmax = 0.0, cmax = 0.0;
+  int i, j;
+
+  for (i = 0; i < M; i++)
+    {
+      for (j = 0; j < N; j++)
+        {
+          const size_t idx = IDX (order, i, j, ldc);
+          dmax = GSL_MAX (dmax, fabs (C[idx] - Cref[idx]));
+          cmax = GSL_MAX (cmax, fabs (Cref[idx]));
+        }
+    }
+
+  return (cmax > 0.0) ? dmax / cmax : dmax;
+}
+
+static void
+test_gemm_blocked (const int M, const int N, const int K)
+{
+  const double alpha = 0.7, beta = -1.3;
+  const int ld = GSL_MAX (GSL_MAX (M, N), K) + 3;
+  unsigned long seed = 1;
+  double *A = random_array (ld * ld, &seed);
+  double *B = random_array (ld * ld, &seed);
+  double *C0 = random_array (ld * ld, &seed);
+  double *C = malloc (ld * ld * sizeof (double));
+  double *Cref = malloc (ld * ld * sizeof (double));
+  float *Af = malloc (ld * ld * sizeof (float));
+  float *Bf = malloc (ld * ld * sizeof (float));
+  float *Cf = malloc (ld * ld * sizeof (float));
+  size_t io, ia, ib, n;
+  int i, j, p;
+
+  for (n = 0; n < (size_t) (ld * ld); n++)
+    {
+      Af[n] = (float) A[n];
+      Bf[n] = (float) B[n];
+    }
+
+  for (io = 0; io < 2; io++)
+    {
+      const int order = orders[io];
+
+      for (ia = 0; ia < 2; ia++)
+        {
+          for (ib = 0; ib < 2; ib++)
+            {
+              const int transA = transes[ia], transB = transes[ib];
+              double err;
+
+              for (i = 0; i < M; i++)
+                {
+                  for (j = 0; j < N; j++)
+                    {
+                      const size_t idx = IDX (order, i, j, ld);
+                      double sum = 0.0;
+
+                      for (p = 0; p < K; p++)
+                        sum += op_elem (order, transA, A, ld, i, p) *
+                               op_elem (order, transB, B, ld, p, j);
+
+                      Cref[idx] = alpha * sum + beta * C0[idx];
+                    }
+                }
+
+              for (n = 0; n < (size_t) (ld * ld); n++)
+                {
+                  C[n] = C0[n];
+                  Cf[n] = (float) C0[n];
+                }
+
+              cblas_dgemm (order, transA, transB, M, N, K, alpha, A, ld,
+                           B, ld, beta, C, ld);
+              err = max_rel_diff (order, M, N, C, Cref, ld);
+              gsl_test (err > 1.0e-12, "dgemm blocked M=%d N=%d K=%d order=%d transA=%d transB=%d, error %g",
+                        M, N, K, order, transA, transB, err);
+
+              cblas_sgemm (order, transA, transB, M, N, K, (float) alpha,
+                           Af, ld, Bf, ld, (float) beta, Cf, ld);
+              for (n = 0; n < (size_t) (ld * ld); n++)
+                C[n] = Cf[n];
+              err = max_rel_diff (order, M, N, C, Cref, ld);
+              gsl_test (err > 1.0e-4, "sgemm blocked M=%d N=%d K=%d order=%d transA=%d transB=%d, error %g",
+                        M, N, K, order, transA, transB, err);
+            }
+        }
+    }
+
+  free (A);
+  free (B);
+  free (C0);
+  free (C);
+  free (Cref);
+  free (Af);
+  free (Bf);
+  free (Cf);
+}
+
+/* element (i,j) of op(A) for a complex matrix A, stored in z */
+
+static void
+op_zelem (const int order, const int trans, const double *A, const int lda,
+          const int i, const int j, double z[2])
+{
+  const size_t idx = (trans == CblasNoTrans) ? IDX (order, i, j, lda) : IDX (order, j, i, lda);
+
+  z[0] = A[2 * idx];
+  z[1] = (trans == CblasConjTrans) ? -A[2 * idx + 1] : A[2 * idx + 1];
+}
+
+static void
+test_zgemm_blocked (const int M, const int N, const int K)
+{
+  static const int ztranses[] = { CblasNoTrans, CblasTrans, CblasConjTrans };
+  const double alpha[2] = { 0.7, -0.4 }, beta[2] = { -1.3, 0.2 };
+  const float alphaf[2] = { 0.7f, -0.4f }, betaf[2] = { -1.3f, 0.2f };
+  const int ld = GSL_MAX (GSL_MAX (M, N), K) + 3;
+  const size_t n2 = 2 * ld * ld;
+  unsigned long seed = 3;
+  double *A = random_array (n2, &seed);
+  double *B = random_array (n2, &seed);
+  double *C0 = random_array (n2, &seed);
+  double *C = malloc (n2 * sizeof (double));
+  double *Cref = malloc (n2 * sizeof (double));
+  float *Af = malloc (n2 * sizeof (float));
+  float *Bf = malloc (n2 * sizeof (float));
+  float *Cf = malloc (n2 * sizeof (float));
+  size_t io, ia, ib, n;
+  int i, j, p, m;
+
+  for (n = 0; n < n2; n++)
+    {
+      Af[n] = (float) A[n];
+      Bf[n] = (float) B[n];
+    }
+
+  for (io = 0; io < 2; io++)
+    {
+      const int order = orders[io];
+
+      for (ia = 0; ia < 3; ia++)
+        {
+          for (ib = 0; ib < 3; ib++)
+            {
+              const int transA = ztranses[ia], transB = ztranses[ib];
+
+              for (n = 0; n < n2; n++)
+                Cref[n] = C0[n];
+
+              for (i = 0; i < M; i++)
+                {
+                  for (j = 0; j < N; j++)
+                    {
+                      const size_t idx = IDX (order, i, j, ld);
+                      double sr = 0.0, si = 0.0, a[2], b[2];
+
+                      for (p = 0; p < K; p++)
+                        {
+                          op_zelem (order, transA, A, ld, i, p, a);
+                          op_zelem (order, transB, B, ld, p, j, b);
+                          sr += a[0] * b[0] - a[1] * b[1];
+                          si += a[0] * b[1] + a[1] * b[0];
+                        }
+
+                      Cref[2 * idx] = alpha[0] * sr - alpha[1] * si
+                        + beta[0] * C0[2 * idx] - beta[1] * C0[2 * idx + 1];
+                      Cref[2 * idx + 1] = alpha[0] * si + alpha[1] * sr
+                        + beta[0] * C0[2 * idx + 1] + beta[1] * C0[2 * idx];
+                    }
+                }
+
+              /* m = 0 uses the four real products, m = 1 the three real
+                 products of the 3m variants.  The whole arrays are
+                 compared, to check that nothing outside C is written */
+
+              for (m = 0; m < 2; m++)
+                {
+                  double err;
+
+                  for (n = 0; n < n2; n++)
+                    {
+                      C[n] = C0[n];
+                      Cf[n] = (float) C0[n];
+                    }
+
+                  if (m == 0)
+                    {
+                      cblas_zgemm (order, transA, transB, M, N, K, alpha, A,
+                                   ld, B, ld, beta, C, ld);
+                      cblas_cgemm (order, transA, transB, M, N, K, alphaf,
+                                   Af, ld, Bf, ld, betaf, Cf, ld);
+                    }
+                  else
+                    {
+                      cblas_zgemm3m (order, transA, transB, M, N, K, alpha,
+                                     A, ld, B, ld, beta, C, ld);
+                      cblas_cgemm3m (order, transA, transB, M, N, K, alphaf,
+                                     Af, ld, Bf, ld, betaf, Cf, ld);
+                    }
+
+                  err = max_rel_diff (CblasRowMajor, 1, n2, C, Cref, n2);
+                  gsl_test (err > 1.0e-12, "%s blocked M=%d N=%d K=%d order=%d transA=%d transB=%d, error %g",
+                            m ? "zgemm3m" : "zgemm", M, N, K, order, transA, transB, err);
+
+                  for (n = 0; n < n2; n++)
+                    C[n] = Cf[n];
+
+                  err = max_rel_diff (CblasRowMajor, 1, n2, C, Cref, n2);
+                  gsl_test (err > 1.0e-4, "%s blocked M=%d N=%d K=%d order=%d transA=%d transB=%d, error %g",
+                            m ? "cgemm3m" : "cgemm", M, N, K, order, transA, transB, err);
+                }
+            }
+        }
+    }
+
+  free (A);
+  free (B);
+  free (C0);
+  free (C);
+  free (Cref);
+  free (Af);
+  free (Bf);
+  free (Cf);
+}
+
+static void
+test_symm_blocked (const int M, const int N)
+{
+  const double alpha = -0.4, beta = 0.9;
+  const int ld = GSL_MAX (M, N) + 2;
+  unsigned long seed = 2;
+  double *A = random_array (ld * ld, &seed);
+  double *B = random_array (ld * ld, &seed);
+  double *C0 = random_array (ld * ld, &seed);
+  double *C = malloc (ld * ld * sizeof (double));
+  double *Cref = malloc (ld * ld * sizeof (double));
+  size_t io, is, iu, n;
+  int i, j, p;
+
+  for (io = 0; io < 2; io++)
+    {
+      const int order = orders[io];
+
+      for (is = 0; is < 2; is++)
+        {
+          for (iu = 0; iu < 2; iu++)
+            {
+              const int side = sides[is], uplo = uplos[iu];
+              const int K = (side == CblasLeft) ? M : N;
+              double err;
+
+              for (i = 0; i < M; i++)
+                {
+                  for (j = 0; j < N; j++)
+                    {
+                      const size_t idx = IDX (order, i, j, ld);
+                      double sum = 0.0;
+
+                      for (p = 0; p < K; p++)
+                        {
+                          if (side == CblasLeft)
+                            sum += sym_elem (order, uplo, A, ld, i, p) * B[IDX (order, p, j, ld)];
+                          else
+                            sum += B[IDX (order, i, p, ld)] * sym_elem (order, uplo, A, ld, p, j);
+                        }
+
+                      Cref[idx] = alpha * sum + beta * C0[idx];
+                    }
+                }
+
+              for (n = 0; n < (size_t) (ld * ld); n++)
+                C[n] = C0[n];
+
+              cblas_dsymm (order, side, uplo, M, N, alpha, A, ld, B, ld,
+                           beta, C, ld);
+              err = max_rel_diff (order, M, N, C, Cref, ld);
+              gsl_test (err > 1.0e-12, "dsymm blocked M=%d N=%d order=%d side=%d uplo=%d, error %g",
+                        M, N, order, side, uplo, err);
+            }
+        }
+    }
+
+  free (A);
+  free (B);
+  free (C0);
+  free (C);
+  free (Cref);
+}
+
+/* tests dsyrk (rank2 = 0) and dsyr2k (rank2 = 1) */
+
+static void
+test_syrk_blocked (const int N, const int K, const int rank2)
+{
+  const double alpha = 1.1, beta = -0.6;
+  const int ld = GSL_MAX (N, K) + 1;
+  unsigned long seed = 3;
+  double *A = random_array (ld * ld, &seed);
+  double *B = random_array (ld * ld, &seed);
+  double *C0 = random_array (ld * ld, &seed);
+  double *C = malloc (ld * ld * sizeof (double));
+  double *Cref = malloc (ld * ld * sizeof (double));
+  size_t io, it, iu, n;
+  int i, j, p;
+
+  for (io = 0; io < 2; io++)
+    {
+      const int order = orders[io];
+
+      for (it = 0; it < 2; it++)
+        {
+          for (iu = 0; iu < 2; iu++)
+            {
+              const int trans = transes[it], uplo = uplos[iu];
+              double err;
+
+              for (n = 0; n < (size_t) (ld * ld); n++)
+                Cref[n] = C0[n];
+
+              for (i = 0; i < N; i++)
+                {
+                  for (j = 0; j < N; j++)
+                    {
+                      const size_t idx = IDX (order, i, j, ld);
+                      double sum = 0.0;
+
+                      if ((uplo == CblasUpper) ? (i > j) : (i < j))
+                        continue;
+
+                      for (p = 0; p < K; p++)
+                        {
+                          if (rank2)
+                            sum += op_elem (order, trans, A, ld, i, p) * op_elem (order, trans, B, ld, j, p)
+                                 + op_elem (order, trans, B, ld, i, p) * op_elem (order, trans, A, ld, j, p);
+                          else
+                            sum += op_elem (order, trans, A, ld, i, p) * op_elem (order, trans, A, ld, j, p);
+                        }
+
+                      Cref[idx] = alpha * sum + beta * C0[idx];
+                    }
+                }
+
+              for (n = 0; n < (size_t) (ld * ld); n++)
+                C[n] = C0[n];
+
+              if (rank2)
+                cblas_dsyr2k (order, uplo, trans, N, K, alpha, A, ld, B, ld,
+                              beta, C, ld);
+              else
+                cblas_dsyrk (order, uplo, trans, N, K, alpha, A, ld,
+                             beta, C, ld);
+
+              /* compare the full matrices, so that writes outside the
+                 uplo triangle are detected */
+              err = max_rel_diff (order, N, N, C, Cref, ld);
+              gsl_test (err > 1.0e-12, "%s blocked N=%d K=%d order=%d trans=%d uplo=%d, error %g",
+                        rank2 ? "dsyr2k" : "dsyrk", N, K, order, trans, uplo, err);
+            }
+        }
+    }
+
+  free (A);
+  free (B);
+  free (C0);
+  free (C);
+  free (Cref);
+}
+
+/* element (i,j) of op(A) for a triangular matrix A, as a complex
+   number z (stride = 2) or a real number (stride = 1) */
+
+static void
+tri_elem (const int stride, const int order, const int uplo,
+          const int trans, const int diag, const double *A, const int lda,
+          const int i, const int j, double z[2])
+{
+  const int r = (trans == CblasNoTrans) ? i : j;
+  const int c = (trans == CblasNoTrans) ? j : i;
+
+  z[0] = z[1] = 0.0;
+
+  if (r == c && diag == CblasUnit)
+    z[0] = 1.0;
+  else if ((uplo == CblasUpper) ? (r <= c) : (r >= c))
+    {
+      const size_t idx = stride * IDX (order, r, c, lda);
+      z[0] = A[idx];
+      if (stride == 2)
+        z[1] = (trans == CblasConjTrans) ? -A[idx + 1] : A[idx + 1];
+    }
+}
+
+/* R := alpha * op(A) * X (side = Left) or alpha * X * op(A) (side =
+   Right), in complex arithmetic */
+
+static void
+tri_product (const int stride, const int order, const int side,
+             const int uplo, const int trans, const int diag,
+             const int M, const int N, const double alpha[2],
+             const double *A, const double *X, double *R, const int ld)
+{
+  const int K = (side == CblasLeft) ? M : N;
+  int i, j, p;
+
+  for (i = 0; i < M; i++)
+    {
+      for (j = 0; j < N; j++)
+        {
+          double sr = 0.0, si = 0.0;
+          const size_t idx = stride * IDX (order, i, j, ld);
+
+          for (p = 0; p < K; p++)
+            {
+              double a[2], x[2];
+              const size_t xdx = (side == CblasLeft) ? stride * IDX (order, p, j, ld)
+                                                     : stride * IDX (order, i, p, ld);
+
+              if (side == CblasLeft)
+                tri_elem (stride, order, uplo, trans, diag, A, ld, i, p, a);
+              else
+                tri_elem (stride, order, uplo, trans, diag, A, ld, p, j, a);
+
+              x[0] = X[xdx];
+              x[1] = (stride == 2) ? X[xdx + 1] : 0.0;
+              sr += a[0] * x[0] - a[1] * x[1];
+              si += a[0] * x[1] + a[1] * x[0];
+            }
+
+          R[idx] = alpha[0] * sr - alpha[1] * si;
+          if (stride == 2)
+            R[idx + 1] = alpha[0] * si + alpha[1] * sr;
+        }
+    }
+}
+
+/* maximum difference between the M-by-N real (stride = 1) or
+   complex (stride = 2) matrices X and Xref, relative to the largest
+   element of Xref */
+
+static double
+max_rel_diff_stride (const int stride, const int order, const int M,
+                     const int N, const double *X, const double *Xref,
+                     const int ld)
+{
+  double dmax = 0.0, xmax = 0.0;
+  int i, j, c;
+
+  for (i = 0; i < M; i++)
+    {
+      for (j = 0; j < N; j++)
+        {
+          for (c = 0; c < stride; c++)
+            {
+              const size_t idx = stride * IDX (order, i, j, ld) + c;
+              dmax = GSL_MAX (dmax, fabs (X[idx] - Xref[idx]));
+              xmax = GSL_MAX (xmax, fabs (Xref[idx]));
+            }
+        }
+    }
+
+  return (xmax > 0.0) ? dmax / xmax : dmax;
+}
+
+/* checks dtrmm/ztrmm against the defining formula, and dtrsm/ztrsm by
+   multiplying the solution back with op(A) */
+
+static void
+test_trsm_blocked (const int stride, const int M, const int N)
+{
+  static const int transes3[] = { CblasNoTrans, CblasTrans, CblasConjTrans };
+  static const int diags[] = { CblasNonUnit, CblasUnit };
+  const double alpha_real[2] = { -1.7, 0.0 }, alpha_cplx[2] = { 0.6, -1.1 };
+  const double one[2] = { 1.0, 0.0 };
+  const double *alpha = (stride == 2) ? alpha_cplx : alpha_real;
+  const int ld = GSL_MAX (M, N) + 2;
+  const size_t n = stride * ld * ld;
+  unsigned long seed = 5;
+  double *A = random_array (n, &seed);
+  double *B0 = random_array (n, &seed);
+  double *B = malloc (n * sizeof (double));
+  double *R = malloc (n * sizeof (double));
+  double *S = malloc (n * sizeof (double));
+  const char *name = (stride == 2) ? "z" : "d";
+  size_t io, is, iu, it, id, i;
+
+  /* keep the triangular matrices well conditioned, including the
+     unit diagonal case */
+  for (i = 0; i < n; i++)
+    A[i] *= 4.0 / ld;
+
+  for (i = 0; i < (size_t) ld; i++)
+    A[stride * (ld * i + i)] += 1.0;
+
+  /* S = alpha * B0 */
+  for (i = 0; i < n; i += stride)
+    {
+      if (stride == 2)
+        {
+          S[i] = alpha[0] * B0[i] - alpha[1] * B0[i + 1];
+          S[i + 1] = alpha[0] * B0[i + 1] + alpha[1] * B0[i];
+        }
+      else
+        S[i] = alpha[0] * B0[i];
+    }
+
+  for (io = 0; io < 2; io++)
+    {
+      for (is = 0; is < 2; is++)
+        {
+          for (iu = 0; iu < 2; iu++)
+            {
+              for (it = 0; it < 3; it++)
+                {
+                  for (id = 0; id < 2; id++)
+                    {
+                      const int order = orders[io], side = sides[is];
+                      const int uplo = uplos[iu], trans = transes3[it];
+                      const int diag = diags[id];
+                      double err;
+
+                      for (i = 0; i < n; i++)
+                        B[i] = B0[i];
+
+                      if (stride == 2)
+                        cblas_ztrmm (order, side, uplo, trans, diag, M, N,
+                                     alpha, A, ld, B, ld);
+                      else
+                        cblas_dtrmm (order, side, uplo, trans, diag, M, N,
+                                     alpha[0], A, ld, B, ld);
+
+                      tri_product (stride, order, side, uplo, trans, diag,
+                                   M, N, alpha, A, B0, R, ld);
+                      err = max_rel_diff_stride (stride, order, M, N, B, R, ld);
+                      gsl_test (err > 1.0e-12, "%strmm blocked M=%d N=%d order=%d side=%d uplo=%d trans=%d diag=%d, error %g",
+                                name, M, N, order, side, uplo, trans, diag, err);
+
+                      for (i = 0; i < n; i++)
+                        B[i] = B0[i];
+
+                      if (stride == 2)
+                        cblas_ztrsm (order, side, uplo, trans, diag, M, N,
+                                     alpha, A, ld, B, ld);
+                      else
+                        cblas_dtrsm (order, side, uplo, trans, diag, M, N,
+                                     alpha[0], A, ld, B, ld);
+
+                      /* op(A) * X should reproduce alpha * B0 */
+                      tri_product (stride, order, side, uplo, trans, diag,
+                                   M, N, one, A, B, R, ld);
+                      err = max_rel_diff_stride (stride, order, M, N, R, S, ld);
+                      gsl_test (err > 1.0e-12, "%strsm blocked M=%d N=%d order=%d side=%d uplo=%d trans=%d diag=%d, error %g",
+                                name, M, N, order, side, uplo, trans, diag, err);
+                    }
+                }
+            }
+        }
+    }
+
+  free (A);
+  free (B0);
+  free (B);
+  free (R);
+  free (S);
+}
+
+/* the multithreaded routines split the output into tiles computed by
+   the serial code, so the results with several threads should agree
+   with the serial results to rounding error */
+
+#define TN 150
+#define TK 170
+#define TLD 173
+
+typedef void (*test_l3_op) (const int order, const int flag1,
+                            const int flag2, const double *A,
+                            const double *B, double *C);
+
+static void
+op_zgemm (const int order, const int transA, const int transB,
+          const double *A, const double *B, double *C)
+{
+  const double alpha[2] = { 0.3, -1.2 }, beta[2] = { 0.5, 0.1 };
+  cblas_zgemm (order, transA, transB, TN, TN - 3, TK, alpha, A, TLD, B, TLD,
+               beta, C, TLD);
+}
+
+static void
+op_zsymm (const int order, const int side, const int uplo,
+          const double *A, const double *B, double *C)
+{
+  const double alpha[2] = { 0.3, -1.2 }, beta[2] = { 0.5, 0.1 };
+  cblas_zsymm (order, side, uplo, TN, TK, alpha, A, TLD, B, TLD, beta, C, TLD);
+}
+
+static void
+op_zhemm (const int order, const int side, const int uplo,
+          const double *A, const double *B, double *C)
+{
+  const double alpha[2] = { 0.3, -1.2 }, beta[2] = { 0.5, 0.1 };
+  cblas_zhemm (order, side, uplo, TN, TK, alpha, A, TLD, B, TLD, beta, C, TLD);
+}
+
+static void
+op_zsyrk (const int order, const int uplo, const int trans,
+          const double *A, const double *B, double *C)
+{
+  const double alpha[2] = { 0.3, -1.2 }, beta[2] = { 0.5, 0.1 };
+  (void) B;
+  cblas_zsyrk (order, uplo, trans, TN, TK, alpha, A, TLD, beta, C, TLD);
+}
+
+static void
+op_zherk (const int order, const int uplo, const int trans,
+          const double *A, const double *B, double *C)
+{
+  (void) B;
+  cblas_zherk (order, uplo, (trans == CblasTrans) ? CblasConjTrans : trans,
+               TN, TK, 0.7, A, TLD, -0.2, C, TLD);
+}
+
+static void
+op_zsyr2k (const int order, const int uplo, const int trans,
+           const double *A, const double *B, double *C)
+{
+  const double alpha[2] = { 0.3, -1.2 }, beta[2] = { 0.5, 0.1 };
+  cblas_zsyr2k (order, uplo, trans, TN, TK, alpha, A, TLD, B, TLD, beta, C,
+                TLD);
+}
+
+static void
+op_zher2k (const int order, const int uplo, const int trans,
+           const double *A, const double *B, double *C)
+{
+  const double alpha[2] = { 0.3, -1.2 };
+  cblas_zher2k (order, uplo, (trans == CblasTrans) ? CblasConjTrans : trans,
+                TN, TK, alpha, A, TLD, B, TLD, 0.4, C, TLD);
+}
+
+static void
+op_ztrsm (const int order, const int side, const int uplo,
+          const double *A, const double *B, double *C)
+{
+  const double alpha[2] = { 0.3, -1.2 };
+  (void) B;
+  cblas_ztrsm (order, side, uplo, CblasConjTrans, CblasNonUnit, TN, TN,
+               alpha, A, TLD, C, TLD);
+}
+
+static void
+op_ztrmm (const int order, const int side, const int uplo,
+          const double *A, const double *B, double *C)
+{
+  const double alpha[2] = { 0.3, -1.2 };
+  (void) B;
+  cblas_ztrmm (order, side, uplo, CblasNoTrans, CblasUnit, TN, TN,
+               alpha, A, TLD, C, TLD);
+}
+
+static void
+op_dtrsm (const int order, const int side, const int uplo,
+          const double *A, const double *B, double *C)
+{
+  (void) B;
+  cblas_dtrsm (order, side, uplo, CblasTrans, CblasNonUnit, TN, TN,
+               -0.8, A, TLD, C, TLD);
+}
+
+static void
+op_dtrmm (const int order, const int side, const int uplo,
+          const double *A, const double *B, double *C)
+{
+  (void) B;
+  cblas_dtrmm (order, side, uplo, CblasNoTrans, CblasNonUnit, TN, TN,
+               1.5, A, TLD, C, TLD);
+}
+
+static void
+test_threads_op (const char *desc, test_l3_op op, const int *flags1,
+                 const int *flags2)
+{
+  const size_t n = 2 * TLD * TLD;
+  unsigned long seed = 4;
+  double *A = random_array (n, &seed);
+  double *B = random_array (n, &seed);
+  double *C0 = random_array (n, &seed);
+  double *C1 = malloc (n * sizeof (double));
+  double *C = malloc (n * sizeof (double));
+  const int nthreads = gsl_cblas_get_num_threads ();
+  size_t io, i1, i2, i;
+
+  /* keep the triangular matrices well conditioned for trsm */
+  for (i = 0; i < TLD; i++)
+    {
+      A[2 * (TLD * i + i)] += 10.0;
+    }
+
+  for (io = 0; io < 2; io++)
+    {
+      for (i1 = 0; i1 < 2; i1++)
+        {
+          for (i2 = 0; i2 < 2; i2++)
+            {
+              double dmax = 0.0, cmax = 0.0;
+
+              for (i = 0; i < n; i++)
+                C1[i] = C[i] = C0[i];
+
+              gsl_cblas_set_num_threads (1);
+              op (orders[io], flags1[i1], flags2[i2], A, B, C1);
+              gsl_cblas_set_num_threads (4);
+              op (orders[io], flags1[i1], flags2[i2], A, B, C);
+
+              for (i = 0; i < n; i++)
+                {
+                  dmax = GSL_MAX (dmax, fabs (C[i] - C1[i]));
+                  cmax = GSL_MAX (cmax, fabs (C1[i]));
+                }
+
+              gsl_test (dmax > 1.0e-13 * cmax, "%s threaded order=%d flags=%d,%d",
+                        desc, orders[io], flags1[i1], flags2[i2]);
+            }
+        }
+    }
+
+  gsl_cblas_set_num_threads (nthreads);
+
+  free (A);
+  free (B);
+  free (C0);
+  free (C1);
+  free (C);
+}
+
+static void
+test_threads (void)
+{
+  test_threads_op ("zgemm", op_zgemm, transes, transes);
+  test_threads_op ("zsymm", op_zsymm, sides, uplos);
+  test_threads_op ("zhemm", op_zhemm, sides, uplos);
+  test_threads_op ("zsyrk", op_zsyrk, uplos, transes);
+  test_threads_op ("zherk", op_zherk, uplos, transes);
+  test_threads_op ("zsyr2k", op_zsyr2k, uplos, transes);
+  test_threads_op ("zher2k", op_zher2k, uplos, transes);
+  test_threads_op ("ztrsm", op_ztrsm, sides, uplos);
+  test_threads_op ("ztrmm", op_ztrmm, sides, uplos);
+  test_threads_op ("dtrsm", op_dtrsm, sides, uplos);
+  test_threads_op ("dtrmm", op_dtrmm, sides, uplos);
+}
+
+void
+test_blocked (void)
+{
+  test_gemm_blocked (150, 70, 270);
+  test_gemm_blocked (37, 131, 41);
+  test_zgemm_blocked (70, 45, 90);
+  test_zgemm_blocked (33, 61, 17);
+  test_zgemm_blocked (24, 19, 300);    /* more than one KC block */
+  test_symm_blocked (133, 71);
+  test_syrk_blocked (150, 37, 0);
+  test_syrk_blocked (150, 37, 1);
+  test_syrk_blocked (70, 300, 1);
+  test_trsm_blocked (1, 150, 97);
+  test_trsm_blocked (2, 131, 140);
+  test_threads ();
+}
@@ -0,0 +1,285 @@
+/* cblas/test_kernels.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Tests the vectorized level 1 and level 2 kernels for every
+ * instruction set supported by the processor, against direct loops,
+ * with lengths covering the vector remainder handling. */
+
+#include <stdlib.h>
+#include <gsl/gsl_test.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_cblas.h>
+
+#include "kernels.h"
+#include "tests.h"
+
+static const int lengths[] = { 0, 1, 2, 3, 5, 7, 8, 15, 16, 17, 31, 33, 63,
+                               100, 257, 1000 };
+
+#define NLENGTHS (sizeof (lengths) / sizeof (lengths[0]))
+
+static double
+urand (unsigned long *seed)
+{
+  *seed = (*seed * 1103515245UL + 12345UL) & 0x7fffffffUL;
+  return (double) *seed / 2147483648.0 - 0.5;
+}
+
+static void
+fill (double *x, const int n, unsigned long *seed)
+{
+  int i;
+
+  for (i = 0; i < n; i++)
+    x[i] = urand (seed);
+}
+
+static void
+test_kernels_l1 (const gsl_cblas_dkernels * k)
+{
+  const int nmax = 1000;
+  double *x = malloc (nmax * sizeof (double));
+  double *y = malloc (nmax * sizeof (double));
+  double *z = malloc (nmax * sizeof (double));
+  unsigned long seed = 7;
+  size_t t;
+  int i;
+
+  for (t = 0; t < NLENGTHS; t++)
+    {
+      const int n = lengths[t];
+      const double alpha = -1.3;
+      double expected, bound, r, amax;
+      CBLAS_INDEX imax;
+      int ok;
+
+      fill (x, n, &seed);
+      fill (y, n, &seed);
+
+      expected = 0.0;
+      bound = 0.0;
+      for (i = 0; i < n; i++)
+        {
+          expected += x[i] * y[i];
+          bound += fabs (x[i] * y[i]);
+        }
+      r = k->dot (n, x, y);
+      gsl_test (fabs (r - expected) > 1.0e-14 * bound,
+                "%s dot n=%d", k->name, n);
+
+      for (i = 0; i < n; i++)
+        z[i] = y[i];
+      k->axpy (n, alpha, x, z);
+      ok = 1;
+      for (i = 0; i < n; i++)
+        ok &= fabs (z[i] - (y[i] + alpha * x[i])) <= 1.0e-15 * (fabs (alpha * x[i]) + fabs (y[i]));
+      gsl_test (!ok, "%s axpy n=%d", k->name, n);
+
+      for (i = 0; i < n; i++)
+        z[i] = y[i];
+      k->scal (n, alpha, z);
+      ok = 1;
+      for (i = 0; i < n; i++)
+        ok &= (z[i] == alpha * y[i]);
+      gsl_test (!ok, "%s scal n=%d", k->name, n);
+
+      /* repeat the maximum, so that the first occurrence must be found */
+      if (n > 4)
+        {
+          x[n / 2] = 2.0;
+          x[n - 1] = -2.0;
+        }
+
+      if (n > 2)
+        x[1] = GSL_NAN;
+
+      amax = 0.0;
+      imax = 0;
+      for (i = 0; i < n; i++)
+        {
+          if (fabs (x[i]) > amax)
+            {
+              amax = fabs (x[i]);
+              imax = i;
+            }
+        }
+
+      gsl_test (k->amax (n, x) != amax, "%s amax n=%d", k->name, n);
+      gsl_test (k->iamax (n, x) != imax, "%s iamax n=%d", k->name, n);
+
+      expected = 0.0;
+      for (i = 0; i < n; i++)
+        expected += (0.25 * y[i]) * (0.25 * y[i]);
+      r = k->ssq (n, 0.25, y);
+      gsl_test (fabs (r - expected) > 1.0e-14 * expected,
+                "%s ssq n=%d", k->name, n);
+
+      for (i = 0; i < n; i++)
+        z[i] = y[i];
+      fill (x, n, &seed);
+      expected = 0.0;
+      bound = 0.0;
+      for (i = 0; i < n; i++)
+        {
+          expected += y[i] * x[i];
+          bound += fabs (y[i] * x[i]);
+        }
+      r = k->symv_row (n, alpha, y, x, z);
+      ok = (fabs (r - expected) <= 1.0e-14 * bound);
+      for (i = 0; i < n; i++)
+        ok &= fabs (z[i] - (y[i] + alpha * y[i])) <= 1.0e-15 * fabs (y[i]) * (1.0 + fabs (alpha));
+      gsl_test (!ok, "%s symv_row n=%d", k->name, n);
+    }
+
+  free (x);
+  free (y);
+  free (z);
+}
+
+static void
+test_kernels_gemv (const gsl_cblas_dkernels * k, const int M, const int N)
+{
+  const int lda = N + 3, inc = 2;
+  const double alpha = 0.7;
+  const int nv = inc * GSL_MAX (M, N) + 1;
+  double *A = malloc (M * lda * sizeof (double));
+  double *x = malloc (nv * sizeof (double));
+  double *y = malloc (nv * sizeof (double));
+  double *z = malloc (nv * sizeof (double));
+  unsigned long seed = 11;
+  int i, j, ok;
+
+  fill (A, M * lda, &seed);
+  fill (x, nv, &seed);
+  fill (y, nv, &seed);
+
+  /* y_i += alpha * A_i x, with y strided */
+
+  for (i = 0; i < nv; i++)
+    z[i] = y[i];
+
+  k->gemv_n (M, N, alpha, A, lda, x, z, inc);
+
+  ok = 1;
+  for (i = 0; i < M; i++)
+    {
+      double sum = 0.0, bound = 0.0;
+
+      for (j = 0; j < N; j++)
+        {
+          sum += A[lda * i + j] * x[j];
+          bound += fabs (A[lda * i + j] * x[j]);
+        }
+
+      ok &= fabs (z[inc * i] - (y[inc * i] + alpha * sum)) <= 1.0e-14 * (bound + fabs (y[inc * i]));
+    }
+
+  for (i = 0; i < nv; i++)
+    {
+      if (i % inc != 0 || i >= inc * M)
+        ok &= (z[i] == y[i]);
+    }
+
+  gsl_test (!ok, "%s gemv_n M=%d N=%d", k->name, M, N);
+
+  /* y += alpha * A' x, with x strided and some x_i = 0 skipped, so
+     that a NaN in the corresponding row must not propagate */
+
+  for (i = 0; i < M; i += 3)
+    {
+      x[inc * i] = 0.0;
+      A[lda * i] = GSL_NAN;
+    }
+
+  for (i = 0; i < nv; i++)
+    z[i] = y[i];
+
+  k->gemv_t (M, N, alpha, A, lda, x, inc, z);
+
+  ok = 1;
+  for (j = 0; j < N; j++)
+    {
+      double sum = 0.0, bound = 0.0;
+
+      for (i = 0; i < M; i++)
+        {
+          if (x[inc * i] != 0.0)
+            {
+              sum += A[lda * i + j] * x[inc * i];
+              bound += fabs (A[lda * i + j] * x[inc * i]);
+            }
+        }
+
+      ok &= fabs (z[j] - (y[j] + alpha * sum)) <= 1.0e-14 * (bound + fabs (y[j]));
+    }
+
+  for (j = N; j < nv; j++)
+    ok &= (z[j] == y[j]);
+
+  gsl_test (!ok, "%s gemv_t M=%d N=%d", k->name, M, N);
+
+  free (A);
+  free (x);
+  free (y);
+  free (z);
+}
+
+/* dnrm2 must not overflow or underflow for large or tiny elements */
+
+static void
+test_kernels_nrm2 (void)
+{
+  static const double scales[] = { 1.0, 1.0e300, 1.0e-300, 1.0e-310 };
+  const int n = 100;
+  double x[100];
+  size_t s;
+  int i;
+
+  for (s = 0; s < sizeof (scales) / sizeof (scales[0]); s++)
+    {
+      double r;
+
+      for (i = 0; i < n; i++)
+        x[i] = scales[s] * ((i % 2) ? 1.0 : -1.0);
+
+      r = cblas_dnrm2 (n, x, 1);
+      gsl_test (fabs (r - 10.0 * scales[s]) > 1.0e-14 * 10.0 * scales[s],
+                "dnrm2 scale=%g", scales[s]);
+    }
+}
+
+void
+test_kernels (void)
+{
+  int arch;
+
+  for (arch = KERNELS_SSE2; arch <= KERNELS_AVX512; arch++)
+    {
+      const gsl_cblas_dkernels *k = gsl_cblas_dkernels_arch (arch);
+
+      if (k == NULL)
+        continue;
+
+      test_kernels_l1 (k);
+      test_kernels_gemv (k, 1, 1);
+      test_kernels_gemv (k, 7, 5);
+      test_kernels_gemv (k, 33, 70);
+      test_kernels_gemv (k, 100, 19);
+    }
+
+  test_kernels_nrm2 ();
+}
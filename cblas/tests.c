@@ -42,3 +42,5 @@
   test_her2k ();
   test_trmm ();
   test_trsm ();
+  test_blocked ();
+  test_kernels ();
@@ -42,3 +42,5 @@ void test_syr2k (void);
 void test_her2k (void);
 void test_trmm (void);
 void test_trsm (void);
+void test_blocked (void);
+void test_kernels (void);
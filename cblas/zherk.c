@@ -2,6 +2,7 @@
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
 #include "error_cblas_l3.h"
+#include "parallel.h"
 
 void
 cblas_zherk (const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo,
@@ -10,6 +11,10 @@ cblas_zherk (const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo,
              const double beta, void *C, const int ldc)
 {
 #define BASE double
+#define SELF cblas_zherk
+#define GEMM cblas_zgemm
 #include "source_herk.h"
+#undef GEMM
+#undef SELF
 #undef BASE
 }
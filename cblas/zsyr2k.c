@@ -2,6 +2,7 @@
 #include <gsl/gsl_cblas.h>
 #include "cblas.h"
 #include "error_cblas_l3.h"
+#include "parallel.h"
 
 void
 cblas_zsyr2k (const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo,
@@ -10,6 +11,10 @@ cblas_zsyr2k (const enum CBLAS_ORDER Order, const enum CBLAS_UPLO Uplo,
               const int ldb, const void *beta, void *C, const int ldc)
 {
 #define BASE double
+#define SELF cblas_zsyr2k
+#define GEMM cblas_zgemm
 #include "source_syr2k_c.h"
+#undef GEMM
+#undef SELF
 #undef BASE
 }
@@ -0,0 +1,188 @@
+/* eigen/batch.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <math.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_sys.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_eigen.h>
+
+#include "batch_internal.h"
+
+/*
+ * this module computes the eigensystems of batches of small symmetric
+ * n-by-n matrices, such as 3-by-3 tensors, without workspaces. The
+ * matrices of a batch are stored one below the other in an
+ * (nbatch*n)-by-n matrix, their eigenvalues one after the other in a
+ * vector of length nbatch*n, and their eigenvectors in an
+ * (nbatch*n)-by-n matrix, as in gsl_linalg_LU_decomp_batch.
+ *
+ * Each matrix is diagonalized by cyclic Jacobi rotations, which for
+ * these sizes converge in a few sweeps and are more accurate than the
+ * QR method. For n <= BATCH_MAX_N there is a separate kernel for each
+ * size, with all loop bounds fixed at compile time.
+ */
+
+/* largest matrix size with a size-specific kernel */
+#define BATCH_MAX_N 4
+
+/* maximum number of Jacobi sweeps */
+#define BATCH_EIGEN_MAXSWEEP 30
+
+typedef int (*batch_symmv_fn) (const size_t n, double * A, const size_t lda,
+                               double * eval, const size_t estride,
+                               double * V, const size_t ldv);
+
+#define BATCH_N 1
+#define BATCH_SUFFIX 1
+#include "batch_source.c"
+#undef BATCH_N
+#undef BATCH_SUFFIX
+
+#define BATCH_N 2
+#define BATCH_SUFFIX 2
+#include "batch_source.c"
+#undef BATCH_N
+#undef BATCH_SUFFIX
+
+#define BATCH_N 3
+#define BATCH_SUFFIX 3
+#include "batch_source.c"
+#undef BATCH_N
+#undef BATCH_SUFFIX
+
+#define BATCH_N 4
+#define BATCH_SUFFIX 4
+#include "batch_source.c"
+#undef BATCH_N
+#undef BATCH_SUFFIX
+
+#define BATCH_N n
+#define BATCH_SUFFIX n
+#include "batch_source.c"
+#undef BATCH_N
+#undef BATCH_SUFFIX
+
+static const batch_symmv_fn symmv_kernels[BATCH_MAX_N + 1] = {
+  NULL, symmv_1, symmv_2, symmv_3, symmv_4
+};
+
+static int batch_symmv (const size_t nbatch, gsl_matrix * A, gsl_vector * eval,
+                        gsl_matrix * evec);
+
+/*
+gsl_eigen_symm_batch()
+  Eigenvalues of a batch of real symmetric n-by-n matrices
+
+Inputs: A    - (nbatch*n)-by-n matrix; rows k*n to k*n+n-1 hold A_k,
+               whose lower triangle is referenced; destroyed on output
+        eval - (output) eigenvalues, length nbatch*n; elements k*n to
+               k*n+n-1 hold those of A_k in ascending order
+
+Return: success/error
+*/
+
+int
+gsl_eigen_symm_batch (gsl_matrix * A, gsl_vector * eval)
+{
+  size_t nbatch;
+
+  if (batch_check (A, &nbatch))
+    {
+      GSL_ERROR ("number of rows of A must be a multiple of the number of columns",
+                 GSL_EBADLEN);
+    }
+  else if (eval->size != A->size1)
+    {
+      GSL_ERROR ("eigenvalue vector must have length nbatch*n", GSL_EBADLEN);
+    }
+  else
+    {
+      return batch_symmv (nbatch, A, eval, NULL);
+    }
+}
+
+/*
+gsl_eigen_symmv_batch()
+  Eigenvalues and eigenvectors of a batch of real symmetric n-by-n
+matrices
+
+Inputs: A    - (nbatch*n)-by-n matrix; rows k*n to k*n+n-1 hold A_k,
+               whose lower triangle is referenced; destroyed on output
+        eval - (output) eigenvalues, length nbatch*n; elements k*n to
+               k*n+n-1 hold those of A_k in ascending order
+        evec - (output) (nbatch*n)-by-n matrix; rows k*n to k*n+n-1
+               hold the orthonormal eigenvectors of A_k in columns
+
+Return: success/error
+*/
+
+int
+gsl_eigen_symmv_batch (gsl_matrix * A, gsl_vector * eval, gsl_matrix * evec)
+{
+  size_t nbatch;
+
+  if (batch_check (A, &nbatch))
+    {
+      GSL_ERROR ("number of rows of A must be a multiple of the number of columns",
+                 GSL_EBADLEN);
+    }
+  else if (eval->size != A->size1)
+    {
+      GSL_ERROR ("eigenvalue vector must have length nbatch*n", GSL_EBADLEN);
+    }
+  else if (evec->size1 != A->size1 || evec->size2 != A->size2)
+    {
+      GSL_ERROR ("eigenvector matrix must be the same size as A", GSL_EBADLEN);
+    }
+  else
+    {
+      return batch_symmv (nbatch, A, eval, evec);
+    }
+}
+
+/* compute the eigensystems of the batch, with sizes already checked */
+
+static int
+batch_symmv (const size_t nbatch, gsl_matrix * A, gsl_vector * eval,
+             gsl_matrix * evec)
+{
+  const size_t n = A->size2;
+  const int nthreads = gsl_get_num_threads ();
+  const batch_symmv_fn kernel = BATCH_KERNEL (symmv, n);
+  int k, status = 0;
+
+#pragma omp parallel for num_threads(nthreads) schedule(static) reduction(|:status)
+  for (k = 0; k < (int) nbatch; k++)
+    {
+      status |= kernel (n, A->data + k * n * A->tda, A->tda,
+                        eval->data + k * n * eval->stride, eval->stride,
+                        (evec != NULL) ? evec->data + k * n * evec->tda : NULL,
+                        (evec != NULL) ? evec->tda : 0);
+    }
+
+  if (status)
+    {
+      GSL_ERROR ("Jacobi iterations did not converge", GSL_EMAXITER);
+    }
+
+  return GSL_SUCCESS;
+}
@@ -0,0 +1,174 @@
+/* eigen/batch_source.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * kernel for one small symmetric n-by-n matrix, included by batch.c once
+ * for each size BATCH_N = 1, ..., BATCH_MAX_N, so that all loop bounds are
+ * known at compile time, and once with BATCH_N = n for larger matrices.
+ */
+
+/*
+symmv()
+  Eigenvalues and eigenvectors of a symmetric matrix by cyclic Jacobi
+rotations, with the rotations of gsl_eigen_jacobi
+
+Inputs: n       - size of matrix
+        A       - matrix with row stride lda; the lower triangle is
+                  referenced, and the whole matrix is destroyed
+        lda     - row stride of A
+        eval    - (output) eigenvalues in ascending order
+        estride - stride of eval
+        V       - (output) eigenvectors in columns, or NULL
+        ldv     - row stride of V
+
+Return: 0 on success, 1 if the sweep limit was reached
+
+Notes: a rotation is skipped when |A_pq| <= eps sqrt(|A_pp A_qq|), so
+that the eigenvalues are computed to high relative accuracy when A is
+a well conditioned scaling of a positive definite matrix, as in
+
+Demmel, J. and Veselic, K., 1992. Jacobi's method is more accurate
+  than QR. SIAM J. Matrix Anal. Appl., 13(4), pp.1204-1245.
+*/
+
+static int
+FUNCTION (symmv) (const size_t n, double * A, const size_t lda,
+                  double * eval, const size_t estride,
+                  double * V, const size_t ldv)
+{
+  size_t i, j, p, q, sweep;
+  int rotated = 1;
+
+  (void) n;
+
+  /* copy the lower triangle to the upper */
+  for (i = 0; i < BATCH_N; i++)
+    {
+      for (j = 0; j < i; j++)
+        A[j * lda + i] = A[i * lda + j];
+    }
+
+  if (V != NULL)
+    {
+      for (i = 0; i < BATCH_N; i++)
+        {
+          for (j = 0; j < BATCH_N; j++)
+            V[i * ldv + j] = (i == j) ? 1.0 : 0.0;
+        }
+    }
+
+  for (sweep = 0; rotated && sweep < BATCH_EIGEN_MAXSWEEP; sweep++)
+    {
+      rotated = 0;
+
+      for (p = 0; p < BATCH_N; p++)
+        {
+          for (q = p + 1; q < BATCH_N; q++)
+            {
+              const double apq = A[p * lda + q];
+              const double app = A[p * lda + p];
+              const double aqq = A[q * lda + q];
+              double tau, t, c, s;
+              size_t r;
+
+              if (fabs (apq) <= GSL_DBL_EPSILON * sqrt (fabs (app)) * sqrt (fabs (aqq)) ||
+                  fabs (apq) < GSL_DBL_MIN)
+                continue;
+
+              rotated = 1;
+
+              tau = (aqq - app) / (2.0 * apq);
+
+              if (tau >= 0.0)
+                t = 1.0 / (tau + hypot (1.0, tau));
+              else
+                t = -1.0 / (-tau + hypot (1.0, tau));
+
+              c = 1.0 / hypot (1.0, t);
+              s = t * c;
+
+              /* A = J^T A J, which annihilates A_pq */
+              A[p * lda + p] = app - t * apq;
+              A[q * lda + q] = aqq + t * apq;
+              A[p * lda + q] = 0.0;
+              A[q * lda + p] = 0.0;
+
+              for (r = 0; r < BATCH_N; r++)
+                {
+                  double arp, arq;
+
+                  if (r == p || r == q)
+                    continue;
+
+                  arp = A[r * lda + p];
+                  arq = A[r * lda + q];
+
+                  A[r * lda + p] = A[p * lda + r] = c * arp - s * arq;
+                  A[r * lda + q] = A[q * lda + r] = s * arp + c * arq;
+                }
+
+              if (V != NULL)
+                {
+                  for (r = 0; r < BATCH_N; r++)
+                    {
+                      const double vrp = V[r * ldv + p];
+                      const double vrq = V[r * ldv + q];
+
+                      V[r * ldv + p] = c * vrp - s * vrq;
+                      V[r * ldv + q] = s * vrp + c * vrq;
+                    }
+                }
+            }
+        }
+    }
+
+  for (i = 0; i < BATCH_N; i++)
+    eval[i * estride] = A[i * lda + i];
+
+  /* sort into ascending order */
+  for (i = 0; i + 1 < BATCH_N; i++)
+    {
+      size_t k = i;
+
+      for (j = i + 1; j < BATCH_N; j++)
+        {
+          if (eval[j * estride] < eval[k * estride])
+            k = j;
+        }
+
+      if (k != i)
+        {
+          const double tmp = eval[i * estride];
+
+          eval[i * estride] = eval[k * estride];
+          eval[k * estride] = tmp;
+
+          if (V != NULL)
+            {
+              for (j = 0; j < BATCH_N; j++)
+                {
+                  const double vji = V[j * ldv + i];
+
+                  V[j * ldv + i] = V[j * ldv + k];
+                  V[j * ldv + k] = vji;
+                }
+            }
+        }
+    }
+
+  return rotated;
+}
@@ -57,6 +57,48 @@ gsl_eigen_symmv_workspace * gsl_eigen_symmv_alloc (const size_t n);
 void gsl_eigen_symmv_free (gsl_eigen_symmv_workspace * w);
 int gsl_eigen_symmv (gsl_matrix * A, gsl_vector * eval, gsl_matrix * evec, gsl_eigen_symmv_workspace * w);
 
+int gsl_eigen_symm_batch (gsl_matrix * A, gsl_vector * eval);
+int gsl_eigen_symmv_batch (gsl_matrix * A, gsl_vector * eval, gsl_matrix * evec);
+
+typedef struct {
+  size_t size;
+  double * d;
+  double * sd;
+  double * gc;
+  double * gs;
+  double * work;         /* scratch, length 6 n */
+  size_t * iwork;        /* scratch, length 5 n */
+  gsl_matrix * Z;        /* eigenvectors of tridiagonal matrix */
+  gsl_matrix * U;        /* eigenvectors of rank one modification */
+} gsl_eigen_symmvdc_workspace;
+
+gsl_eigen_symmvdc_workspace * gsl_eigen_symmvdc_alloc (const size_t n);
+void gsl_eigen_symmvdc_free (gsl_eigen_symmvdc_workspace * w);
+int gsl_eigen_symmvdc (gsl_matrix * A, gsl_vector * eval, gsl_matrix * evec, gsl_eigen_symmvdc_workspace * w);
+
+typedef struct {
+  size_t size;
+  double * d;
+  double * sd;
+  double * tau;
+  double * work;         /* bisection intervals, length 2 n */
+  size_t * iwork;        /* block and cluster indices, length 4 n + 2 */
+} gsl_eigen_symmx_workspace;
+
+gsl_eigen_symmx_workspace * gsl_eigen_symmx_alloc (const size_t n);
+void gsl_eigen_symmx_free (gsl_eigen_symmx_workspace * w);
+int gsl_eigen_symmx_range (gsl_matrix * A, const double vl, const double vu,
+                           gsl_vector * eval, size_t * nfound,
+                           gsl_eigen_symmx_workspace * w);
+int gsl_eigen_symmx_index (gsl_matrix * A, const size_t il, const size_t iu,
+                           gsl_vector * eval, gsl_eigen_symmx_workspace * w);
+int gsl_eigen_symmvx_range (gsl_matrix * A, const double vl, const double vu,
+                            gsl_vector * eval, gsl_matrix * evec,
+                            size_t * nfound, gsl_eigen_symmx_workspace * w);
+int gsl_eigen_symmvx_index (gsl_matrix * A, const size_t il, const size_t iu,
+                            gsl_vector * eval, gsl_matrix * evec,
+                            gsl_eigen_symmx_workspace * w);
+
 typedef struct {
   size_t size;
   double * d;
@@ -106,6 +148,12 @@ int gsl_eigen_francis_Z (gsl_matrix * H, gsl_vector_complex * eval,
                          gsl_matrix * Z,
                          gsl_eigen_francis_workspace * w);
 
+typedef enum {
+  GSL_EIGEN_NONSYMM_FRANCIS,
+  GSL_EIGEN_NONSYMM_MULTISHIFT
+}
+gsl_eigen_nonsymm_method_t;
+
 typedef struct {
   size_t size;                 /* size of matrices */
   gsl_vector *diag;            /* diagonal matrix elements from balancing */
@@ -115,12 +163,16 @@ typedef struct {
   size_t n_evals;              /* number of eigenvalues found */
 
   gsl_eigen_francis_workspace *francis_workspace_p;
+
+  gsl_eigen_nonsymm_method_t method; /* QR algorithm to use */
 } gsl_eigen_nonsymm_workspace;
 
 gsl_eigen_nonsymm_workspace * gsl_eigen_nonsymm_alloc (const size_t n);
 void gsl_eigen_nonsymm_free (gsl_eigen_nonsymm_workspace * w);
 void gsl_eigen_nonsymm_params (const int compute_t, const int balance,
                                gsl_eigen_nonsymm_workspace *w);
+void gsl_eigen_nonsymm_method (const gsl_eigen_nonsymm_method_t method,
+                               gsl_eigen_nonsymm_workspace *w);
 int gsl_eigen_nonsymm (gsl_matrix * A, gsl_vector_complex * eval,
                        gsl_eigen_nonsymm_workspace * w);
 int gsl_eigen_nonsymm_Z (gsl_matrix * A, gsl_vector_complex * eval,
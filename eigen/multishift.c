@@ -0,0 +1,1532 @@
+/* eigen/multishift.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * This module contains the small-bulge multishift QR algorithm with
+ * aggressive early deflation (AED) for real upper Hessenberg matrices.
+ * It is included by nonsymm.c. See
+ *
+ * [1] K. Braman, R. Byers and R. Mathias, "The multishift QR
+ *     algorithm. Part I: Maintaining well-focused shifts and level 3
+ *     performance", SIAM J. Matrix Anal. Appl. 23(4), pp. 929-947, 2002.
+ *
+ * [2] K. Braman, R. Byers and R. Mathias, "The multishift QR
+ *     algorithm. Part II: Aggressive early deflation", SIAM J. Matrix
+ *     Anal. Appl. 23(4), pp. 948-973, 2002.
+ *
+ * and the LAPACK routines DLAQR0, DLAQR3 and DLAQR5 on which the
+ * implementation is based. The Schur forms of the deflation windows
+ * are computed with the Francis double shift solver of francis.c.
+ */
+
+#define MULTISHIFT_NMIN     75  /* smaller matrices use the Francis solver */
+#define MULTISHIFT_NIBBLE   14  /* skip the sweep if AED deflated this percentage of the window */
+#define MULTISHIFT_KEXNW    5   /* iterations without deflation before enlarging the window */
+#define MULTISHIFT_KEXSH    6   /* iterations without deflation between exceptional shifts */
+
+typedef struct
+{
+  int size;                    /* size of matrix */
+  int nsr;                     /* number of shifts per sweep */
+  int nwr;                     /* size of deflation window */
+  int nwmax;                   /* maximum size of deflation window */
+  double *wr;                  /* real parts of eigenvalue estimates */
+  double *wi;                  /* imaginary parts of eigenvalue estimates */
+  gsl_matrix *T;               /* deflation window */
+  gsl_matrix *V;               /* Schur vectors of deflation window */
+  gsl_matrix *U;               /* accumulated reflectors of a sweep */
+  gsl_vector *tau;             /* Householder coefficients */
+  gsl_vector_complex *eval;    /* eigenvalues of deflation window */
+  double *work;                /* workspace for off-diagonal updates */
+  gsl_eigen_francis_workspace *francis_workspace_p;
+
+  gsl_matrix *H;               /* Hessenberg matrix */
+  gsl_matrix *Z;               /* Schur vectors, or NULL */
+  int wantt;                   /* compute the full Schur form? */
+} multishift_workspace;
+
+static multishift_workspace * multishift_alloc (const size_t n);
+static void multishift_free (multishift_workspace * w);
+static int multishift_schur (gsl_matrix * H, gsl_vector_complex * eval,
+                             gsl_matrix * Z, const int wantt,
+                             size_t * n_evals, multishift_workspace * w);
+static int multishift_aed (const int ktop, const int kbot, const int nw,
+                           int * ns, multishift_workspace * w);
+static void multishift_sweep (const int ktop, const int kbot, const int ns,
+                              const double * sr, const double * si,
+                              multishift_workspace * w);
+static void multishift_update (const int ktop, const int kbot, const int k0,
+                               const int k1, const gsl_matrix * U,
+                               multishift_workspace * w);
+static int multishift_exchange (gsl_matrix * T, gsl_matrix * V, const int ifst,
+                                const int nb, const int ilst);
+static int multishift_swap (gsl_matrix * T, gsl_matrix * V, const int j,
+                            const int n1, const int n2);
+static void multishift_eigenvalues (const gsl_matrix * T, double * wr, double * wi);
+static void multishift_lanv2 (double * a, double * b, double * c, double * d,
+                              double * rt1r, double * rt1i, double * rt2r,
+                              double * rt2i, double * cs, double * sn);
+
+/* number of shifts per sweep for an active block of size nh, as in
+   LAPACK IPARMQ */
+
+static int
+multishift_nshifts (const int nh)
+{
+  int ns;
+
+  if (nh < 30)
+    ns = 2;
+  else if (nh < 60)
+    ns = 4;
+  else if (nh < 150)
+    ns = 10;
+  else if (nh < 590)
+    ns = GSL_MAX (10, nh / (int) floor (log ((double) nh) / M_LN2 + 0.5));
+  else if (nh < 3000)
+    ns = 64;
+  else if (nh < 6000)
+    ns = 128;
+  else
+    ns = 256;
+
+  return GSL_MAX (2, ns - ns % 2);
+}
+
+static multishift_workspace *
+multishift_alloc (const size_t n)
+{
+  const int N = (int) n;
+  multishift_workspace *w;
+  int ns, nu;
+
+  w = calloc (1, sizeof (multishift_workspace));
+  if (w == 0)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for multishift workspace",
+                      GSL_ENOMEM);
+    }
+
+  w->size = N;
+
+  ns = GSL_MIN (multishift_nshifts (N), (N - 3) / 6);
+  w->nsr = GSL_MAX (2, ns - ns % 2);
+
+  w->nwr = (N <= 500) ? w->nsr : 3 * w->nsr / 2;
+  w->nwr = GSL_MAX (2, GSL_MIN (w->nwr, (N - 1) / 3));
+
+  /* the window grows when there is no deflation, up to nwmax */
+  w->nwmax = GSL_MIN ((N - 1) / 3, 4 * w->nwr);
+
+  /* the reflectors of a sweep are accumulated for a window of at
+     most 3*nsr + 1 rows, see multishift_sweep */
+  nu = GSL_MIN (3 * w->nsr + 1, N);
+
+  w->wr = malloc (n * sizeof (double));
+  w->wi = malloc (n * sizeof (double));
+  w->T = gsl_matrix_alloc (w->nwmax, w->nwmax);
+  w->V = gsl_matrix_alloc (w->nwmax, w->nwmax);
+  w->U = gsl_matrix_alloc (nu, nu);
+  w->tau = gsl_vector_alloc (w->nwmax);
+  w->eval = gsl_vector_complex_alloc (w->nwmax);
+  w->work = malloc (GSL_MAX (nu, w->nwmax) * n * sizeof (double));
+  w->francis_workspace_p = gsl_eigen_francis_alloc ();
+
+  if (w->wr == 0 || w->wi == 0 || w->T == 0 || w->V == 0 || w->U == 0 ||
+      w->tau == 0 || w->eval == 0 || w->work == 0 ||
+      w->francis_workspace_p == 0)
+    {
+      multishift_free (w);
+      GSL_ERROR_NULL ("failed to allocate space for multishift workspace",
+                      GSL_ENOMEM);
+    }
+
+  return w;
+}
+
+static void
+multishift_free (multishift_workspace * w)
+{
+  RETURN_IF_NULL (w);
+
+  if (w->wr)
+    free (w->wr);
+
+  if (w->wi)
+    free (w->wi);
+
+  if (w->T)
+    gsl_matrix_free (w->T);
+
+  if (w->V)
+    gsl_matrix_free (w->V);
+
+  if (w->U)
+    gsl_matrix_free (w->U);
+
+  if (w->tau)
+    gsl_vector_free (w->tau);
+
+  if (w->eval)
+    gsl_vector_complex_free (w->eval);
+
+  if (w->work)
+    free (w->work);
+
+  if (w->francis_workspace_p)
+    gsl_eigen_francis_free (w->francis_workspace_p);
+
+  free (w);
+}
+
+/*
+multishift_schur()
+  Compute the real Schur form T = Q^t H Q of an upper Hessenberg
+matrix with the multishift QR algorithm, as in LAPACK DLAQR0
+
+Inputs: H       - upper Hessenberg matrix, with zeros below the
+                  subdiagonal; on output the Schur form T if wantt
+                  is set, otherwise only the diagonal blocks of T
+        eval    - where to store eigenvalues, in the order of the
+                  diagonal blocks of T
+        Z       - if not NULL, Z := Z Q
+        wantt   - 1 to compute the full Schur form
+        n_evals - (output) number of eigenvalues found
+        w       - workspace
+
+Return: success, or GSL_EMAXITER if the iteration did not converge,
+in which case the n_evals eigenvalues found are stored at the
+beginning of eval
+
+Notes: each iteration first looks for converged eigenvalues in a
+deflation window at the bottom of the active block (multishift_aed).
+If few eigenvalues deflate, the eigenvalues of the window which
+did not deflate are used as shifts for a sweep which chases a chain
+of small bulges through the active block (multishift_sweep).
+*/
+
+static int
+multishift_schur (gsl_matrix * H, gsl_vector_complex * eval, gsl_matrix * Z,
+                  const int wantt, size_t * n_evals, multishift_workspace * w)
+{
+  const int N = (int) H->size1;
+  const int itmax = 30 * GSL_MAX (10, N);
+  const double ulp = GSL_DBL_EPSILON;
+  const double smlnum = GSL_DBL_MIN * ((double) N / ulp);
+  double * wr = w->wr;
+  double * wi = w->wi;
+  int kbot = N - 1;
+  int ndfl = 1;
+  int nw = w->nwr;
+  int it, i, k, start;
+
+  w->H = H;
+  w->Z = Z;
+  w->wantt = wantt;
+
+  for (it = 0; it < itmax && kbot >= 0; ++it)
+    {
+      int ktop, nh, nwupbd, ld, ls, ks;
+
+      /* locate the active block, setting negligible subdiagonal
+         elements to zero */
+      for (k = kbot; k > 0; --k)
+        {
+          const double hk = fabs (gsl_matrix_get (H, k, k - 1));
+
+          if (hk == 0.0)
+            break;
+
+          if (hk <= GSL_MAX (smlnum, ulp * (fabs (gsl_matrix_get (H, k, k)) +
+                                            fabs (gsl_matrix_get (H, k - 1, k - 1)))))
+            {
+              gsl_matrix_set (H, k, k - 1, 0.0);
+              break;
+            }
+        }
+
+      ktop = k;
+      nh = kbot - ktop + 1;
+
+      /* size of the deflation window, enlarged after KEXNW iterations
+         without deflation */
+      nwupbd = GSL_MIN (nh, w->nwmax);
+
+      if (ndfl < MULTISHIFT_KEXNW)
+        nw = GSL_MIN (nwupbd, w->nwr);
+      else
+        nw = GSL_MIN (nwupbd, 2 * nw);
+
+      if (nw < w->nwmax)
+        {
+          if (nw >= nh - 1)
+            {
+              nw = nh;
+            }
+          else
+            {
+              const int kwtop = kbot - nw + 1;
+
+              if (fabs (gsl_matrix_get (H, kwtop, kwtop - 1)) >
+                  fabs (gsl_matrix_get (H, kwtop - 1, kwtop - 2)))
+                ++nw;
+            }
+        }
+
+      ld = multishift_aed (ktop, kbot, nw, &ls, w);
+
+      kbot -= ld;
+      ks = kbot - ls + 1;
+
+      /* skip the sweep if enough eigenvalues deflated, since AED
+         may well deflate more on the next iteration */
+      if (ld == 0 || (100 * ld <= nw * MULTISHIFT_NIBBLE &&
+                      kbot - ktop + 1 > GSL_MIN (MULTISHIFT_NMIN, w->nwmax)))
+        {
+          int ns = GSL_MIN (w->nsr, GSL_MAX (2, kbot - ktop));
+
+          ns -= ns % 2;
+
+          if (ndfl % MULTISHIFT_KEXSH == 0)
+            {
+              /* exceptional shifts */
+              ks = kbot - ns + 1;
+
+              for (i = kbot; i >= GSL_MAX (ks + 1, ktop + 2); i -= 2)
+                {
+                  const double ss = fabs (gsl_matrix_get (H, i, i - 1)) +
+                                    fabs (gsl_matrix_get (H, i - 1, i - 2));
+                  double aa = 0.75 * ss + gsl_matrix_get (H, i, i);
+                  double bb = ss;
+                  double cc = -0.4375 * ss;
+                  double dd = aa;
+                  double cs, sn;
+
+                  multishift_lanv2 (&aa, &bb, &cc, &dd, &wr[i - 1], &wi[i - 1],
+                                    &wr[i], &wi[i], &cs, &sn);
+                }
+
+              if (ks == ktop)
+                {
+                  wr[ks + 1] = gsl_matrix_get (H, ks + 1, ks + 1);
+                  wi[ks + 1] = 0.0;
+                  wr[ks] = wr[ks + 1];
+                  wi[ks] = wi[ks + 1];
+                }
+            }
+          else
+            {
+              if (kbot - ks + 1 <= ns / 2)
+                {
+                  /* AED did not provide enough shifts; use the
+                     eigenvalues of the trailing submatrix */
+                  gsl_matrix_view Hs, Ts;
+                  gsl_vector_complex_view ev;
+                  int status;
+
+                  ks = kbot - ns + 1;
+
+                  Hs = gsl_matrix_submatrix (H, ks, ks, ns, ns);
+                  Ts = gsl_matrix_submatrix (w->T, 0, 0, ns, ns);
+                  ev = gsl_vector_complex_subvector (w->eval, 0, ns);
+
+                  gsl_matrix_memcpy (&Ts.matrix, &Hs.matrix);
+                  gsl_eigen_francis_T (0, w->francis_workspace_p);
+                  status = gsl_eigen_francis (&Ts.matrix, &ev.vector,
+                                              w->francis_workspace_p);
+
+                  if (status == GSL_SUCCESS)
+                    {
+                      for (i = 0; i < ns; ++i)
+                        {
+                          gsl_complex z = gsl_vector_complex_get (&ev.vector, i);
+                          wr[ks + i] = GSL_REAL (z);
+                          wi[ks + i] = GSL_IMAG (z);
+                        }
+                    }
+                  else
+                    {
+                      double aa = gsl_matrix_get (H, kbot - 1, kbot - 1);
+                      double bb = gsl_matrix_get (H, kbot - 1, kbot);
+                      double cc = gsl_matrix_get (H, kbot, kbot - 1);
+                      double dd = gsl_matrix_get (H, kbot, kbot);
+                      double cs, sn;
+
+                      multishift_lanv2 (&aa, &bb, &cc, &dd, &wr[kbot - 1],
+                                        &wi[kbot - 1], &wr[kbot], &wi[kbot],
+                                        &cs, &sn);
+                      ks = kbot - 1;
+                    }
+                }
+
+              /* sort the shifts by decreasing magnitude; the bubble
+                 sort keeps complex conjugate pairs together */
+              for (k = kbot; k > ks; --k)
+                {
+                  int sorted = 1;
+
+                  for (i = ks; i < k; ++i)
+                    {
+                      if (fabs (wr[i]) + fabs (wi[i]) <
+                          fabs (wr[i + 1]) + fabs (wi[i + 1]))
+                        {
+                          double tmp;
+
+                          tmp = wr[i];
+                          wr[i] = wr[i + 1];
+                          wr[i + 1] = tmp;
+
+                          tmp = wi[i];
+                          wi[i] = wi[i + 1];
+                          wi[i + 1] = tmp;
+
+                          sorted = 0;
+                        }
+                    }
+
+                  if (sorted)
+                    break;
+                }
+
+              /* shuffle the shifts into pairs of real shifts and pairs
+                 of complex conjugate shifts */
+              for (i = kbot; i >= ks + 2; i -= 2)
+                {
+                  if (wi[i] != -wi[i - 1])
+                    {
+                      double tmp;
+
+                      tmp = wr[i];
+                      wr[i] = wr[i - 1];
+                      wr[i - 1] = wr[i - 2];
+                      wr[i - 2] = tmp;
+
+                      tmp = wi[i];
+                      wi[i] = wi[i - 1];
+                      wi[i - 1] = wi[i - 2];
+                      wi[i - 2] = tmp;
+                    }
+                }
+            }
+
+          /* with only two real shifts, use the one closer to H(kbot,kbot)
+             twice */
+          if (kbot - ks + 1 == 2 && wi[kbot] == 0.0)
+            {
+              const double hkk = gsl_matrix_get (H, kbot, kbot);
+
+              if (fabs (wr[kbot] - hkk) < fabs (wr[kbot - 1] - hkk))
+                wr[kbot - 1] = wr[kbot];
+              else
+                wr[kbot] = wr[kbot - 1];
+            }
+
+          ns = GSL_MIN (ns, kbot - ks + 1);
+          ns -= ns % 2;
+          ks = kbot - ns + 1;
+
+          multishift_sweep (ktop, kbot, ns, &wr[ks], &wi[ks], w);
+        }
+
+      if (ld > 0)
+        ndfl = 1;
+      else
+        ++ndfl;
+    }
+
+  /*
+   * Standardize the 2-by-2 blocks and store the eigenvalues. If the
+   * iteration did not converge, only rows kbot+1:N-1 are in Schur
+   * form.
+   */
+
+  start = kbot + 1;
+  i = start;
+
+  while (i < N)
+    {
+      gsl_complex z;
+
+      if (i == N - 1 || gsl_matrix_get (H, i + 1, i) == 0.0)
+        {
+          GSL_SET_COMPLEX (&z, gsl_matrix_get (H, i, i), 0.0);
+          gsl_vector_complex_set (eval, i - start, z);
+          ++i;
+        }
+      else
+        {
+          double a = gsl_matrix_get (H, i, i);
+          double b = gsl_matrix_get (H, i, i + 1);
+          double c = gsl_matrix_get (H, i + 1, i);
+          double d = gsl_matrix_get (H, i + 1, i + 1);
+          double rt1r, rt1i, rt2r, rt2i, cs, sn;
+
+          multishift_lanv2 (&a, &b, &c, &d, &rt1r, &rt1i, &rt2r, &rt2i,
+                            &cs, &sn);
+
+          gsl_matrix_set (H, i, i, a);
+          gsl_matrix_set (H, i, i + 1, b);
+          gsl_matrix_set (H, i + 1, i, c);
+          gsl_matrix_set (H, i + 1, i + 1, d);
+
+          if (wantt)
+            {
+              gsl_vector_view xv, yv;
+
+              if (i + 2 < N)
+                {
+                  xv = gsl_matrix_subrow (H, i, i + 2, N - i - 2);
+                  yv = gsl_matrix_subrow (H, i + 1, i + 2, N - i - 2);
+                  gsl_blas_drot (&xv.vector, &yv.vector, cs, sn);
+                }
+
+              if (i > 0)
+                {
+                  xv = gsl_matrix_subcolumn (H, i, 0, i);
+                  yv = gsl_matrix_subcolumn (H, i + 1, 0, i);
+                  gsl_blas_drot (&xv.vector, &yv.vector, cs, sn);
+                }
+            }
+
+          if (Z)
+            {
+              gsl_vector_view xv = gsl_matrix_column (Z, i);
+              gsl_vector_view yv = gsl_matrix_column (Z, i + 1);
+
+              gsl_blas_drot (&xv.vector, &yv.vector, cs, sn);
+            }
+
+          GSL_SET_COMPLEX (&z, rt1r, rt1i);
+          gsl_vector_complex_set (eval, i - start, z);
+          GSL_SET_COMPLEX (&z, rt2r, rt2i);
+          gsl_vector_complex_set (eval, i - start + 1, z);
+
+          i += 2;
+        }
+    }
+
+  *n_evals = N - start;
+
+  if (kbot >= 0)
+    {
+      GSL_ERROR ("maximum iterations reached without finding all eigenvalues",
+                 GSL_EMAXITER);
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+multishift_aed()
+  Aggressive early deflation, as in LAPACK DLAQR3
+
+The trailing nw-by-nw window of the active block H(ktop:kbot,ktop:kbot)
+is reduced to Schur form T = V^t H V, which couples the window to the
+rest of the block through the spike s V(0,:), where s = H(kwtop,kwtop-1).
+Eigenvalues of T whose spike components are negligible are deflated,
+after the others have been moved to the top of T. The undeflated part
+of T is then returned to Hessenberg form and the window and spike are
+copied back to H.
+
+Inputs: ktop - first row of active block
+        kbot - last row of active block
+        nw   - size of deflation window
+        ns   - (output) number of eigenvalues which did not deflate;
+               their values are stored in wr[kbot-nd-ns+1:kbot-nd]
+               for use as shifts
+        w    - workspace
+
+Return: number nd of eigenvalues deflated
+*/
+
+static int
+multishift_aed (const int ktop, const int kbot, const int nw, int * ns,
+                multishift_workspace * w)
+{
+  gsl_matrix * H = w->H;
+  const int N = (int) H->size1;
+  const int jw = GSL_MIN (nw, kbot - ktop + 1);
+  const int kwtop = kbot - jw + 1;
+  const double ulp = GSL_DBL_EPSILON;
+  const double smlnum = GSL_DBL_MIN * ((double) N / ulp);
+  double s = (kwtop == ktop) ? 0.0 : gsl_matrix_get (H, kwtop, kwtop - 1);
+  gsl_matrix_view T, V;
+  gsl_vector_complex_view ev;
+  int nund, ilst, i, j, status;
+
+  if (jw == 1)
+    {
+      const double hkk = gsl_matrix_get (H, kwtop, kwtop);
+
+      w->wr[kwtop] = hkk;
+      w->wi[kwtop] = 0.0;
+
+      if (fabs (s) <= GSL_MAX (smlnum, ulp * fabs (hkk)))
+        {
+          *ns = 0;
+
+          if (kwtop > ktop)
+            gsl_matrix_set (H, kwtop, kwtop - 1, 0.0);
+
+          return 1;
+        }
+
+      *ns = 1;
+      return 0;
+    }
+
+  T = gsl_matrix_submatrix (w->T, 0, 0, jw, jw);
+  V = gsl_matrix_submatrix (w->V, 0, 0, jw, jw);
+  ev = gsl_vector_complex_subvector (w->eval, 0, jw);
+
+  for (i = 0; i < jw; ++i)
+    {
+      for (j = 0; j < jw; ++j)
+        {
+          double tij = (i > j + 1) ? 0.0 : gsl_matrix_get (H, kwtop + i, kwtop + j);
+          gsl_matrix_set (&T.matrix, i, j, tij);
+        }
+    }
+
+  gsl_matrix_set_identity (&V.matrix);
+
+  gsl_eigen_francis_T (1, w->francis_workspace_p);
+  status = gsl_eigen_francis_Z (&T.matrix, &ev.vector, &V.matrix,
+                                w->francis_workspace_p);
+
+  if (status != GSL_SUCCESS)
+    {
+      /* nothing deflates, use the diagonal as shifts */
+      for (i = 0; i < jw; ++i)
+        {
+          w->wr[kwtop + i] = gsl_matrix_get (H, kwtop + i, kwtop + i);
+          w->wi[kwtop + i] = 0.0;
+        }
+
+      *ns = jw;
+      return 0;
+    }
+
+  for (j = 0; j + 2 < jw; ++j)
+    {
+      for (i = j + 2; i < jw; ++i)
+        gsl_matrix_set (&T.matrix, i, j, 0.0);
+    }
+
+  /*
+   * Check the blocks of T for deflation from the bottom up, moving
+   * the blocks which do not deflate to the top of T. If a block
+   * cannot be moved, the remaining blocks are not checked.
+   */
+
+  nund = jw;
+  ilst = 0;
+
+  while (ilst < nund)
+    {
+      const int bulge = (nund > 1 &&
+                         gsl_matrix_get (&T.matrix, nund - 1, nund - 2) != 0.0);
+      const double t22 = fabs (gsl_matrix_get (&T.matrix, nund - 1, nund - 1));
+
+      if (!bulge)
+        {
+          double foo = (t22 == 0.0) ? fabs (s) : t22;
+          double spike = fabs (s * gsl_matrix_get (&V.matrix, 0, nund - 1));
+
+          if (spike <= GSL_MAX (smlnum, ulp * foo))
+            {
+              nund -= 1;
+            }
+          else
+            {
+              if (multishift_exchange (&T.matrix, &V.matrix, nund - 1, 1, ilst))
+                break;
+
+              ilst += 1;
+            }
+        }
+      else
+        {
+          double foo = t22 +
+            sqrt (fabs (gsl_matrix_get (&T.matrix, nund - 1, nund - 2))) *
+            sqrt (fabs (gsl_matrix_get (&T.matrix, nund - 2, nund - 1)));
+          double spike = GSL_MAX (fabs (s * gsl_matrix_get (&V.matrix, 0, nund - 1)),
+                                  fabs (s * gsl_matrix_get (&V.matrix, 0, nund - 2)));
+
+          if (foo == 0.0)
+            foo = fabs (s);
+
+          if (spike <= GSL_MAX (smlnum, ulp * foo))
+            {
+              nund -= 2;
+            }
+          else
+            {
+              if (multishift_exchange (&T.matrix, &V.matrix, nund - 2, 2, ilst))
+                break;
+
+              ilst += 2;
+            }
+        }
+    }
+
+  if (nund == 0)
+    s = 0.0;
+
+  /* eigenvalues of the window; those of T(0:nund,0:nund) are the shifts */
+  multishift_eigenvalues (&T.matrix, w->wr + kwtop, w->wi + kwtop);
+
+  if (nund < jw || s == 0.0)
+    {
+      if (nund > 1 && s != 0.0)
+        {
+          /* reflect the spike back to a multiple of e_1 and return
+             T(0:nund,0:nund) to Hessenberg form */
+          gsl_vector_view x = gsl_vector_subvector (w->tau, 0, nund);
+          gsl_vector_view v0 = gsl_matrix_subrow (&V.matrix, 0, 0, nund);
+          gsl_matrix_view T11 = gsl_matrix_submatrix (&T.matrix, 0, 0, nund, nund);
+          gsl_matrix_view T1 = gsl_matrix_submatrix (&T.matrix, 0, 0, nund, jw);
+          gsl_matrix_view V1 = gsl_matrix_submatrix (&V.matrix, 0, 0, jw, nund);
+          double tau;
+
+          gsl_vector_memcpy (&x.vector, &v0.vector);
+          tau = gsl_linalg_householder_transform (&x.vector);
+
+          gsl_linalg_householder_hm (tau, &x.vector, &T1.matrix);
+          gsl_linalg_householder_mh (tau, &x.vector, &T11.matrix);
+          gsl_linalg_householder_mh (tau, &x.vector, &V1.matrix);
+
+          gsl_linalg_hessenberg_decomp (&T11.matrix, &x.vector);
+
+          if (nund < jw)
+            {
+              for (i = 0; i + 2 < nund; ++i)
+                {
+                  gsl_vector_view hv = gsl_matrix_subcolumn (&T11.matrix, i, i + 1,
+                                                             nund - i - 1);
+                  gsl_matrix_view T12 = gsl_matrix_submatrix (&T.matrix, i + 1, nund,
+                                                              nund - i - 1, jw - nund);
+
+                  gsl_linalg_householder_hm (gsl_vector_get (&x.vector, i),
+                                             &hv.vector, &T12.matrix);
+                }
+            }
+
+          gsl_linalg_hessenberg_unpack_accum (&T11.matrix, &x.vector, &V1.matrix);
+          gsl_linalg_hessenberg_set_zero (&T11.matrix);
+        }
+
+      if (kwtop > ktop)
+        gsl_matrix_set (H, kwtop, kwtop - 1, s * gsl_matrix_get (&V.matrix, 0, 0));
+
+      for (i = 0; i < jw; ++i)
+        {
+          for (j = 0; j < jw; ++j)
+            {
+              double tij = (i > j + 1) ? 0.0 : gsl_matrix_get (&T.matrix, i, j);
+              gsl_matrix_set (H, kwtop + i, kwtop + j, tij);
+            }
+        }
+
+      multishift_update (ktop, kbot, kwtop, kbot, &V.matrix, w);
+    }
+
+  *ns = nund;
+
+  return jw - nund;
+}
+
+/*
+multishift_sweep()
+  Chase a chain of ns/2 bulges, each containing two shifts, through
+the active block H(ktop:kbot,ktop:kbot), as in LAPACK DLAQR5
+
+The bulges are introduced at the top of the block one after the
+other, three rows apart, and chased down together. The chain is moved
+in steps of 3*ns/2 rows. In each step the 3-by-3 reflectors are
+applied only inside a window of the diagonal of H around the chain,
+and accumulated in the orthogonal matrix U, which is then applied to
+the rest of H and Z with level 3 BLAS.
+
+Inputs: ktop - first row of active block
+        kbot - last row of active block
+        ns   - number of shifts
+        sr   - real parts of shifts
+        si   - imaginary parts of shifts, complex shifts must occur
+               in consecutive conjugate pairs
+        w    - workspace
+*/
+
+static void
+multishift_sweep (const int ktop, const int kbot, const int ns,
+                  const double * sr, const double * si,
+                  multishift_workspace * w)
+{
+  gsl_matrix * H = w->H;
+  const int nbmps = ns / 2;           /* number of bulges */
+  const int last = kbot - ktop - 1;   /* last position of a bulge */
+  const int nstep = 3 * nbmps;
+  const int ng = last + 1 + 3 * (nbmps - 1);
+  int g0;
+
+  if (nbmps < 1 || kbot - ktop < 2)
+    return;
+
+  for (g0 = 0; g0 < ng; g0 += nstep)
+    {
+      const int g1 = GSL_MIN (g0 + nstep, ng);
+      const int jlo = ktop + GSL_MAX (0, g0 - 3 * (nbmps - 1));
+      const int jhi = ktop + GSL_MIN (last, g1 - 1);
+      const int k0 = GSL_MAX (ktop, jlo - 1);
+      const int k1 = GSL_MIN (kbot, jhi + 3);
+      const int nu = k1 - k0 + 1;
+      gsl_matrix_view U = gsl_matrix_submatrix (w->U, 0, 0, nu, nu);
+      int g, b;
+
+      gsl_matrix_set_identity (&U.matrix);
+
+      for (g = g0; g < g1; ++g)
+        {
+          /* move each bulge one row down, starting from the lowest */
+          for (b = 0; b < nbmps && g - 3 * b >= 0; ++b)
+            {
+              const int j = ktop + g - 3 * b;  /* first row of reflector */
+              const int nr = GSL_MIN (3, kbot - j + 1);
+              const int r1 = GSL_MIN (j + nr, kbot);
+              double x[3], v1, v2, tau;
+              gsl_vector_view xv;
+              int c, r;
+
+              if (j - ktop > last)
+                continue;
+
+              if (j == ktop)
+                {
+                  /* introduce a new bulge: x = (H - s1 I)(H - s2 I) e_1 */
+                  const double sr1 = sr[2 * b], si1 = si[2 * b];
+                  const double sr2 = sr[2 * b + 1], si2 = si[2 * b + 1];
+                  const double h11 = gsl_matrix_get (H, j, j);
+                  const double h21 = gsl_matrix_get (H, j + 1, j);
+                  const double h12 = gsl_matrix_get (H, j, j + 1);
+                  const double h22 = gsl_matrix_get (H, j + 1, j + 1);
+                  const double h32 = gsl_matrix_get (H, j + 2, j + 1);
+                  const double sc = fabs (h11 - sr2) + fabs (si2) + fabs (h21);
+
+                  if (sc == 0.0)
+                    {
+                      x[0] = x[1] = x[2] = 0.0;
+                    }
+                  else
+                    {
+                      const double h21s = h21 / sc;
+
+                      x[0] = h21s * h12 + (h11 - sr1) * ((h11 - sr2) / sc) - si1 * (si2 / sc);
+                      x[1] = h21s * (h11 + h22 - sr1 - sr2);
+                      x[2] = h21s * h32;
+                    }
+                }
+              else
+                {
+                  for (r = 0; r < nr; ++r)
+                    x[r] = gsl_matrix_get (H, j + r, j - 1);
+                }
+
+              xv = gsl_vector_view_array (x, nr);
+              tau = gsl_linalg_householder_transform (&xv.vector);
+
+              if (j > ktop)
+                {
+                  gsl_matrix_set (H, j, j - 1, x[0]);
+
+                  for (r = 1; r < nr; ++r)
+                    gsl_matrix_set (H, j + r, j - 1, 0.0);
+                }
+
+              if (tau == 0.0)
+                continue;
+
+              v1 = x[1];
+              v2 = (nr == 3) ? x[2] : 0.0;
+
+              /* apply the reflector from the left to H(j:j+nr-1,j:k1) */
+              {
+                double * h0 = gsl_matrix_ptr (H, j, 0);
+                double * h1 = gsl_matrix_ptr (H, j + 1, 0);
+
+                if (nr == 3)
+                  {
+                    double * h2 = gsl_matrix_ptr (H, j + 2, 0);
+
+                    for (c = j; c <= k1; ++c)
+                      {
+                        const double sum = tau * (h0[c] + v1 * h1[c] + v2 * h2[c]);
+                        h0[c] -= sum;
+                        h1[c] -= sum * v1;
+                        h2[c] -= sum * v2;
+                      }
+                  }
+                else
+                  {
+                    for (c = j; c <= k1; ++c)
+                      {
+                        const double sum = tau * (h0[c] + v1 * h1[c]);
+                        h0[c] -= sum;
+                        h1[c] -= sum * v1;
+                      }
+                  }
+              }
+
+              /* apply the reflector from the right to H(k0:r1,j:j+nr-1)
+                 and U(:,j-k0:j-k0+nr-1) */
+              for (r = k0; r <= r1; ++r)
+                {
+                  double * h = gsl_matrix_ptr (H, r, j);
+                  const double sum = tau * (h[0] + v1 * h[1] + v2 * (nr == 3 ? h[2] : 0.0));
+
+                  h[0] -= sum;
+                  h[1] -= sum * v1;
+                  if (nr == 3)
+                    h[2] -= sum * v2;
+                }
+
+              for (r = 0; r < nu; ++r)
+                {
+                  double * u = gsl_matrix_ptr (&U.matrix, r, j - k0);
+                  const double sum = tau * (u[0] + v1 * u[1] + v2 * (nr == 3 ? u[2] : 0.0));
+
+                  u[0] -= sum;
+                  u[1] -= sum * v1;
+                  if (nr == 3)
+                    u[2] -= sum * v2;
+                }
+            }
+        }
+
+      multishift_update (ktop, kbot, k0, k1, &U.matrix, w);
+    }
+}
+
+/*
+multishift_update()
+  Apply an orthogonal transformation U of rows and columns k0:k1 of H,
+which has already been applied to H(k0:k1,k0:k1), to the rest of H
+and to Z:
+
+H(k0:k1,k1+1:i2) := U^t H(k0:k1,k1+1:i2)
+H(i1:k0-1,k0:k1) := H(i1:k0-1,k0:k1) U
+Z(:,k0:k1)       := Z(:,k0:k1) U
+
+where i1:i2 are the rows of the Schur form T, or the active block
+ktop:kbot if T is not computed.
+*/
+
+static void
+multishift_update (const int ktop, const int kbot, const int k0, const int k1,
+                   const gsl_matrix * U, multishift_workspace * w)
+{
+  gsl_matrix * H = w->H;
+  const int N = (int) H->size1;
+  const int nu = k1 - k0 + 1;
+  const int i1 = w->wantt ? 0 : ktop;
+  const int i2 = w->wantt ? N - 1 : kbot;
+
+  if (i2 > k1)
+    {
+      gsl_matrix_view A = gsl_matrix_submatrix (H, k0, k1 + 1, nu, i2 - k1);
+      gsl_matrix_view B = gsl_matrix_view_array (w->work, nu, i2 - k1);
+
+      gsl_blas_dgemm (CblasTrans, CblasNoTrans, 1.0, U, &A.matrix, 0.0, &B.matrix);
+      gsl_matrix_memcpy (&A.matrix, &B.matrix);
+    }
+
+  if (i1 < k0)
+    {
+      gsl_matrix_view A = gsl_matrix_submatrix (H, i1, k0, k0 - i1, nu);
+      gsl_matrix_view B = gsl_matrix_view_array (w->work, k0 - i1, nu);
+
+      gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, &A.matrix, U, 0.0, &B.matrix);
+      gsl_matrix_memcpy (&A.matrix, &B.matrix);
+    }
+
+  if (w->Z)
+    {
+      gsl_matrix_view A = gsl_matrix_submatrix (w->Z, 0, k0, w->Z->size1, nu);
+      gsl_matrix_view B = gsl_matrix_view_array (w->work, w->Z->size1, nu);
+
+      gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, &A.matrix, U, 0.0, &B.matrix);
+      gsl_matrix_memcpy (&A.matrix, &B.matrix);
+    }
+}
+
+/*
+multishift_exchange()
+  Move the diagonal block of size nb starting at row ifst of the
+quasi-triangular matrix T up to row ilst < ifst by swapping it with
+the blocks above it, as in LAPACK DTREXC, and accumulate the
+transformations in V
+
+Return: success, or GSL_FAILURE if a swap was rejected, in which case
+T is still in Schur form with the block between rows ilst and ifst
+*/
+
+static int
+multishift_exchange (gsl_matrix * T, gsl_matrix * V, const int ifst,
+                     const int nb, const int ilst)
+{
+  int here = ifst;
+
+  while (here > ilst)
+    {
+      const int nbnext = (here >= 2 && gsl_matrix_get (T, here - 1, here - 2) != 0.0) ? 2 : 1;
+
+      if (multishift_swap (T, V, here - nbnext, nbnext, nb))
+        return GSL_FAILURE;
+
+      here -= nbnext;
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+multishift_swap()
+  Swap the adjacent diagonal blocks T11 (n1-by-n1) and T22 (n2-by-n2)
+of the quasi-triangular matrix T starting at row j, as in LAPACK DLAEXC,
+and accumulate the transformation in V
+
+The columns of [ -X ; I ] span the invariant subspace of T22, where
+T11 X - X T22 = T12, so the orthogonal factor Q of their QR
+decomposition swaps the blocks. The swap is rejected if Q^t T Q is
+not block triangular to working precision.
+
+Return: success, or GSL_FAILURE if the swap was rejected
+*/
+
+static int
+multishift_swap (gsl_matrix * T, gsl_matrix * V, const int j,
+                 const int n1, const int n2)
+{
+  const int n = (int) T->size1;
+  const int nd = n1 + n2;
+  int i, k, r, c;
+
+  if (n1 == 1 && n2 == 1)
+    {
+      const double t11 = gsl_matrix_get (T, j, j);
+      const double t22 = gsl_matrix_get (T, j + 1, j + 1);
+      const double f = gsl_matrix_get (T, j, j + 1);
+      const double g = t22 - t11;
+      const double rr = gsl_hypot (f, g);
+      double cs = 1.0, sn = 0.0;
+      gsl_vector_view xv, yv;
+
+      if (rr != 0.0)
+        {
+          cs = f / rr;
+          sn = g / rr;
+        }
+
+      if (j + 2 < n)
+        {
+          xv = gsl_matrix_subrow (T, j, j + 2, n - j - 2);
+          yv = gsl_matrix_subrow (T, j + 1, j + 2, n - j - 2);
+          gsl_blas_drot (&xv.vector, &yv.vector, cs, sn);
+        }
+
+      if (j > 0)
+        {
+          xv = gsl_matrix_subcolumn (T, j, 0, j);
+          yv = gsl_matrix_subcolumn (T, j + 1, 0, j);
+          gsl_blas_drot (&xv.vector, &yv.vector, cs, sn);
+        }
+
+      gsl_matrix_set (T, j, j, t22);
+      gsl_matrix_set (T, j + 1, j + 1, t11);
+
+      xv = gsl_matrix_column (V, j);
+      yv = gsl_matrix_column (V, j + 1);
+      gsl_blas_drot (&xv.vector, &yv.vector, cs, sn);
+
+      return GSL_SUCCESS;
+    }
+  else
+    {
+      const double eps = GSL_DBL_EPSILON;
+      const double smlnum = GSL_DBL_MIN / eps;
+      double D_data[16], Q_data[16], M_data[8], K_data[16], x_data[4], tau_data[2];
+      double work[4];
+      gsl_matrix_view D = gsl_matrix_view_array (D_data, nd, nd);
+      gsl_matrix_view Q = gsl_matrix_view_array (Q_data, nd, nd);
+      gsl_matrix_view M = gsl_matrix_view_array (M_data, nd, n2);
+      gsl_vector_view tau = gsl_vector_view_array (tau_data, n2);
+      gsl_matrix_const_view Tjj = gsl_matrix_const_submatrix (T, j, j, nd, nd);
+      const int m = n1 * n2;
+      int perm_c[4];
+      double dnorm = 0.0, knorm = 0.0, smin, thresh;
+
+      gsl_matrix_memcpy (&D.matrix, &Tjj.matrix);
+
+      for (i = 0; i < nd * nd; ++i)
+        dnorm = GSL_MAX (dnorm, fabs (D_data[i]));
+
+      thresh = GSL_MAX (10.0 * eps * dnorm, smlnum);
+
+      /*
+       * Solve T11 X - X T22 = T12 for the n1-by-n2 matrix X, as a
+       * linear system of size n1*n2 in the elements X(r,c) = x[r*n2+c],
+       * by Gaussian elimination with complete pivoting. Small pivots
+       * are perturbed as in LAPACK DLASY2.
+       */
+
+      for (i = 0; i < m * m; ++i)
+        K_data[i] = 0.0;
+
+      for (r = 0; r < n1; ++r)
+        {
+          for (c = 0; c < n2; ++c)
+            {
+              const int row = r * n2 + c;
+
+              for (k = 0; k < n1; ++k)
+                K_data[row * m + k * n2 + c] += gsl_matrix_get (&D.matrix, r, k);
+
+              for (k = 0; k < n2; ++k)
+                K_data[row * m + r * n2 + k] -= gsl_matrix_get (&D.matrix, n1 + k, n1 + c);
+
+              x_data[row] = gsl_matrix_get (&D.matrix, r, n1 + c);
+            }
+        }
+
+      for (i = 0; i < m * m; ++i)
+        knorm = GSL_MAX (knorm, fabs (K_data[i]));
+
+      smin = GSL_MAX (eps * knorm, smlnum);
+
+      for (i = 0; i < m; ++i)
+        perm_c[i] = i;
+
+      for (k = 0; k < m; ++k)
+        {
+          int pr = k, pc = k;
+          double pmax = 0.0, piv;
+
+          for (r = k; r < m; ++r)
+            {
+              for (c = k; c < m; ++c)
+                {
+                  if (fabs (K_data[r * m + c]) > pmax)
+                    {
+                      pmax = fabs (K_data[r * m + c]);
+                      pr = r;
+                      pc = c;
+                    }
+                }
+            }
+
+          if (pr != k)
+            {
+              for (c = 0; c < m; ++c)
+                {
+                  double tmp = K_data[k * m + c];
+                  K_data[k * m + c] = K_data[pr * m + c];
+                  K_data[pr * m + c] = tmp;
+                }
+
+              {
+                double tmp = x_data[k];
+                x_data[k] = x_data[pr];
+                x_data[pr] = tmp;
+              }
+            }
+
+          if (pc != k)
+            {
+              for (r = 0; r < m; ++r)
+                {
+                  double tmp = K_data[r * m + k];
+                  K_data[r * m + k] = K_data[r * m + pc];
+                  K_data[r * m + pc] = tmp;
+                }
+
+              {
+                int tmp = perm_c[k];
+                perm_c[k] = perm_c[pc];
+                perm_c[pc] = tmp;
+              }
+            }
+
+          if (fabs (K_data[k * m + k]) < smin)
+            K_data[k * m + k] = smin;
+
+          piv = K_data[k * m + k];
+
+          for (r = k + 1; r < m; ++r)
+            {
+              const double l = K_data[r * m + k] / piv;
+
+              for (c = k; c < m; ++c)
+                K_data[r * m + c] -= l * K_data[k * m + c];
+
+              x_data[r] -= l * x_data[k];
+            }
+        }
+
+      for (k = m - 1; k >= 0; --k)
+        {
+          double sum = x_data[k];
+
+          for (c = k + 1; c < m; ++c)
+            sum -= K_data[k * m + c] * work[c];
+
+          work[k] = sum / K_data[k * m + k];
+        }
+
+      for (k = 0; k < m; ++k)
+        x_data[perm_c[k]] = work[k];
+
+      /* QR decomposition of M = [ -X ; I ] */
+      for (r = 0; r < n1; ++r)
+        for (c = 0; c < n2; ++c)
+          gsl_matrix_set (&M.matrix, r, c, -x_data[r * n2 + c]);
+
+      for (r = 0; r < n2; ++r)
+        for (c = 0; c < n2; ++c)
+          gsl_matrix_set (&M.matrix, n1 + r, c, (r == c) ? 1.0 : 0.0);
+
+      gsl_linalg_QR_decomp (&M.matrix, &tau.vector);
+
+      gsl_matrix_set_identity (&Q.matrix);
+
+      for (k = n2 - 1; k >= 0; --k)
+        {
+          gsl_vector_const_view h = gsl_matrix_const_subcolumn (&M.matrix, k, k, nd - k);
+          gsl_matrix_view Qk = gsl_matrix_submatrix (&Q.matrix, k, 0, nd - k, nd);
+
+          gsl_linalg_householder_hm (tau_data[k], &h.vector, &Qk.matrix);
+        }
+
+      /* D := Q^t D Q and test whether the swap is stable */
+      {
+        double DQ_data[16];
+        gsl_matrix_view DQ = gsl_matrix_view_array (DQ_data, nd, nd);
+        double err = 0.0;
+
+        gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, &D.matrix, &Q.matrix,
+                        0.0, &DQ.matrix);
+        gsl_blas_dgemm (CblasTrans, CblasNoTrans, 1.0, &Q.matrix, &DQ.matrix,
+                        0.0, &D.matrix);
+
+        for (r = n2; r < nd; ++r)
+          for (c = 0; c < n2; ++c)
+            err = GSL_MAX (err, fabs (gsl_matrix_get (&D.matrix, r, c)));
+
+        if (err > thresh)
+          return GSL_FAILURE;
+      }
+
+      /* apply Q to the rows and columns j:j+nd-1 of T and to V */
+      for (c = j + nd; c < n; ++c)
+        {
+          for (r = 0; r < nd; ++r)
+            work[r] = gsl_matrix_get (T, j + r, c);
+
+          for (r = 0; r < nd; ++r)
+            {
+              double sum = 0.0;
+
+              for (k = 0; k < nd; ++k)
+                sum += gsl_matrix_get (&Q.matrix, k, r) * work[k];
+
+              gsl_matrix_set (T, j + r, c, sum);
+            }
+        }
+
+      for (r = 0; r < j; ++r)
+        {
+          double * t = gsl_matrix_ptr (T, r, j);
+
+          for (c = 0; c < nd; ++c)
+            work[c] = t[c];
+
+          for (c = 0; c < nd; ++c)
+            {
+              double sum = 0.0;
+
+              for (k = 0; k < nd; ++k)
+                sum += work[k] * gsl_matrix_get (&Q.matrix, k, c);
+
+              t[c] = sum;
+            }
+        }
+
+      for (r = 0; r < (int) V->size1; ++r)
+        {
+          double * v = gsl_matrix_ptr (V, r, j);
+
+          for (c = 0; c < nd; ++c)
+            work[c] = v[c];
+
+          for (c = 0; c < nd; ++c)
+            {
+              double sum = 0.0;
+
+              for (k = 0; k < nd; ++k)
+                sum += work[k] * gsl_matrix_get (&Q.matrix, k, c);
+
+              v[c] = sum;
+            }
+        }
+
+      /* the swapped blocks, with T(j+n2:j+nd-1,j:j+n2-1) = 0 */
+      for (r = 0; r < nd; ++r)
+        {
+          for (c = 0; c < nd; ++c)
+            {
+              double dij = gsl_matrix_get (&D.matrix, r, c);
+
+              if (r >= n2 && c < n2)
+                dij = 0.0;
+
+              gsl_matrix_set (T, j + r, j + c, dij);
+            }
+        }
+
+      /* a rounding error may leave a 2-by-2 block with real eigenvalues;
+         split it with a standardizing rotation */
+      for (k = 0; k < 2; ++k)
+        {
+          const int p = j + ((k == 0) ? 0 : n2);
+          const int size = (k == 0) ? n2 : n1;
+
+          if (size == 2)
+            {
+              double a = gsl_matrix_get (T, p, p);
+              double b = gsl_matrix_get (T, p, p + 1);
+              double cc = gsl_matrix_get (T, p + 1, p);
+              double d = gsl_matrix_get (T, p + 1, p + 1);
+              double rt1r, rt1i, rt2r, rt2i, cs, sn;
+              gsl_vector_view xv, yv;
+
+              multishift_lanv2 (&a, &b, &cc, &d, &rt1r, &rt1i, &rt2r, &rt2i,
+                                &cs, &sn);
+
+              gsl_matrix_set (T, p, p, a);
+              gsl_matrix_set (T, p, p + 1, b);
+              gsl_matrix_set (T, p + 1, p, cc);
+              gsl_matrix_set (T, p + 1, p + 1, d);
+
+              if (p + 2 < n)
+                {
+                  xv = gsl_matrix_subrow (T, p, p + 2, n - p - 2);
+                  yv = gsl_matrix_subrow (T, p + 1, p + 2, n - p - 2);
+                  gsl_blas_drot (&xv.vector, &yv.vector, cs, sn);
+                }
+
+              if (p > 0)
+                {
+                  xv = gsl_matrix_subcolumn (T, p, 0, p);
+                  yv = gsl_matrix_subcolumn (T, p + 1, 0, p);
+                  gsl_blas_drot (&xv.vector, &yv.vector, cs, sn);
+                }
+
+              xv = gsl_matrix_column (V, p);
+              yv = gsl_matrix_column (V, p + 1);
+              gsl_blas_drot (&xv.vector, &yv.vector, cs, sn);
+            }
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/* compute the eigenvalues of the 1-by-1 and 2-by-2 diagonal blocks of
+   the quasi-triangular matrix T */
+
+static void
+multishift_eigenvalues (const gsl_matrix * T, double * wr, double * wi)
+{
+  const int n = (int) T->size1;
+  int i = 0;
+
+  while (i < n)
+    {
+      if (i == n - 1 || gsl_matrix_get (T, i + 1, i) == 0.0)
+        {
+          wr[i] = gsl_matrix_get (T, i, i);
+          wi[i] = 0.0;
+          ++i;
+        }
+      else
+        {
+          double a = gsl_matrix_get (T, i, i);
+          double b = gsl_matrix_get (T, i, i + 1);
+          double c = gsl_matrix_get (T, i + 1, i);
+          double d = gsl_matrix_get (T, i + 1, i + 1);
+          double cs, sn;
+
+          multishift_lanv2 (&a, &b, &c, &d, &wr[i], &wi[i], &wr[i + 1],
+                            &wi[i + 1], &cs, &sn);
+          i += 2;
+        }
+    }
+}
+
+/*
+multishift_lanv2()
+  Compute the Schur factorization of a real 2-by-2 matrix in
+standard form, as in francis_standard_form():
+
+[ A B ] = [ CS -SN ] [ AA BB ] [ CS SN ]
+[ C D ]   [ SN  CS ] [ CC DD ] [-SN CS ]
+
+where either CC = 0, or AA = DD and BB*CC < 0. On output a, b, c, d
+contain AA, BB, CC, DD and (rt1r,rt1i), (rt2r,rt2i) the eigenvalues.
+Based on LAPACK DLANV2.
+*/
+
+static void
+multishift_lanv2 (double * a, double * b, double * c, double * d,
+                  double * rt1r, double * rt1i, double * rt2r, double * rt2i,
+                  double * cs, double * sn)
+{
+  double aa = *a, bb = *b, cc = *c, dd = *d;
+
+  if (cc == 0.0)
+    {
+      *cs = 1.0;
+      *sn = 0.0;
+    }
+  else if (bb == 0.0)
+    {
+      /* swap rows and columns */
+      double tmp = dd;
+
+      *cs = 0.0;
+      *sn = 1.0;
+      dd = aa;
+      aa = tmp;
+      bb = -cc;
+      cc = 0.0;
+    }
+  else if ((aa - dd) == 0.0 && GSL_SIGN (bb) != GSL_SIGN (cc))
+    {
+      *cs = 1.0;
+      *sn = 0.0;
+    }
+  else
+    {
+      const double temp = aa - dd;
+      double p = 0.5 * temp;
+      const double bcmax = GSL_MAX (fabs (bb), fabs (cc));
+      const double bcmis = GSL_MIN (fabs (bb), fabs (cc)) * GSL_SIGN (bb) * GSL_SIGN (cc);
+      const double scale = GSL_MAX (fabs (p), bcmax);
+      double z = (p / scale) * p + (bcmax / scale) * bcmis;
+
+      if (z >= 4.0 * GSL_DBL_EPSILON)
+        {
+          /* real eigenvalues */
+          double tau;
+
+          z = p + GSL_SIGN (p) * sqrt (scale) * sqrt (z);
+          aa = dd + z;
+          dd -= (bcmax / z) * bcmis;
+
+          tau = gsl_hypot (cc, z);
+          *cs = z / tau;
+          *sn = cc / tau;
+          bb -= cc;
+          cc = 0.0;
+        }
+      else
+        {
+          /* complex or almost equal real eigenvalues: make the
+             diagonal elements equal */
+          const double sigma = bb + cc;
+          const double tau = gsl_hypot (sigma, temp);
+          double a1, b1, c1, d1, tmp;
+
+          *cs = sqrt (0.5 * (1.0 + fabs (sigma) / tau));
+          *sn = -(p / (tau * (*cs))) * GSL_SIGN (sigma);
+
+          a1 = aa * (*cs) + bb * (*sn);
+          b1 = -aa * (*sn) + bb * (*cs);
+          c1 = cc * (*cs) + dd * (*sn);
+          d1 = -cc * (*sn) + dd * (*cs);
+
+          aa = a1 * (*cs) + c1 * (*sn);
+          bb = b1 * (*cs) + d1 * (*sn);
+          cc = -a1 * (*sn) + c1 * (*cs);
+          dd = -b1 * (*sn) + d1 * (*cs);
+
+          tmp = 0.5 * (aa + dd);
+          aa = dd = tmp;
+
+          if (cc != 0.0)
+            {
+              if (bb != 0.0)
+                {
+                  if (GSL_SIGN (bb) == GSL_SIGN (cc))
+                    {
+                      /* real eigenvalues: reduce to upper triangular */
+                      const double sab = sqrt (fabs (bb));
+                      const double sac = sqrt (fabs (cc));
+                      const double t = 1.0 / sqrt (fabs (bb + cc));
+                      const double cs1 = sab * t;
+                      const double sn1 = sac * t;
+
+                      p = GSL_SIGN (cc) * sab * sac;
+                      aa = tmp + p;
+                      dd = tmp - p;
+                      bb -= cc;
+                      cc = 0.0;
+
+                      tmp = (*cs) * cs1 - (*sn) * sn1;
+                      *sn = (*cs) * sn1 + (*sn) * cs1;
+                      *cs = tmp;
+                    }
+                }
+              else
+                {
+                  bb = -cc;
+                  cc = 0.0;
+                  tmp = *cs;
+                  *cs = -(*sn);
+                  *sn = tmp;
+                }
+            }
+        }
+    }
+
+  *a = aa;
+  *b = bb;
+  *c = cc;
+  *d = dd;
+
+  *rt1r = aa;
+  *rt2r = dd;
+
+  if (cc == 0.0)
+    {
+      *rt1i = 0.0;
+      *rt2i = 0.0;
+    }
+  else
+    {
+      *rt1i = sqrt (fabs (bb)) * sqrt (fabs (cc));
+      *rt2i = -(*rt1i);
+    }
+}
@@ -30,15 +30,19 @@
 
 /*
  * This module computes the eigenvalues of a real nonsymmetric
- * matrix, using the double shift Francis method.
+ * matrix, using the double shift Francis method, or for large
+ * matrices optionally the multishift QR algorithm with aggressive
+ * early deflation.
  *
- * See the references in francis.c.
+ * See the references in francis.c and multishift.c.
  *
  * This module gets the matrix ready by balancing it and
  * reducing it to Hessenberg form before passing it to the
- * francis module.
+ * francis or multishift module.
  */
 
+#include "multishift.c"
+
 /*
 gsl_eigen_nonsymm_alloc()
 
@@ -72,6 +76,7 @@ gsl_eigen_nonsymm_alloc(const size_t n)
   w->size = n;
   w->Z = NULL;
   w->do_balance = 0;
+  w->method = GSL_EIGEN_NONSYMM_FRANCIS;
 
   w->diag = gsl_vector_alloc(n);
 
@@ -140,6 +145,26 @@ gsl_eigen_nonsymm_params (const int compute_t, const int balance,
   w->do_balance = balance;
 } /* gsl_eigen_nonsymm_params() */
 
+/*
+gsl_eigen_nonsymm_method()
+  Select the QR algorithm used to compute the Schur form
+
+Inputs: method - GSL_EIGEN_NONSYMM_FRANCIS for the double shift
+                 Francis method (default), or
+                 GSL_EIGEN_NONSYMM_MULTISHIFT for the multishift
+                 QR algorithm with aggressive early deflation, which
+                 is much faster for large matrices. Matrices smaller
+                 than MULTISHIFT_NMIN always use the Francis method.
+        w      - nonsymm workspace
+*/
+
+void
+gsl_eigen_nonsymm_method (const gsl_eigen_nonsymm_method_t method,
+                          gsl_eigen_nonsymm_workspace *w)
+{
+  w->method = method;
+} /* gsl_eigen_nonsymm_method() */
+
 /*
 gsl_eigen_nonsymm()
 
@@ -206,27 +231,52 @@ gsl_eigen_nonsymm (gsl_matrix * A, gsl_vector_complex * eval,
 
           /* compute U and store it in Z */
           gsl_linalg_hessenberg_unpack(A, w->tau, w->Z);
+        }
 
-          /* find the eigenvalues and Schur vectors */
-          s = gsl_eigen_francis_Z(A, eval, w->Z, w->francis_workspace_p);
+      if (w->method == GSL_EIGEN_NONSYMM_MULTISHIFT && N >= MULTISHIFT_NMIN)
+        {
+          multishift_workspace *ms = multishift_alloc(N);
 
-          if (w->do_balance)
+          if (ms == 0)
             {
-              /*
-               * The Schur vectors in Z are the vectors for the balanced
-               * matrix. We now must undo the balancing to get the
-               * vectors for the original matrix A.
-               */
-              gsl_linalg_balance_accum(w->Z, w->diag);
+              GSL_ERROR ("failed to allocate space for multishift workspace",
+                         GSL_ENOMEM);
             }
+
+          /* the multishift solver requires zeros below the subdiagonal */
+          gsl_linalg_hessenberg_set_zero(A);
+
+          s = multishift_schur(A, eval, w->Z,
+                               w->francis_workspace_p->compute_t || w->Z,
+                               &(w->n_evals), ms);
+
+          multishift_free(ms);
         }
       else
         {
-          /* find the eigenvalues only */
-          s = gsl_eigen_francis(A, eval, w->francis_workspace_p);
+          if (w->Z)
+            {
+              /* find the eigenvalues and Schur vectors */
+              s = gsl_eigen_francis_Z(A, eval, w->Z, w->francis_workspace_p);
+            }
+          else
+            {
+              /* find the eigenvalues only */
+              s = gsl_eigen_francis(A, eval, w->francis_workspace_p);
+            }
+
+          w->n_evals = w->francis_workspace_p->n_evals;
         }
 
-      w->n_evals = w->francis_workspace_p->n_evals;
+      if (w->Z && w->do_balance)
+        {
+          /*
+           * The Schur vectors in Z are the vectors for the balanced
+           * matrix. We now must undo the balancing to get the
+           * vectors for the original matrix A.
+           */
+          gsl_linalg_balance_accum(w->Z, w->diag);
+        }
 
       return s;
     }
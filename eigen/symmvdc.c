@@ -0,0 +1,696 @@
+/* eigen/symmvdc.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_sort.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_eigen.h>
+
+/* Compute eigenvalues/eigenvectors of real symmetric matrix using
+   reduction to tridiagonal form, followed by Cuppen's divide and
+   conquer method for the tridiagonal matrix.
+
+   The tridiagonal matrix T is split into two halves coupled by a rank
+   one modification,
+
+     T = diag(T1, T2) + rho v v^T,
+
+   the halves are diagonalized recursively, and the eigensystem of the
+   resulting diagonal plus rank one matrix D + rho z z^T is found from
+   the roots of the secular equation
+
+     f(lambda) = 1/rho + sum_j z_j^2 / (d_j - lambda) = 0.
+
+   Small blocks are diagonalized with the implicit QR method of
+   gsl_eigen_symmv.  The eigenvectors of a merged block are obtained
+   from those of its halves with a matrix product, so that most of the
+   work is done in dgemm.
+
+   References:
+
+   Cuppen, J.J.M., 1981. A divide and conquer method for the symmetric
+     tridiagonal eigenproblem. Numerische Mathematik, 36(2), pp.177-195.
+
+   Gu, M. and Eisenstat, S.C., 1995. A divide-and-conquer algorithm for
+     the symmetric tridiagonal eigenproblem. SIAM Journal on Matrix
+     Analysis and Applications, 16(1), pp.172-191.
+
+   The deflation criteria follow LAPACK DLAED2. */
+
+#include "qrstep.c"
+
+/* blocks of at most this size are diagonalized with QR iterations */
+#define SYMMVDC_SMALL 25
+
+/* maximum iterations for a root of the secular equation */
+#define SYMMVDC_MAXITER 100
+
+static int symmvdc_solve (const size_t off, const size_t n,
+                          gsl_matrix * S, gsl_eigen_symmvdc_workspace * w);
+static int symmvdc_merge (const size_t off, const size_t n, const size_t n1,
+                          const double beta, gsl_matrix * S,
+                          gsl_eigen_symmvdc_workspace * w);
+static void symmvdc_qr (const size_t n, double d[], double sd[],
+                        gsl_matrix * Q, double gc[], double gs[]);
+static int secular_root (const size_t k, const size_t i, const double dl[],
+                         const double zl[], const double rho,
+                         size_t * org, double * tau);
+
+gsl_eigen_symmvdc_workspace *
+gsl_eigen_symmvdc_alloc (const size_t n)
+{
+  gsl_eigen_symmvdc_workspace * w;
+
+  if (n == 0)
+    {
+      GSL_ERROR_NULL ("matrix dimension must be positive integer", GSL_EINVAL);
+    }
+
+  w = calloc (1, sizeof (gsl_eigen_symmvdc_workspace));
+
+  if (w == 0)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for workspace", GSL_ENOMEM);
+    }
+
+  w->d = malloc (n * sizeof (double));
+  w->sd = malloc (n * sizeof (double));
+  w->gc = malloc (n * sizeof (double));
+  w->gs = malloc (n * sizeof (double));
+  w->work = malloc (6 * n * sizeof (double));
+  w->iwork = malloc (5 * n * sizeof (size_t));
+
+  if (w->d == 0 || w->sd == 0 || w->gc == 0 || w->gs == 0 ||
+      w->work == 0 || w->iwork == 0)
+    {
+      gsl_eigen_symmvdc_free (w);
+      GSL_ERROR_NULL ("failed to allocate space for vectors", GSL_ENOMEM);
+    }
+
+  w->Z = gsl_matrix_alloc (n, n);
+  w->U = gsl_matrix_alloc (n, n);
+
+  if (w->Z == 0 || w->U == 0)
+    {
+      gsl_eigen_symmvdc_free (w);
+      GSL_ERROR_NULL ("failed to allocate space for matrices", GSL_ENOMEM);
+    }
+
+  w->size = n;
+
+  return w;
+}
+
+void
+gsl_eigen_symmvdc_free (gsl_eigen_symmvdc_workspace * w)
+{
+  RETURN_IF_NULL (w);
+
+  if (w->Z)
+    gsl_matrix_free (w->Z);
+
+  if (w->U)
+    gsl_matrix_free (w->U);
+
+  free (w->iwork);
+  free (w->work);
+  free (w->gs);
+  free (w->gc);
+  free (w->sd);
+  free (w->d);
+  free (w);
+}
+
+int
+gsl_eigen_symmvdc (gsl_matrix * A, gsl_vector * eval, gsl_matrix * evec,
+                   gsl_eigen_symmvdc_workspace * w)
+{
+  if (A->size1 != A->size2)
+    {
+      GSL_ERROR ("matrix must be square to compute eigenvalues", GSL_ENOTSQR);
+    }
+  else if (eval->size != A->size1)
+    {
+      GSL_ERROR ("eigenvalue vector must match matrix size", GSL_EBADLEN);
+    }
+  else if (evec->size1 != A->size1 || evec->size2 != A->size1)
+    {
+      GSL_ERROR ("eigenvector matrix must match matrix size", GSL_EBADLEN);
+    }
+  else if (A->size1 != w->size)
+    {
+      GSL_ERROR ("matrix size does not match workspace", GSL_EBADLEN);
+    }
+  else
+    {
+      double *const d = w->d;
+      double *const sd = w->sd;
+      const size_t N = A->size1;
+      double scale = 0.0;
+      size_t i;
+      int status;
+
+      /* handle special case */
+
+      if (N == 1)
+        {
+          double A00 = gsl_matrix_get (A, 0, 0);
+          gsl_vector_set (eval, 0, A00);
+          gsl_matrix_set (evec, 0, 0, 1.0);
+          return GSL_SUCCESS;
+        }
+
+      /* use sd as the temporary workspace for the decomposition */
+
+      {
+        gsl_vector_view d_vec = gsl_vector_view_array (d, N);
+        gsl_vector_view sd_vec = gsl_vector_view_array (sd, N - 1);
+        gsl_vector_view tau = gsl_vector_view_array (sd, N - 1);
+        gsl_linalg_symmtd_decomp (A, &tau.vector);
+        gsl_linalg_symmtd_unpack (A, &tau.vector, evec, &d_vec.vector, &sd_vec.vector);
+      }
+
+      /* scale the tridiagonal matrix to unit norm, to avoid overflow in
+         the secular equation */
+
+      for (i = 0; i < N; i++)
+        {
+          scale = GSL_MAX (scale, fabs (d[i]));
+
+          if (i < N - 1)
+            scale = GSL_MAX (scale, fabs (sd[i]));
+        }
+
+      if (scale == 0.0)
+        {
+          gsl_vector_set_zero (eval);
+          return GSL_SUCCESS;
+        }
+
+      for (i = 0; i < N; i++)
+        {
+          d[i] /= scale;
+
+          if (i < N - 1)
+            sd[i] /= scale;
+        }
+
+      /* eigenvectors of T in Z, with A used as scratch space */
+
+      gsl_matrix_set_zero (w->Z);
+
+      status = symmvdc_solve (0, N, A, w);
+      if (status)
+        return status;
+
+      /* eigenvectors of A = Q Z */
+
+      gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, evec, w->Z, 0.0, A);
+      gsl_matrix_memcpy (evec, A);
+
+      for (i = 0; i < N; i++)
+        gsl_vector_set (eval, i, scale * d[i]);
+
+      return GSL_SUCCESS;
+    }
+}
+
+/* compute the eigensystem of the tridiagonal block (d,sd)[off:off+n]
+   into the diagonal block of Z, with the eigenvalues in increasing
+   order */
+
+static int
+symmvdc_solve (const size_t off, const size_t n, gsl_matrix * S,
+               gsl_eigen_symmvdc_workspace * w)
+{
+  if (n <= SYMMVDC_SMALL)
+    {
+      gsl_matrix_view Q = gsl_matrix_submatrix (w->Z, off, off, n, n);
+      gsl_vector_view d = gsl_vector_view_array (w->d + off, n);
+
+      gsl_matrix_set_identity (&Q.matrix);
+
+      if (n > 1)
+        symmvdc_qr (n, w->d + off, w->sd + off, &Q.matrix, w->gc, w->gs);
+
+      return gsl_eigen_symmv_sort (&d.vector, &Q.matrix, GSL_EIGEN_SORT_VAL_ASC);
+    }
+  else
+    {
+      /*
+       * T = diag(T1 - rho e_n1 e_n1^T, T2 - rho e_1 e_1^T) + rho v v^T
+       * with rho = |beta| and v = [ e_n1 ; sign(beta) e_1 ]
+       */
+      const size_t n1 = n / 2;
+      const double beta = w->sd[off + n1 - 1];
+      int status;
+
+      w->d[off + n1 - 1] -= fabs (beta);
+      w->d[off + n1] -= fabs (beta);
+
+      status = symmvdc_solve (off, n1, S, w);
+      if (status)
+        return status;
+
+      status = symmvdc_solve (off + n1, n - n1, S, w);
+      if (status)
+        return status;
+
+      return symmvdc_merge (off, n, n1, beta, S, w);
+    }
+}
+
+/* merge the eigensystems of the two halves of the block (off,n), given
+   in the diagonal blocks of Z */
+
+static int
+symmvdc_merge (const size_t off, const size_t n, const size_t n1,
+               const double beta, gsl_matrix * S,
+               gsl_eigen_symmvdc_workspace * w)
+{
+  gsl_matrix_view Q = gsl_matrix_submatrix (w->Z, off, off, n, n);
+  gsl_matrix_view Sn = gsl_matrix_submatrix (S, 0, 0, n, n);
+  double *const d = w->d + off;
+  double *const z = w->work;
+  double *const dl = z + n;
+  double *const zl = dl + n;
+  double *const tau = zl + n;
+  double *const vals = tau + n;
+  size_t *const perm = w->iwork;
+  size_t *const nd = perm + n;
+  size_t *const def = nd + n;
+  size_t *const org = def + n;
+  size_t *const p = org + n;
+  const double sgn = (beta >= 0.0) ? 1.0 : -1.0;
+  double rho = fabs (beta);
+  double nrm = 0.0, dmax = 0.0, tol;
+  size_t i, j, k = 0, ndef = 0, i1, i2;
+  long prev = -1;
+
+  /* z = [ last row of Q1, sign(beta) * first row of Q2 ] */
+
+  for (j = 0; j < n; j++)
+    {
+      z[j] = (j < n1) ? gsl_matrix_get (&Q.matrix, n1 - 1, j)
+                      : sgn * gsl_matrix_get (&Q.matrix, n1, j);
+      nrm += z[j] * z[j];
+      dmax = GSL_MAX (dmax, fabs (d[j]));
+    }
+
+  rho *= nrm;
+  nrm = sqrt (nrm);
+
+  for (j = 0; j < n; j++)
+    z[j] /= nrm;
+
+  tol = 8.0 * GSL_DBL_EPSILON * GSL_MAX (dmax, rho);
+
+  /* merge the increasing eigenvalues of the two halves */
+
+  for (i = 0, i1 = 0, i2 = n1; i < n; i++)
+    {
+      if (i2 == n || (i1 < n1 && d[i1] <= d[i2]))
+        perm[i] = i1++;
+      else
+        perm[i] = i2++;
+    }
+
+  /*
+   * deflation: eigenpairs with a negligible component of z are kept,
+   * and for two close eigenvalues a rotation zeroes one of their
+   * components of z
+   */
+
+  for (i = 0; i < n; i++)
+    {
+      j = perm[i];
+
+      if (rho * fabs (z[j]) <= tol)
+        {
+          def[ndef++] = j;
+        }
+      else if (prev < 0)
+        {
+          prev = (long) j;
+        }
+      else
+        {
+          const size_t pj = (size_t) prev;
+          const double r = hypot (z[j], z[pj]);
+          const double c = z[j] / r;
+          const double s = -z[pj] / r;
+
+          if (fabs ((d[j] - d[pj]) * c * s) <= tol)
+            {
+              gsl_vector_view qp = gsl_matrix_column (&Q.matrix, pj);
+              gsl_vector_view qj = gsl_matrix_column (&Q.matrix, j);
+              const double t = d[pj] * c * c + d[j] * s * s;
+
+              z[j] = r;
+              z[pj] = 0.0;
+              gsl_blas_drot (&qp.vector, &qj.vector, c, s);
+              d[j] = d[pj] * s * s + d[j] * c * c;
+              d[pj] = t;
+
+              def[ndef++] = pj;
+            }
+          else
+            {
+              nd[k++] = pj;
+            }
+
+          prev = (long) j;
+        }
+    }
+
+  if (prev >= 0)
+    nd[k++] = (size_t) prev;
+
+  /* S = [ non-deflated columns of Q, deflated columns of Q ] */
+
+  for (i = 0; i < k; i++)
+    {
+      gsl_vector_view src = gsl_matrix_column (&Q.matrix, nd[i]);
+      gsl_vector_view dest = gsl_matrix_column (&Sn.matrix, i);
+      gsl_vector_memcpy (&dest.vector, &src.vector);
+      dl[i] = d[nd[i]];
+      zl[i] = z[nd[i]];
+    }
+
+  for (i = 0; i < ndef; i++)
+    {
+      gsl_vector_view src = gsl_matrix_column (&Q.matrix, def[i]);
+      gsl_vector_view dest = gsl_matrix_column (&Sn.matrix, k + i);
+      gsl_vector_memcpy (&dest.vector, &src.vector);
+      vals[k + i] = d[def[i]];
+    }
+
+  if (k > 0)
+    {
+      gsl_matrix_view U = gsl_matrix_submatrix (w->U, 0, 0, k, k);
+      gsl_matrix_view Sk = gsl_matrix_submatrix (&Sn.matrix, 0, 0, n, k);
+      gsl_matrix_view Qk = gsl_matrix_submatrix (&Q.matrix, 0, 0, n, k);
+
+      /* roots lambda_i = dl[org_i] + tau_i of the secular equation */
+
+      for (i = 0; i < k; i++)
+        {
+          int status = secular_root (k, i, dl, zl, rho, &org[i], &tau[i]);
+
+          if (status)
+            GSL_ERROR ("secular equation failed to converge", status);
+
+          vals[i] = dl[org[i]] + tau[i];
+        }
+
+      /*
+       * recompute z from the computed eigenvalues (Gu and Eisenstat), so
+       * that the eigenvectors are numerically orthogonal:
+       *
+       * z_j^2 = (lambda_j - d_j) / rho prod_{i != j} (lambda_i - d_j) / (d_i - d_j)
+       */
+
+      for (j = 0; j < k; j++)
+        {
+          double wj = (dl[j] - dl[org[j]]) - tau[j];
+
+          for (i = 0; i < k; i++)
+            {
+              if (i != j)
+                wj *= ((dl[j] - dl[org[i]]) - tau[i]) / (dl[j] - dl[i]);
+            }
+
+          z[j] = (zl[j] >= 0.0) ? sqrt (fabs (wj) / rho) : -sqrt (fabs (wj) / rho);
+        }
+
+      /* eigenvectors of D + rho z z^T: u_i = (D - lambda_i)^{-1} z */
+
+      for (i = 0; i < k; i++)
+        {
+          gsl_vector_view ui = gsl_matrix_column (&U.matrix, i);
+
+          for (j = 0; j < k; j++)
+            gsl_matrix_set (&U.matrix, j, i, z[j] / ((dl[j] - dl[org[i]]) - tau[i]));
+
+          gsl_vector_scale (&ui.vector, 1.0 / gsl_blas_dnrm2 (&ui.vector));
+        }
+
+      gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, &Sk.matrix, &U.matrix,
+                      0.0, &Qk.matrix);
+    }
+
+  if (ndef > 0)
+    {
+      gsl_matrix_view src = gsl_matrix_submatrix (&Sn.matrix, 0, k, n, ndef);
+      gsl_matrix_view dest = gsl_matrix_submatrix (&Q.matrix, 0, k, n, ndef);
+      gsl_matrix_memcpy (&dest.matrix, &src.matrix);
+    }
+
+  /* sort the eigenvalues of the block into increasing order */
+
+  gsl_sort_index (p, vals, 1, n);
+  gsl_matrix_memcpy (&Sn.matrix, &Q.matrix);
+
+  for (i = 0; i < n; i++)
+    {
+      gsl_vector_view src = gsl_matrix_column (&Sn.matrix, p[i]);
+      gsl_vector_view dest = gsl_matrix_column (&Q.matrix, i);
+      gsl_vector_memcpy (&dest.vector, &src.vector);
+      d[i] = vals[p[i]];
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+secular_root()
+  Find the i-th root of the secular equation
+
+f(lambda) = 1/rho + sum_j zl_j^2 / (dl_j - lambda)
+
+with dl increasing and rho > 0. The root lies in (dl_i, dl_{i+1}), or
+(dl_{k-1}, dl_{k-1} + rho |zl|^2] for i = k - 1, and is returned as
+lambda = dl[org] + tau, where dl[org] is the nearest pole, so that the
+differences dl_j - lambda are computed accurately.
+
+The iteration uses the rational model of Bunch, Nielsen and Sorensen,
+which matches the value and derivative of the terms with poles below
+and above the root separately, safeguarded by bisection on the bracket
+of the root.
+*/
+
+static int
+secular_root (const size_t k, const size_t i, const double dl[],
+              const double zl[], const double rho, size_t * org, double * tau)
+{
+  double lo, hi, t;
+  size_t j, iter;
+
+  if (i < k - 1)
+    {
+      const double mid = 0.5 * (dl[i + 1] - dl[i]);
+      double fmid = 1.0 / rho;
+
+      for (j = 0; j < k; j++)
+        fmid += zl[j] * zl[j] / ((dl[j] - dl[i]) - mid);
+
+      /* f is increasing, so the sign of f at the midpoint tells which
+         pole is nearest */
+
+      if (fmid >= 0.0)
+        {
+          *org = i;
+          lo = 0.0;
+          hi = mid;
+        }
+      else
+        {
+          *org = i + 1;
+          lo = -mid;
+          hi = 0.0;
+        }
+    }
+  else
+    {
+      double znrm2 = 0.0;
+
+      for (j = 0; j < k; j++)
+        znrm2 += zl[j] * zl[j];
+
+      *org = i;
+      lo = 0.0;
+      hi = rho * znrm2;
+    }
+
+  t = 0.5 * (lo + hi);
+
+  for (iter = 0; iter < SYMMVDC_MAXITER; iter++)
+    {
+      const double d0 = dl[*org];
+      double psi = 0.0, dpsi = 0.0, phi = 0.0, dphi = 0.0;
+      double f, ferr, delta1, s, tnew;
+
+      for (j = 0; j < k; j++)
+        {
+          const double delta = (dl[j] - d0) - t;
+          const double r = zl[j] / delta;
+
+          if (j <= i)
+            {
+              psi += zl[j] * r;
+              dpsi += r * r;
+            }
+          else
+            {
+              phi += zl[j] * r;
+              dphi += r * r;
+            }
+        }
+
+      f = 1.0 / rho + psi + phi;
+
+      /* bound on the rounding error in f, as in LAPACK dlaed4; near a
+         pole with a tiny zl_i the bracket cannot shrink below this */
+      ferr = GSL_DBL_EPSILON * (8.0 * (1.0 / rho + phi - psi) + fabs (t) * (dpsi + dphi));
+
+      if (fabs (f) <= ferr)
+        break;
+      else if (f < 0.0)
+        lo = t;
+      else
+        hi = t;
+
+      /* model f with the poles of dl_i and dl_{i+1} and solve for the
+         step s of lambda */
+
+      delta1 = (dl[i] - d0) - t;
+
+      if (i < k - 1)
+        {
+          const double delta2 = (dl[i + 1] - d0) - t;
+          const double b = dpsi * delta1 * delta1;
+          const double e = dphi * delta2 * delta2;
+          const double a0 = 1.0 / rho + (psi - dpsi * delta1) + (phi - dphi * delta2);
+          const double qb = -(a0 * (delta1 + delta2) + b + e);
+          const double qc = a0 * delta1 * delta2 + b * delta2 + e * delta1;
+          const double disc = qb * qb - 4.0 * a0 * qc;
+
+          s = GSL_NAN;
+
+          if (a0 == 0.0)
+            {
+              s = -qc / qb;
+            }
+          else if (disc >= 0.0)
+            {
+              const double q = -0.5 * (qb + ((qb >= 0.0) ? sqrt (disc) : -sqrt (disc)));
+              const double r1 = q / a0;
+              const double r2 = (q != 0.0) ? qc / q : r1;
+
+              /* the root of the model lies between its poles */
+              s = (r1 > delta1 && r1 < delta2) ? r1 : r2;
+            }
+        }
+      else
+        {
+          const double a0 = 1.0 / rho + (psi - dpsi * delta1);
+
+          s = (a0 > 0.0) ? delta1 + dpsi * delta1 * delta1 / a0 : GSL_NAN;
+        }
+
+      tnew = t + s;
+
+      /* the upper bound of the last root is not a pole, and may be the
+         root itself */
+      if (!(tnew > lo && (tnew < hi || (i == k - 1 && tnew == hi))))
+        tnew = 0.5 * (lo + hi);
+
+      if (fabs (tnew - t) <= 2.0 * GSL_DBL_EPSILON * fabs (tnew) ||
+          hi - lo <= 2.0 * GSL_DBL_EPSILON * GSL_MAX (fabs (lo), fabs (hi)))
+        {
+          t = tnew;
+          break;
+        }
+
+      t = tnew;
+    }
+
+  *tau = t;
+
+  return (iter < SYMMVDC_MAXITER) ? GSL_SUCCESS : GSL_EMAXITER;
+}
+
+/* QR iterations on a small block, as in gsl_eigen_symmv, accumulating
+   the rotations in Q */
+
+static void
+symmvdc_qr (const size_t n, double d[], double sd[], gsl_matrix * Q,
+            double gc[], double gs[])
+{
+  size_t a, b;
+
+  chop_small_elements (n, d, sd);
+
+  b = n - 1;
+
+  while (b > 0)
+    {
+      if (sd[b - 1] == 0.0 || isnan (sd[b - 1]))
+        {
+          b--;
+          continue;
+        }
+
+      a = b - 1;
+
+      while (a > 0)
+        {
+          if (sd[a - 1] == 0.0)
+            break;
+
+          a--;
+        }
+
+      {
+        size_t i;
+        const size_t n_block = b - a + 1;
+
+        qrstep (n_block, d + a, sd + a, gc, gs);
+
+        for (i = 0; i < n_block - 1; i++)
+          {
+            const double c = gc[i], s = gs[i];
+            size_t r;
+
+            for (r = 0; r < n; r++)
+              {
+                double qri = gsl_matrix_get (Q, r, a + i);
+                double qrj = gsl_matrix_get (Q, r, a + i + 1);
+                gsl_matrix_set (Q, r, a + i, qri * c - qrj * s);
+                gsl_matrix_set (Q, r, a + i + 1, qri * s + qrj * c);
+              }
+          }
+
+        chop_small_elements (n, d, sd);
+      }
+    }
+}
@@ -0,0 +1,811 @@
+/* eigen/symmx.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_eigen.h>
+
+/* Compute selected eigenvalues/eigenvectors of a real symmetric matrix,
+   given by an interval or a range of indices, using reduction to
+   tridiagonal form followed by bisection and inverse iteration.
+
+   The number of eigenvalues of the tridiagonal matrix T less than x is
+   the number of negative pivots in the L D L^T factorization of T - x I
+   (Sturm sequence count), so each wanted eigenvalue can be found by
+   bisection independently of the others.  The eigenvalues are computed
+   in parallel.
+
+   The eigenvectors of T are computed by inverse iteration, with the
+   vectors of eigenvalues closer than 10^-3 ||T|| reorthogonalized
+   against each other.  Such clusters are independent, and are
+   processed in parallel.  The eigenvectors of A are then obtained by
+   applying the Householder transformations of the tridiagonal
+   reduction.
+
+   The algorithms follow LAPACK DSTEBZ and DSTEIN,
+
+   Demmel, J., Dhillon, I. and Ren, H., 1995. On the correctness of some
+     bisection-like parallel eigenvalue algorithms in floating point
+     arithmetic. Electronic Transactions on Numerical Analysis, 3,
+     pp.116-149.
+
+   Jessup, E.R. and Ipsen, I.C.F., 1992. Improving the accuracy of
+     inverse iteration. SIAM Journal on Scientific and Statistical
+     Computing, 13(2), pp.550-572. */
+
+/* iterations of inverse iteration before and after the growth test
+   is passed */
+#define SYMMX_MAXITS 5
+#define SYMMX_EXTRA  2
+
+/* columns of eigenvectors transformed together by each thread */
+#define SYMMX_BLOCK  32
+
+static int symmx (gsl_matrix * A, const int range, const double vl,
+                  const double vu, size_t il, size_t iu, gsl_vector * eval,
+                  gsl_matrix * evec, size_t * nfound,
+                  gsl_eigen_symmx_workspace * w);
+static size_t symmx_count (const double d[], const double e[], const size_t n,
+                           const double x, const double pivmin);
+static int symmx_invit (const size_t n, const double d[], const double e[],
+                        const size_t nclust, const double lambda[],
+                        const size_t cols[], const size_t off,
+                        gsl_matrix * Z, double work[]);
+
+gsl_eigen_symmx_workspace *
+gsl_eigen_symmx_alloc (const size_t n)
+{
+  gsl_eigen_symmx_workspace * w;
+
+  if (n == 0)
+    {
+      GSL_ERROR_NULL ("matrix dimension must be positive integer",
+                      GSL_EINVAL);
+    }
+
+  w = (gsl_eigen_symmx_workspace *) calloc (1, sizeof (gsl_eigen_symmx_workspace));
+
+  if (w == 0)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for workspace", GSL_ENOMEM);
+    }
+
+  w->d = (double *) malloc (n * sizeof (double));
+
+  if (w->d == 0)
+    {
+      gsl_eigen_symmx_free (w);
+      GSL_ERROR_NULL ("failed to allocate space for diagonal", GSL_ENOMEM);
+    }
+
+  w->sd = (double *) malloc (n * sizeof (double));
+
+  if (w->sd == 0)
+    {
+      gsl_eigen_symmx_free (w);
+      GSL_ERROR_NULL ("failed to allocate space for subdiagonal", GSL_ENOMEM);
+    }
+
+  w->tau = (double *) malloc (n * sizeof (double));
+
+  if (w->tau == 0)
+    {
+      gsl_eigen_symmx_free (w);
+      GSL_ERROR_NULL ("failed to allocate space for Householder coefficients", GSL_ENOMEM);
+    }
+
+  w->work = (double *) malloc (2 * n * sizeof (double));
+
+  if (w->work == 0)
+    {
+      gsl_eigen_symmx_free (w);
+      GSL_ERROR_NULL ("failed to allocate space for bisection intervals", GSL_ENOMEM);
+    }
+
+  w->iwork = (size_t *) malloc ((4 * n + 2) * sizeof (size_t));
+
+  if (w->iwork == 0)
+    {
+      gsl_eigen_symmx_free (w);
+      GSL_ERROR_NULL ("failed to allocate space for block indices", GSL_ENOMEM);
+    }
+
+  w->size = n;
+
+  return w;
+}
+
+void
+gsl_eigen_symmx_free (gsl_eigen_symmx_workspace * w)
+{
+  RETURN_IF_NULL (w);
+
+  if (w->d)
+    free (w->d);
+
+  if (w->sd)
+    free (w->sd);
+
+  if (w->tau)
+    free (w->tau);
+
+  if (w->work)
+    free (w->work);
+
+  if (w->iwork)
+    free (w->iwork);
+
+  free (w);
+}
+
+/*
+gsl_eigen_symmx_range()
+  Compute the eigenvalues of a real symmetric matrix in [vl,vu)
+
+Inputs: A      - matrix, destroyed on output
+        vl     - lower bound of interval
+        vu     - upper bound of interval
+        eval   - (output) eigenvalues in ascending order, with length
+                 at least the number of eigenvalues in [vl,vu)
+        nfound - (output) number of eigenvalues in [vl,vu)
+        w      - workspace
+
+Return: success/error
+*/
+
+int
+gsl_eigen_symmx_range (gsl_matrix * A, const double vl, const double vu,
+                       gsl_vector * eval, size_t * nfound,
+                       gsl_eigen_symmx_workspace * w)
+{
+  return symmx (A, 1, vl, vu, 0, 0, eval, NULL, nfound, w);
+}
+
+/*
+gsl_eigen_symmx_index()
+  Compute the eigenvalues il, il+1, ..., iu (counting from 0 in
+ascending order) of a real symmetric matrix
+
+Inputs: A    - matrix, destroyed on output
+        il   - index of smallest eigenvalue wanted
+        iu   - index of largest eigenvalue wanted, il <= iu < N
+        eval - (output) eigenvalues in ascending order, length at least
+               iu - il + 1
+        w    - workspace
+
+Return: success/error
+*/
+
+int
+gsl_eigen_symmx_index (gsl_matrix * A, const size_t il, const size_t iu,
+                       gsl_vector * eval, gsl_eigen_symmx_workspace * w)
+{
+  size_t nfound;
+  return symmx (A, 0, 0.0, 0.0, il, iu, eval, NULL, &nfound, w);
+}
+
+/*
+gsl_eigen_symmvx_range()
+  Compute the eigenvalues of a real symmetric matrix in [vl,vu) and the
+corresponding eigenvectors
+
+Inputs: A      - matrix, destroyed on output
+        vl     - lower bound of interval
+        vu     - upper bound of interval
+        eval   - (output) eigenvalues in ascending order
+        evec   - (output) eigenvectors in the first nfound columns; it
+                 must have N rows, and at least as many columns as the
+                 length of eval
+        nfound - (output) number of eigenvalues in [vl,vu)
+        w      - workspace
+
+Return: success/error
+*/
+
+int
+gsl_eigen_symmvx_range (gsl_matrix * A, const double vl, const double vu,
+                        gsl_vector * eval, gsl_matrix * evec,
+                        size_t * nfound, gsl_eigen_symmx_workspace * w)
+{
+  return symmx (A, 1, vl, vu, 0, 0, eval, evec, nfound, w);
+}
+
+/*
+gsl_eigen_symmvx_index()
+  Compute the eigenvalues il, il+1, ..., iu of a real symmetric matrix
+and the corresponding eigenvectors
+
+Inputs: A    - matrix, destroyed on output
+        il   - index of smallest eigenvalue wanted
+        iu   - index of largest eigenvalue wanted, il <= iu < N
+        eval - (output) eigenvalues in ascending order
+        evec - (output) eigenvectors in the first iu - il + 1 columns
+        w    - workspace
+
+Return: success/error
+*/
+
+int
+gsl_eigen_symmvx_index (gsl_matrix * A, const size_t il, const size_t iu,
+                        gsl_vector * eval, gsl_matrix * evec,
+                        gsl_eigen_symmx_workspace * w)
+{
+  size_t nfound;
+  return symmx (A, 0, 0.0, 0.0, il, iu, eval, evec, &nfound, w);
+}
+
+static int
+symmx (gsl_matrix * A, const int range, const double vl, const double vu,
+       size_t il, size_t iu, gsl_vector * eval, gsl_matrix * evec,
+       size_t * nfound, gsl_eigen_symmx_workspace * w)
+{
+  const size_t N = A->size1;
+
+  *nfound = 0;
+
+  if (A->size1 != A->size2)
+    {
+      GSL_ERROR ("matrix must be square to compute eigenvalues", GSL_ENOTSQR);
+    }
+  else if (N != w->size)
+    {
+      GSL_ERROR ("matrix size does not match workspace", GSL_EBADLEN);
+    }
+  else if (range && !(vl < vu))
+    {
+      GSL_ERROR ("interval must satisfy vl < vu", GSL_EDOM);
+    }
+  else if (!range && (il > iu || iu >= N))
+    {
+      GSL_ERROR ("indices must satisfy il <= iu < N", GSL_EDOM);
+    }
+  else if (evec != NULL && (evec->size1 != N || evec->size2 < eval->size))
+    {
+      GSL_ERROR ("eigenvector matrix must have N rows and at least as many columns as eval", GSL_EBADLEN);
+    }
+  else
+    {
+      const int nthreads = gsl_get_num_threads ();
+      double * d = w->d;
+      double * e = w->sd;
+      double * lo = w->work;
+      double * hi = w->work + N;
+      size_t * bstart = w->iwork;        /* start of each block, N + 1 */
+      size_t * block = w->iwork + N + 1; /* block of each eigenvalue, N */
+      size_t * perm = w->iwork + 2 * N + 1; /* eigenvalues sorted by block, N */
+      size_t * cstart = w->iwork + 3 * N + 1; /* start of each cluster in perm, N + 1 */
+      double tnorm = 0.0, gl, gu, pivmin, emax2 = 0.0, atol;
+      size_t nblock = 0, nclust = 0, m, i, j;
+      int k;
+      int nomem = 0, status = GSL_SUCCESS;
+
+      /* reduce to tridiagonal form */
+
+      if (N == 1)
+        {
+          d[0] = gsl_matrix_get (A, 0, 0);
+        }
+      else
+        {
+          gsl_vector_view tau = gsl_vector_view_array (w->tau, N - 1);
+          gsl_vector_view d_vec = gsl_vector_view_array (d, N);
+          gsl_vector_view sd_vec = gsl_vector_view_array (e, N - 1);
+
+          gsl_linalg_symmtd_decomp (A, &tau.vector);
+          gsl_linalg_symmtd_unpack_T (A, &d_vec.vector, &sd_vec.vector);
+        }
+
+      e[N - 1] = 0.0;
+
+      /* Gershgorin interval and norm of T */
+
+      gl = d[0];
+      gu = d[0];
+
+      for (i = 0; i < N; ++i)
+        {
+          const double r = fabs (e[i]) + ((i > 0) ? fabs (e[i - 1]) : 0.0);
+
+          gl = GSL_MIN (gl, d[i] - r);
+          gu = GSL_MAX (gu, d[i] + r);
+          emax2 = GSL_MAX (emax2, e[i] * e[i]);
+        }
+
+      tnorm = GSL_MAX (fabs (gl), fabs (gu));
+      pivmin = GSL_DBL_MIN * GSL_MAX (1.0, emax2);
+      atol = GSL_DBL_EPSILON * tnorm;
+
+      gl -= 2.1 * (N * GSL_DBL_EPSILON * tnorm + 2.0 * pivmin);
+      gu += 2.1 * (N * GSL_DBL_EPSILON * tnorm + 2.0 * pivmin);
+
+      /* split T into unreduced blocks at negligible off-diagonal
+       * elements; the Sturm count of T is the sum of those of the
+       * blocks, since a zero e[i] restarts the recurrence */
+
+      bstart[nblock++] = 0;
+
+      for (i = 0; i + 1 < N; ++i)
+        {
+          if (fabs (e[i]) <= GSL_DBL_EPSILON * sqrt (fabs (d[i])) * sqrt (fabs (d[i + 1])))
+            {
+              e[i] = 0.0;
+              bstart[nblock++] = i + 1;
+            }
+        }
+
+      bstart[nblock] = N;
+
+      /* indices of wanted eigenvalues */
+
+      if (range)
+        {
+          const size_t cl = symmx_count (d, e, N, vl, pivmin);
+          const size_t cu = symmx_count (d, e, N, vu, pivmin);
+
+          if (cu <= cl)
+            return GSL_SUCCESS;
+
+          il = cl;
+          iu = cu - 1;
+        }
+
+      m = iu - il + 1;
+      *nfound = m;
+
+      if (eval->size < m)
+        {
+          GSL_ERROR ("eigenvalue vector too short for the eigenvalues found", GSL_EBADLEN);
+        }
+
+      /* bisection for each eigenvalue index il + j, maintaining
+       * count(lo) <= il + j < count(hi) */
+
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic, 8)
+      for (k = 0; k < (int) m; ++k)
+        {
+          const size_t idx = il + (size_t) k;
+          double a = gl, b = gu;
+
+          while (b - a > GSL_MAX (GSL_MAX (atol, 2.0 * pivmin),
+                                  2.0 * GSL_DBL_EPSILON * GSL_MAX (fabs (a), fabs (b))))
+            {
+              const double mid = 0.5 * (a + b);
+
+              if (mid <= a || mid >= b)
+                break;
+
+              if (symmx_count (d, e, N, mid, pivmin) <= idx)
+                a = mid;
+              else
+                b = mid;
+            }
+
+          lo[k] = a;
+          hi[k] = b;
+        }
+
+      for (j = 0; j < m; ++j)
+        gsl_vector_set (eval, j, 0.5 * (lo[j] + hi[j]));
+
+      if (evec == NULL)
+        return GSL_SUCCESS;
+
+      /* assign each eigenvalue to the block containing it: the
+       * eigenvalues in [lo,hi) are ordered by block */
+
+      for (j = 0; j < m; ++j)
+        {
+          size_t r = il + j - symmx_count (d, e, N, lo[j], pivmin);
+          size_t b;
+
+          for (b = 0; b < nblock; ++b)
+            {
+              const size_t n = bstart[b + 1] - bstart[b];
+              const double * db = d + bstart[b];
+              const double * eb = e + bstart[b];
+              const size_t nb = symmx_count (db, eb, n, hi[j], pivmin)
+                                - symmx_count (db, eb, n, lo[j], pivmin);
+
+              if (r < nb || b + 1 == nblock)
+                break;
+
+              r -= nb;
+            }
+
+          block[j] = b;
+        }
+
+      /* order eigenvalues by block, keeping ascending order within a
+       * block, and split each block into clusters */
+
+      {
+        size_t * count = cstart; /* used as scratch before clusters are formed */
+
+        for (i = 0; i <= nblock; ++i)
+          count[i] = 0;
+
+        for (j = 0; j < m; ++j)
+          ++count[block[j] + 1];
+
+        for (i = 0; i < nblock; ++i)
+          count[i + 1] += count[i];
+
+        for (j = 0; j < m; ++j)
+          perm[count[block[j]]++] = j;
+      }
+
+      {
+        double onenrm = 0.0;
+
+        for (j = 0; j < m; ++j)
+          {
+            const size_t b = block[perm[j]];
+
+            if (j == 0 || b != block[perm[j - 1]])
+              {
+                cstart[nclust++] = j;
+
+                onenrm = 0.0;
+                for (i = bstart[b]; i < bstart[b + 1]; ++i)
+                  {
+                    onenrm = GSL_MAX (onenrm, fabs (d[i]) + fabs (e[i]) +
+                                      ((i > bstart[b]) ? fabs (e[i - 1]) : 0.0));
+                  }
+              }
+            else if (gsl_vector_get (eval, perm[j]) -
+                     gsl_vector_get (eval, perm[j - 1]) > 1.0e-3 * onenrm)
+              {
+                cstart[nclust++] = j;
+              }
+          }
+      }
+
+      /* eigenvectors of T by inverse iteration */
+
+      {
+        gsl_matrix_view Z = gsl_matrix_submatrix (evec, 0, 0, N, m);
+        gsl_matrix_set_zero (&Z.matrix);
+      }
+
+#pragma omp parallel num_threads(nthreads) reduction(|:nomem,status)
+      {
+        double * work = malloc (7 * N * sizeof (double));
+        int c;
+
+        if (work == NULL)
+          nomem = 1;
+
+#pragma omp for schedule(dynamic)
+        for (c = 0; c < (int) nclust; ++c)
+          {
+            const size_t c0 = cstart[c];
+            const size_t c1 = ((size_t) c + 1 < nclust) ? cstart[c + 1] : m;
+            const size_t b = block[perm[c0]];
+            const size_t off = bstart[b];
+
+            if (work == NULL)
+              continue;
+
+            status |= symmx_invit (bstart[b + 1] - off, d + off, e + off,
+                                   c1 - c0, eval->data, perm + c0, off,
+                                   evec, work);
+          }
+
+        free (work);
+      }
+
+      if (nomem)
+        {
+          GSL_ERROR ("failed to allocate working space", GSL_ENOMEM);
+        }
+
+      /* back-transform Z <- Q Z, with Q = Q_1 Q_2 ... Q_(N-2); T has
+       * been copied to (d,e), so the leading elements of the Householder
+       * vectors are set to 1 in A, which the threads then only read */
+
+      if (N > 2)
+        {
+          const int ncb = (int) ((m + SYMMX_BLOCK - 1) / SYMMX_BLOCK);
+          int cb;
+
+          for (i = 0; i + 1 < N; ++i)
+            gsl_matrix_set (A, i + 1, i, 1.0);
+
+#pragma omp parallel for num_threads(nthreads) schedule(static)
+          for (cb = 0; cb < ncb; ++cb)
+            {
+              const size_t j0 = (size_t) cb * SYMMX_BLOCK;
+              const size_t nc = GSL_MIN (SYMMX_BLOCK, m - j0);
+              double wdata[SYMMX_BLOCK];
+              gsl_vector_view wv = gsl_vector_view_array (wdata, nc);
+              size_t ii;
+
+              for (ii = N - 2; ii-- > 0;)
+                {
+                  gsl_vector_const_view h = gsl_matrix_const_subcolumn (A, ii, ii + 1, N - ii - 1);
+                  gsl_matrix_view Zi = gsl_matrix_submatrix (evec, ii + 1, j0, N - ii - 1, nc);
+
+                  gsl_linalg_householder_left (w->tau[ii], &h.vector, &Zi.matrix, &wv.vector);
+                }
+            }
+        }
+
+      if (status)
+        {
+          GSL_ERROR ("inverse iteration did not converge", GSL_EMAXITER);
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/* number of eigenvalues of the tridiagonal matrix (d,e) less than x; a
+ * pivot which vanishes because x is an eigenvalue of a leading submatrix
+ * is taken as positive, so that x itself is not counted */
+
+static size_t
+symmx_count (const double d[], const double e[], const size_t n,
+             const double x, const double pivmin)
+{
+  size_t count = 0, i;
+  double q = d[0] - x;
+
+  if (fabs (q) <= pivmin)
+    q = pivmin;
+
+  if (q < 0.0)
+    ++count;
+
+  for (i = 1; i < n; ++i)
+    {
+      q = d[i] - x - e[i - 1] * e[i - 1] / q;
+
+      if (fabs (q) <= pivmin)
+        q = pivmin;
+
+      if (q < 0.0)
+        ++count;
+    }
+
+  return count;
+}
+
+/*
+symmx_invit()
+  Compute eigenvectors of an unreduced block of T for a cluster of
+eigenvalues by inverse iteration
+
+Inputs: n      - size of block
+        d      - diagonal of block
+        e      - off-diagonal of block, length n - 1
+        nclust - number of eigenvalues in cluster
+        lambda - all eigenvalues
+        cols   - indices of the eigenvalues of the cluster in lambda and
+                 columns of Z, in ascending order of eigenvalue
+        off    - first row of block in Z
+        Z      - (output) eigenvectors, in rows off to off + n - 1 of
+                 the columns cols
+        work   - workspace, length 7 n
+
+Return: 0 on success, 1 if an eigenvector did not converge
+*/
+
+static int
+symmx_invit (const size_t n, const double d[], const double e[],
+             const size_t nclust, const double lambda[],
+             const size_t cols[], const size_t off,
+             gsl_matrix * Z, double work[])
+{
+  double * a = work;          /* diagonal of U */
+  double * b = work + n;      /* first superdiagonal of U */
+  double * c = work + 2 * n;  /* multipliers of L */
+  double * s = work + 3 * n;  /* second superdiagonal of U */
+  double * piv = work + 4 * n; /* 1 if rows k and k+1 were interchanged */
+  double * x = work + 5 * n;
+  const double dtpcrt = sqrt (0.1 / n);
+  double onenrm = 0.0, tol, xjm = 0.0;
+  unsigned long seed;
+  int failed = 0;
+  size_t i, j, p, k;
+
+  if (n == 1)
+    {
+      for (j = 0; j < nclust; ++j)
+        gsl_matrix_set (Z, off, cols[j], 1.0);
+
+      return 0;
+    }
+
+  for (i = 0; i < n; ++i)
+    {
+      onenrm = GSL_MAX (onenrm, fabs (d[i]) + ((i + 1 < n) ? fabs (e[i]) : 0.0) +
+                        ((i > 0) ? fabs (e[i - 1]) : 0.0));
+    }
+
+  tol = GSL_DBL_EPSILON * onenrm;
+
+  for (j = 0; j < nclust; ++j)
+    {
+      double xj = lambda[cols[j]];
+      size_t its, nrmchk = 0, jmax = 0;
+      double nrm;
+
+      /* separate numerically equal eigenvalues, so that the
+       * factorizations differ */
+      if (j > 0 && xj - xjm < 10.0 * fabs (GSL_DBL_EPSILON * xj))
+        xj = xjm + 10.0 * fabs (GSL_DBL_EPSILON * xj);
+
+      xjm = xj;
+
+      /* LU factorization of T - xj I with partial pivoting */
+
+      for (i = 0; i < n; ++i)
+        a[i] = d[i] - xj;
+
+      for (i = 0; i + 1 < n; ++i)
+        {
+          b[i] = e[i];
+          c[i] = e[i];
+        }
+
+      for (k = 0; k + 1 < n; ++k)
+        {
+          if (fabs (a[k]) >= fabs (c[k]))
+            {
+              piv[k] = 0.0;
+              c[k] = (a[k] != 0.0) ? c[k] / a[k] : 0.0;
+              a[k + 1] -= c[k] * b[k];
+              s[k] = 0.0;
+            }
+          else
+            {
+              const double mult = a[k] / c[k];
+              const double temp = a[k + 1];
+
+              piv[k] = 1.0;
+              a[k] = c[k];
+              a[k + 1] = b[k] - mult * temp;
+
+              if (k + 2 < n)
+                {
+                  s[k] = b[k + 1];
+                  b[k + 1] = -mult * s[k];
+                }
+              else
+                {
+                  s[k] = 0.0;
+                }
+
+              b[k] = temp;
+              c[k] = mult;
+            }
+        }
+
+      /* starting vector, with a seed depending only on the column so
+       * that the results do not depend on the number of threads */
+
+      seed = 1 + cols[j];
+      for (i = 0; i < n; ++i)
+        {
+          seed = (69069UL * seed + 1UL) & 0xffffffffUL;
+          x[i] = 2.0 * (seed / 4294967296.0) - 1.0;
+        }
+
+      for (its = 0; its < SYMMX_MAXITS + SYMMX_EXTRA + 1; ++its)
+        {
+          double asum = 0.0, scl;
+
+          /* scale the right hand side so that growth of the solution
+           * by 1/(n eps ||T||) signals convergence */
+          for (i = 0; i < n; ++i)
+            asum += fabs (x[i]);
+
+          scl = n * onenrm * GSL_MAX (GSL_DBL_EPSILON, fabs (a[n - 1])) / asum;
+
+          for (i = 0; i < n; ++i)
+            x[i] *= scl;
+
+          /* solve L U y = P x */
+
+          for (k = 0; k + 1 < n; ++k)
+            {
+              if (piv[k] != 0.0)
+                {
+                  const double temp = x[k + 1];
+                  x[k + 1] = x[k] - c[k] * temp;
+                  x[k] = temp;
+                }
+              else
+                {
+                  x[k + 1] -= c[k] * x[k];
+                }
+            }
+
+          for (k = n; k-- > 0;)
+            {
+              double temp = x[k];
+              double ak = a[k];
+
+              if (k + 1 < n)
+                temp -= b[k] * x[k + 1];
+              if (k + 2 < n)
+                temp -= s[k] * x[k + 2];
+
+              /* perturb small pivots */
+              if (fabs (ak) < tol)
+                ak = (ak >= 0.0) ? tol : -tol;
+
+              x[k] = temp / ak;
+            }
+
+          /* reorthogonalize against the previous vectors of the cluster */
+
+          for (p = 0; p < j; ++p)
+            {
+              double dot = 0.0;
+
+              for (i = 0; i < n; ++i)
+                dot += x[i] * gsl_matrix_get (Z, off + i, cols[p]);
+
+              for (i = 0; i < n; ++i)
+                x[i] -= dot * gsl_matrix_get (Z, off + i, cols[p]);
+            }
+
+          jmax = 0;
+          for (i = 1; i < n; ++i)
+            {
+              if (fabs (x[i]) > fabs (x[jmax]))
+                jmax = i;
+            }
+
+          if (fabs (x[jmax]) >= dtpcrt)
+            {
+              if (++nrmchk > SYMMX_EXTRA)
+                break;
+            }
+          else if (its >= SYMMX_MAXITS)
+            {
+              failed = 1;
+              break;
+            }
+
+          /* rescale to avoid overflow in the next solve */
+          nrm = fabs (x[jmax]);
+          for (i = 0; i < n; ++i)
+            x[i] /= nrm;
+        }
+
+      /* normalize, with the largest element positive */
+
+      nrm = 0.0;
+      for (i = 0; i < n; ++i)
+        nrm = gsl_hypot (nrm, x[i]);
+
+      if (x[jmax] < 0.0)
+        nrm = -nrm;
+
+      for (i = 0; i < n; ++i)
+        gsl_matrix_set (Z, off + i, cols[j], x[i] / nrm);
+    }
+
+  return failed;
+}
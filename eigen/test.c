@@ -343,6 +343,7 @@ test_eigen_symm_matrix(const gsl_matrix * m, size_t count,
   gsl_matrix * evec = gsl_matrix_alloc(N, N);
   gsl_eigen_symm_workspace * w = gsl_eigen_symm_alloc(N);
   gsl_eigen_symmv_workspace * wv = gsl_eigen_symmv_alloc(N);
+  gsl_eigen_symmvdc_workspace * wdc = gsl_eigen_symmvdc_alloc(N);
 
   gsl_matrix_memcpy(A, m);
 
@@ -372,6 +373,18 @@ test_eigen_symm_matrix(const gsl_matrix * m, size_t count,
   gsl_eigen_symmv_sort(evalv, evec, GSL_EIGEN_SORT_ABS_DESC);
   test_eigen_symm_results(m, evalv, evec, count, desc, "abs/desc");
 
+  /* divide and conquer */
+  gsl_matrix_memcpy(A, m);
+  gsl_eigen_symmvdc(A, evalv, evec, wdc);
+  test_eigen_symm_results(m, evalv, evec, count, desc, "dc");
+
+  gsl_vector_memcpy(y, evalv);
+  gsl_sort_vector(y);
+  test_eigenvalues_real(y, x, desc, "dc");
+
+  gsl_eigen_symmv_sort(evalv, evec, GSL_EIGEN_SORT_ABS_DESC);
+  test_eigen_symm_results(m, evalv, evec, count, desc, "dc abs/desc");
+
   gsl_matrix_free(A);
   gsl_vector_free(eval);
   gsl_vector_free(evalv);
@@ -380,8 +393,326 @@ test_eigen_symm_matrix(const gsl_matrix * m, size_t count,
   gsl_matrix_free(evec);
   gsl_eigen_symm_free(w);
   gsl_eigen_symmv_free(wv);
+  gsl_eigen_symmvdc_free(wdc);
 } /* test_eigen_symm_matrix() */
 
+/* compare the eigenvalues il..iu and eigenvalues in [vl,vu) with those
+   of gsl_eigen_symm, and check the eigenvectors */
+
+void
+test_eigen_symmx_results (const gsl_matrix * A, const gsl_vector * exact,
+                          const gsl_vector * eval, const gsl_matrix * evec,
+                          const size_t il, const size_t m, const char * desc,
+                          const char * desc2)
+{
+  const size_t N = A->size1;
+  const double anorm = GSL_MAX(fabs(gsl_vector_get(exact, 0)),
+                               fabs(gsl_vector_get(exact, N - 1)));
+  const double tol = 1.0e3 * N * GSL_DBL_EPSILON * GSL_MAX(anorm, 1.0);
+  gsl_vector * y = gsl_vector_alloc(N);
+  size_t i, j;
+
+  for (i = 0; i < m; ++i)
+    {
+      double ei = gsl_vector_get(eval, i);
+
+      gsl_test_abs(ei, gsl_vector_get(exact, il + i), tol,
+                   "%s, eigenvalue(%d), %s", desc, il + i, desc2);
+
+      if (evec != NULL)
+        {
+          gsl_vector_const_view vi = gsl_matrix_const_column(evec, i);
+
+          /* || A v - lambda v || */
+          gsl_blas_dgemv(CblasNoTrans, 1.0, A, &vi.vector, 0.0, y);
+          gsl_blas_daxpy(-ei, &vi.vector, y);
+          gsl_test(gsl_blas_dnrm2(y) > tol, "%s, residual(%d), %s",
+                   desc, il + i, desc2);
+
+          gsl_test_rel(gsl_blas_dnrm2(&vi.vector), 1.0, N * GSL_DBL_EPSILON,
+                       "%s, normalized(%d), %s", desc, il + i, desc2);
+
+          for (j = i + 1; j < m; ++j)
+            {
+              gsl_vector_const_view vj = gsl_matrix_const_column(evec, j);
+              double vivj;
+
+              gsl_blas_ddot(&vi.vector, &vj.vector, &vivj);
+              gsl_test_abs(vivj, 0.0, 10.0 * N * GSL_DBL_EPSILON,
+                           "%s, orthogonal(%d,%d), %s", desc, il + i, il + j, desc2);
+            }
+        }
+    }
+
+  gsl_vector_free(y);
+}
+
+void
+test_eigen_symmx_matrix(const gsl_matrix * m, const char * desc)
+{
+  const size_t N = m->size1;
+  gsl_matrix * A = gsl_matrix_alloc(N, N);
+  gsl_vector * exact = gsl_vector_alloc(N);
+  gsl_vector * eval = gsl_vector_alloc(N);
+  gsl_matrix * evec = gsl_matrix_alloc(N, N);
+  gsl_eigen_symm_workspace * ws = gsl_eigen_symm_alloc(N);
+  gsl_eigen_symmx_workspace * w = gsl_eigen_symmx_alloc(N);
+  const size_t ranges[][2] = { { 0, N - 1 }, { 0, 0 }, { N - 1, N - 1 },
+                               { N / 4, N / 2 }, { N / 3, N / 3 } };
+  size_t i, nfound;
+
+  gsl_matrix_memcpy(A, m);
+  gsl_eigen_symm(A, exact, ws);
+  gsl_sort_vector(exact);
+
+  for (i = 0; i < sizeof(ranges) / sizeof(ranges[0]); ++i)
+    {
+      const size_t il = ranges[i][0];
+      const size_t iu = ranges[i][1];
+
+      gsl_matrix_memcpy(A, m);
+      gsl_eigen_symmx_index(A, il, iu, eval, w);
+      test_eigen_symmx_results(m, exact, eval, NULL, il, iu - il + 1, desc, "index");
+
+      gsl_matrix_memcpy(A, m);
+      gsl_eigen_symmvx_index(A, il, iu, eval, evec, w);
+      test_eigen_symmx_results(m, exact, eval, evec, il, iu - il + 1, desc, "vector index");
+    }
+
+  /* the interval between the midpoints of separated eigenvalues */
+  {
+    size_t il = N / 5, iu = (3 * N) / 4;
+    double vl, vu;
+
+    while (il > 0 && gsl_vector_get(exact, il) - gsl_vector_get(exact, il - 1) < 1.0e-6)
+      --il;
+    while (iu + 1 < N && gsl_vector_get(exact, iu + 1) - gsl_vector_get(exact, iu) < 1.0e-6)
+      ++iu;
+
+    vl = (il > 0) ? 0.5 * (gsl_vector_get(exact, il - 1) + gsl_vector_get(exact, il))
+                  : gsl_vector_get(exact, 0) - 1.0;
+    vu = (iu + 1 < N) ? 0.5 * (gsl_vector_get(exact, iu) + gsl_vector_get(exact, iu + 1))
+                      : gsl_vector_get(exact, N - 1) + 1.0;
+
+    gsl_matrix_memcpy(A, m);
+    gsl_eigen_symmvx_range(A, vl, vu, eval, evec, &nfound, w);
+    gsl_test(nfound != iu - il + 1, "%s, range count %d expected %d", desc,
+             nfound, iu - il + 1);
+    test_eigen_symmx_results(m, exact, eval, evec, il, GSL_MIN(nfound, iu - il + 1),
+                             desc, "vector range");
+
+    gsl_matrix_memcpy(A, m);
+    gsl_eigen_symmx_range(A, vl, vu, eval, &nfound, w);
+    test_eigen_symmx_results(m, exact, eval, NULL, il, GSL_MIN(nfound, iu - il + 1),
+                             desc, "range");
+
+    /* an interval outside the spectrum */
+    gsl_matrix_memcpy(A, m);
+    gsl_eigen_symmx_range(A, gsl_vector_get(exact, N - 1) + 1.0,
+                          gsl_vector_get(exact, N - 1) + 2.0, eval, &nfound, w);
+    gsl_test(nfound != 0, "%s, empty range count %d", desc, nfound);
+  }
+
+  gsl_matrix_free(A);
+  gsl_vector_free(exact);
+  gsl_vector_free(eval);
+  gsl_matrix_free(evec);
+  gsl_eigen_symm_free(ws);
+  gsl_eigen_symmx_free(w);
+} /* test_eigen_symmx_matrix() */
+
+/* intervals [vl,vu) with end points exactly on the eigenvalues of a
+   diagonal matrix, which must include vl and exclude vu */
+
+void
+test_eigen_symmx_endpoints(const gsl_matrix * m, const char * desc)
+{
+  const size_t N = m->size1;
+  gsl_matrix * A = gsl_matrix_alloc(N, N);
+  gsl_vector * exact = gsl_vector_alloc(N);
+  gsl_vector * eval = gsl_vector_alloc(N);
+  gsl_matrix * evec = gsl_matrix_alloc(N, N);
+  gsl_eigen_symmx_workspace * w = gsl_eigen_symmx_alloc(N);
+  size_t i, j, nfound;
+
+  gsl_vector_const_view diag = gsl_matrix_const_diagonal(m);
+  gsl_vector_memcpy(exact, &diag.vector);
+  gsl_sort_vector(exact);
+
+  for (i = 0; i < N; ++i)
+    {
+      for (j = i + 1; j <= N; ++j)
+        {
+          const double vl = gsl_vector_get(exact, i);
+          const double vu = (j < N) ? gsl_vector_get(exact, j)
+                                    : gsl_vector_get(exact, N - 1) + 1.0;
+          size_t il = i, iu = j;
+
+          if (vu <= vl)
+            continue;
+
+          /* eigenvalues in [vl,vu) have indices il to iu - 1 */
+          while (il > 0 && gsl_vector_get(exact, il - 1) == vl)
+            --il;
+          while (iu > 0 && gsl_vector_get(exact, iu - 1) == vu)
+            --iu;
+
+          gsl_matrix_memcpy(A, m);
+          gsl_eigen_symmx_range(A, vl, vu, eval, &nfound, w);
+          gsl_test(nfound != iu - il, "%s, [%g,%g) count %d expected %d",
+                   desc, vl, vu, nfound, iu - il);
+          test_eigen_symmx_results(m, exact, eval, NULL, il, GSL_MIN(nfound, iu - il),
+                                   desc, "endpoint range");
+
+          gsl_matrix_memcpy(A, m);
+          gsl_eigen_symmvx_range(A, vl, vu, eval, evec, &nfound, w);
+          gsl_test(nfound != iu - il, "%s, [%g,%g) vector count %d expected %d",
+                   desc, vl, vu, nfound, iu - il);
+          test_eigen_symmx_results(m, exact, eval, evec, il, GSL_MIN(nfound, iu - il),
+                                   desc, "endpoint vector range");
+        }
+    }
+
+  gsl_matrix_free(A);
+  gsl_vector_free(exact);
+  gsl_vector_free(eval);
+  gsl_matrix_free(evec);
+  gsl_eigen_symmx_free(w);
+} /* test_eigen_symmx_endpoints() */
+
+/* batch of the matrices m_k, for the batched eigensolvers */
+
+void
+test_eigen_symm_batch_matrix(const gsl_matrix * m, const char * desc)
+{
+  const size_t N = m->size2;
+  const size_t nbatch = m->size1 / N;
+  gsl_matrix * A = gsl_matrix_alloc(nbatch * N, N);
+  gsl_vector * eval = gsl_vector_alloc(nbatch * N);
+  gsl_matrix * evec = gsl_matrix_alloc(nbatch * N, N);
+  gsl_matrix * B = gsl_matrix_alloc(N, N);
+  gsl_vector * exact = gsl_vector_alloc(N);
+  gsl_eigen_symm_workspace * ws = gsl_eigen_symm_alloc(N);
+  size_t k;
+
+  gsl_matrix_memcpy(A, m);
+  gsl_eigen_symm_batch(A, eval);
+
+  for (k = 0; k < nbatch; ++k)
+    {
+      gsl_matrix_const_view mk = gsl_matrix_const_submatrix(m, k * N, 0, N, N);
+      gsl_vector_view ek = gsl_vector_subvector(eval, k * N, N);
+
+      gsl_matrix_memcpy(B, &mk.matrix);
+      gsl_eigen_symm(B, exact, ws);
+      gsl_sort_vector(exact);
+
+      test_eigen_symmx_results(&mk.matrix, exact, &ek.vector, NULL, 0, N, desc, "batch");
+    }
+
+  gsl_matrix_memcpy(A, m);
+  gsl_eigen_symmv_batch(A, eval, evec);
+
+  for (k = 0; k < nbatch; ++k)
+    {
+      gsl_matrix_const_view mk = gsl_matrix_const_submatrix(m, k * N, 0, N, N);
+      gsl_vector_view ek = gsl_vector_subvector(eval, k * N, N);
+      gsl_matrix_view vk = gsl_matrix_submatrix(evec, k * N, 0, N, N);
+
+      gsl_matrix_memcpy(B, &mk.matrix);
+      gsl_eigen_symm(B, exact, ws);
+      gsl_sort_vector(exact);
+
+      test_eigen_symmx_results(&mk.matrix, exact, &ek.vector, &vk.matrix, 0, N,
+                               desc, "vector batch");
+    }
+
+  gsl_matrix_free(A);
+  gsl_vector_free(eval);
+  gsl_matrix_free(evec);
+  gsl_matrix_free(B);
+  gsl_vector_free(exact);
+  gsl_eigen_symm_free(ws);
+} /* test_eigen_symm_batch_matrix() */
+
+void
+test_eigen_symm_batch(void)
+{
+  const size_t nbatch = 20;
+  gsl_rng *r = gsl_rng_alloc(gsl_rng_default);
+  size_t n, k, i;
+
+  /* sizes with and without a size-specific kernel */
+  for (n = 1; n <= 6; ++n)
+    {
+      gsl_matrix * A = gsl_matrix_alloc(nbatch * n, n);
+
+      for (k = 0; k < nbatch; ++k)
+        {
+          gsl_matrix_view Ak = gsl_matrix_submatrix(A, k * n, 0, n, n);
+          create_random_symm_matrix(&Ak.matrix, r, -10, 10);
+        }
+
+      test_eigen_symm_batch_matrix(A, "symm batch random");
+
+      /* zero, identity, repeated and graded matrices in one batch */
+      for (k = 0; k < nbatch; ++k)
+        {
+          gsl_matrix_view Ak = gsl_matrix_submatrix(A, k * n, 0, n, n);
+
+          switch (k % 4)
+            {
+            case 0:
+              gsl_matrix_set_zero(&Ak.matrix);
+              break;
+
+            case 1:
+              gsl_matrix_set_identity(&Ak.matrix);
+              break;
+
+            case 2:
+              gsl_matrix_set_all(&Ak.matrix, 1.0);
+              break;
+
+            default:
+              create_random_symm_matrix(&Ak.matrix, r, -1, 1);
+              for (i = 0; i < n; ++i)
+                {
+                  gsl_vector_view ri = gsl_matrix_row(&Ak.matrix, i);
+                  gsl_vector_view ci = gsl_matrix_column(&Ak.matrix, i);
+                  gsl_vector_scale(&ri.vector, pow(10.0, (double) i));
+                  gsl_vector_scale(&ci.vector, pow(10.0, (double) i));
+                }
+              break;
+            }
+        }
+
+      test_eigen_symm_batch_matrix(A, "symm batch special");
+
+      gsl_matrix_free(A);
+    }
+
+  /* an empty batch */
+  {
+    gsl_matrix * A = gsl_matrix_alloc(0, 0);
+    gsl_matrix * evec = gsl_matrix_alloc(0, 0);
+    gsl_vector * eval = gsl_vector_alloc(0);
+    int status;
+
+    status = gsl_eigen_symm_batch(A, eval);
+    gsl_test(status, "symm batch empty status=%d", status);
+
+    status = gsl_eigen_symmv_batch(A, eval, evec);
+    gsl_test(status, "symmv batch empty status=%d", status);
+
+    gsl_matrix_free(A);
+    gsl_matrix_free(evec);
+    gsl_vector_free(eval);
+  }
+
+  gsl_rng_free(r);
+} /* test_eigen_symm_batch() */
+
 void
 test_eigen_symm(void)
 {
@@ -397,6 +728,7 @@ test_eigen_symm(void)
         {
           create_random_symm_matrix(A, r, -10, 10);
           test_eigen_symm_matrix(A, i, "symm random");
+          test_eigen_symmx_matrix(A, "symmx random");
         }
 
       gsl_matrix_free(A);
@@ -460,6 +792,102 @@ test_eigen_symm(void)
 
 } /* test_eigen_symm() */
 
+/* larger matrices for the divide and conquer method, including
+   matrices with multiple and clustered eigenvalues which exercise the
+   deflation */
+
+void
+test_eigen_symmvdc(void)
+{
+  const size_t sizes[] = { 26, 51, 64, 100, 173 };
+  gsl_rng *r = gsl_rng_alloc(gsl_rng_default);
+  size_t n, i, j, t;
+
+  for (t = 0; t < sizeof(sizes) / sizeof(sizes[0]); ++t)
+    {
+      gsl_matrix * A = gsl_matrix_alloc(sizes[t], sizes[t]);
+
+      n = sizes[t];
+
+      create_random_symm_matrix(A, r, -10, 10);
+      test_eigen_symm_matrix(A, 0, "symmvdc random");
+      test_eigen_symmx_matrix(A, "symmx random");
+
+      /* 1-2-1 tridiagonal matrix */
+      gsl_matrix_set_zero(A);
+      for (i = 0; i < n; ++i)
+        {
+          gsl_matrix_set(A, i, i, 2.0);
+          if (i > 0)
+            {
+              gsl_matrix_set(A, i, i - 1, -1.0);
+              gsl_matrix_set(A, i - 1, i, -1.0);
+            }
+        }
+      test_eigen_symm_matrix(A, 0, "symmvdc tridiag");
+      test_eigen_symmx_matrix(A, "symmx tridiag");
+
+      /* I + u u^T, with a multiple eigenvalue 1 */
+      for (i = 0; i < n; ++i)
+        {
+          for (j = 0; j < n; ++j)
+            gsl_matrix_set(A, i, j, (i == j) + 1.0 / (1.0 + i + j));
+        }
+      test_eigen_symm_matrix(A, 0, "symmvdc I+uu^T");
+      test_eigen_symmx_matrix(A, "symmx I+uu^T");
+
+      /* diagonal matrix with repeated eigenvalues */
+      gsl_matrix_set_zero(A);
+      for (i = 0; i < n; ++i)
+        gsl_matrix_set(A, i, i, (double) (i % 7));
+      test_eigen_symm_matrix(A, 0, "symmvdc diag");
+      test_eigen_symmx_matrix(A, "symmx diag");
+
+      /* Wilkinson matrix, with pairs of close eigenvalues */
+      gsl_matrix_set_zero(A);
+      for (i = 0; i < n; ++i)
+        {
+          gsl_matrix_set(A, i, i, fabs((double) i - 0.5 * (n - 1)));
+          if (i > 0)
+            {
+              gsl_matrix_set(A, i, i - 1, 1.0);
+              gsl_matrix_set(A, i - 1, i, 1.0);
+            }
+        }
+      test_eigen_symm_matrix(A, 0, "symmvdc wilkinson");
+      test_eigen_symmx_matrix(A, "symmx wilkinson");
+
+      gsl_matrix_free(A);
+    }
+
+  gsl_rng_free(r);
+} /* test_eigen_symmvdc() */
+
+void
+test_eigen_symmx_diag(void)
+{
+  const size_t sizes[] = { 1, 3, 10, 26 };
+  size_t i, t;
+
+  for (t = 0; t < sizeof(sizes) / sizeof(sizes[0]); ++t)
+    {
+      const size_t n = sizes[t];
+      gsl_matrix * A = gsl_matrix_calloc(n, n);
+
+      /* distinct eigenvalues 1, 2, ..., n in reverse order */
+      for (i = 0; i < n; ++i)
+        gsl_matrix_set(A, i, i, (double) (n - i));
+      test_eigen_symmx_endpoints(A, "symmx diag distinct");
+
+      /* repeated eigenvalues, including 0 */
+      for (i = 0; i < n; ++i)
+        gsl_matrix_set(A, i, i, (double) (i % 4) - 1.0);
+      test_eigen_symmx_endpoints(A, "symmx diag repeated");
+
+      gsl_matrix_free(A);
+    }
+} /* test_eigen_symmx_diag() */
+
 /******************************************
  * herm test code                         *
  ******************************************/
@@ -732,6 +1160,59 @@ test_eigen_nonsymm_matrix(const gsl_matrix * m, size_t count,
   gsl_vector_complex_free(eval);
 }
 
+/* compare the eigenvalues computed by the multishift and Francis
+   methods without Schur vectors */
+void
+test_eigen_nonsymm_multishift(const gsl_matrix * m, size_t count,
+                              const char * desc)
+{
+  const size_t N = m->size1;
+  gsl_matrix * A = gsl_matrix_alloc(N, N);
+  gsl_vector_complex * eval = gsl_vector_complex_alloc(N);
+  gsl_vector_complex * eval_ms = gsl_vector_complex_alloc(N);
+  gsl_eigen_nonsymm_workspace * w = gsl_eigen_nonsymm_alloc(N);
+  double norm = 0.0;
+  size_t i, j;
+  int s;
+
+  for (i = 0; i < N; ++i)
+    for (j = 0; j < N; ++j)
+      norm = GSL_MAX(norm, fabs(gsl_matrix_get(m, i, j)));
+
+  gsl_matrix_memcpy(A, m);
+  gsl_eigen_nonsymm(A, eval, w);
+
+  gsl_eigen_nonsymm_method(GSL_EIGEN_NONSYMM_MULTISHIFT, w);
+
+  gsl_matrix_memcpy(A, m);
+  s = gsl_eigen_nonsymm(A, eval_ms, w);
+  gsl_test(s, "nonsymm(N=%u,cnt=%u), %s, multishift, status",
+           N, count, desc);
+
+  for (i = 0; i < N; ++i)
+    {
+      gsl_complex zi = gsl_vector_complex_get(eval_ms, i);
+      double dmin = GSL_POSINF;
+
+      for (j = 0; j < N; ++j)
+        {
+          gsl_complex zj = gsl_vector_complex_get(eval, j);
+          double d = gsl_hypot(GSL_REAL(zi) - GSL_REAL(zj),
+                               GSL_IMAG(zi) - GSL_IMAG(zj));
+          dmin = GSL_MIN(dmin, d);
+        }
+
+      gsl_test_abs(dmin, 0.0, 1e4 * N * norm * GSL_DBL_EPSILON,
+                   "nonsymm(N=%u,cnt=%u), %s, multishift, eigenvalue(%d)",
+                   N, count, desc, i);
+    }
+
+  gsl_matrix_free(A);
+  gsl_vector_complex_free(eval);
+  gsl_vector_complex_free(eval_ms);
+  gsl_eigen_nonsymm_free(w);
+}
+
 void
 test_eigen_nonsymm(void)
 {
@@ -759,6 +1240,37 @@ test_eigen_nonsymm(void)
       gsl_eigen_nonsymmv_free(w);
     }
 
+  /* multishift QR algorithm */
+  {
+    const size_t sizes[] = { 80, 121, 200 };
+
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+      {
+        n = sizes[i];
+
+        {
+          gsl_matrix * m = gsl_matrix_alloc(n, n);
+          gsl_eigen_nonsymmv_workspace * w = gsl_eigen_nonsymmv_alloc(n);
+
+          gsl_eigen_nonsymm_method(GSL_EIGEN_NONSYMM_MULTISHIFT,
+                                   w->nonsymm_workspace_p);
+
+          create_random_nonsymm_matrix(m, r, -10, 10);
+
+          gsl_eigen_nonsymmv_params(0, w);
+          test_eigen_nonsymm_matrix(m, i, "random, unbalanced, multishift", w);
+
+          gsl_eigen_nonsymmv_params(1, w);
+          test_eigen_nonsymm_matrix(m, i, "random, balanced, multishift", w);
+
+          test_eigen_nonsymm_multishift(m, i, "random");
+
+          gsl_matrix_free(m);
+          gsl_eigen_nonsymmv_free(w);
+        }
+      }
+  }
+
   gsl_rng_free(r);
 
   {
@@ -1309,6 +1821,9 @@ main()
   gsl_rng_env_setup ();
 
   test_eigen_symm();
+  test_eigen_symmvdc();
+  test_eigen_symmx_diag();
+  test_eigen_symm_batch();
   test_eigen_herm();
   test_eigen_nonsymm();
   test_eigen_gensymm();
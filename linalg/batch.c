@@ -0,0 +1,627 @@
+/* linalg/batch.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <math.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_sys.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_linalg.h>
+
+#include "batch_internal.h"
+
+/*
+ * this module contains routines for factoring and solving batches of
+ * small dense n-by-n systems. The matrices of a batch are stored one
+ * below the other in an (nbatch*n)-by-n matrix, and their right hand
+ * sides, pivots and Householder coefficients one after the other in
+ * vectors of length nbatch*n.
+ *
+ * Each matrix is processed by a kernel which works directly on the
+ * array, without views or permutation objects. For n <= BATCH_MAX_N
+ * there is a separate kernel for each size, with all loop bounds fixed
+ * at compile time.
+ */
+
+/* largest matrix size with a size-specific kernel */
+#define BATCH_MAX_N 16
+
+typedef int (*batch_lu_decomp_fn) (const size_t n, double * A, const size_t lda,
+                                   unsigned int * piv, const size_t pstride);
+typedef int (*batch_lu_svx_fn) (const size_t n, const double * LU, const size_t lda,
+                                const unsigned int * piv, const size_t pstride,
+                                double * x, const size_t stride);
+typedef int (*batch_cholesky_decomp_fn) (const size_t n, double * A, const size_t lda);
+typedef int (*batch_cholesky_svx_fn) (const size_t n, const double * L, const size_t lda,
+                                      double * x, const size_t stride);
+typedef int (*batch_QR_decomp_fn) (const size_t n, double * A, const size_t lda,
+                                   double * tau, const size_t tstride);
+typedef int (*batch_QR_svx_fn) (const size_t n, const double * QR, const size_t lda,
+                                const double * tau, const size_t tstride,
+                                double * x, const size_t stride);
+typedef int (*batch_SV_decomp_fn) (const size_t n, double * A, const size_t lda,
+                                   double * V, const size_t ldv,
+                                   double * S, const size_t sstride);
+
+static double batch_nrm2 (const size_t n, const double * x, const size_t stride);
+
+#define BATCH_N 1
+#define BATCH_SUFFIX 1
+#include "batch_source.c"
+#undef BATCH_N
+#undef BATCH_SUFFIX
+
+#define BATCH_N 2
+#define BATCH_SUFFIX 2
+#include "batch_source.c"
+#undef BATCH_N
+#undef BATCH_SUFFIX
+
+#define BATCH_N 3
+#define BATCH_SUFFIX 3
+#include "batch_source.c"
+#undef BATCH_N
+#undef BATCH_SUFFIX
+
+#define BATCH_N 4
+#define BATCH_SUFFIX 4
+#include "batch_source.c"
+#undef BATCH_N
+#undef BATCH_SUFFIX
+
+#define BATCH_N 5
+#define BATCH_SUFFIX 5
+#include "batch_source.c"
+#undef BATCH_N
+#undef BATCH_SUFFIX
+
+#define BATCH_N 6
+#define BATCH_SUFFIX 6
+#include "batch_source.c"
+#undef BATCH_N
+#undef BATCH_SUFFIX
+
+#define BATCH_N 7
+#define BATCH_SUFFIX 7
+#include "batch_source.c"
+#undef BATCH_N
+#undef BATCH_SUFFIX
+
+#define BATCH_N 8
+#define BATCH_SUFFIX 8
+#include "batch_source.c"
+#undef BATCH_N
+#undef BATCH_SUFFIX
+
+#define BATCH_N 9
+#define BATCH_SUFFIX 9
+#include "batch_source.c"
+#undef BATCH_N
+#undef BATCH_SUFFIX
+
+#define BATCH_N 10
+#define BATCH_SUFFIX 10
+#include "batch_source.c"
+#undef BATCH_N
+#undef BATCH_SUFFIX
+
+#define BATCH_N 11
+#define BATCH_SUFFIX 11
+#include "batch_source.c"
+#undef BATCH_N
+#undef BATCH_SUFFIX
+
+#define BATCH_N 12
+#define BATCH_SUFFIX 12
+#include "batch_source.c"
+#undef BATCH_N
+#undef BATCH_SUFFIX
+
+#define BATCH_N 13
+#define BATCH_SUFFIX 13
+#include "batch_source.c"
+#undef BATCH_N
+#undef BATCH_SUFFIX
+
+#define BATCH_N 14
+#define BATCH_SUFFIX 14
+#include "batch_source.c"
+#undef BATCH_N
+#undef BATCH_SUFFIX
+
+#define BATCH_N 15
+#define BATCH_SUFFIX 15
+#include "batch_source.c"
+#undef BATCH_N
+#undef BATCH_SUFFIX
+
+#define BATCH_N 16
+#define BATCH_SUFFIX 16
+#include "batch_source.c"
+#undef BATCH_N
+#undef BATCH_SUFFIX
+
+#define BATCH_N n
+#define BATCH_SUFFIX n
+#include "batch_source.c"
+#undef BATCH_N
+#undef BATCH_SUFFIX
+
+static const batch_lu_decomp_fn lu_decomp_kernels[BATCH_MAX_N + 1] = {
+  NULL, lu_decomp_1, lu_decomp_2, lu_decomp_3, lu_decomp_4,
+  lu_decomp_5, lu_decomp_6, lu_decomp_7, lu_decomp_8, lu_decomp_9,
+  lu_decomp_10, lu_decomp_11, lu_decomp_12, lu_decomp_13,
+  lu_decomp_14, lu_decomp_15, lu_decomp_16
+};
+
+static const batch_lu_svx_fn lu_svx_kernels[BATCH_MAX_N + 1] = {
+  NULL, lu_svx_1, lu_svx_2, lu_svx_3, lu_svx_4, lu_svx_5, lu_svx_6,
+  lu_svx_7, lu_svx_8, lu_svx_9, lu_svx_10, lu_svx_11, lu_svx_12,
+  lu_svx_13, lu_svx_14, lu_svx_15, lu_svx_16
+};
+
+static const batch_cholesky_decomp_fn cholesky_decomp_kernels[BATCH_MAX_N + 1] = {
+  NULL, cholesky_decomp_1, cholesky_decomp_2, cholesky_decomp_3,
+  cholesky_decomp_4, cholesky_decomp_5, cholesky_decomp_6,
+  cholesky_decomp_7, cholesky_decomp_8, cholesky_decomp_9,
+  cholesky_decomp_10, cholesky_decomp_11, cholesky_decomp_12,
+  cholesky_decomp_13, cholesky_decomp_14, cholesky_decomp_15,
+  cholesky_decomp_16
+};
+
+static const batch_cholesky_svx_fn cholesky_svx_kernels[BATCH_MAX_N + 1] = {
+  NULL, cholesky_svx_1, cholesky_svx_2, cholesky_svx_3,
+  cholesky_svx_4, cholesky_svx_5, cholesky_svx_6, cholesky_svx_7,
+  cholesky_svx_8, cholesky_svx_9, cholesky_svx_10, cholesky_svx_11,
+  cholesky_svx_12, cholesky_svx_13, cholesky_svx_14, cholesky_svx_15,
+  cholesky_svx_16
+};
+
+static const batch_QR_decomp_fn QR_decomp_kernels[BATCH_MAX_N + 1] = {
+  NULL, QR_decomp_1, QR_decomp_2, QR_decomp_3, QR_decomp_4,
+  QR_decomp_5, QR_decomp_6, QR_decomp_7, QR_decomp_8, QR_decomp_9,
+  QR_decomp_10, QR_decomp_11, QR_decomp_12, QR_decomp_13,
+  QR_decomp_14, QR_decomp_15, QR_decomp_16
+};
+
+static const batch_QR_svx_fn QR_svx_kernels[BATCH_MAX_N + 1] = {
+  NULL, QR_svx_1, QR_svx_2, QR_svx_3, QR_svx_4, QR_svx_5, QR_svx_6,
+  QR_svx_7, QR_svx_8, QR_svx_9, QR_svx_10, QR_svx_11, QR_svx_12,
+  QR_svx_13, QR_svx_14, QR_svx_15, QR_svx_16
+};
+
+static const batch_SV_decomp_fn SV_decomp_kernels[BATCH_MAX_N + 1] = {
+  NULL, SV_decomp_1, SV_decomp_2, SV_decomp_3, SV_decomp_4,
+  SV_decomp_5, SV_decomp_6, SV_decomp_7, SV_decomp_8, SV_decomp_9,
+  SV_decomp_10, SV_decomp_11, SV_decomp_12, SV_decomp_13,
+  SV_decomp_14, SV_decomp_15, SV_decomp_16
+};
+
+/*
+gsl_linalg_LU_decomp_batch()
+  LU decomposition with partial pivoting of a batch of n-by-n matrices,
+P_k A_k = L_k U_k
+
+Inputs: A   - (input/output) (nbatch*n)-by-n matrix; rows k*n to
+              k*n+n-1 hold A_k on input and L_k, U_k on output
+        piv - (output) row interchanges, length nbatch*n; row i of A_k
+              was interchanged with row piv[k*n+i], as in
+              gsl_linalg_LU_band_decomp
+
+Return: success/error
+
+Notes: singular matrices are factored without error, and detected by
+gsl_linalg_LU_solve_batch.
+*/
+
+int
+gsl_linalg_LU_decomp_batch (gsl_matrix * A, gsl_vector_uint * piv)
+{
+  size_t nbatch;
+
+  if (batch_check (A, &nbatch))
+    {
+      GSL_ERROR ("number of rows of A must be a multiple of the number of columns",
+                 GSL_EBADLEN);
+    }
+  else if (piv->size != A->size1)
+    {
+      GSL_ERROR ("pivot vector must have length nbatch*n", GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t n = A->size2;
+      const int nthreads = gsl_get_num_threads ();
+      const batch_lu_decomp_fn kernel = BATCH_KERNEL (lu_decomp, n);
+      int k;
+
+#pragma omp parallel for num_threads(nthreads) schedule(static)
+      for (k = 0; k < (int) nbatch; k++)
+        {
+          kernel (n, A->data + k * n * A->tda, A->tda,
+                  piv->data + k * n * piv->stride, piv->stride);
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_linalg_LU_solve_batch()
+  Solve the systems A_k x_k = b_k of a batch of n-by-n matrices, using
+their LU decompositions from gsl_linalg_LU_decomp_batch
+
+Inputs: LU  - (nbatch*n)-by-n matrix of LU decompositions
+        piv - row interchanges, length nbatch*n
+        b   - right hand sides, length nbatch*n
+        x   - (output) solutions, length nbatch*n; may be the same
+              vector as b
+
+Return: success/error; if any of the matrices is singular, GSL_EDOM
+is returned after the other systems have been solved
+*/
+
+int
+gsl_linalg_LU_solve_batch (const gsl_matrix * LU, const gsl_vector_uint * piv,
+                           const gsl_vector * b, gsl_vector * x)
+{
+  size_t nbatch;
+
+  if (batch_check (LU, &nbatch))
+    {
+      GSL_ERROR ("number of rows of LU must be a multiple of the number of columns",
+                 GSL_EBADLEN);
+    }
+  else if (piv->size != LU->size1)
+    {
+      GSL_ERROR ("pivot vector must have length nbatch*n", GSL_EBADLEN);
+    }
+  else if (b->size != LU->size1)
+    {
+      GSL_ERROR ("right hand side vector must have length nbatch*n", GSL_EBADLEN);
+    }
+  else if (x->size != LU->size1)
+    {
+      GSL_ERROR ("solution vector must have length nbatch*n", GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t n = LU->size2;
+      const int nthreads = gsl_get_num_threads ();
+      const batch_lu_svx_fn kernel = BATCH_KERNEL (lu_svx, n);
+      int k, status = 0;
+
+      if (x != b)
+        gsl_vector_memcpy (x, b);
+
+#pragma omp parallel for num_threads(nthreads) schedule(static) reduction(|:status)
+      for (k = 0; k < (int) nbatch; k++)
+        {
+          status |= kernel (n, LU->data + k * n * LU->tda, LU->tda,
+                            piv->data + k * n * piv->stride, piv->stride,
+                            x->data + k * n * x->stride, x->stride);
+        }
+
+      if (status)
+        {
+          GSL_ERROR ("matrix is singular", GSL_EDOM);
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_linalg_cholesky_decomp_batch()
+  Cholesky decomposition of a batch of symmetric positive definite
+n-by-n matrices, A_k = L_k L_k^T
+
+Inputs: A - (input/output) (nbatch*n)-by-n matrix; on input, the lower
+            triangles of rows k*n to k*n+n-1 hold A_k, and on output
+            they hold L_k. The upper triangles are not referenced.
+
+Return: success/error; if any of the matrices is not positive definite,
+GSL_EDOM is returned after the others have been factored
+*/
+
+int
+gsl_linalg_cholesky_decomp_batch (gsl_matrix * A)
+{
+  size_t nbatch;
+
+  if (batch_check (A, &nbatch))
+    {
+      GSL_ERROR ("number of rows of A must be a multiple of the number of columns",
+                 GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t n = A->size2;
+      const int nthreads = gsl_get_num_threads ();
+      const batch_cholesky_decomp_fn kernel = BATCH_KERNEL (cholesky_decomp, n);
+      int k, status = 0;
+
+#pragma omp parallel for num_threads(nthreads) schedule(static) reduction(|:status)
+      for (k = 0; k < (int) nbatch; k++)
+        {
+          status |= kernel (n, A->data + k * n * A->tda, A->tda);
+        }
+
+      if (status)
+        {
+          GSL_ERROR ("matrix is not positive definite", GSL_EDOM);
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_linalg_cholesky_solve_batch()
+  Solve the systems A_k x_k = b_k of a batch of n-by-n matrices, using
+their Cholesky decompositions from gsl_linalg_cholesky_decomp_batch
+
+Inputs: LLT - (nbatch*n)-by-n matrix of Cholesky factors
+        b   - right hand sides, length nbatch*n
+        x   - (output) solutions, length nbatch*n; may be the same
+              vector as b
+
+Return: success/error
+*/
+
+int
+gsl_linalg_cholesky_solve_batch (const gsl_matrix * LLT, const gsl_vector * b,
+                                 gsl_vector * x)
+{
+  size_t nbatch;
+
+  if (batch_check (LLT, &nbatch))
+    {
+      GSL_ERROR ("number of rows of LLT must be a multiple of the number of columns",
+                 GSL_EBADLEN);
+    }
+  else if (b->size != LLT->size1)
+    {
+      GSL_ERROR ("right hand side vector must have length nbatch*n", GSL_EBADLEN);
+    }
+  else if (x->size != LLT->size1)
+    {
+      GSL_ERROR ("solution vector must have length nbatch*n", GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t n = LLT->size2;
+      const int nthreads = gsl_get_num_threads ();
+      const batch_cholesky_svx_fn kernel = BATCH_KERNEL (cholesky_svx, n);
+      int k;
+
+      if (x != b)
+        gsl_vector_memcpy (x, b);
+
+#pragma omp parallel for num_threads(nthreads) schedule(static)
+      for (k = 0; k < (int) nbatch; k++)
+        {
+          kernel (n, LLT->data + k * n * LLT->tda, LLT->tda,
+                  x->data + k * n * x->stride, x->stride);
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_linalg_QR_decomp_batch()
+  QR decomposition of a batch of n-by-n matrices, A_k = Q_k R_k
+
+Inputs: A   - (input/output) (nbatch*n)-by-n matrix; rows k*n to
+              k*n+n-1 hold A_k on input, and Q_k and R_k on output in
+              the format of gsl_linalg_QR_decomp
+        tau - (output) Householder coefficients, length nbatch*n
+
+Return: success/error
+*/
+
+int
+gsl_linalg_QR_decomp_batch (gsl_matrix * A, gsl_vector * tau)
+{
+  size_t nbatch;
+
+  if (batch_check (A, &nbatch))
+    {
+      GSL_ERROR ("number of rows of A must be a multiple of the number of columns",
+                 GSL_EBADLEN);
+    }
+  else if (tau->size != A->size1)
+    {
+      GSL_ERROR ("tau vector must have length nbatch*n", GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t n = A->size2;
+      const int nthreads = gsl_get_num_threads ();
+      const batch_QR_decomp_fn kernel = BATCH_KERNEL (QR_decomp, n);
+      int k;
+
+#pragma omp parallel for num_threads(nthreads) schedule(static)
+      for (k = 0; k < (int) nbatch; k++)
+        {
+          kernel (n, A->data + k * n * A->tda, A->tda,
+                  tau->data + k * n * tau->stride, tau->stride);
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_linalg_QR_solve_batch()
+  Solve the systems A_k x_k = b_k of a batch of n-by-n matrices, using
+their QR decompositions from gsl_linalg_QR_decomp_batch
+
+Inputs: QR  - (nbatch*n)-by-n matrix of QR decompositions
+        tau - Householder coefficients, length nbatch*n
+        b   - right hand sides, length nbatch*n
+        x   - (output) solutions, length nbatch*n; may be the same
+              vector as b
+
+Return: success/error; if any of the matrices is singular, GSL_EDOM
+is returned after the other systems have been solved
+*/
+
+int
+gsl_linalg_QR_solve_batch (const gsl_matrix * QR, const gsl_vector * tau,
+                           const gsl_vector * b, gsl_vector * x)
+{
+  size_t nbatch;
+
+  if (batch_check (QR, &nbatch))
+    {
+      GSL_ERROR ("number of rows of QR must be a multiple of the number of columns",
+                 GSL_EBADLEN);
+    }
+  else if (tau->size != QR->size1)
+    {
+      GSL_ERROR ("tau vector must have length nbatch*n", GSL_EBADLEN);
+    }
+  else if (b->size != QR->size1)
+    {
+      GSL_ERROR ("right hand side vector must have length nbatch*n", GSL_EBADLEN);
+    }
+  else if (x->size != QR->size1)
+    {
+      GSL_ERROR ("solution vector must have length nbatch*n", GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t n = QR->size2;
+      const int nthreads = gsl_get_num_threads ();
+      const batch_QR_svx_fn kernel = BATCH_KERNEL (QR_svx, n);
+      int k, status = 0;
+
+      if (x != b)
+        gsl_vector_memcpy (x, b);
+
+#pragma omp parallel for num_threads(nthreads) schedule(static) reduction(|:status)
+      for (k = 0; k < (int) nbatch; k++)
+        {
+          status |= kernel (n, QR->data + k * n * QR->tda, QR->tda,
+                            tau->data + k * n * tau->stride, tau->stride,
+                            x->data + k * n * x->stride, x->stride);
+        }
+
+      if (status)
+        {
+          GSL_ERROR ("matrix is singular", GSL_EDOM);
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_linalg_SV_decomp_batch()
+  Singular value decomposition of a batch of n-by-n matrices,
+A_k = U_k S_k V_k^T, by one-sided Jacobi orthogonalization
+
+Inputs: A - (input/output) (nbatch*n)-by-n matrix; rows k*n to k*n+n-1
+            hold A_k on input and U_k on output
+        V - (output) (nbatch*n)-by-n matrix of the V_k
+        S - (output) singular values, length nbatch*n; elements k*n to
+            k*n+n-1 hold those of A_k in decreasing order
+
+Return: success/error
+
+Notes: each matrix is decomposed as by gsl_linalg_SV_decomp_jacobi,
+which computes small singular values to high relative accuracy.
+*/
+
+int
+gsl_linalg_SV_decomp_batch (gsl_matrix * A, gsl_matrix * V, gsl_vector * S)
+{
+  size_t nbatch;
+
+  if (batch_check (A, &nbatch))
+    {
+      GSL_ERROR ("number of rows of A must be a multiple of the number of columns",
+                 GSL_EBADLEN);
+    }
+  else if (V->size1 != A->size1 || V->size2 != A->size2)
+    {
+      GSL_ERROR ("matrix V must be the same size as A", GSL_EBADLEN);
+    }
+  else if (S->size != A->size1)
+    {
+      GSL_ERROR ("vector S must have length nbatch*n", GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t n = A->size2;
+      const int nthreads = gsl_get_num_threads ();
+      const batch_SV_decomp_fn kernel = BATCH_KERNEL (SV_decomp, n);
+      int k, status = 0;
+
+#pragma omp parallel for num_threads(nthreads) schedule(static) reduction(|:status)
+      for (k = 0; k < (int) nbatch; k++)
+        {
+          status |= kernel (n, A->data + k * n * A->tda, A->tda,
+                            V->data + k * n * V->tda, V->tda,
+                            S->data + k * n * S->stride, S->stride);
+        }
+
+      if (status)
+        {
+          GSL_ERROR ("Jacobi iterations did not reach desired tolerance",
+                     GSL_ETOL);
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/* Euclidean norm of x, scaled to avoid overflow as in dnrm2 */
+
+static double
+batch_nrm2 (const size_t n, const double * x, const size_t stride)
+{
+  double scale = 0.0, ssq = 1.0;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      const double xi = x[i * stride];
+
+      if (xi != 0.0)
+        {
+          const double ax = fabs (xi);
+
+          if (scale < ax)
+            {
+              ssq = 1.0 + ssq * (scale / ax) * (scale / ax);
+              scale = ax;
+            }
+          else
+            {
+              ssq += (ax / scale) * (ax / scale);
+            }
+        }
+    }
+
+  return scale * sqrt (ssq);
+}
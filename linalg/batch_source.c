@@ -0,0 +1,453 @@
+/* linalg/batch_source.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/*
+ * kernels for one small n-by-n matrix, included by batch.c once for each
+ * size BATCH_N = 1, ..., BATCH_MAX_N, so that all loop bounds are known
+ * at compile time, and once with BATCH_N = n for larger matrices.
+ *
+ * A matrix is stored with row stride lda, and a vector with stride
+ * stride. The functions return 0 on success and 1 if the matrix is
+ * singular or not positive definite.
+ */
+
+/* LU decomposition with partial pivoting, as in LU_decomp_L2 */
+
+static int
+FUNCTION (lu_decomp) (const size_t n, double * A, const size_t lda,
+                      unsigned int * piv, const size_t pstride)
+{
+  size_t i, j, k;
+
+  (void) n;
+
+  for (j = 0; j < BATCH_N; j++)
+    {
+      size_t p = j;
+      double amax = fabs (A[j * lda + j]);
+      double ajj;
+
+      for (i = j + 1; i < BATCH_N; i++)
+        {
+          const double aij = fabs (A[i * lda + j]);
+
+          if (aij > amax)
+            {
+              amax = aij;
+              p = i;
+            }
+        }
+
+      piv[j * pstride] = (unsigned int) p;
+
+      if (p != j)
+        {
+          for (k = 0; k < BATCH_N; k++)
+            {
+              const double tmp = A[j * lda + k];
+              A[j * lda + k] = A[p * lda + k];
+              A[p * lda + k] = tmp;
+            }
+        }
+
+      ajj = A[j * lda + j];
+      if (ajj == 0.0)
+        continue;
+
+      for (i = j + 1; i < BATCH_N; i++)
+        {
+          const double lij = A[i * lda + j] / ajj;
+
+          A[i * lda + j] = lij;
+
+          for (k = j + 1; k < BATCH_N; k++)
+            A[i * lda + k] -= lij * A[j * lda + k];
+        }
+    }
+
+  return 0;
+}
+
+/* solve A x = b in place with the factors of FUNCTION(lu_decomp) */
+
+static int
+FUNCTION (lu_svx) (const size_t n, const double * LU, const size_t lda,
+                   const unsigned int * piv, const size_t pstride,
+                   double * x, const size_t stride)
+{
+  size_t i, j;
+
+  (void) n;
+
+  for (i = 0; i < BATCH_N; i++)
+    {
+      if (LU[i * lda + i] == 0.0)
+        return 1;
+    }
+
+  /* x = P b */
+  for (i = 0; i < BATCH_N; i++)
+    {
+      const size_t p = piv[i * pstride];
+
+      if (p != i)
+        {
+          const double tmp = x[i * stride];
+          x[i * stride] = x[p * stride];
+          x[p * stride] = tmp;
+        }
+    }
+
+  /* x = L^{-1} x */
+  for (i = 1; i < BATCH_N; i++)
+    {
+      double sum = x[i * stride];
+
+      for (j = 0; j < i; j++)
+        sum -= LU[i * lda + j] * x[j * stride];
+
+      x[i * stride] = sum;
+    }
+
+  /* x = U^{-1} x */
+  for (i = BATCH_N; i-- > 0; )
+    {
+      double sum = x[i * stride];
+
+      for (j = i + 1; j < BATCH_N; j++)
+        sum -= LU[i * lda + j] * x[j * stride];
+
+      x[i * stride] = sum / LU[i * lda + i];
+    }
+
+  return 0;
+}
+
+/* Cholesky decomposition A = L L^T, with L in the lower triangle */
+
+static int
+FUNCTION (cholesky_decomp) (const size_t n, double * A, const size_t lda)
+{
+  size_t i, j, k;
+
+  (void) n;
+
+  for (j = 0; j < BATCH_N; j++)
+    {
+      double ajj = A[j * lda + j];
+
+      if (ajj <= 0.0)
+        return 1;
+
+      ajj = sqrt (ajj);
+      A[j * lda + j] = ajj;
+
+      for (i = j + 1; i < BATCH_N; i++)
+        A[i * lda + j] /= ajj;
+
+      /* update the lower triangle of the trailing matrix */
+      for (i = j + 1; i < BATCH_N; i++)
+        {
+          const double lij = A[i * lda + j];
+
+          for (k = j + 1; k <= i; k++)
+            A[i * lda + k] -= lij * A[k * lda + j];
+        }
+    }
+
+  return 0;
+}
+
+/* solve A x = b in place with the factor of FUNCTION(cholesky_decomp) */
+
+static int
+FUNCTION (cholesky_svx) (const size_t n, const double * L, const size_t lda,
+                         double * x, const size_t stride)
+{
+  size_t i, j;
+
+  (void) n;
+
+  /* x = L^{-1} x */
+  for (i = 0; i < BATCH_N; i++)
+    {
+      double sum = x[i * stride];
+
+      for (j = 0; j < i; j++)
+        sum -= L[i * lda + j] * x[j * stride];
+
+      x[i * stride] = sum / L[i * lda + i];
+    }
+
+  /* x = L^{-T} x */
+  for (i = BATCH_N; i-- > 0; )
+    {
+      double sum = x[i * stride];
+
+      for (j = i + 1; j < BATCH_N; j++)
+        sum -= L[j * lda + i] * x[j * stride];
+
+      x[i * stride] = sum / L[i * lda + i];
+    }
+
+  return 0;
+}
+
+/*
+ * QR decomposition with Householder reflections, in the format of
+ * gsl_linalg_QR_decomp: R in the upper triangle, the Householder vectors
+ * below the diagonal and their coefficients in tau
+ */
+
+static int
+FUNCTION (QR_decomp) (const size_t n, double * A, const size_t lda,
+                      double * tau, const size_t tstride)
+{
+  size_t i, j, k;
+
+  (void) n;
+
+  for (j = 0; j < BATCH_N; j++)
+    {
+      const double alpha = A[j * lda + j];
+      double scale = 0.0, ssq = 0.0;
+      double xnorm, beta, t, s;
+
+      /* xnorm = || A(j+1:n-1,j) ||, scaled against overflow */
+      for (i = j + 1; i < BATCH_N; i++)
+        scale = GSL_MAX (scale, fabs (A[i * lda + j]));
+
+      if (scale == 0.0)
+        {
+          tau[j * tstride] = 0.0;
+          continue;
+        }
+
+      for (i = j + 1; i < BATCH_N; i++)
+        {
+          const double aij = A[i * lda + j] / scale;
+          ssq += aij * aij;
+        }
+
+      xnorm = scale * sqrt (ssq);
+
+      beta = -GSL_SIGN (alpha) * gsl_hypot (alpha, xnorm);
+      t = (beta - alpha) / beta;
+      s = 1.0 / (alpha - beta);
+
+      for (i = j + 1; i < BATCH_N; i++)
+        A[i * lda + j] *= s;
+
+      A[j * lda + j] = beta;
+      tau[j * tstride] = t;
+
+      /* apply H = I - tau v v^T to the columns to the right */
+      for (k = j + 1; k < BATCH_N; k++)
+        {
+          double w = A[j * lda + k];
+
+          for (i = j + 1; i < BATCH_N; i++)
+            w += A[i * lda + j] * A[i * lda + k];
+
+          w *= t;
+          A[j * lda + k] -= w;
+
+          for (i = j + 1; i < BATCH_N; i++)
+            A[i * lda + k] -= w * A[i * lda + j];
+        }
+    }
+
+  return 0;
+}
+
+/* solve A x = b in place with the factors of FUNCTION(QR_decomp) */
+
+static int
+FUNCTION (QR_svx) (const size_t n, const double * QR, const size_t lda,
+                   const double * tau, const size_t tstride,
+                   double * x, const size_t stride)
+{
+  size_t i, j;
+
+  (void) n;
+
+  for (i = 0; i < BATCH_N; i++)
+    {
+      if (QR[i * lda + i] == 0.0)
+        return 1;
+    }
+
+  /* x = Q^T x */
+  for (j = 0; j < BATCH_N; j++)
+    {
+      double w = x[j * stride];
+
+      for (i = j + 1; i < BATCH_N; i++)
+        w += QR[i * lda + j] * x[i * stride];
+
+      w *= tau[j * tstride];
+      x[j * stride] -= w;
+
+      for (i = j + 1; i < BATCH_N; i++)
+        x[i * stride] -= w * QR[i * lda + j];
+    }
+
+  /* x = R^{-1} x */
+  for (i = BATCH_N; i-- > 0; )
+    {
+      double sum = x[i * stride];
+
+      for (j = i + 1; j < BATCH_N; j++)
+        sum -= QR[i * lda + j] * x[j * stride];
+
+      x[i * stride] = sum / QR[i * lda + i];
+    }
+
+  return 0;
+}
+
+/* singular value decomposition A = U S V^T by one-sided Jacobi
+ * orthogonalization, as in gsl_linalg_SV_decomp_jacobi; A is replaced
+ * by U, and the singular values are in decreasing order. The return
+ * value is 1 if the sweep limit was reached */
+
+static int
+FUNCTION (SV_decomp) (const size_t n, double * A, const size_t lda,
+                      double * V, const size_t ldv,
+                      double * S, const size_t sstride)
+{
+  const double tolerance = 10.0 * BATCH_N * GSL_DBL_EPSILON;
+  const size_t sweepmax = GSL_MAX (5 * BATCH_N, 12);
+  size_t count = 1, sweep = 0;
+  size_t i, j, k;
+
+  (void) n;
+
+  for (i = 0; i < BATCH_N; i++)
+    {
+      for (j = 0; j < BATCH_N; j++)
+        V[i * ldv + j] = (i == j) ? 1.0 : 0.0;
+    }
+
+  /* column error estimates */
+  for (j = 0; j < BATCH_N; j++)
+    S[j * sstride] = GSL_DBL_EPSILON * batch_nrm2 (BATCH_N, A + j, lda);
+
+  while (count > 0 && sweep <= sweepmax)
+    {
+      count = BATCH_N * (BATCH_N - 1) / 2;
+
+      for (j = 0; j + 1 < BATCH_N; j++)
+        {
+          for (k = j + 1; k < BATCH_N; k++)
+            {
+              double p = 0.0, q, v, a, b, cosine, sine;
+              const double abserr_a = S[j * sstride];
+              const double abserr_b = S[k * sstride];
+              int sorted, orthog, noisya, noisyb;
+
+              for (i = 0; i < BATCH_N; i++)
+                p += A[i * lda + j] * A[i * lda + k];
+
+              p *= 2.0;
+
+              a = batch_nrm2 (BATCH_N, A + j, lda);
+              b = batch_nrm2 (BATCH_N, A + k, lda);
+
+              q = a * a - b * b;
+              v = hypot (p, q);
+
+              sorted = (GSL_COERCE_DBL (a) >= GSL_COERCE_DBL (b));
+              orthog = (fabs (p) <= tolerance * GSL_COERCE_DBL (a * b));
+              noisya = (a < abserr_a);
+              noisyb = (b < abserr_b);
+
+              if (sorted && (orthog || noisya || noisyb))
+                {
+                  count--;
+                  continue;
+                }
+
+              if (v == 0 || !sorted)
+                {
+                  cosine = 0.0;
+                  sine = 1.0;
+                }
+              else
+                {
+                  cosine = sqrt ((v + q) / (2.0 * v));
+                  sine = p / (2.0 * v * cosine);
+                }
+
+              for (i = 0; i < BATCH_N; i++)
+                {
+                  const double aij = A[i * lda + j];
+                  const double aik = A[i * lda + k];
+
+                  A[i * lda + j] = aij * cosine + aik * sine;
+                  A[i * lda + k] = -aij * sine + aik * cosine;
+                }
+
+              S[j * sstride] = fabs (cosine) * abserr_a + fabs (sine) * abserr_b;
+              S[k * sstride] = fabs (sine) * abserr_a + fabs (cosine) * abserr_b;
+
+              for (i = 0; i < BATCH_N; i++)
+                {
+                  const double vij = V[i * ldv + j];
+                  const double vik = V[i * ldv + k];
+
+                  V[i * ldv + j] = vij * cosine + vik * sine;
+                  V[i * ldv + k] = -vij * sine + vik * cosine;
+                }
+            }
+        }
+
+      sweep++;
+    }
+
+  /* singular values and normalized columns */
+  {
+    double prev_norm = -1.0;
+
+    for (j = 0; j < BATCH_N; j++)
+      {
+        const double norm = batch_nrm2 (BATCH_N, A + j, lda);
+
+        if (norm == 0.0 || prev_norm == 0.0 ||
+            (j > 0 && norm <= tolerance * prev_norm))
+          {
+            S[j * sstride] = 0.0;
+
+            for (i = 0; i < BATCH_N; i++)
+              A[i * lda + j] = 0.0;
+
+            prev_norm = 0.0;
+          }
+        else
+          {
+            S[j * sstride] = norm;
+
+            for (i = 0; i < BATCH_N; i++)
+              A[i * lda + j] /= norm;
+
+            prev_norm = norm;
+          }
+      }
+  }
+
+  return (count > 0);
+}
@@ -0,0 +1,421 @@
+/* linalg/benchmark.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Throughput of the dense BLAS and linear algebra routines.
+ *
+ * Usage: benchmark [-j] [-n N1,N2,...] [-t SECONDS] [ROUTINE...]
+ *
+ * Each routine is run on random n-by-n matrices for each size n, and
+ * repeated until at least SECONDS (default 0.2) have elapsed.  The
+ * fastest call is reported as one line of CSV per routine and size,
+ * or as a JSON array with -j, giving the number of threads of the
+ * level 3 CBLAS routines, the time in seconds, the rate in GFLOP/s and
+ * the GSL error message of the routine ("success" unless it failed, in
+ * which case the time and rate are left empty).  The thread count is
+ * only known for the bundled libgslcblas and is 0 for other libraries.
+ *
+ * The rates use the conventional operation counts of the LAPACK
+ * benchmarks.  For the SV_decomp routines and eigen_symmv, whose cost
+ * depends on the convergence of the iterations, they are nominal counts
+ * which are only meaningful for comparing runs with each other.
+ *
+ * The program is built with "make benchmark".  It links with the
+ * bundled libgslcblas by default, and with another CBLAS library
+ * given on the command line, for example
+ *
+ *   make benchmark BENCHMARK_CBLAS=-lopenblas BENCHMARK_GSLCBLAS= */
+
+#include <config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_eigen.h>
+
+#ifdef HAVE_GSLCBLAS
+#include <gsl/gsl_cblas.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#else
+#include <sys/time.h>
+#endif
+
+typedef struct
+{
+  gsl_matrix *A;                /* input, restored before each call */
+  gsl_matrix *B;                /* second operand or right hand side */
+  gsl_matrix *C;                /* output */
+  gsl_matrix *W;                /* working copy of A */
+  gsl_vector *x;
+  gsl_vector *y;
+  gsl_permutation *p;
+  gsl_eigen_symmv_workspace *eigen;
+} bench_data;
+
+/* the operation count of a routine is coeff * n^3, or coeff * n^2 for
+   dgemv */
+
+typedef struct
+{
+  const char *name;
+  double coeff;
+  int power;
+  int (*run) (bench_data * d);
+  int copy;                     /* restore W from A before each call */
+} bench_type;
+
+static int
+run_dgemm (bench_data * d)
+{
+  return gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, d->A, d->B,
+                         0.0, d->C);
+}
+
+static int
+run_dsyrk (bench_data * d)
+{
+  return gsl_blas_dsyrk (CblasLower, CblasNoTrans, 1.0, d->A, 0.0, d->C);
+}
+
+static int
+run_dtrsm (bench_data * d)
+{
+  /* the triangle of the SPD matrix B is well conditioned */
+  return gsl_blas_dtrsm (CblasLeft, CblasLower, CblasNoTrans, CblasNonUnit,
+                         1.0, d->B, d->W);
+}
+
+static int
+run_dgemv (bench_data * d)
+{
+  return gsl_blas_dgemv (CblasNoTrans, 1.0, d->A, d->x, 0.0, d->y);
+}
+
+static int
+run_lu (bench_data * d)
+{
+  int signum;
+  return gsl_linalg_LU_decomp (d->W, d->p, &signum);
+}
+
+static int
+run_cholesky (bench_data * d)
+{
+  return gsl_linalg_cholesky_decomp1 (d->W);
+}
+
+static int
+run_qr (bench_data * d)
+{
+  return gsl_linalg_QR_decomp_r (d->W, d->C);
+}
+
+static int
+run_svd (bench_data * d)
+{
+  return gsl_linalg_SV_decomp (d->W, d->C, d->x, d->y);
+}
+
+static int
+run_svd_dc (bench_data * d)
+{
+  return gsl_linalg_SV_decomp_dc (d->W, d->C, d->x);
+}
+
+static int
+run_svd_jacobi (bench_data * d)
+{
+  return gsl_linalg_SV_decomp_jacobi (d->W, d->C, d->x);
+}
+
+static int
+run_svd_jacobi_par (bench_data * d)
+{
+  return gsl_linalg_SV_decomp_jacobi_par (d->W, d->C, d->x, NULL);
+}
+
+static int
+run_eigen (bench_data * d)
+{
+  /* symmetric part of A, restored by the copy */
+  return gsl_eigen_symmv (d->W, d->x, d->C, d->eigen);
+}
+
+static const bench_type bench_types[] = {
+  { "dgemm", 2.0, 3, run_dgemm, 0 },
+  { "dsyrk", 1.0, 3, run_dsyrk, 0 },
+  { "dtrsm", 1.0, 3, run_dtrsm, 1 },
+  { "dgemv", 2.0, 2, run_dgemv, 0 },
+  { "LU_decomp", 2.0 / 3.0, 3, run_lu, 1 },
+  { "cholesky_decomp1", 1.0 / 3.0, 3, run_cholesky, 1 },
+  { "QR_decomp_r", 4.0 / 3.0, 3, run_qr, 1 },
+  { "SV_decomp", 12.0, 3, run_svd, 1 },
+  { "SV_decomp_dc", 12.0, 3, run_svd_dc, 1 },
+  { "SV_decomp_jacobi", 12.0, 3, run_svd_jacobi, 1 },
+  { "SV_decomp_jacobi_par", 12.0, 3, run_svd_jacobi_par, 1 },
+  { "eigen_symmv", 9.0, 3, run_eigen, 1 },
+  { NULL, 0.0, 0, NULL, 0 }
+};
+
+/* elapsed time in seconds; clock() would give the processor time,
+   which adds up over the threads of a parallel routine */
+static double
+wall_time (void)
+{
+#ifdef _OPENMP
+  return omp_get_wtime ();
+#else
+  struct timeval tv;
+
+  gettimeofday (&tv, NULL);
+
+  return (double) tv.tv_sec + 1.0e-6 * (double) tv.tv_usec;
+#endif
+}
+
+static bench_data *
+bench_alloc (const size_t n, const char *name, gsl_rng * r)
+{
+  bench_data *d = calloc (1, sizeof (bench_data));
+  size_t i, j;
+
+  d->A = gsl_matrix_alloc (n, n);
+  d->B = gsl_matrix_alloc (n, n);
+  d->C = gsl_matrix_alloc (n, n);
+  d->W = gsl_matrix_alloc (n, n);
+  d->x = gsl_vector_alloc (n);
+  d->y = gsl_vector_alloc (n);
+  d->p = gsl_permutation_alloc (n);
+
+  /* A is symmetric for the symmetric routines, and B is symmetric
+     positive definite */
+
+  for (i = 0; i < n; i++)
+    {
+      for (j = 0; j <= i; j++)
+        {
+          const double a = gsl_rng_uniform (r) - 0.5;
+          const double aij = gsl_rng_uniform (r) - 0.5;
+          const double b = gsl_rng_uniform (r) - 0.5;
+
+          gsl_matrix_set (d->A, i, j, a);
+          gsl_matrix_set (d->A, j, i, (strcmp (name, "eigen_symmv") == 0) ? a : aij);
+          gsl_matrix_set (d->B, i, j, b);
+          gsl_matrix_set (d->B, j, i, b);
+        }
+
+      *gsl_matrix_ptr (d->B, i, i) += n;
+      gsl_vector_set (d->x, i, gsl_rng_uniform (r) - 0.5);
+    }
+
+  if (strcmp (name, "cholesky_decomp1") == 0)
+    gsl_matrix_memcpy (d->A, d->B);
+
+  if (strcmp (name, "eigen_symmv") == 0)
+    d->eigen = gsl_eigen_symmv_alloc (n);
+
+  return d;
+}
+
+static void
+bench_free (bench_data * d)
+{
+  gsl_matrix_free (d->A);
+  gsl_matrix_free (d->B);
+  gsl_matrix_free (d->C);
+  gsl_matrix_free (d->W);
+  gsl_vector_free (d->x);
+  gsl_vector_free (d->y);
+  gsl_permutation_free (d->p);
+
+  if (d->eigen)
+    gsl_eigen_symmv_free (d->eigen);
+
+  free (d);
+}
+
+/* stores in time the time of the fastest of the calls made in min_time
+   seconds, and returns the status of the first call that fails */
+
+static int
+bench_run (const bench_type * t, bench_data * d, const double min_time,
+           double * time)
+{
+  double best = GSL_POSINF, total = 0.0;
+
+  do
+    {
+      double t0, t1;
+      int status;
+
+      if (t->copy)
+        gsl_matrix_memcpy (d->W, d->A);
+
+      t0 = wall_time ();
+      status = t->run (d);
+      t1 = wall_time ();
+
+      if (status)
+        return status;
+
+      best = GSL_MIN (best, t1 - t0);
+      total += t1 - t0;
+    }
+  while (total < min_time);
+
+  *time = best;
+
+  return GSL_SUCCESS;
+}
+
+/* number of threads of the level 3 CBLAS routines, 0 when another
+   CBLAS library is linked */
+
+static int
+cblas_threads (void)
+{
+#ifdef HAVE_GSLCBLAS
+  return gsl_cblas_get_num_threads ();
+#else
+  return 0;
+#endif
+}
+
+static int
+selected (const char *name, int argc, char *argv[], int first)
+{
+  int i;
+
+  if (first >= argc)
+    return 1;
+
+  for (i = first; i < argc; i++)
+    {
+      if (strcmp (argv[i], name) == 0)
+        return 1;
+    }
+
+  return 0;
+}
+
+int
+main (int argc, char *argv[])
+{
+  static const char default_sizes[] = "100,200,400";
+  const char *sizes = default_sizes;
+  double min_time = 0.2;
+  int json = 0, first = 1, nout = 0;
+  const int nthreads = cblas_threads ();
+  const bench_type *t;
+  gsl_rng *r;
+
+  while (first < argc && argv[first][0] == '-')
+    {
+      if (strcmp (argv[first], "-j") == 0)
+        {
+          json = 1;
+          first++;
+        }
+      else if (strcmp (argv[first], "-n") == 0 && first + 1 < argc)
+        {
+          sizes = argv[first + 1];
+          first += 2;
+        }
+      else if (strcmp (argv[first], "-t") == 0 && first + 1 < argc)
+        {
+          min_time = atof (argv[first + 1]);
+          first += 2;
+        }
+      else
+        {
+          fprintf (stderr, "usage: %s [-j] [-n N1,N2,...] [-t SECONDS] [ROUTINE...]\n",
+                   argv[0]);
+          return EXIT_FAILURE;
+        }
+    }
+
+  gsl_set_error_handler_off ();
+  r = gsl_rng_alloc (gsl_rng_default);
+
+  if (json)
+    printf ("[\n");
+  else
+    printf ("routine,n,threads,time,gflops,status\n");
+
+  for (t = bench_types; t->name != NULL; t++)
+    {
+      const char *s = sizes;
+
+      if (!selected (t->name, argc, argv, first))
+        continue;
+
+      while (*s != '\0')
+        {
+          char *end;
+          const long n = strtol (s, &end, 10);
+
+          if (end == s)
+            break;
+
+          if (n > 0)
+            {
+              bench_data *d = bench_alloc (n, t->name, r);
+              const double flops = t->coeff * gsl_pow_int ((double) n, t->power);
+              double time = 0.0;
+              const int status = bench_run (t, d, min_time, &time);
+
+              if (json)
+                printf ("%s  {\"routine\": \"%s\", \"n\": %ld, \"threads\": %d, ",
+                        nout ? ",\n" : "", t->name, n, nthreads);
+              else
+                printf ("%s,%ld,%d,", t->name, n, nthreads);
+
+              if (status)
+                printf (json ? "\"time\": null, \"gflops\": null, " : ",,");
+              else if (json)
+                printf ("\"time\": %.6e, \"gflops\": %.4f, ", time,
+                        flops / time * 1.0e-9);
+              else
+                printf ("%.6e,%.4f,", time, flops / time * 1.0e-9);
+
+              if (json)
+                printf ("\"status\": \"%s\"}", gsl_strerror (status));
+              else
+                printf ("%s\n", gsl_strerror (status));
+
+              fflush (stdout);
+              bench_free (d);
+              nout++;
+            }
+
+          s = (*end == ',') ? end + 1 : end;
+        }
+    }
+
+  if (json)
+    printf ("%s]\n", nout ? "\n" : "");
+
+  gsl_rng_free (r);
+
+  return EXIT_SUCCESS;
+}
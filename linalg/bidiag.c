@@ -71,6 +71,34 @@
 
 #include <gsl/gsl_linalg.h>
 
+/* block size and crossover point of the blocked algorithm: the
+   trailing matrix is reduced with the unblocked algorithm once it has
+   at most BIDIAG_CROSSOVER columns */
+#define BIDIAG_BLOCK      32
+#define BIDIAG_CROSSOVER  64
+
+static int bidiag_decomp_L2 (gsl_matrix * A, gsl_vector * tau_U, gsl_vector * tau_V);
+static int bidiag_panel (gsl_matrix * A, gsl_vector * tau_U, gsl_vector * tau_V,
+                         gsl_vector * d, gsl_vector * e, gsl_matrix * Xt, gsl_matrix * Yt);
+
+/*
+gsl_linalg_bidiag_decomp()
+  Blocked bidiagonalization, as in LAPACK DGEBRD
+
+The reflectors of a panel of BIDIAG_BLOCK rows and columns are
+computed with the trailing matrix updated only implicitly,
+accumulating the matrices X and Y such that the updated trailing
+matrix is
+
+A22 - V Y^T - X U^T
+
+where the columns of V and rows of U are the left and right
+Householder vectors of the panel.  The trailing matrix is then
+formed with two calls to dgemm, so that half of the operations are
+in level 3 BLAS.  The reflectors and tau are the same as for the
+unblocked algorithm.
+*/
+
 int 
 gsl_linalg_bidiag_decomp (gsl_matrix * A, gsl_vector * tau_U, gsl_vector * tau_V)  
 {
@@ -86,56 +114,259 @@ gsl_linalg_bidiag_decomp (gsl_matrix * A, gsl_vector * tau_U, gsl_vector * tau_V
     {
       GSL_ERROR ("size of tau_V must be (N - 1)", GSL_EBADLEN);
     }
+  else if (A->size2 <= BIDIAG_CROSSOVER)
+    {
+      return bidiag_decomp_L2 (A, tau_U, tau_V);
+    }
   else
     {
       const size_t M = A->size1;
       const size_t N = A->size2;
-      gsl_vector * tmp = gsl_vector_alloc(M);
-      size_t j;
-  
-      for (j = 0 ; j < N; j++)
+      const size_t nb = BIDIAG_BLOCK;
+      gsl_matrix * Xt = gsl_matrix_alloc (nb, M);
+      gsl_matrix * Yt = gsl_matrix_alloc (nb, N);
+      double d_data[BIDIAG_BLOCK], e_data[BIDIAG_BLOCK];
+      gsl_vector_view d = gsl_vector_view_array (d_data, nb);
+      gsl_vector_view e = gsl_vector_view_array (e_data, nb);
+      gsl_matrix_view m;
+      gsl_vector_view tu, tv;
+      size_t j, k;
+
+      if (Xt == NULL || Yt == NULL)
         {
-          /* apply Householder transformation to current column */
-          gsl_vector_view v = gsl_matrix_subcolumn(A, j, j, M - j);
-          double tau_j = gsl_linalg_householder_transform (&v.vector);
+          if (Xt)
+            gsl_matrix_free (Xt);
+          if (Yt)
+            gsl_matrix_free (Yt);
+          GSL_ERROR ("failed to allocate workspace", GSL_ENOMEM);
+        }
 
-          /* apply the transformation to the remaining columns */
-          if (j + 1 < N)
+      for (j = 0; N - j > BIDIAG_CROSSOVER; j += nb)
+        {
+          const size_t m1 = M - j;
+          const size_t n1 = N - j;
+          gsl_matrix_view Aj = gsl_matrix_submatrix (A, j, j, m1, n1);
+          gsl_matrix_view Xj = gsl_matrix_submatrix (Xt, 0, 0, nb, m1);
+          gsl_matrix_view Yj = gsl_matrix_submatrix (Yt, 0, 0, nb, n1);
+          gsl_vector_view tuj = gsl_vector_subvector (tau_U, j, nb);
+          gsl_vector_view tvj = gsl_vector_subvector (tau_V, j, nb);
+          gsl_matrix_view V = gsl_matrix_submatrix (A, j + nb, j, m1 - nb, nb);
+          gsl_matrix_view U = gsl_matrix_submatrix (A, j, j + nb, nb, n1 - nb);
+          gsl_matrix_view X2 = gsl_matrix_submatrix (Xt, 0, nb, nb, m1 - nb);
+          gsl_matrix_view Y2 = gsl_matrix_submatrix (Yt, 0, nb, nb, n1 - nb);
+          gsl_matrix_view A22 = gsl_matrix_submatrix (A, j + nb, j + nb, m1 - nb, n1 - nb);
+
+          bidiag_panel (&Aj.matrix, &tuj.vector, &tvj.vector, &d.vector, &e.vector,
+                        &Xj.matrix, &Yj.matrix);
+
+          /* A22 := A22 - V Y^T - X U^T */
+          gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, -1.0, &V.matrix, &Y2.matrix, 1.0, &A22.matrix);
+          gsl_blas_dgemm (CblasTrans, CblasNoTrans, -1.0, &X2.matrix, &U.matrix, 1.0, &A22.matrix);
+
+          /* restore the diagonal and superdiagonal */
+          for (k = 0; k < nb; k++)
             {
-              gsl_matrix_view m = gsl_matrix_submatrix (A, j, j + 1, M - j, N - j - 1);
-              gsl_vector_view work = gsl_vector_subvector(tau_U, j, N - j - 1);
-              double * ptr = gsl_vector_ptr(&v.vector, 0);
-              double tmp = *ptr;
-
-              *ptr = 1.0;
-              gsl_linalg_householder_left (tau_j, &v.vector, &m.matrix, &work.vector);
-              *ptr = tmp;
+              gsl_matrix_set (A, j + k, j + k, d_data[k]);
+              gsl_matrix_set (A, j + k, j + k + 1, e_data[k]);
             }
+        }
+
+      m = gsl_matrix_submatrix (A, j, j, M - j, N - j);
+      tu = gsl_vector_subvector (tau_U, j, N - j);
+      tv = gsl_vector_subvector (tau_V, j, N - j - 1);
+      bidiag_decomp_L2 (&m.matrix, &tu.vector, &tv.vector);
+
+      gsl_matrix_free (Xt);
+      gsl_matrix_free (Yt);
+
+      return GSL_SUCCESS;
+    }
+}
+
+/* unblocked algorithm, applying one reflector at a time */
+
+static int
+bidiag_decomp_L2 (gsl_matrix * A, gsl_vector * tau_U, gsl_vector * tau_V)
+{
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+  gsl_vector * tmp = gsl_vector_alloc(M);
+  size_t j;
+  
+  for (j = 0 ; j < N; j++)
+    {
+      /* apply Householder transformation to current column */
+      gsl_vector_view v = gsl_matrix_subcolumn(A, j, j, M - j);
+      double tau_j = gsl_linalg_householder_transform (&v.vector);
 
-          gsl_vector_set (tau_U, j, tau_j);            
+      /* apply the transformation to the remaining columns */
+      if (j + 1 < N)
+        {
+          gsl_matrix_view m = gsl_matrix_submatrix (A, j, j + 1, M - j, N - j - 1);
+          gsl_vector_view work = gsl_vector_subvector(tau_U, j, N - j - 1);
+          double * ptr = gsl_vector_ptr(&v.vector, 0);
+          double tmp = *ptr;
 
-          /* apply Householder transformation to current row */
-          if (j + 1 < N)
+          *ptr = 1.0;
+          gsl_linalg_householder_left (tau_j, &v.vector, &m.matrix, &work.vector);
+          *ptr = tmp;
+        }
+
+      gsl_vector_set (tau_U, j, tau_j);            
+
+      /* apply Householder transformation to current row */
+      if (j + 1 < N)
+        {
+          v = gsl_matrix_subrow (A, j, j + 1, N - j - 1);
+          tau_j = gsl_linalg_householder_transform (&v.vector);
+          
+          /* apply the transformation to the remaining rows */
+          if (j + 1 < M)
             {
-              v = gsl_matrix_subrow (A, j, j + 1, N - j - 1);
-              tau_j = gsl_linalg_householder_transform (&v.vector);
-              
-              /* apply the transformation to the remaining rows */
-              if (j + 1 < M)
-                {
-                  gsl_matrix_view m = gsl_matrix_submatrix (A, j + 1, j + 1, M - j - 1, N - j - 1);
-                  gsl_vector_view work = gsl_vector_subvector(tmp, 0, M - j - 1);
-                  gsl_linalg_householder_right (tau_j, &v.vector, &m.matrix, &work.vector);
-                }
-
-              gsl_vector_set (tau_V, j, tau_j);
+              gsl_matrix_view m = gsl_matrix_submatrix (A, j + 1, j + 1, M - j - 1, N - j - 1);
+              gsl_vector_view work = gsl_vector_subvector(tmp, 0, M - j - 1);
+              gsl_linalg_householder_right (tau_j, &v.vector, &m.matrix, &work.vector);
             }
+
+          gsl_vector_set (tau_V, j, tau_j);
         }
+    }
 
-      gsl_vector_free(tmp);
+  gsl_vector_free(tmp);
 
-      return GSL_SUCCESS;
+  return GSL_SUCCESS;
+}
+
+/*
+bidiag_panel()
+  Reduce the first nb = Xt->size1 rows and columns of the m-by-n
+matrix A to upper bidiagonal form, as in LAPACK DLABRD
+
+Inputs: A     - m-by-n trailing matrix, m >= n > nb
+        tau_U - (output) coefficients of the left reflectors, length nb
+        tau_V - (output) coefficients of the right reflectors, length nb
+        d     - (output) diagonal elements, length nb
+        e     - (output) superdiagonal elements, length nb
+        Xt    - (output) nb-by-m matrix X^T
+        Yt    - (output) nb-by-n matrix Y^T
+
+Notes:
+1) On output the leading elements of the Householder vectors, on the
+diagonal and superdiagonal of A, are set to 1 so that the vectors can
+be used in the update of the trailing matrix; the bidiagonal elements
+are stored in d and e.
+
+2) Row i of Y^T is tau_U(i) u_i^T A and row i of X^T is
+tau_V(i) (A v_i)^T, with the products corrected for the updates of
+the previous reflectors of the panel, which have not yet been applied
+to the trailing matrix.  X and Y are stored transposed so that these
+vectors are contiguous.
+*/
+
+static int
+bidiag_panel (gsl_matrix * A, gsl_vector * tau_U, gsl_vector * tau_V,
+              gsl_vector * d, gsl_vector * e, gsl_matrix * Xt, gsl_matrix * Yt)
+{
+  const size_t m = A->size1;
+  const size_t n = A->size2;
+  const size_t nb = Xt->size1;
+  size_t i;
+
+  for (i = 0; i < nb; i++)
+    {
+      gsl_vector_view u = gsl_matrix_subcolumn (A, i, i, m - i);
+      gsl_vector_view v = gsl_matrix_subrow (A, i, i + 1, n - i - 1);
+      gsl_vector_view yi = gsl_matrix_subrow (Yt, i, i + 1, n - i - 1);
+      gsl_vector_view xi = gsl_matrix_subrow (Xt, i, i + 1, m - i - 1);
+      gsl_matrix_view A22 = gsl_matrix_submatrix (A, i + 1, i + 1, m - i - 1, n - i - 1);
+      gsl_matrix_view A12 = gsl_matrix_submatrix (A, i, i + 1, m - i, n - i - 1);
+      gsl_matrix_view Y2 = gsl_matrix_submatrix (Yt, 0, i + 1, i + 1, n - i - 1);
+      gsl_matrix_view V2 = gsl_matrix_submatrix (A, i + 1, 0, m - i - 1, i + 1);
+      gsl_vector_view vr = gsl_matrix_subrow (A, i, 0, i + 1);
+      double tau_i;
+
+      if (i > 0)
+        {
+          /* apply the previous reflectors to column i:
+             A(i:m,i) -= V(i:m,:) Y(i,:)^T + X(i:m,:) U(:,i) */
+          gsl_matrix_view Vi = gsl_matrix_submatrix (A, i, 0, m - i, i);
+          gsl_matrix_view Xi = gsl_matrix_submatrix (Xt, 0, i, i, m - i);
+          gsl_vector_view yc = gsl_matrix_subcolumn (Yt, i, 0, i);
+          gsl_vector_view uc = gsl_matrix_subcolumn (A, i, 0, i);
+
+          gsl_blas_dgemv (CblasNoTrans, -1.0, &Vi.matrix, &yc.vector, 1.0, &u.vector);
+          gsl_blas_dgemv (CblasTrans, -1.0, &Xi.matrix, &uc.vector, 1.0, &u.vector);
+        }
+
+      /* generate the left reflector for column i */
+      tau_i = gsl_linalg_householder_transform (&u.vector);
+      gsl_vector_set (d, i, gsl_vector_get (&u.vector, 0));
+      gsl_vector_set (&u.vector, 0, 1.0);
+      gsl_vector_set (tau_U, i, tau_i);
+
+      /* Y(i+1:n,i) = tau (A^T u - Y V^T u - U^T X^T u), using Y(0:i,i)
+         as workspace */
+      gsl_blas_dgemv (CblasTrans, 1.0, &A12.matrix, &u.vector, 0.0, &yi.vector);
+
+      if (i > 0)
+        {
+          gsl_matrix_view Vi = gsl_matrix_submatrix (A, i, 0, m - i, i);
+          gsl_matrix_view Xi = gsl_matrix_submatrix (Xt, 0, i, i, m - i);
+          gsl_matrix_view Yp = gsl_matrix_submatrix (Yt, 0, i + 1, i, n - i - 1);
+          gsl_matrix_view U2 = gsl_matrix_submatrix (A, 0, i + 1, i, n - i - 1);
+          gsl_vector_view t = gsl_matrix_subrow (Yt, i, 0, i);
+
+          gsl_blas_dgemv (CblasTrans, 1.0, &Vi.matrix, &u.vector, 0.0, &t.vector);
+          gsl_blas_dgemv (CblasTrans, -1.0, &Yp.matrix, &t.vector, 1.0, &yi.vector);
+          gsl_blas_dgemv (CblasNoTrans, 1.0, &Xi.matrix, &u.vector, 0.0, &t.vector);
+          gsl_blas_dgemv (CblasTrans, -1.0, &U2.matrix, &t.vector, 1.0, &yi.vector);
+        }
+
+      gsl_blas_dscal (tau_i, &yi.vector);
+
+      /* apply the reflectors to row i:
+         A(i,i+1:n) -= Y(i+1:n,0:i+1) V(i,0:i+1)^T + U(:,i+1:n)^T X(i,:)^T */
+      gsl_blas_dgemv (CblasTrans, -1.0, &Y2.matrix, &vr.vector, 1.0, &v.vector);
+
+      if (i > 0)
+        {
+          gsl_matrix_view U2 = gsl_matrix_submatrix (A, 0, i + 1, i, n - i - 1);
+          gsl_vector_view xc = gsl_matrix_subcolumn (Xt, i, 0, i);
+
+          gsl_blas_dgemv (CblasTrans, -1.0, &U2.matrix, &xc.vector, 1.0, &v.vector);
+        }
+
+      /* generate the right reflector for row i */
+      tau_i = gsl_linalg_householder_transform (&v.vector);
+      gsl_vector_set (e, i, gsl_vector_get (&v.vector, 0));
+      gsl_vector_set (&v.vector, 0, 1.0);
+      gsl_vector_set (tau_V, i, tau_i);
+
+      /* X(i+1:m,i) = tau (A v - V Y^T v - X U v), using X(0:i+1,i) as
+         workspace */
+      gsl_blas_dgemv (CblasNoTrans, 1.0, &A22.matrix, &v.vector, 0.0, &xi.vector);
+
+      {
+        gsl_vector_view t = gsl_matrix_subrow (Xt, i, 0, i + 1);
+
+        gsl_blas_dgemv (CblasNoTrans, 1.0, &Y2.matrix, &v.vector, 0.0, &t.vector);
+        gsl_blas_dgemv (CblasNoTrans, -1.0, &V2.matrix, &t.vector, 1.0, &xi.vector);
+      }
+
+      if (i > 0)
+        {
+          gsl_matrix_view U2 = gsl_matrix_submatrix (A, 0, i + 1, i, n - i - 1);
+          gsl_matrix_view Xp = gsl_matrix_submatrix (Xt, 0, i + 1, i, m - i - 1);
+          gsl_vector_view t = gsl_matrix_subrow (Xt, i, 0, i);
+
+          gsl_blas_dgemv (CblasNoTrans, 1.0, &U2.matrix, &v.vector, 0.0, &t.vector);
+          gsl_blas_dgemv (CblasTrans, -1.0, &Xp.matrix, &t.vector, 1.0, &xi.vector);
+        }
+
+      gsl_blas_dscal (tau_i, &xi.vector);
     }
+
+  return GSL_SUCCESS;
 }
 
 /* Form the orthogonal matrices U, V, diagonal d and superdiagonal sd
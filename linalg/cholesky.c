@@ -46,6 +46,11 @@ static double cholesky_norm1(const gsl_matrix * LLT, gsl_vector * work);
 static int cholesky_Ainv(CBLAS_TRANSPOSE_t TransA, gsl_vector * x, void * params);
 static int cholesky_decomp_L2 (gsl_matrix * A);
 static int cholesky_decomp_L3 (gsl_matrix * A);
+static int cholesky_rank_update (gsl_matrix * LLT, gsl_matrix * V, const double sigma);
+
+/* number of columns of V for which the rotations are computed at a time
+   in the rank-k update */
+#define CHOLESKY_UPDATE_BLOCK 32
 
 /*
 In GSL 2.2, we decided to modify the behavior of the Cholesky decomposition
@@ -535,6 +540,76 @@ gsl_linalg_cholesky_rcond (const gsl_matrix * LLT, double * rcond,
     }
 }
 
+/*
+gsl_linalg_cholesky_update()
+  Update the Cholesky factorization of A to that of
+
+A + V V^T
+
+Inputs: LLT - (input) Cholesky factorization of A from gsl_linalg_cholesky_decomp1
+              (output) Cholesky factorization of A + V V^T
+        V   - (input) N-by-k matrix V
+              (output) destroyed
+
+Return: success/error
+
+Notes:
+1) The factor is updated with k rank-1 updates in O(N^2 k) operations
+(Golub and Van Loan, Matrix Computations (4th ed), section 6.5.4)
+
+2) The copy of A stored in the upper triangle of LLT is also updated,
+for later rcond calculation
+*/
+
+int
+gsl_linalg_cholesky_update (gsl_matrix * LLT, gsl_matrix * V)
+{
+  if (LLT->size1 != LLT->size2)
+    {
+      GSL_ERROR ("cholesky matrix must be square", GSL_ENOTSQR);
+    }
+  else if (LLT->size1 != V->size1)
+    {
+      GSL_ERROR ("V matrix must have N rows", GSL_EBADLEN);
+    }
+  else
+    {
+      return cholesky_rank_update(LLT, V, 1.0);
+    }
+}
+
+/*
+gsl_linalg_cholesky_downdate()
+  Update the Cholesky factorization of A to that of
+
+A - V V^T
+
+Inputs: LLT - (input) Cholesky factorization of A from gsl_linalg_cholesky_decomp1
+              (output) Cholesky factorization of A - V V^T
+        V   - (input) N-by-k matrix V
+              (output) destroyed
+
+Return: success, or GSL_EDOM if A - V V^T is not positive definite, in
+which case the contents of LLT are undefined on output
+*/
+
+int
+gsl_linalg_cholesky_downdate (gsl_matrix * LLT, gsl_matrix * V)
+{
+  if (LLT->size1 != LLT->size2)
+    {
+      GSL_ERROR ("cholesky matrix must be square", GSL_ENOTSQR);
+    }
+  else if (LLT->size1 != V->size1)
+    {
+      GSL_ERROR ("V matrix must have N rows", GSL_EBADLEN);
+    }
+  else
+    {
+      return cholesky_rank_update(LLT, V, -1.0);
+    }
+}
+
 /* compute 1-norm of original matrix, stored in upper triangle of LLT;
  * diagonal entries have to be reconstructed */
 static double
@@ -597,6 +672,108 @@ cholesky_Ainv(CBLAS_TRANSPOSE_t TransA, gsl_vector * x, void * params)
   return GSL_SUCCESS;
 }
 
+/*
+cholesky_rank_update()
+  Update the Cholesky factor L of A to that of A + sigma V V^T,
+sigma = +/- 1
+
+Inputs: LLT   - Cholesky factor in lower triangle, A in upper triangle
+        V     - N-by-k matrix, destroyed on output
+        sigma - +1 for update, -1 for downdate
+
+Notes:
+1) For each column v of V, the rank-1 update of column j of L is
+
+r = sqrt(L(j,j)^2 + sigma v(j)^2), c = r / L(j,j), s = v(j) / L(j,j)
+L(j,j) = r
+L(j+1:N,j) = (L(j+1:N,j) + sigma s v(j+1:N)) / c
+v(j+1:N) = c v(j+1:N) - s L(j+1:N,j)
+
+2) The k updates of column j are applied together, row by row, so that
+the rows of V are accessed contiguously
+*/
+
+static int
+cholesky_rank_update (gsl_matrix * LLT, gsl_matrix * V, const double sigma)
+{
+  const size_t N = LLT->size1;
+  const size_t k = V->size2;
+  const size_t nb = CHOLESKY_UPDATE_BLOCK;
+  double c[CHOLESKY_UPDATE_BLOCK], s[CHOLESKY_UPDATE_BLOCK];
+  size_t i, j, l, l0;
+
+  /* A := A + sigma V V^T in upper triangle: dgemm above the diagonal
+   * blocks, dgemv within them */
+  for (j = 0; j < N; j += nb)
+    {
+      const size_t jb = GSL_MIN(nb, N - j);
+      gsl_matrix_view Vj = gsl_matrix_submatrix(V, j, 0, jb, k);
+
+      if (j > 0)
+        {
+          gsl_matrix_view A12 = gsl_matrix_submatrix(LLT, 0, j, j, jb);
+          gsl_matrix_view V1 = gsl_matrix_submatrix(V, 0, 0, j, k);
+
+          gsl_blas_dgemm(CblasNoTrans, CblasTrans, sigma, &V1.matrix, &Vj.matrix, 1.0, &A12.matrix);
+        }
+
+      for (i = 1; i < jb; ++i)
+        {
+          gsl_vector_view a = gsl_matrix_subcolumn(LLT, j + i, j, i);
+          gsl_matrix_view Vi = gsl_matrix_submatrix(V, j, 0, i, k);
+          gsl_vector_view vi = gsl_matrix_row(V, j + i);
+
+          gsl_blas_dgemv(CblasNoTrans, sigma, &Vi.matrix, &vi.vector, 1.0, &a.vector);
+        }
+    }
+
+  for (j = 0; j < N; ++j)
+    {
+      for (l0 = 0; l0 < k; l0 += nb)
+        {
+          const size_t nl = GSL_MIN(nb, k - l0);
+          double ljj = gsl_matrix_get(LLT, j, j);
+
+          /* compute the rotations for column j */
+          for (l = 0; l < nl; ++l)
+            {
+              double vjl = gsl_matrix_get(V, j, l0 + l);
+              double r2 = ljj * ljj + sigma * vjl * vjl;
+              double r;
+
+              if (r2 <= 0.0)
+                {
+                  GSL_ERROR("matrix is not positive definite", GSL_EDOM);
+                }
+
+              r = sqrt(r2);
+              c[l] = r / ljj;
+              s[l] = vjl / ljj;
+              ljj = r;
+            }
+
+          gsl_matrix_set(LLT, j, j, ljj);
+
+          /* apply them to L(j+1:N,j) and V(j+1:N,l0:l0+nl-1) */
+          for (i = j + 1; i < N; ++i)
+            {
+              double * vi = gsl_matrix_ptr(V, i, l0);
+              double lij = gsl_matrix_get(LLT, i, j);
+
+              for (l = 0; l < nl; ++l)
+                {
+                  lij = (lij + sigma * s[l] * vi[l]) / c[l];
+                  vi[l] = c[l] * vi[l] - s[l] * lij;
+                }
+
+              gsl_matrix_set(LLT, i, j, lij);
+            }
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
 /*
 cholesky_decomp_L2()
   Perform Cholesky decomposition of a symmetric positive
@@ -29,6 +29,12 @@
 
 static double cholesky_band_norm1(const gsl_matrix * A);
 static int cholesky_band_Ainv(CBLAS_TRANSPOSE_t TransA, gsl_vector * x, void * params);
+static int cholesky_band_rank_update(gsl_matrix * LLT, gsl_matrix * V, const double sigma);
+static double cholesky_band_norm1_LLT(const gsl_matrix * LLT);
+
+/* number of columns of V for which the rotations are computed at a time
+   in the rank-k update */
+#define CHOLESKY_BAND_UPDATE_BLOCK 32
 
 /*
 gsl_linalg_cholesky_band_decomp()
@@ -344,6 +350,70 @@ gsl_linalg_cholesky_band_rcond (const gsl_matrix * LLT, double * rcond, gsl_vect
     }
 }
 
+/*
+gsl_linalg_cholesky_band_update()
+  Update the banded Cholesky factorization of A to that of
+
+A + V V^T
+
+Inputs: LLT - (input) Cholesky factorization of A from gsl_linalg_cholesky_band_decomp
+              (output) Cholesky factorization of A + V V^T
+        V   - (input) N-by-k matrix V; the nonzero elements of each column
+                      must lie in at most ndiag consecutive rows, so that
+                      A + V V^T has the same bandwidth as A
+              (output) destroyed
+
+Return: success/error
+
+Notes:
+1) The factor is updated with k rank-1 updates in O(N p k) operations,
+where p is the lower bandwidth. The 1-norm stored for
+gsl_linalg_cholesky_band_rcond is recomputed from the updated factor
+in O(N p^2) operations.
+*/
+
+int
+gsl_linalg_cholesky_band_update (gsl_matrix * LLT, gsl_matrix * V)
+{
+  if (LLT->size1 != V->size1)
+    {
+      GSL_ERROR ("V matrix must have N rows", GSL_EBADLEN);
+    }
+  else
+    {
+      return cholesky_band_rank_update(LLT, V, 1.0);
+    }
+}
+
+/*
+gsl_linalg_cholesky_band_downdate()
+  Update the banded Cholesky factorization of A to that of
+
+A - V V^T
+
+Inputs: LLT - (input) Cholesky factorization of A from gsl_linalg_cholesky_band_decomp
+              (output) Cholesky factorization of A - V V^T
+        V   - (input) N-by-k matrix V, with columns as for
+                      gsl_linalg_cholesky_band_update
+              (output) destroyed
+
+Return: success, or GSL_EDOM if A - V V^T is not positive definite, in
+which case the contents of LLT are undefined on output
+*/
+
+int
+gsl_linalg_cholesky_band_downdate (gsl_matrix * LLT, gsl_matrix * V)
+{
+  if (LLT->size1 != V->size1)
+    {
+      GSL_ERROR ("V matrix must have N rows", GSL_EBADLEN);
+    }
+  else
+    {
+      return cholesky_band_rank_update(LLT, V, -1.0);
+    }
+}
+
 /*
 gsl_linalg_cholesky_band_scale()
   This function computes scale factors diag(S), such that
@@ -504,3 +574,133 @@ cholesky_band_Ainv(CBLAS_TRANSPOSE_t TransA, gsl_vector * x, void * params)
 
   return GSL_SUCCESS;
 }
+
+/*
+cholesky_band_rank_update()
+  Update the banded Cholesky factor L of A to that of A + sigma V V^T,
+sigma = +/- 1, with the algorithm of cholesky_rank_update() in cholesky.c
+
+Notes: if column v of V is nonzero only in rows i0 to i0+p, then after
+the update of column j >= i0 of L it is nonzero only in rows j+1 to
+j+p, so that only the p elements of L below the diagonal of column j
+are modified.
+*/
+
+static int
+cholesky_band_rank_update(gsl_matrix * LLT, gsl_matrix * V, const double sigma)
+{
+  const size_t N = LLT->size1;
+  const size_t ndiag = LLT->size2;
+  const size_t p = ndiag - 1; /* lower bandwidth */
+  const size_t k = V->size2;
+  const size_t nb = CHOLESKY_BAND_UPDATE_BLOCK;
+  double c[CHOLESKY_BAND_UPDATE_BLOCK], s[CHOLESKY_BAND_UPDATE_BLOCK];
+  size_t i, j, l, l0;
+
+  /* check that the columns of V lie within the band */
+  for (l = 0; l < k; ++l)
+    {
+      size_t i0 = N, i1 = 0;
+
+      for (i = 0; i < N; ++i)
+        {
+          if (gsl_matrix_get(V, i, l) != 0.0)
+            {
+              i0 = GSL_MIN(i0, i);
+              i1 = i;
+            }
+        }
+
+      if (i0 < N && i1 - i0 > p)
+        {
+          GSL_ERROR("columns of V must not exceed the bandwidth of the matrix", GSL_EINVAL);
+        }
+    }
+
+  for (j = 0; j < N; ++j)
+    {
+      /* number of elements below the diagonal in column j of L */
+      const size_t lenv = GSL_MIN(p, N - j - 1);
+
+      for (l0 = 0; l0 < k; l0 += nb)
+        {
+          const size_t nl = GSL_MIN(nb, k - l0);
+          double ljj = gsl_matrix_get(LLT, j, 0);
+
+          /* compute the rotations for column j */
+          for (l = 0; l < nl; ++l)
+            {
+              double vjl = gsl_matrix_get(V, j, l0 + l);
+              double r2 = ljj * ljj + sigma * vjl * vjl;
+              double r;
+
+              if (r2 <= 0.0)
+                {
+                  GSL_ERROR("matrix is not positive definite", GSL_EDOM);
+                }
+
+              r = sqrt(r2);
+              c[l] = r / ljj;
+              s[l] = vjl / ljj;
+              ljj = r;
+            }
+
+          gsl_matrix_set(LLT, j, 0, ljj);
+
+          /* apply them to L(j+1:j+lenv,j) and V(j+1:j+lenv,l0:l0+nl-1) */
+          for (i = 1; i <= lenv; ++i)
+            {
+              double * vi = gsl_matrix_ptr(V, j + i, l0);
+              double lij = gsl_matrix_get(LLT, j, i);
+
+              for (l = 0; l < nl; ++l)
+                {
+                  lij = (lij + sigma * s[l] * vi[l]) / c[l];
+                  vi[l] = c[l] * vi[l] - s[l] * lij;
+                }
+
+              gsl_matrix_set(LLT, j, i, lij);
+            }
+        }
+    }
+
+  /* update the 1-norm stored by gsl_linalg_cholesky_band_decomp() */
+  if (ndiag > 1)
+    gsl_matrix_set(LLT, N - 1, p, cholesky_band_norm1_LLT(LLT));
+
+  return GSL_SUCCESS;
+}
+
+/* compute 1-norm of A = L L^T from its banded Cholesky factor */
+static double
+cholesky_band_norm1_LLT(const gsl_matrix * LLT)
+{
+  const size_t N = LLT->size1;
+  const size_t p = LLT->size2 - 1; /* lower bandwidth */
+  double value = 0.0;
+  size_t i, j, m;
+
+  for (j = 0; j < N; ++j)
+    {
+      const size_t imin = (j > p) ? j - p : 0;
+      const size_t imax = GSL_MIN(j + p, N - 1);
+      double sum = 0.0;
+
+      for (i = imin; i <= imax; ++i)
+        {
+          /* A(i,j) = sum_m L(i,m) L(j,m), with L(i,m) = LLT(m,i-m) */
+          const size_t hi = GSL_MIN(i, j);
+          const size_t lo = (GSL_MAX(i, j) > p) ? GSL_MAX(i, j) - p : 0;
+          double aij = 0.0;
+
+          for (m = lo; m <= hi; ++m)
+            aij += gsl_matrix_get(LLT, m, i - m) * gsl_matrix_get(LLT, m, j - m);
+
+          sum += fabs(aij);
+        }
+
+      value = GSL_MAX(value, sum);
+    }
+
+  return value;
+}
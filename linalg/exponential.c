@@ -29,6 +29,8 @@
 #include <gsl/gsl_mode.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_blas.h>
+#include <gsl/gsl_permutation.h>
+#include <gsl/gsl_permute_vector.h>
 
 #include "gsl_linalg.h"
 
@@ -185,3 +187,416 @@ gsl_linalg_exponential_ss(
   }
 }
 
+
+
+/* 1-norm of A, the largest absolute column sum */
+static double
+exp_norm1(const gsl_matrix * A)
+{
+  const size_t N = A->size1;
+  double norm = 0.0;
+  size_t j;
+
+  for (j = 0; j < N; ++j)
+    {
+      gsl_vector_const_view c = gsl_matrix_const_column(A, j);
+      norm = GSL_MAX(norm, gsl_blas_dasum(&c.vector));
+    }
+
+  return norm;
+}
+
+/* Pade degrees, the largest 1-norm of A for which each gives
+ * double precision accuracy without scaling, and the coefficients
+ * of the numerator polynomials, from Higham (2005), Tables 2.3 and 10.4
+ */
+static const int pade_degree[5] = { 3, 5, 7, 9, 13 };
+
+static const double pade_theta[5] =
+{
+  1.495585217958292e-2, 2.539398330063230e-1, 9.504178996162932e-1,
+  2.097847961257068e0, 5.371920351148152e0
+};
+
+static const double pade_b3[4] = { 120.0, 60.0, 12.0, 1.0 };
+static const double pade_b5[6] = { 30240.0, 15120.0, 3360.0, 420.0, 30.0, 1.0 };
+static const double pade_b7[8] =
+{
+  17297280.0, 8648640.0, 1995840.0, 277200.0, 25200.0, 1512.0, 56.0, 1.0
+};
+static const double pade_b9[10] =
+{
+  17643225600.0, 8821612800.0, 2075673600.0, 302702400.0, 30270240.0,
+  2162160.0, 110880.0, 3960.0, 90.0, 1.0
+};
+static const double pade_b13[14] =
+{
+  64764752532480000.0, 32382376266240000.0, 7771770303897600.0,
+  1187353796428800.0, 129060195264000.0, 10559470521600.0,
+  670442572800.0, 33522128640.0, 1323241920.0, 40840800.0, 960960.0,
+  16380.0, 182.0, 1.0
+};
+
+/* M = M + alpha B */
+static void
+exp_matrix_axpy(const double alpha, const gsl_matrix * B, gsl_matrix * M)
+{
+  const size_t N = M->size1;
+  size_t i;
+
+  for (i = 0; i < N; ++i)
+    {
+      gsl_vector_const_view b = gsl_matrix_const_row(B, i);
+      gsl_vector_view m = gsl_matrix_row(M, i);
+      gsl_blas_daxpy(alpha, &b.vector, &m.vector);
+    }
+}
+
+/*
+gsl_linalg_exponential_pade()
+  Compute the matrix exponential exp(A) with the scaling and
+squaring method and a Pade approximant of degree 3, 5, 7, 9 or 13,
+chosen from the 1-norm of A
+
+Inputs: A  - N-by-N matrix
+        eA - (output) exp(A)
+
+Return: success/error
+
+Notes:
+1) Algorithm 2.3 of N. J. Higham, The scaling and squaring method for
+the matrix exponential revisited, SIAM J. Matrix Anal. Appl. 26, 1179
+(2005). With ||2^{-s} A||_1 <= theta_m, the Pade approximant r_m
+gives exp(2^{-s} A) to double precision, and exp(A) = r_m(2^{-s} A)^{2^s}.
+
+2) r_m(X) = (V - U)^{-1} (V + U), with U the odd and V the even part
+of the numerator polynomial, which is evaluated with the products
+X^2, X^4, X^6 (and X^8 for m = 9).
+*/
+
+int
+gsl_linalg_exponential_pade(const gsl_matrix * A, gsl_matrix * eA)
+{
+  const size_t N = A->size1;
+
+  if (N != A->size2)
+    {
+      GSL_ERROR("cannot exponentiate a non-square matrix", GSL_ENOTSQR);
+    }
+  else if (eA->size1 != N || eA->size2 != N)
+    {
+      GSL_ERROR("exponential of matrix must have same dimension as matrix", GSL_EBADLEN);
+    }
+  else
+    {
+      const double norm = exp_norm1(A);
+      gsl_matrix * X = gsl_matrix_alloc(N, N);
+      gsl_matrix * X2 = gsl_matrix_alloc(N, N);
+      gsl_matrix * X4 = gsl_matrix_alloc(N, N);
+      gsl_matrix * X6 = gsl_matrix_alloc(N, N);
+      gsl_matrix * U = gsl_matrix_alloc(N, N);
+      gsl_matrix * V = gsl_matrix_alloc(N, N);
+      gsl_permutation * p = gsl_permutation_alloc(N);
+      const double * b;
+      int m = 13, s = 0, signum, status;
+      size_t i, j;
+
+      if (X == NULL || X2 == NULL || X4 == NULL || X6 == NULL ||
+          U == NULL || V == NULL || p == NULL)
+        {
+          if (X)
+            gsl_matrix_free(X);
+          if (X2)
+            gsl_matrix_free(X2);
+          if (X4)
+            gsl_matrix_free(X4);
+          if (X6)
+            gsl_matrix_free(X6);
+          if (U)
+            gsl_matrix_free(U);
+          if (V)
+            gsl_matrix_free(V);
+          if (p)
+            gsl_permutation_free(p);
+          GSL_ERROR("failed to allocate workspace", GSL_ENOMEM);
+        }
+
+      for (i = 0; i < 4; ++i)
+        {
+          if (norm <= pade_theta[i])
+            {
+              m = pade_degree[i];
+              break;
+            }
+        }
+
+      /* X = 2^{-s} A */
+      gsl_matrix_memcpy(X, A);
+
+      if (m == 13 && norm > pade_theta[4])
+        {
+          s = (int) ceil(log(norm / pade_theta[4]) / M_LN2);
+          gsl_matrix_scale(X, ldexp(1.0, -s));
+        }
+
+      gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, X, X, 0.0, X2);
+
+      if (m >= 5)
+        gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, X2, X2, 0.0, X4);
+
+      if (m >= 7)
+        gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, X4, X2, 0.0, X6);
+
+      if (m == 13)
+        {
+          b = pade_b13;
+
+          /* eA = X6 (b13 X6 + b11 X4 + b9 X2), V = X6 (b12 X6 + b10 X4 + b8 X2) */
+          gsl_matrix_memcpy(U, X6);
+          gsl_matrix_scale(U, b[13]);
+          exp_matrix_axpy(b[11], X4, U);
+          exp_matrix_axpy(b[9], X2, U);
+          gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, X6, U, 0.0, eA);
+
+          gsl_matrix_memcpy(U, X6);
+          gsl_matrix_scale(U, b[12]);
+          exp_matrix_axpy(b[10], X4, U);
+          exp_matrix_axpy(b[8], X2, U);
+          gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, X6, U, 0.0, V);
+
+          /* eA += b7 X6 + b5 X4 + b3 X2 + b1 I */
+          exp_matrix_axpy(b[7], X6, eA);
+          exp_matrix_axpy(b[5], X4, eA);
+          exp_matrix_axpy(b[3], X2, eA);
+          gsl_matrix_add_diagonal(eA, b[1]);
+
+          /* V += b6 X6 + b4 X4 + b2 X2 + b0 I */
+          exp_matrix_axpy(b[6], X6, V);
+          exp_matrix_axpy(b[4], X4, V);
+          exp_matrix_axpy(b[2], X2, V);
+          gsl_matrix_add_diagonal(V, b[0]);
+        }
+      else
+        {
+          /* even powers X^{2k}, with X^8 stored in U */
+          const gsl_matrix * Xk[5];
+          int k;
+
+          Xk[1] = X2;
+          Xk[2] = X4;
+          Xk[3] = X6;
+          Xk[4] = U;
+
+          b = (m == 3) ? pade_b3 : (m == 5) ? pade_b5 : (m == 7) ? pade_b7 : pade_b9;
+
+          if (m == 9)
+            gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, X4, X4, 0.0, U);
+
+          /* eA = sum_k b_{2k+1} X^{2k}, V = sum_k b_{2k} X^{2k} */
+          gsl_matrix_set_zero(eA);
+          gsl_matrix_set_zero(V);
+          gsl_matrix_add_diagonal(eA, b[1]);
+          gsl_matrix_add_diagonal(V, b[0]);
+
+          for (k = 2; k < m; k += 2)
+            {
+              exp_matrix_axpy(b[k + 1], Xk[k / 2], eA);
+              exp_matrix_axpy(b[k], Xk[k / 2], V);
+            }
+        }
+
+      /* U = X eA */
+      gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, X, eA, 0.0, U);
+
+      /* eA = V + U, V = V - U */
+      gsl_matrix_memcpy(eA, V);
+      gsl_matrix_add(eA, U);
+      gsl_matrix_sub(V, U);
+
+      /* eA = (V - U)^{-1} (V + U) */
+      status = gsl_linalg_LU_decomp(V, p, &signum);
+      if (status == GSL_SUCCESS)
+        {
+          for (j = 0; j < N; ++j)
+            {
+              gsl_vector_view c = gsl_matrix_column(eA, j);
+              gsl_permute_vector(p, &c.vector);
+            }
+
+          gsl_blas_dtrsm(CblasLeft, CblasLower, CblasNoTrans, CblasUnit, 1.0, V, eA);
+          gsl_blas_dtrsm(CblasLeft, CblasUpper, CblasNoTrans, CblasNonUnit, 1.0, V, eA);
+
+          /* undo the scaling */
+          for (i = 0; i < (size_t) s; ++i)
+            {
+              gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, eA, eA, 0.0, U);
+              gsl_matrix_memcpy(eA, U);
+            }
+        }
+
+      gsl_matrix_free(X);
+      gsl_matrix_free(X2);
+      gsl_matrix_free(X4);
+      gsl_matrix_free(X6);
+      gsl_matrix_free(U);
+      gsl_matrix_free(V);
+      gsl_permutation_free(p);
+
+      return status;
+    }
+}
+
+/* largest ||t A||_1 for which s = 1 step of the Taylor polynomial of
+ * degree m = 1, ..., 55 gives double precision accuracy, from
+ * Al-Mohy and Higham (2011), Table 3.1
+ */
+#define EXP_ACTION_MMAX 55
+
+static const double taylor_theta[EXP_ACTION_MMAX] =
+{
+  2.29e-16, 2.58e-8, 1.39e-5, 3.40e-4, 2.40e-3, 9.07e-3, 2.38e-2, 4.99e-2,
+  8.96e-2, 1.44e-1, 2.14e-1, 3.00e-1, 4.00e-1, 5.14e-1, 6.41e-1, 7.81e-1,
+  9.31e-1, 1.09e0, 1.26e0, 1.44e0, 1.62e0, 1.82e0, 2.01e0, 2.22e0,
+  2.43e0, 2.64e0, 2.86e0, 3.08e0, 3.31e0, 3.54e0, 3.77e0, 4.01e0,
+  4.25e0, 4.49e0, 4.74e0, 4.98e0, 5.23e0, 5.48e0, 5.74e0, 5.99e0,
+  6.25e0, 6.51e0, 6.77e0, 7.03e0, 7.29e0, 7.55e0, 7.82e0, 8.08e0,
+  8.35e0, 8.62e0, 8.89e0, 9.16e0, 9.43e0, 9.70e0, 9.98e0
+};
+
+/*
+gsl_linalg_exponential_action()
+  Compute w = exp(t A) v without forming exp(t A)
+
+Inputs: t - scalar
+        A - N-by-N matrix
+        v - vector, length N
+        w - (output) exp(t A) v, length N; may be the same vector as v
+
+Return: success/error
+
+Notes:
+1) Algorithm 3.2 of A. H. Al-Mohy and N. J. Higham, Computing the action
+of the matrix exponential, with an application to exponential
+integrators, SIAM J. Sci. Comput. 33, 488 (2011), without balancing:
+with mu = trace(A)/N and B = A - mu I,
+
+exp(t A) v = e^{t mu} [ T_m(t B / s) ]^s v
+
+where T_m is the Taylor polynomial of degree m, and m and s are chosen
+to minimize the number m s of products with A subject to
+||t B||_1 / s <= theta_m. The series for each step is truncated early
+once two consecutive terms are negligible.
+
+2) Only products A b are needed, so the cost is O(m s N^2)
+*/
+
+int
+gsl_linalg_exponential_action(const double t, const gsl_matrix * A,
+                              const gsl_vector * v, gsl_vector * w)
+{
+  const size_t N = A->size1;
+
+  if (N != A->size2)
+    {
+      GSL_ERROR("cannot exponentiate a non-square matrix", GSL_ENOTSQR);
+    }
+  else if (v->size != N)
+    {
+      GSL_ERROR("vector v must match matrix size", GSL_EBADLEN);
+    }
+  else if (w->size != N)
+    {
+      GSL_ERROR("vector w must match matrix size", GSL_EBADLEN);
+    }
+  else
+    {
+      const double tol = 0.5 * GSL_DBL_EPSILON;
+      gsl_vector_const_view diag = gsl_matrix_const_diagonal(A);
+      gsl_vector * b = gsl_vector_alloc(N);
+      gsl_vector * Ab = gsl_vector_alloc(N);
+      double mu = 0.0, norm = 0.0, eta;
+      size_t i, j, k, m = 0, s = 1;
+
+      if (b == NULL || Ab == NULL)
+        {
+          if (b)
+            gsl_vector_free(b);
+          if (Ab)
+            gsl_vector_free(Ab);
+          GSL_ERROR("failed to allocate workspace", GSL_ENOMEM);
+        }
+
+      /* mu = trace(A) / N */
+      for (i = 0; i < N; ++i)
+        mu += gsl_vector_get(&diag.vector, i);
+
+      mu /= (double) N;
+
+      /* ||t (A - mu I)||_1 */
+      for (j = 0; j < N; ++j)
+        {
+          gsl_vector_const_view c = gsl_matrix_const_column(A, j);
+          const double ajj = gsl_matrix_get(A, j, j);
+          double sum = gsl_blas_dasum(&c.vector) - fabs(ajj) + fabs(ajj - mu);
+
+          norm = GSL_MAX(norm, sum);
+        }
+
+      norm *= fabs(t);
+
+      if (norm > 0.0)
+        {
+          double cost = GSL_POSINF;
+
+          for (k = 1; k <= EXP_ACTION_MMAX; ++k)
+            {
+              const double sk = ceil(norm / taylor_theta[k - 1]);
+
+              if (k * sk < cost)
+                {
+                  cost = k * sk;
+                  m = k;
+                  s = (size_t) sk;
+                }
+            }
+        }
+
+      eta = exp(t * mu / (double) s);
+
+      gsl_vector_memcpy(w, v);
+      gsl_vector_memcpy(b, v);
+
+      for (i = 0; i < s; ++i)
+        {
+          double c1 = fabs(gsl_vector_get(b, gsl_blas_idamax(b)));
+
+          for (k = 1; k <= m; ++k)
+            {
+              double c2, fnorm;
+
+              /* b = t/(s k) (A - mu I) b */
+              gsl_blas_dgemv(CblasNoTrans, 1.0, A, b, 0.0, Ab);
+              gsl_blas_daxpy(-mu, b, Ab);
+              gsl_blas_dscal(t / ((double) s * k), Ab);
+              gsl_vector_swap(b, Ab);
+
+              c2 = fabs(gsl_vector_get(b, gsl_blas_idamax(b)));
+              gsl_blas_daxpy(1.0, b, w);
+              fnorm = fabs(gsl_vector_get(w, gsl_blas_idamax(w)));
+
+              if (c1 + c2 <= tol * fnorm)
+                break;
+
+              c1 = c2;
+            }
+
+          gsl_blas_dscal(eta, w);
+          gsl_vector_memcpy(b, w);
+        }
+
+      gsl_vector_free(b);
+      gsl_vector_free(Ab);
+
+      return GSL_SUCCESS;
+    }
+}
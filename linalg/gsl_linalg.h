@@ -87,6 +87,17 @@ int gsl_linalg_exponential_ss(
   gsl_mode_t mode
   );
 
+/* Matrix exponential by scaling and squaring with Pade approximants,
+ * following Higham, SIAM J. Matrix Anal. Appl. 26, 1179 (2005)
+ */
+int gsl_linalg_exponential_pade (const gsl_matrix * A, gsl_matrix * eA);
+
+/* Action exp(t A) v of the matrix exponential on a vector, following
+ * Al-Mohy + Higham, SIAM J. Sci. Comput. 33, 488 (2011)
+ */
+int gsl_linalg_exponential_action (const double t, const gsl_matrix * A,
+                                   const gsl_vector * v, gsl_vector * w);
+
 
 /* Householder Transformations */
 
@@ -175,6 +186,62 @@ int gsl_linalg_SV_decomp_jacobi (gsl_matrix * A,
                                  gsl_matrix * Q,
                                  gsl_vector * S);
 
+int gsl_linalg_SV_decomp_jacobi_par (gsl_matrix * A,
+                                     gsl_matrix * Q,
+                                     gsl_vector * S,
+                                     size_t * nsweep);
+
+int gsl_linalg_SV_decomp_dc (gsl_matrix * A,
+                             gsl_matrix * V,
+                             gsl_vector * S);
+
+/* Randomized truncated SVD; the M-by-N matrix A is given by the
+ * products Y = op(A) X with blocks of vectors X
+ */
+
+typedef struct
+{
+  int (* mult) (CBLAS_TRANSPOSE_t TransA, const gsl_matrix * X, void * params,
+                gsl_matrix * Y);
+  size_t size1;          /* number of rows of A */
+  size_t size2;          /* number of columns of A */
+  void * params;
+} gsl_linalg_SV_rand_function;
+
+#define GSL_SV_RAND_FN_EVAL(F,TransA,X,Y) (*((F)->mult))(TransA,X,(F)->params,Y)
+
+typedef struct
+{
+  size_t size1;          /* number of rows of A */
+  size_t size2;          /* number of columns of A */
+  size_t k;              /* number of singular values */
+  size_t l;              /* number of samples, k + oversampling */
+  gsl_matrix * Q;        /* M-by-l orthonormal basis for range of A */
+  gsl_matrix * Z;        /* N-by-l workspace */
+  gsl_matrix * T;        /* l-by-l workspace */
+  gsl_matrix * X;        /* l-by-l workspace */
+  gsl_vector * S;        /* l singular values of Q^T A */
+  gsl_vector * work;     /* workspace, length l */
+} gsl_linalg_SV_rand_workspace;
+
+/* the gsl_rng of gsl_rng.h, so that this header does not need it */
+struct gsl_rng_struct;
+
+gsl_linalg_SV_rand_workspace * gsl_linalg_SV_rand_alloc (const size_t M, const size_t N,
+                                                         const size_t k, const size_t p);
+void gsl_linalg_SV_rand_free (gsl_linalg_SV_rand_workspace * w);
+int gsl_linalg_SV_rand_range (gsl_linalg_SV_rand_function * f, const size_t q,
+                              struct gsl_rng_struct * r,
+                              gsl_linalg_SV_rand_workspace * w);
+int gsl_linalg_SV_decomp_rand_fn (gsl_linalg_SV_rand_function * f, gsl_matrix * U,
+                                  gsl_vector * S, gsl_matrix * V, const size_t q,
+                                  struct gsl_rng_struct * r,
+                                  gsl_linalg_SV_rand_workspace * w);
+int gsl_linalg_SV_decomp_rand (const gsl_matrix * A, gsl_matrix * U, gsl_vector * S,
+                               gsl_matrix * V, const size_t q,
+                               struct gsl_rng_struct * r,
+                               gsl_linalg_SV_rand_workspace * w);
+
 int
 gsl_linalg_SV_solve (const gsl_matrix * U,
                      const gsl_matrix * Q,
@@ -228,6 +295,26 @@ int gsl_linalg_LU_band_svx (const size_t lb, const size_t ub, const gsl_matrix *
 int gsl_linalg_LU_band_unpack (const size_t M, const size_t lb, const size_t ub, const gsl_matrix * LUB,
                                const gsl_vector_uint * piv, gsl_matrix * L, gsl_matrix * U);
 
+/* Batched decompositions of small matrices, stored one below the other */
+
+int gsl_linalg_LU_decomp_batch (gsl_matrix * A, gsl_vector_uint * piv);
+int gsl_linalg_LU_solve_batch (const gsl_matrix * LU, const gsl_vector_uint * piv,
+                               const gsl_vector * b, gsl_vector * x);
+int gsl_linalg_cholesky_decomp_batch (gsl_matrix * A);
+int gsl_linalg_cholesky_solve_batch (const gsl_matrix * LLT, const gsl_vector * b,
+                                     gsl_vector * x);
+int gsl_linalg_QR_decomp_batch (gsl_matrix * A, gsl_vector * tau);
+int gsl_linalg_QR_solve_batch (const gsl_matrix * QR, const gsl_vector * tau,
+                               const gsl_vector * b, gsl_vector * x);
+int gsl_linalg_SV_decomp_batch (gsl_matrix * A, gsl_matrix * V, gsl_vector * S);
+
+/* Mixed precision solvers, factoring in single precision */
+
+int gsl_linalg_LU_solve_mixed (gsl_matrix * A, gsl_permutation * p,
+                               const gsl_vector * b, gsl_vector * x, int * iter);
+int gsl_linalg_cholesky_solve_mixed (gsl_matrix * A, const gsl_vector * b,
+                                     gsl_vector * x, int * iter);
+
 /* Complex LU Decomposition */
 
 int gsl_linalg_complex_LU_decomp (gsl_matrix_complex * A, 
@@ -271,6 +358,8 @@ int gsl_linalg_QR_decomp_old (gsl_matrix * A, gsl_vector * tau);
 
 int gsl_linalg_QR_decomp_r (gsl_matrix * A, gsl_matrix * T);
 
+int gsl_linalg_QR_TSQR_decomp (gsl_matrix * A, gsl_matrix * T);
+
 int gsl_linalg_QR_solve (const gsl_matrix * QR, const gsl_vector * tau, const gsl_vector * b, gsl_vector * x);
 
 int gsl_linalg_QR_solve_r (const gsl_matrix * QR, const gsl_matrix * T, const gsl_vector * b, gsl_vector * x);
@@ -601,6 +690,10 @@ int gsl_linalg_cholesky_solve2 (const gsl_matrix * LLT,
 int gsl_linalg_cholesky_rcond (const gsl_matrix * LLT, double * rcond,
                                gsl_vector * work);
 
+int gsl_linalg_cholesky_update (gsl_matrix * LLT, gsl_matrix * V);
+
+int gsl_linalg_cholesky_downdate (gsl_matrix * LLT, gsl_matrix * V);
+
 /* Complex Cholesky Decomposition */
 
 int gsl_linalg_complex_cholesky_decomp (gsl_matrix_complex * A);
@@ -691,6 +784,10 @@ int gsl_linalg_cholesky_band_scale_apply(gsl_matrix * A, const gsl_vector * S);
 
 int gsl_linalg_cholesky_band_rcond (const gsl_matrix * LLT, double * rcond, gsl_vector * work);
 
+int gsl_linalg_cholesky_band_update (gsl_matrix * LLT, gsl_matrix * V);
+
+int gsl_linalg_cholesky_band_downdate (gsl_matrix * LLT, gsl_matrix * V);
+
 /* L D L^T decomposition */
 
 int gsl_linalg_ldlt_decomp (gsl_matrix * A);
@@ -701,6 +798,17 @@ int gsl_linalg_ldlt_svx (const gsl_matrix * LDLT, gsl_vector * x);
 
 int gsl_linalg_ldlt_rcond (const gsl_matrix * LDLT, double * rcond, gsl_vector * work);
 
+int gsl_linalg_ldlt_bk_decomp (gsl_matrix * A, gsl_permutation * p);
+
+int gsl_linalg_ldlt_bk_solve (const gsl_matrix * LDLT, const gsl_permutation * p,
+                              const gsl_vector * b, gsl_vector * x);
+
+int gsl_linalg_ldlt_bk_svx (const gsl_matrix * LDLT, const gsl_permutation * p,
+                            gsl_vector * x);
+
+int gsl_linalg_ldlt_bk_rcond (const gsl_matrix * LDLT, const gsl_permutation * p,
+                              double * rcond, gsl_vector * work);
+
 /* Banded L D L^T decomposition */
 
 int gsl_linalg_ldlt_band_decomp (gsl_matrix * A);
@@ -782,6 +890,30 @@ int gsl_linalg_solve_tridiag (const gsl_vector * diag,
                                    const gsl_vector * b,
                                    gsl_vector * x);
 
+/* Parallel linear solve for a long nonsymmetric tridiagonal system,
+ * with the same storage as gsl_linalg_solve_tridiag
+ */
+int gsl_linalg_solve_tridiag_par (const gsl_vector * diag,
+                                  const gsl_vector * abovediag,
+                                  const gsl_vector * belowdiag,
+                                  const gsl_vector * b,
+                                  gsl_vector * x);
+
+/* Linear solve for many tridiagonal systems of the same size.
+
+ * Column s of each matrix holds the vector of system s, as in
+ * gsl_linalg_solve_symm_tridiag and gsl_linalg_solve_tridiag
+ */
+int gsl_linalg_solve_symm_tridiag_batch (const gsl_matrix * diag,
+                                         const gsl_matrix * offdiag,
+                                         const gsl_matrix * B,
+                                         gsl_matrix * X);
+int gsl_linalg_solve_tridiag_batch (const gsl_matrix * diag,
+                                    const gsl_matrix * abovediag,
+                                    const gsl_matrix * belowdiag,
+                                    const gsl_matrix * B,
+                                    gsl_matrix * X);
+
 
 /* Linear solve for a symmetric cyclic tridiagonal system.
 
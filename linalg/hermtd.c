@@ -57,6 +57,31 @@
 
 #include <gsl/gsl_linalg.h>
 
+/* block size and crossover point of the blocked algorithm: the
+   trailing matrix is reduced with the unblocked algorithm once it has
+   at most HERMTD_CROSSOVER rows */
+#define HERMTD_BLOCK      32
+#define HERMTD_CROSSOVER  64
+
+static int hermtd_decomp_L2 (gsl_matrix_complex * A, gsl_vector_complex * tau);
+static int hermtd_panel (gsl_matrix_complex * A, gsl_vector_complex * tau,
+                         gsl_vector_complex * e, gsl_matrix_complex * W);
+static void hermtd_conj (gsl_vector_complex * v);
+
+/*
+gsl_linalg_hermtd_decomp()
+  Blocked tridiagonal reduction, as in LAPACK ZHETRD
+
+The reflectors of a panel of HERMTD_BLOCK columns are computed with
+the trailing matrix updated only implicitly, accumulating the matrix
+W such that the updated trailing matrix is
+
+A22 - V W^H - W V^H
+
+which is then formed with a single call to zher2k.  The reflectors
+and tau are the same as for the unblocked algorithm.
+*/
+
 int 
 gsl_linalg_hermtd_decomp (gsl_matrix_complex * A, gsl_vector_complex * tau)  
 {
@@ -69,58 +94,220 @@ gsl_linalg_hermtd_decomp (gsl_matrix_complex * A, gsl_vector_complex * tau)
     {
       GSL_ERROR ("size of tau must be (matrix size - 1)", GSL_EBADLEN);
     }
+  else if (A->size1 <= HERMTD_CROSSOVER)
+    {
+      return hermtd_decomp_L2 (A, tau);
+    }
   else
     {
       const size_t N = A->size1;
-      size_t i;
-  
-      const gsl_complex zero = gsl_complex_rect (0.0, 0.0);
-      const gsl_complex one = gsl_complex_rect (1.0, 0.0);
+      const size_t nb = HERMTD_BLOCK;
       const gsl_complex neg_one = gsl_complex_rect (-1.0, 0.0);
+      gsl_matrix_complex * W = gsl_matrix_complex_alloc (N, nb);
+      gsl_vector_complex * e = gsl_vector_complex_alloc (nb);
+      gsl_matrix_complex_view m;
+      gsl_vector_complex_view t;
+      size_t i, j;
 
-      for (i = 0 ; i < N - 1; i++)
+      if (W == NULL || e == NULL)
         {
-          gsl_vector_complex_view c = gsl_matrix_complex_column (A, i);
-          gsl_vector_complex_view v = gsl_vector_complex_subvector (&c.vector, i + 1, N - (i + 1));
-          gsl_complex tau_i = gsl_linalg_complex_householder_transform (&v.vector);
+          if (W)
+            gsl_matrix_complex_free (W);
+          if (e)
+            gsl_vector_complex_free (e);
+          GSL_ERROR ("failed to allocate workspace", GSL_ENOMEM);
+        }
+
+      for (i = 0; N - i > HERMTD_CROSSOVER; i += nb)
+        {
+          const size_t n = N - i;
+          gsl_matrix_complex_view Ai = gsl_matrix_complex_submatrix (A, i, i, n, n);
+          gsl_matrix_complex_view Wi = gsl_matrix_complex_submatrix (W, 0, 0, n, nb);
+          gsl_vector_complex_view ti = gsl_vector_complex_subvector (tau, i, nb);
+          gsl_matrix_complex_view V = gsl_matrix_complex_submatrix (A, i + nb, i, n - nb, nb);
+          gsl_matrix_complex_view W2 = gsl_matrix_complex_submatrix (W, nb, 0, n - nb, nb);
+          gsl_matrix_complex_view A22 = gsl_matrix_complex_submatrix (A, i + nb, i + nb, n - nb, n - nb);
+
+          hermtd_panel (&Ai.matrix, &ti.vector, e, &Wi.matrix);
+
+          /* A22 := A22 - V W^H - W V^H */
+          gsl_blas_zher2k (CblasLower, CblasNoTrans, neg_one, &V.matrix, &W2.matrix, 1.0, &A22.matrix);
+
+          /* restore the subdiagonal */
+          for (j = 0; j < nb; j++)
+            gsl_matrix_complex_set (A, i + j + 1, i + j, gsl_vector_complex_get (e, j));
+        }
+
+      m = gsl_matrix_complex_submatrix (A, i, i, N - i, N - i);
+      t = gsl_vector_complex_subvector (tau, i, N - i - 1);
+      hermtd_decomp_L2 (&m.matrix, &t.vector);
+
+      gsl_matrix_complex_free (W);
+      gsl_vector_complex_free (e);
+
+      return GSL_SUCCESS;
+    }
+}  
+
+/* unblocked algorithm, applying one reflector at a time */
+
+static int
+hermtd_decomp_L2 (gsl_matrix_complex * A, gsl_vector_complex * tau)
+{
+  const size_t N = A->size1;
+  size_t i;
+  
+  const gsl_complex zero = gsl_complex_rect (0.0, 0.0);
+  const gsl_complex one = gsl_complex_rect (1.0, 0.0);
+  const gsl_complex neg_one = gsl_complex_rect (-1.0, 0.0);
+
+  for (i = 0 ; i < N - 1; i++)
+    {
+      gsl_vector_complex_view c = gsl_matrix_complex_column (A, i);
+      gsl_vector_complex_view v = gsl_vector_complex_subvector (&c.vector, i + 1, N - (i + 1));
+      gsl_complex tau_i = gsl_linalg_complex_householder_transform (&v.vector);
+      
+      /* Apply the transformation H^T A H to the remaining columns */
+
+      if ((i + 1) < (N - 1) 
+          && !(GSL_REAL(tau_i) == 0.0 && GSL_IMAG(tau_i) == 0.0)) 
+        {
+          gsl_matrix_complex_view m = 
+            gsl_matrix_complex_submatrix (A, i + 1, i + 1, 
+                                          N - (i+1), N - (i+1));
+          gsl_complex ei = gsl_vector_complex_get(&v.vector, 0);
+          gsl_vector_complex_view x = gsl_vector_complex_subvector (tau, i, N-(i+1));
+          gsl_vector_complex_set (&v.vector, 0, one);
           
-          /* Apply the transformation H^T A H to the remaining columns */
-
-          if ((i + 1) < (N - 1) 
-              && !(GSL_REAL(tau_i) == 0.0 && GSL_IMAG(tau_i) == 0.0)) 
-            {
-              gsl_matrix_complex_view m = 
-                gsl_matrix_complex_submatrix (A, i + 1, i + 1, 
-                                              N - (i+1), N - (i+1));
-              gsl_complex ei = gsl_vector_complex_get(&v.vector, 0);
-              gsl_vector_complex_view x = gsl_vector_complex_subvector (tau, i, N-(i+1));
-              gsl_vector_complex_set (&v.vector, 0, one);
-              
-              /* x = tau * A * v */
-              gsl_blas_zhemv (CblasLower, tau_i, &m.matrix, &v.vector, zero, &x.vector);
-
-              /* w = x - (1/2) tau * (x' * v) * v  */
-              {
-                gsl_complex xv, txv, alpha;
-                gsl_blas_zdotc(&x.vector, &v.vector, &xv);
-                txv = gsl_complex_mul(tau_i, xv);
-                alpha = gsl_complex_mul_real(txv, -0.5);
-                gsl_blas_zaxpy(alpha, &v.vector, &x.vector);
-              }
-              
-              /* apply the transformation A = A - v w' - w v' */
-              gsl_blas_zher2(CblasLower, neg_one, &v.vector, &x.vector, &m.matrix);
-
-              gsl_vector_complex_set (&v.vector, 0, ei);
-            }
+          /* x = tau * A * v */
+          gsl_blas_zhemv (CblasLower, tau_i, &m.matrix, &v.vector, zero, &x.vector);
+
+          /* w = x - (1/2) tau * (x' * v) * v  */
+          {
+            gsl_complex xv, txv, alpha;
+            gsl_blas_zdotc(&x.vector, &v.vector, &xv);
+            txv = gsl_complex_mul(tau_i, xv);
+            alpha = gsl_complex_mul_real(txv, -0.5);
+            gsl_blas_zaxpy(alpha, &v.vector, &x.vector);
+          }
           
-          gsl_vector_complex_set (tau, i, tau_i);
+          /* apply the transformation A = A - v w' - w v' */
+          gsl_blas_zher2(CblasLower, neg_one, &v.vector, &x.vector, &m.matrix);
+
+          gsl_vector_complex_set (&v.vector, 0, ei);
         }
       
-      return GSL_SUCCESS;
+      gsl_vector_complex_set (tau, i, tau_i);
     }
-}  
+  
+  return GSL_SUCCESS;
+}
+
+/*
+hermtd_panel()
+  Reduce the first nb = W->size2 columns of the n-by-n matrix A, as in
+LAPACK ZLATRD
+
+Inputs: A   - n-by-n trailing matrix, n > nb
+        tau - (output) Householder coefficients, length nb
+        e   - (output) subdiagonal elements, length nb
+        W   - (output) n-by-nb matrix W; rows nb:n-1 are used for the
+              update of the trailing matrix
+
+Notes:
+1) On output the leading elements of the Householder vectors, below
+the diagonal of A, are set to 1 so that the vectors can be used in the
+update; the subdiagonal is stored in e.
+
+2) Column i of W is computed as in the unblocked algorithm, with the
+product A22 v_i corrected for the updates of the previous reflectors
+in the panel, which have not yet been applied to A22.
+*/
+
+static int
+hermtd_panel (gsl_matrix_complex * A, gsl_vector_complex * tau,
+              gsl_vector_complex * e, gsl_matrix_complex * W)
+{
+  const size_t n = A->size1;
+  const size_t nb = W->size2;
+  const gsl_complex zero = gsl_complex_rect (0.0, 0.0);
+  const gsl_complex one = gsl_complex_rect (1.0, 0.0);
+  const gsl_complex neg_one = gsl_complex_rect (-1.0, 0.0);
+  size_t i;
+
+  for (i = 0; i < nb; i++)
+    {
+      gsl_vector_complex_view ai = gsl_matrix_complex_subcolumn (A, i, i, n - i);
+      gsl_vector_complex_view v = gsl_matrix_complex_subcolumn (A, i, i + 1, n - i - 1);
+      gsl_vector_complex_view wi = gsl_matrix_complex_subcolumn (W, i, i + 1, n - i - 1);
+      gsl_matrix_complex_view m = gsl_matrix_complex_submatrix (A, i + 1, i + 1, n - i - 1, n - i - 1);
+      gsl_complex tau_i, wv, alpha;
+
+      if (i > 0)
+        {
+          /* apply the previous reflectors to column i:
+             A(i:n,i) -= V(i:n,:) W(i,:)^H + W(i:n,:) V(i,:)^H */
+          gsl_matrix_complex_view Vi = gsl_matrix_complex_submatrix (A, i, 0, n - i, i);
+          gsl_matrix_complex_view Wi = gsl_matrix_complex_submatrix (W, i, 0, n - i, i);
+          gsl_vector_complex_view vr = gsl_matrix_complex_subrow (A, i, 0, i);
+          gsl_vector_complex_view wr = gsl_matrix_complex_subrow (W, i, 0, i);
+
+          hermtd_conj (&wr.vector);
+          gsl_blas_zgemv (CblasNoTrans, neg_one, &Vi.matrix, &wr.vector, one, &ai.vector);
+          hermtd_conj (&wr.vector);
+
+          hermtd_conj (&vr.vector);
+          gsl_blas_zgemv (CblasNoTrans, neg_one, &Wi.matrix, &vr.vector, one, &ai.vector);
+          hermtd_conj (&vr.vector);
+
+          /* the diagonal element is real */
+          GSL_IMAG (*gsl_matrix_complex_ptr (A, i, i)) = 0.0;
+        }
 
+      tau_i = gsl_linalg_complex_householder_transform (&v.vector);
+      gsl_vector_complex_set (e, i, gsl_vector_complex_get (&v.vector, 0));
+      gsl_vector_complex_set (&v.vector, 0, one);
+      gsl_vector_complex_set (tau, i, tau_i);
+
+      /* w = A22 v - V (W^H v) - W (V^H v), using W(0:i,i) as workspace */
+
+      gsl_blas_zhemv (CblasLower, one, &m.matrix, &v.vector, zero, &wi.vector);
+
+      if (i > 0)
+        {
+          gsl_matrix_complex_view V2 = gsl_matrix_complex_submatrix (A, i + 1, 0, n - i - 1, i);
+          gsl_matrix_complex_view W2 = gsl_matrix_complex_submatrix (W, i + 1, 0, n - i - 1, i);
+          gsl_vector_complex_view x = gsl_matrix_complex_subcolumn (W, i, 0, i);
+
+          gsl_blas_zgemv (CblasConjTrans, one, &W2.matrix, &v.vector, zero, &x.vector);
+          gsl_blas_zgemv (CblasNoTrans, neg_one, &V2.matrix, &x.vector, one, &wi.vector);
+          gsl_blas_zgemv (CblasConjTrans, one, &V2.matrix, &v.vector, zero, &x.vector);
+          gsl_blas_zgemv (CblasNoTrans, neg_one, &W2.matrix, &x.vector, one, &wi.vector);
+        }
+
+      /* w = tau w - (1/2) tau (w' v) v */
+      gsl_blas_zscal (tau_i, &wi.vector);
+      gsl_blas_zdotc (&wi.vector, &v.vector, &wv);
+      alpha = gsl_complex_mul_real (gsl_complex_mul (tau_i, wv), -0.5);
+      gsl_blas_zaxpy (alpha, &v.vector, &wi.vector);
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* v := conj(v) */
+
+static void
+hermtd_conj (gsl_vector_complex * v)
+{
+  size_t i;
+
+  for (i = 0; i < v->size; i++)
+    {
+      gsl_complex * vi = gsl_vector_complex_ptr (v, i);
+      GSL_IMAG (*vi) = -GSL_IMAG (*vi);
+    }
+}
 
 /*  Form the orthogonal matrix U from the packed QR matrix */
 
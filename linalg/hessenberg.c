@@ -21,6 +21,21 @@
 #include <gsl/gsl_linalg.h>
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_vector.h>
+#include <gsl/gsl_blas.h>
+
+/*
+ * The reduction is blocked as in LAPACK DGEHRD for matrices with more
+ * than HESSENBERG_CROSSOVER columns.  The last HESSENBERG_CROSSOVER
+ * columns are always reduced with the unblocked algorithm.
+ */
+#define HESSENBERG_BLOCK      32
+#define HESSENBERG_CROSSOVER  64
+
+static int hessenberg_decomp_L2 (gsl_matrix * A, gsl_vector * tau, const size_t j);
+static int hessenberg_panel (gsl_matrix * A, gsl_vector * tau, const size_t k,
+                             gsl_matrix * T, gsl_matrix * Y, gsl_vector * work);
+static void hessenberg_block_T (const gsl_matrix * Y, const gsl_vector * tau,
+                                gsl_matrix * T);
 
 /*
 gsl_linalg_hessenberg_decomp()
@@ -61,6 +76,19 @@ row i + 3, column i, and so on.
 Also note that for the purposes of computing U(i),
 v(1:i) = 0, v(i + 1) = 1, and v(i+2:n) is what is stored in
 column i of A beneath the subdiagonal.
+
+For large matrices the reflectors of a panel of HESSENBERG_BLOCK
+columns are computed together with the matrices Y = A V T and T of
+the block reflector
+
+U(i) ... U(i + nb - 1) = I - V T V^t
+
+(Quintana-Orti and van de Geijn, "Improving the performance of
+reduction to Hessenberg form", ACM TOMS 32, 2006). The rest of the
+matrix is then updated with level 3 BLAS, from the right with
+A := A - Y V^t and from the left with the block reflector. The
+reflectors and tau are the same as for the unblocked algorithm, up
+to rounding errors.
 */
 
 int
@@ -82,53 +110,341 @@ gsl_linalg_hessenberg_decomp(gsl_matrix *A, gsl_vector *tau)
       /* nothing to do */
       return GSL_SUCCESS;
     }
+  else if (N <= HESSENBERG_CROSSOVER)
+    {
+      return hessenberg_decomp_L2 (A, tau, 0);
+    }
   else
     {
-      size_t i;           /* looping */
-      gsl_vector_view c,  /* matrix column */
-                      hv; /* householder vector */
-      gsl_matrix_view m;
-      double tau_i;       /* beta in algorithm 7.4.2 */
+      const size_t nb = HESSENBERG_BLOCK;
+      gsl_matrix * Y = gsl_matrix_alloc (N, nb);
+      gsl_matrix * W = gsl_matrix_alloc (N, nb);
+      gsl_vector * work = gsl_vector_alloc (2 * N);
+      double T_data[HESSENBERG_BLOCK * HESSENBERG_BLOCK];
+      gsl_matrix_view T = gsl_matrix_view_array (T_data, nb, nb);
+      size_t i, j, k;
+
+      if (Y == NULL || W == NULL || work == NULL)
+        {
+          if (Y)
+            gsl_matrix_free (Y);
+          if (W)
+            gsl_matrix_free (W);
+          GSL_ERROR ("failed to allocate workspace", GSL_ENOMEM);
+        }
 
-      for (i = 0; i < N - 2; ++i)
+      for (i = 0; N - i > HESSENBERG_CROSSOVER; i += nb)
         {
-          /*
-           * make a copy of A(i + 1:n, i) and store it in the section
-           * of 'tau' that we haven't stored coefficients in yet
-           */
+          const size_t n2 = N - i - nb;   /* columns right of the panel */
+          gsl_matrix_view V1 = gsl_matrix_submatrix (A, i + 1, i, nb, nb);
+          gsl_matrix_view V2 = gsl_matrix_submatrix (A, i + nb + 1, i, n2 - 1, nb);
+          gsl_matrix_view C1 = gsl_matrix_submatrix (A, i + 1, i + nb, nb, n2);
+          gsl_matrix_view C2 = gsl_matrix_submatrix (A, i + nb + 1, i + nb, n2 - 1, n2);
+          gsl_matrix_view Wn = gsl_matrix_submatrix (W, 0, 0, n2, nb);
+          double ei;
+
+          hessenberg_panel (A, tau, i, &T.matrix, Y, work);
+
+          /* right update A(:, i+nb:N) := A(:, i+nb:N) - Y V(i+nb:N,:)^t,
+             with the unit element of the last reflector in place */
+          {
+            gsl_matrix_view Vb = gsl_matrix_submatrix (A, i + nb, i, n2, nb);
+            gsl_matrix_view A2 = gsl_matrix_submatrix (A, 0, i + nb, N, n2);
+
+            ei = gsl_matrix_get (A, i + nb, i + nb - 1);
+            gsl_matrix_set (A, i + nb, i + nb - 1, 1.0);
+            gsl_blas_dgemm (CblasNoTrans, CblasTrans, -1.0, Y, &Vb.matrix,
+                            1.0, &A2.matrix);
+            gsl_matrix_set (A, i + nb, i + nb - 1, ei);
+          }
+
+          /* right update of the panel columns above row i + 1, which
+             were not updated by hessenberg_panel */
+          {
+            gsl_matrix_view Y1 = gsl_matrix_submatrix (Y, 0, 0, i + 1, nb - 1);
+            gsl_matrix_view Vt = gsl_matrix_submatrix (A, i + 1, i, nb - 1, nb - 1);
+            gsl_matrix_view A1 = gsl_matrix_submatrix (A, 0, i + 1, i + 1, nb - 1);
+
+            gsl_blas_dtrmm (CblasRight, CblasLower, CblasTrans, CblasUnit,
+                            1.0, &Vt.matrix, &Y1.matrix);
+            gsl_matrix_sub (&A1.matrix, &Y1.matrix);
+          }
+
+          /* left update A(i+1:N, i+nb:N) := (I - V T^t V^t) A(i+1:N, i+nb:N),
+             using W = A^t V T */
+          gsl_matrix_transpose_memcpy (&Wn.matrix, &C1.matrix);
+          gsl_blas_dtrmm (CblasRight, CblasLower, CblasNoTrans, CblasUnit,
+                          1.0, &V1.matrix, &Wn.matrix);
+          gsl_blas_dgemm (CblasTrans, CblasNoTrans, 1.0, &C2.matrix, &V2.matrix,
+                          1.0, &Wn.matrix);
+          gsl_blas_dtrmm (CblasRight, CblasUpper, CblasNoTrans, CblasNonUnit,
+                          1.0, &T.matrix, &Wn.matrix);
+          gsl_blas_dgemm (CblasNoTrans, CblasTrans, -1.0, &V2.matrix, &Wn.matrix,
+                          1.0, &C2.matrix);
+          gsl_blas_dtrmm (CblasRight, CblasLower, CblasTrans, CblasUnit,
+                          1.0, &V1.matrix, &Wn.matrix);
+
+          for (j = 0; j < nb; j++)
+            {
+              for (k = 0; k < n2; k++)
+                {
+                  double * ptr = gsl_matrix_ptr (&C1.matrix, j, k);
+                  *ptr -= gsl_matrix_get (&Wn.matrix, k, j);
+                }
+            }
+        }
 
-          c = gsl_matrix_subcolumn(A, i, i + 1, N - i - 1);
+      hessenberg_decomp_L2 (A, tau, i);
 
-          hv = gsl_vector_subvector(tau, i + 1, N - (i + 1));
-          gsl_vector_memcpy(&hv.vector, &c.vector);
+      gsl_matrix_free (Y);
+      gsl_matrix_free (W);
+      gsl_vector_free (work);
 
-          /* compute householder transformation of A(i+1:n,i) */
-          tau_i = gsl_linalg_householder_transform(&hv.vector);
+      return GSL_SUCCESS;
+    }
+} /* gsl_linalg_hessenberg_decomp() */
 
-          /* apply left householder matrix (I - tau_i v v') to A */
-          m = gsl_matrix_submatrix(A, i + 1, i, N - (i + 1), N - i);
-          gsl_linalg_householder_hm(tau_i, &hv.vector, &m.matrix);
+/* reduce columns j:N-3 of A with the unblocked algorithm 7.4.2;
+   columns 0:j-1 must already be reduced */
 
-          /* apply right householder matrix (I - tau_i v v') to A */
-          m = gsl_matrix_submatrix(A, 0, i + 1, N, N - (i + 1));
-          gsl_linalg_householder_mh(tau_i, &hv.vector, &m.matrix);
+static int
+hessenberg_decomp_L2 (gsl_matrix * A, gsl_vector * tau, const size_t j)
+{
+  const size_t N = A->size1;
+  size_t i;           /* looping */
+  gsl_vector_view c,  /* matrix column */
+                  hv; /* householder vector */
+  gsl_matrix_view m;
+  double tau_i;       /* beta in algorithm 7.4.2 */
 
-          /* save Householder coefficient */
-          gsl_vector_set(tau, i, tau_i);
+  for (i = j; i < N - 2; ++i)
+    {
+      /*
+       * make a copy of A(i + 1:n, i) and store it in the section
+       * of 'tau' that we haven't stored coefficients in yet
+       */
+
+      c = gsl_matrix_subcolumn(A, i, i + 1, N - i - 1);
+
+      hv = gsl_vector_subvector(tau, i + 1, N - (i + 1));
+      gsl_vector_memcpy(&hv.vector, &c.vector);
+
+      /* compute householder transformation of A(i+1:n,i) */
+      tau_i = gsl_linalg_householder_transform(&hv.vector);
+
+      /* apply left householder matrix (I - tau_i v v') to A */
+      m = gsl_matrix_submatrix(A, i + 1, i, N - (i + 1), N - i);
+      gsl_linalg_householder_hm(tau_i, &hv.vector, &m.matrix);
+
+      /* apply right householder matrix (I - tau_i v v') to A */
+      m = gsl_matrix_submatrix(A, 0, i + 1, N, N - (i + 1));
+      gsl_linalg_householder_mh(tau_i, &hv.vector, &m.matrix);
+
+      /* save Householder coefficient */
+      gsl_vector_set(tau, i, tau_i);
+
+      /*
+       * store Householder vector below the subdiagonal in column
+       * i of the matrix. hv(1) does not need to be stored since
+       * it is always 1.
+       */
+      c = gsl_vector_subvector(&c.vector, 1, c.vector.size - 1);
+      hv = gsl_vector_subvector(&hv.vector, 1, hv.vector.size - 1);
+      gsl_vector_memcpy(&c.vector, &hv.vector);
+    }
 
-          /*
-           * store Householder vector below the subdiagonal in column
-           * i of the matrix. hv(1) does not need to be stored since
-           * it is always 1.
-           */
-          c = gsl_vector_subvector(&c.vector, 1, c.vector.size - 1);
-          hv = gsl_vector_subvector(&hv.vector, 1, hv.vector.size - 1);
-          gsl_vector_memcpy(&c.vector, &hv.vector);
+  return GSL_SUCCESS;
+}
+
+/*
+hessenberg_panel()
+  Reduce the HESSENBERG_BLOCK columns k:k+nb-1 of A, as in LAPACK
+DLAHR2
+
+Each column is first brought up to date with the right reflectors
+of the previous columns of the panel, A := A - Y V^t, and the left
+reflectors, A := (I - V T^t V^t) A, before its reflector is
+computed. The rest of the matrix is not modified.
+
+Inputs: A    - N-by-N matrix, with columns 0:k-1 reduced
+        tau  - (output) Householder coefficients of the panel
+        k    - first column of the panel
+        T    - (output) nb-by-nb upper triangular factor of the block
+               reflector
+        Y    - (output) N-by-nb matrix Y = A V T
+        work - workspace, length 2*N
+*/
+
+static int
+hessenberg_panel (gsl_matrix * A, gsl_vector * tau, const size_t k,
+                  gsl_matrix * T, gsl_matrix * Y, gsl_vector * work)
+{
+  const size_t N = A->size1;
+  const size_t nb = T->size1;
+  const size_t m = N - k - 1;
+  double w_data[HESSENBERG_BLOCK];
+  double ei = 0.0;
+  size_t j, l;
+
+  /* b is a contiguous copy of the column A(k+1:N, c) being reduced,
+     y a contiguous copy of a column of Y */
+  gsl_vector_view b = gsl_vector_subvector (work, 0, m);
+  gsl_vector_view y = gsl_vector_subvector (work, N, m);
+
+  for (j = 0; j < nb; j++)
+    {
+      const size_t c = k + j;
+      gsl_vector_view Ac = gsl_matrix_subcolumn (A, c, k + 1, m);
+      gsl_vector_view b2 = gsl_vector_subvector (&b.vector, j, m - j);
+      double tau_j;
+
+      gsl_vector_memcpy (&b.vector, &Ac.vector);
+
+      if (j > 0)
+        {
+          gsl_matrix_view Yj = gsl_matrix_submatrix (Y, k + 1, 0, m, j);
+          gsl_matrix_view V1 = gsl_matrix_submatrix (A, k + 1, k, j, j);
+          gsl_matrix_view V2 = gsl_matrix_submatrix (A, c + 1, k, m - j, j);
+          gsl_matrix_view Tj = gsl_matrix_submatrix (T, 0, 0, j, j);
+          gsl_vector_view vc = gsl_matrix_subrow (A, c, k, j);
+          gsl_vector_view b1 = gsl_vector_subvector (&b.vector, 0, j);
+          gsl_vector_view w = gsl_vector_view_array (w_data, j);
+
+          /* b := b - Y V(c,:)^t */
+          gsl_blas_dgemv (CblasNoTrans, -1.0, &Yj.matrix, &vc.vector, 1.0, &b.vector);
+
+          /* b := (I - V T^t V^t) b */
+          gsl_vector_memcpy (&w.vector, &b1.vector);
+          gsl_blas_dtrmv (CblasLower, CblasTrans, CblasUnit, &V1.matrix, &w.vector);
+          gsl_blas_dgemv (CblasTrans, 1.0, &V2.matrix, &b2.vector, 1.0, &w.vector);
+          gsl_blas_dtrmv (CblasUpper, CblasTrans, CblasNonUnit, &Tj.matrix, &w.vector);
+          gsl_blas_dgemv (CblasNoTrans, -1.0, &V2.matrix, &w.vector, 1.0, &b2.vector);
+          gsl_blas_dtrmv (CblasLower, CblasNoTrans, CblasUnit, &V1.matrix, &w.vector);
+          gsl_vector_sub (&b1.vector, &w.vector);
+
+          /* restore the subdiagonal element of the previous column */
+          gsl_matrix_set (A, c, c - 1, ei);
         }
 
-      return GSL_SUCCESS;
+      /* reflector annihilating A(c+2:N, c), with v(0) = 1 kept in b */
+      tau_j = gsl_linalg_householder_transform (&b2.vector);
+      ei = gsl_vector_get (&b2.vector, 0);
+      gsl_vector_set (&b2.vector, 0, 1.0);
+      gsl_vector_memcpy (&Ac.vector, &b.vector);
+      gsl_vector_set (tau, c, tau_j);
+
+      /* y = tau_j (A(k+1:N, c+1:N) v - Y T(0:j, j)), where
+         T(0:j, j) = V^t v */
+      {
+        gsl_matrix_view A2 = gsl_matrix_submatrix (A, k + 1, c + 1, m, m - j);
+
+        gsl_blas_dgemv (CblasNoTrans, 1.0, &A2.matrix, &b2.vector, 0.0, &y.vector);
+      }
+
+      if (j > 0)
+        {
+          gsl_matrix_view Yj = gsl_matrix_submatrix (Y, k + 1, 0, m, j);
+          gsl_matrix_view V2 = gsl_matrix_submatrix (A, c + 1, k, m - j, j);
+          gsl_matrix_view Tj = gsl_matrix_submatrix (T, 0, 0, j, j);
+          gsl_vector_view w = gsl_vector_view_array (w_data, j);
+
+          gsl_blas_dgemv (CblasTrans, 1.0, &V2.matrix, &b2.vector, 0.0, &w.vector);
+          gsl_blas_dgemv (CblasNoTrans, -1.0, &Yj.matrix, &w.vector, 1.0, &y.vector);
+
+          /* T(0:j, j) = -tau_j T(0:j, 0:j) V^t v */
+          gsl_blas_dtrmv (CblasUpper, CblasNoTrans, CblasNonUnit, &Tj.matrix, &w.vector);
+
+          for (l = 0; l < j; l++)
+            gsl_matrix_set (T, l, j, -tau_j * w_data[l]);
+        }
+
+      for (l = j + 1; l < nb; l++)
+        gsl_matrix_set (T, l, j, 0.0);
+
+      gsl_matrix_set (T, j, j, tau_j);
+
+      gsl_vector_scale (&y.vector, tau_j);
+
+      {
+        gsl_vector_view Ycol = gsl_matrix_subcolumn (Y, j, k + 1, m);
+        gsl_vector_memcpy (&Ycol.vector, &y.vector);
+      }
     }
-} /* gsl_linalg_hessenberg_decomp() */
+
+  gsl_matrix_set (A, k + nb, k + nb - 1, ei);
+
+  /* Y(0:k+1, :) = A(0:k+1, k+1:N) V T */
+  {
+    gsl_matrix_view Y1 = gsl_matrix_submatrix (Y, 0, 0, k + 1, nb);
+    gsl_matrix_view A1 = gsl_matrix_submatrix (A, 0, k + 1, k + 1, nb);
+    gsl_matrix_view A2 = gsl_matrix_submatrix (A, 0, k + nb + 1, k + 1, m - nb);
+    gsl_matrix_view V1 = gsl_matrix_submatrix (A, k + 1, k, nb, nb);
+    gsl_matrix_view V2 = gsl_matrix_submatrix (A, k + nb + 1, k, m - nb, nb);
+
+    gsl_matrix_memcpy (&Y1.matrix, &A1.matrix);
+    gsl_blas_dtrmm (CblasRight, CblasLower, CblasNoTrans, CblasUnit,
+                    1.0, &V1.matrix, &Y1.matrix);
+    gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, &A2.matrix, &V2.matrix,
+                    1.0, &Y1.matrix);
+    gsl_blas_dtrmm (CblasRight, CblasUpper, CblasNoTrans, CblasNonUnit,
+                    1.0, T, &Y1.matrix);
+  }
+
+  return GSL_SUCCESS;
+}
+
+/*
+hessenberg_block_T()
+  Compute the upper triangular matrix T of the block reflector
+
+U(0) U(1) ... U(nb - 1) = I - Y T Y^t
+
+where Y is unit lower trapezoidal with the Householder vectors in
+its columns, as in LAPACK DLARFT. The elements of Y on and above the
+diagonal are not referenced.
+*/
+
+static void
+hessenberg_block_T (const gsl_matrix * Y, const gsl_vector * tau,
+                    gsl_matrix * T)
+{
+  const size_t m = Y->size1;
+  const size_t nb = Y->size2;
+  size_t j, k;
+
+  for (j = 0; j < nb; ++j)
+    {
+      const double tau_j = gsl_vector_get (tau, j);
+
+      gsl_matrix_set (T, j, j, tau_j);
+
+      if (j > 0)
+        {
+          gsl_vector_view z = gsl_matrix_subcolumn (T, j, 0, j);
+          gsl_matrix_const_view Tj = gsl_matrix_const_submatrix (T, 0, 0, j, j);
+
+          /* z = -tau_j Y(:, 0:j-1)^t y_j, with y_j(j) = 1 */
+          for (k = 0; k < j; ++k)
+            gsl_vector_set (&z.vector, k, gsl_matrix_get (Y, j, k));
+
+          if (j + 1 < m)
+            {
+              gsl_matrix_const_view Yb = gsl_matrix_const_submatrix (Y, j + 1, 0, m - j - 1, j);
+              gsl_vector_const_view yj = gsl_matrix_const_subcolumn (Y, j, j + 1, m - j - 1);
+
+              gsl_blas_dgemv (CblasTrans, 1.0, &Yb.matrix, &yj.vector, 1.0, &z.vector);
+            }
+
+          gsl_vector_scale (&z.vector, -tau_j);
+
+          /* T(0:j-1, j) = T(0:j-1, 0:j-1) z */
+          gsl_blas_dtrmv (CblasUpper, CblasNoTrans, CblasNonUnit, &Tj.matrix, &z.vector);
+        }
+
+      for (k = j + 1; k < nb; ++k)
+        gsl_matrix_set (T, k, j, 0.0);
+    }
+}
 
 /*
 gsl_linalg_hessenberg_unpack()
@@ -201,6 +517,9 @@ Notes: 1) On input, V needs to be initialized. The Householder matrices
 
        2) V does not have to be square, but must have the same
           number of columns as the order of H
+
+       3) For large matrices the Householder matrices are applied
+          in blocks of HESSENBERG_BLOCK with level 3 BLAS
 */
 
 int
@@ -224,7 +543,7 @@ gsl_linalg_hessenberg_unpack_accum(gsl_matrix * H, gsl_vector * tau,
     }
   else
     {
-      size_t j;           /* looping */
+      size_t j = 0;       /* looping */
       double tau_j;       /* householder coefficient */
       gsl_vector_view c,  /* matrix column */
                       hv; /* householder vector */
@@ -236,7 +555,57 @@ gsl_linalg_hessenberg_unpack_accum(gsl_matrix * H, gsl_vector * tau,
           return GSL_SUCCESS;
         }
 
-      for (j = 0; j < (N - 2); ++j)
+      if (N > HESSENBERG_CROSSOVER)
+        {
+          /*
+           * apply the reflectors in blocks of HESSENBERG_BLOCK,
+           *
+           * V -> V * U(j) ... U(j + nb - 1) = V * (I - Y T Y^t)
+           */
+          const size_t M = V->size1;
+          const size_t nb = HESSENBERG_BLOCK;
+          gsl_matrix * W = gsl_matrix_alloc (M, nb);
+          double T_data[HESSENBERG_BLOCK * HESSENBERG_BLOCK];
+          gsl_matrix_view T = gsl_matrix_view_array (T_data, nb, nb);
+
+          if (W == NULL)
+            {
+              GSL_ERROR ("failed to allocate workspace", GSL_ENOMEM);
+            }
+
+          for (j = 0; j + nb <= N - 2; j += nb)
+            {
+              const size_t n1 = N - j - 1;  /* rows of Y */
+              gsl_matrix_view Y = gsl_matrix_submatrix (H, j + 1, j, n1, nb);
+              gsl_matrix_view Y1 = gsl_matrix_submatrix (H, j + 1, j, nb, nb);
+              gsl_matrix_view Y2 = gsl_matrix_submatrix (H, j + nb + 1, j, n1 - nb, nb);
+              gsl_matrix_view V1 = gsl_matrix_submatrix (V, 0, j + 1, M, nb);
+              gsl_matrix_view V2 = gsl_matrix_submatrix (V, 0, j + nb + 1, M, n1 - nb);
+              gsl_vector_view t = gsl_vector_subvector (tau, j, nb);
+
+              hessenberg_block_T (&Y.matrix, &t.vector, &T.matrix);
+
+              /* W = V(:, j+1:N) Y T */
+              gsl_matrix_memcpy (W, &V1.matrix);
+              gsl_blas_dtrmm (CblasRight, CblasLower, CblasNoTrans, CblasUnit,
+                              1.0, &Y1.matrix, W);
+              gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, &V2.matrix,
+                              &Y2.matrix, 1.0, W);
+              gsl_blas_dtrmm (CblasRight, CblasUpper, CblasNoTrans, CblasNonUnit,
+                              1.0, &T.matrix, W);
+
+              /* V(:, j+1:N) -= W Y^t */
+              gsl_blas_dgemm (CblasNoTrans, CblasTrans, -1.0, W, &Y2.matrix,
+                              1.0, &V2.matrix);
+              gsl_blas_dtrmm (CblasRight, CblasLower, CblasTrans, CblasUnit,
+                              1.0, &Y1.matrix, W);
+              gsl_matrix_sub (&V1.matrix, W);
+            }
+
+          gsl_matrix_free (W);
+        }
+
+      for (; j < (N - 2); ++j)
         {
           c = gsl_matrix_column(H, j);
 
@@ -431,3 +800,4 @@ gsl_linalg_hessenberg_submatrix(gsl_matrix *M, gsl_matrix *A, size_t top,
       return GSL_SUCCESS;
     }
 } /* gsl_linalg_hessenberg_submatrix() */
+
@@ -0,0 +1,737 @@
+/* linalg/ldlt_bk.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* L D L^T decomposition of a symmetric indefinite matrix with
+ * Bunch-Kaufman pivoting */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_permutation.h>
+#include <gsl/gsl_permute_vector.h>
+#include <gsl/gsl_linalg.h>
+
+/* block size and crossover point of the blocked algorithm: the
+   trailing matrix is factored with the unblocked algorithm once it has
+   at most LDLT_BK_CROSSOVER rows */
+#define LDLT_BK_BLOCK      32
+#define LDLT_BK_CROSSOVER  64
+
+/* Bunch-Kaufman threshold (1 + sqrt(17)) / 8, which minimizes the
+   bound on element growth */
+#define LDLT_BK_ALPHA      0.6403882032022076
+
+static int ldlt_bk_L2 (gsl_matrix * A, const size_t k0, gsl_permutation * p);
+static int ldlt_bk_panel (gsl_matrix * A, const size_t k0, gsl_permutation * p,
+                          gsl_matrix * W, size_t * kb);
+static void ldlt_bk_interchange (gsl_matrix * A, const size_t k, const size_t kk,
+                                 const size_t kp);
+static int ldlt_bk_Dsolve (const gsl_matrix * LDLT, gsl_vector * x);
+static double ldlt_bk_norm1 (const gsl_matrix * A);
+static int ldlt_bk_Ainv (CBLAS_TRANSPOSE_t TransA, gsl_vector * x, void * params);
+
+typedef struct
+{
+  const gsl_matrix * LDLT;
+  const gsl_permutation * perm;
+} ldlt_bk_params;
+
+/*
+gsl_linalg_ldlt_bk_decomp()
+  Perform the pivoted L D L^T decomposition of a symmetric
+indefinite matrix using lower triangle
+
+P A P^T = L D L^T
+
+Inputs: A - (input) symmetric nonsingular matrix
+            (output) lower triangle contains L factor;
+                     diagonal and superdiagonal contain D
+        p - (output) permutation matrix P
+
+Return: success/error
+
+Notes:
+1) D is block diagonal with 1-by-1 and 2-by-2 blocks, chosen with
+the Bunch-Kaufman pivoting strategy (Golub and Van Loan, Matrix
+Computations (4th ed), section 4.4.4). A 2-by-2 block in rows k,k+1
+has a nonzero element D(k,k+1), which is stored in A(k,k+1); for
+1-by-1 blocks A(k,k+1) = 0. The element L(k+1,k) of a 2-by-2 block is
+zero, so that L is the unit lower triangle of A.
+
+2) Unlike LAPACK DSYTRF, the interchanges are applied to the whole of
+L, so that p is a single permutation of the rows and columns of A.
+
+3) For large matrices, the factorization proceeds in panels of
+LDLT_BK_BLOCK columns as in LAPACK DLASYF, with the trailing matrix
+updated once per panel with level 3 BLAS.
+
+4) The 1-norm ||A||_1 of the original matrix is stored in the upper right
+corner on output for N > 2
+*/
+
+int
+gsl_linalg_ldlt_bk_decomp (gsl_matrix * A, gsl_permutation * p)
+{
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+
+  if (M != N)
+    {
+      GSL_ERROR ("LDLT decomposition requires square matrix", GSL_ENOTSQR);
+    }
+  else if (p->size != N)
+    {
+      GSL_ERROR ("permutation length must match matrix size", GSL_EBADLEN);
+    }
+  else
+    {
+      double anorm;
+      size_t k = 0;
+      int status;
+
+      gsl_permutation_init (p);
+
+      /* compute ||A||_1 */
+      anorm = ldlt_bk_norm1 (A);
+
+      if (N > LDLT_BK_CROSSOVER)
+        {
+          gsl_matrix * W = gsl_matrix_alloc (N, LDLT_BK_BLOCK);
+          size_t kb;
+
+          if (W == NULL)
+            {
+              GSL_ERROR ("failed to allocate workspace", GSL_ENOMEM);
+            }
+
+          while (N - k > LDLT_BK_CROSSOVER)
+            {
+              gsl_matrix_view Wk = gsl_matrix_submatrix (W, 0, 0, N - k, LDLT_BK_BLOCK);
+
+              status = ldlt_bk_panel (A, k, p, &Wk.matrix, &kb);
+              if (status)
+                {
+                  gsl_matrix_free (W);
+                  return status;
+                }
+
+              k += kb;
+            }
+
+          gsl_matrix_free (W);
+        }
+
+      status = ldlt_bk_L2 (A, k, p);
+      if (status)
+        return status;
+
+      /* save ||A||_1 in upper right corner */
+      if (N > 2)
+        gsl_matrix_set (A, 0, N - 1, anorm);
+
+      return GSL_SUCCESS;
+    }
+}
+
+int
+gsl_linalg_ldlt_bk_solve (const gsl_matrix * LDLT,
+                          const gsl_permutation * p,
+                          const gsl_vector * b,
+                          gsl_vector * x)
+{
+  if (LDLT->size1 != LDLT->size2)
+    {
+      GSL_ERROR ("LDLT matrix must be square", GSL_ENOTSQR);
+    }
+  else if (LDLT->size1 != p->size)
+    {
+      GSL_ERROR ("matrix size must match permutation size", GSL_EBADLEN);
+    }
+  else if (LDLT->size1 != b->size)
+    {
+      GSL_ERROR ("matrix size must match b size", GSL_EBADLEN);
+    }
+  else if (LDLT->size2 != x->size)
+    {
+      GSL_ERROR ("matrix size must match solution size", GSL_EBADLEN);
+    }
+  else
+    {
+      int status;
+
+      /* copy x <- b */
+      gsl_vector_memcpy (x, b);
+
+      status = gsl_linalg_ldlt_bk_svx (LDLT, p, x);
+
+      return status;
+    }
+}
+
+int
+gsl_linalg_ldlt_bk_svx (const gsl_matrix * LDLT,
+                        const gsl_permutation * p,
+                        gsl_vector * x)
+{
+  if (LDLT->size1 != LDLT->size2)
+    {
+      GSL_ERROR ("LDLT matrix must be square", GSL_ENOTSQR);
+    }
+  else if (LDLT->size1 != p->size)
+    {
+      GSL_ERROR ("matrix size must match permutation size", GSL_EBADLEN);
+    }
+  else if (LDLT->size2 != x->size)
+    {
+      GSL_ERROR ("matrix size must match solution size", GSL_EBADLEN);
+    }
+  else
+    {
+      /* x := P b */
+      gsl_permute_vector (p, x);
+
+      /* solve for z using forward-substitution, L z = P b */
+      gsl_blas_dtrsv (CblasLower, CblasNoTrans, CblasUnit, LDLT, x);
+
+      /* solve for y, D y = z */
+      ldlt_bk_Dsolve (LDLT, x);
+
+      /* perform back-substitution, L^T w = y */
+      gsl_blas_dtrsv (CblasLower, CblasTrans, CblasUnit, LDLT, x);
+
+      /* x := P^T w */
+      gsl_permute_vector_inverse (p, x);
+
+      return GSL_SUCCESS;
+    }
+}
+
+int
+gsl_linalg_ldlt_bk_rcond (const gsl_matrix * LDLT, const gsl_permutation * p,
+                          double * rcond, gsl_vector * work)
+{
+  const size_t M = LDLT->size1;
+  const size_t N = LDLT->size2;
+
+  if (M != N)
+    {
+      GSL_ERROR ("LDLT matrix must be square", GSL_ENOTSQR);
+    }
+  else if (N != p->size)
+    {
+      GSL_ERROR ("matrix size must match permutation size", GSL_EBADLEN);
+    }
+  else if (work->size != 3 * N)
+    {
+      GSL_ERROR ("work vector must have length 3*N", GSL_EBADLEN);
+    }
+  else
+    {
+      int status;
+      double Anorm;    /* ||A||_1 */
+      double Ainvnorm; /* ||A^{-1}||_1 */
+      ldlt_bk_params params;
+
+      if (N == 1)
+        {
+          Anorm = fabs (gsl_matrix_get (LDLT, 0, 0));
+        }
+      else if (N == 2)
+        {
+          /* no room to store the norm, form L D L^T instead */
+          double d0 = gsl_matrix_get (LDLT, 0, 0);
+          double d1 = gsl_matrix_get (LDLT, 1, 1);
+          double e = gsl_matrix_get (LDLT, 0, 1);
+          double l = gsl_matrix_get (LDLT, 1, 0);
+          double a01 = fabs (l * d0 + e);
+          double a11 = fabs (l * l * d0 + 2.0 * l * e + d1);
+
+          Anorm = GSL_MAX (fabs (d0) + a01, a01 + a11);
+        }
+      else
+        {
+          Anorm = gsl_matrix_get (LDLT, 0, N - 1);
+        }
+
+      *rcond = 0.0;
+
+      /* don't continue if matrix is singular */
+      if (Anorm == 0.0)
+        return GSL_SUCCESS;
+
+      params.LDLT = LDLT;
+      params.perm = p;
+
+      /* estimate ||A^{-1}||_1 */
+      status = gsl_linalg_invnorm1 (N, ldlt_bk_Ainv, &params, &Ainvnorm, work);
+
+      if (status)
+        return status;
+
+      if (Ainvnorm != 0.0)
+        *rcond = (1.0 / Anorm) / Ainvnorm;
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+ldlt_bk_L2()
+  Unblocked Bunch-Kaufman factorization of the trailing matrix
+A(k0:N-1,k0:N-1), as in LAPACK DSYTF2, with the interchanges also
+applied to the previously computed columns of L
+*/
+
+static int
+ldlt_bk_L2 (gsl_matrix * A, const size_t k0, gsl_permutation * p)
+{
+  const size_t N = A->size1;
+  const double alpha = LDLT_BK_ALPHA;
+  size_t k = k0;
+
+  while (k < N)
+    {
+      size_t kstep = 1;
+      size_t kp = k;
+      size_t kk, imax = k;
+      double absakk = fabs (gsl_matrix_get (A, k, k));
+      double colmax = 0.0;
+
+      if (k < N - 1)
+        {
+          gsl_vector_view v = gsl_matrix_subcolumn (A, k, k + 1, N - k - 1);
+          imax = k + 1 + gsl_blas_idamax (&v.vector);
+          colmax = fabs (gsl_matrix_get (A, imax, k));
+        }
+
+      if (GSL_MAX (absakk, colmax) == 0.0)
+        {
+          GSL_ERROR ("matrix is singular", GSL_EDOM);
+        }
+
+      if (absakk < alpha * colmax)
+        {
+          /* rowmax is the largest off-diagonal element in row/column imax */
+          gsl_vector_view r = gsl_matrix_subrow (A, imax, k, imax - k);
+          double rowmax = fabs (gsl_matrix_get (A, imax, k + gsl_blas_idamax (&r.vector)));
+
+          if (imax < N - 1)
+            {
+              gsl_vector_view c = gsl_matrix_subcolumn (A, imax, imax + 1, N - imax - 1);
+              size_t jmax = imax + 1 + gsl_blas_idamax (&c.vector);
+              rowmax = GSL_MAX (rowmax, fabs (gsl_matrix_get (A, jmax, imax)));
+            }
+
+          if (absakk * rowmax >= alpha * colmax * colmax)
+            kp = k;
+          else if (fabs (gsl_matrix_get (A, imax, imax)) >= alpha * rowmax)
+            kp = imax;
+          else
+            {
+              kp = imax;
+              kstep = 2;
+            }
+        }
+
+      kk = k + kstep - 1;
+      if (kp != kk)
+        {
+          ldlt_bk_interchange (A, k, kk, kp);
+
+          /* interchange rows and columns kk and kp of the trailing matrix */
+          {
+            double tmp;
+
+            if (kp < N - 1)
+              {
+                gsl_vector_view c1 = gsl_matrix_subcolumn (A, kk, kp + 1, N - kp - 1);
+                gsl_vector_view c2 = gsl_matrix_subcolumn (A, kp, kp + 1, N - kp - 1);
+                gsl_blas_dswap (&c1.vector, &c2.vector);
+              }
+
+            if (kp > kk + 1)
+              {
+                gsl_vector_view c3 = gsl_matrix_subcolumn (A, kk, kk + 1, kp - kk - 1);
+                gsl_vector_view r3 = gsl_matrix_subrow (A, kp, kk + 1, kp - kk - 1);
+                gsl_blas_dswap (&c3.vector, &r3.vector);
+              }
+
+            tmp = gsl_matrix_get (A, kk, kk);
+            gsl_matrix_set (A, kk, kk, gsl_matrix_get (A, kp, kp));
+            gsl_matrix_set (A, kp, kp, tmp);
+
+            if (kstep == 2)
+              {
+                tmp = gsl_matrix_get (A, k + 1, k);
+                gsl_matrix_set (A, k + 1, k, gsl_matrix_get (A, kp, k));
+                gsl_matrix_set (A, kp, k, tmp);
+              }
+          }
+
+          gsl_permutation_swap (p, kk, kp);
+        }
+
+      if (kstep == 1)
+        {
+          if (k < N - 1)
+            {
+              double r1 = 1.0 / gsl_matrix_get (A, k, k);
+              gsl_vector_view x = gsl_matrix_subcolumn (A, k, k + 1, N - k - 1);
+              gsl_matrix_view A22 = gsl_matrix_submatrix (A, k + 1, k + 1, N - k - 1, N - k - 1);
+
+              /* A22 := A22 - x x^T / d_k */
+              gsl_blas_dsyr (CblasLower, -r1, &x.vector, &A22.matrix);
+              gsl_blas_dscal (r1, &x.vector);
+
+              gsl_matrix_set (A, k, k + 1, 0.0);
+            }
+        }
+      else
+        {
+          const double e = gsl_matrix_get (A, k + 1, k);
+          size_t j;
+
+          if (k < N - 2)
+            {
+              double d11 = gsl_matrix_get (A, k + 1, k + 1) / e;
+              double d22 = gsl_matrix_get (A, k, k) / e;
+              double t = 1.0 / (d11 * d22 - 1.0);
+              double d21 = t / e;
+
+              /* A22 := A22 - [x y] D^{-1} [x y]^T */
+              for (j = k + 2; j < N; ++j)
+                {
+                  double xj = gsl_matrix_get (A, j, k);
+                  double yj = gsl_matrix_get (A, j, k + 1);
+                  double wk = d21 * (d11 * xj - yj);
+                  double wkp1 = d21 * (d22 * yj - xj);
+                  gsl_vector_view aj = gsl_matrix_subcolumn (A, j, j, N - j);
+                  gsl_vector_view x = gsl_matrix_subcolumn (A, k, j, N - j);
+                  gsl_vector_view y = gsl_matrix_subcolumn (A, k + 1, j, N - j);
+
+                  gsl_blas_daxpy (-wk, &x.vector, &aj.vector);
+                  gsl_blas_daxpy (-wkp1, &y.vector, &aj.vector);
+
+                  gsl_matrix_set (A, j, k, wk);
+                  gsl_matrix_set (A, j, k + 1, wkp1);
+                }
+
+              gsl_matrix_set (A, k + 1, k + 2, 0.0);
+            }
+
+          /* move D(k+1,k) to the superdiagonal */
+          gsl_matrix_set (A, k, k + 1, e);
+          gsl_matrix_set (A, k + 1, k, 0.0);
+        }
+
+      k += kstep;
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+ldlt_bk_panel()
+  Factor a panel of at most LDLT_BK_BLOCK columns of the trailing
+matrix A(k0:N-1,k0:N-1) and update the rest of the trailing matrix,
+as in LAPACK DLASYF
+
+Inputs: A  - matrix
+        k0 - first column of panel
+        p  - permutation
+        W  - (N-k0)-by-LDLT_BK_BLOCK workspace
+        kb - (output) number of columns factored, LDLT_BK_BLOCK - 1 or
+             LDLT_BK_BLOCK
+
+Notes: columns of W hold the columns of the panel of the updated
+matrix, which are L D, so that once the panel is complete the trailing
+matrix is updated as A22 := A22 - L21 W21^T
+*/
+
+static int
+ldlt_bk_panel (gsl_matrix * A, const size_t k0, gsl_permutation * p,
+               gsl_matrix * W, size_t * kb)
+{
+  const size_t N = A->size1;
+  const size_t nb = W->size2;
+  const double alpha = LDLT_BK_ALPHA;
+  size_t k = k0;
+  size_t j, jj;
+
+  /* stop when there may not be room in W for a 2-by-2 block */
+  while (k - k0 < nb - 1)
+    {
+      const size_t c = k - k0; /* column of W */
+      size_t kstep = 1;
+      size_t kp = k;
+      size_t kk, imax;
+      double absakk, colmax;
+      gsl_vector_view wk = gsl_matrix_subcolumn (W, c, c, N - k);
+      gsl_vector_view ak = gsl_matrix_subcolumn (A, k, k, N - k);
+
+      /* W(k:N,c) = updated column k of A */
+      gsl_vector_memcpy (&wk.vector, &ak.vector);
+      if (c > 0)
+        {
+          gsl_matrix_view L = gsl_matrix_submatrix (A, k, k0, N - k, c);
+          gsl_vector_view wrow = gsl_matrix_subrow (W, c, 0, c);
+          gsl_blas_dgemv (CblasNoTrans, -1.0, &L.matrix, &wrow.vector, 1.0, &wk.vector);
+        }
+
+      absakk = fabs (gsl_matrix_get (W, c, c));
+
+      {
+        gsl_vector_view v = gsl_matrix_subcolumn (W, c, c + 1, N - k - 1);
+        imax = k + 1 + gsl_blas_idamax (&v.vector);
+        colmax = fabs (gsl_matrix_get (W, imax - k0, c));
+      }
+
+      if (GSL_MAX (absakk, colmax) == 0.0)
+        {
+          GSL_ERROR ("matrix is singular", GSL_EDOM);
+        }
+
+      if (absakk < alpha * colmax)
+        {
+          gsl_vector_view wi = gsl_matrix_subcolumn (W, c + 1, c, N - k);
+          gsl_vector_view r = gsl_matrix_subrow (A, imax, k, imax - k);
+          gsl_vector_view ai = gsl_matrix_subcolumn (A, imax, imax, N - imax);
+          gsl_vector_view wi1 = gsl_matrix_subcolumn (W, c + 1, c, imax - k);
+          gsl_vector_view wi2 = gsl_matrix_subcolumn (W, c + 1, imax - k0, N - imax);
+          double rowmax, wii;
+          size_t jmax;
+
+          /* W(k:N,c+1) = updated column imax of A */
+          gsl_vector_memcpy (&wi1.vector, &r.vector);
+          gsl_vector_memcpy (&wi2.vector, &ai.vector);
+          if (c > 0)
+            {
+              gsl_matrix_view L = gsl_matrix_submatrix (A, k, k0, N - k, c);
+              gsl_vector_view wrow = gsl_matrix_subrow (W, imax - k0, 0, c);
+              gsl_blas_dgemv (CblasNoTrans, -1.0, &L.matrix, &wrow.vector, 1.0, &wi.vector);
+            }
+
+          /* largest off-diagonal element in column imax */
+          wii = gsl_matrix_get (W, imax - k0, c + 1);
+          gsl_matrix_set (W, imax - k0, c + 1, 0.0);
+          jmax = gsl_blas_idamax (&wi.vector);
+          rowmax = fabs (gsl_vector_get (&wi.vector, jmax));
+          gsl_matrix_set (W, imax - k0, c + 1, wii);
+
+          if (absakk * rowmax >= alpha * colmax * colmax)
+            kp = k;
+          else if (fabs (wii) >= alpha * rowmax)
+            {
+              kp = imax;
+              gsl_vector_memcpy (&wk.vector, &wi.vector);
+            }
+          else
+            {
+              kp = imax;
+              kstep = 2;
+            }
+        }
+
+      kk = k + kstep - 1;
+      if (kp != kk)
+        {
+          /* copy the non-updated column kk of A to column kp; column
+             kk itself is overwritten by L below */
+          gsl_matrix_set (A, kp, kp, gsl_matrix_get (A, kk, kk));
+
+          if (kp > kk + 1)
+            {
+              gsl_vector_view c3 = gsl_matrix_subcolumn (A, kk, kk + 1, kp - kk - 1);
+              gsl_vector_view r3 = gsl_matrix_subrow (A, kp, kk + 1, kp - kk - 1);
+              gsl_vector_memcpy (&r3.vector, &c3.vector);
+            }
+
+          if (kp < N - 1)
+            {
+              gsl_vector_view c1 = gsl_matrix_subcolumn (A, kk, kp + 1, N - kp - 1);
+              gsl_vector_view c2 = gsl_matrix_subcolumn (A, kp, kp + 1, N - kp - 1);
+              gsl_vector_memcpy (&c2.vector, &c1.vector);
+            }
+
+          ldlt_bk_interchange (A, k, kk, kp);
+
+          {
+            gsl_vector_view w1 = gsl_matrix_subrow (W, kk - k0, 0, c + kstep);
+            gsl_vector_view w2 = gsl_matrix_subrow (W, kp - k0, 0, c + kstep);
+            gsl_blas_dswap (&w1.vector, &w2.vector);
+          }
+
+          gsl_permutation_swap (p, kk, kp);
+        }
+
+      if (kstep == 1)
+        {
+          gsl_vector_view x = gsl_matrix_subcolumn (A, k, k + 1, N - k - 1);
+
+          gsl_vector_memcpy (&ak.vector, &wk.vector);
+          gsl_blas_dscal (1.0 / gsl_matrix_get (A, k, k), &x.vector);
+          gsl_matrix_set (A, k, k + 1, 0.0);
+        }
+      else
+        {
+          const double e = gsl_matrix_get (W, c + 1, c);
+          double d11 = gsl_matrix_get (W, c + 1, c + 1) / e;
+          double d22 = gsl_matrix_get (W, c, c) / e;
+          double t = 1.0 / (d11 * d22 - 1.0);
+          double d21 = t / e;
+
+          for (j = k + 2; j < N; ++j)
+            {
+              double xj = gsl_matrix_get (W, j - k0, c);
+              double yj = gsl_matrix_get (W, j - k0, c + 1);
+
+              gsl_matrix_set (A, j, k, d21 * (d11 * xj - yj));
+              gsl_matrix_set (A, j, k + 1, d21 * (d22 * yj - xj));
+            }
+
+          gsl_matrix_set (A, k, k, gsl_matrix_get (W, c, c));
+          gsl_matrix_set (A, k + 1, k + 1, gsl_matrix_get (W, c + 1, c + 1));
+          gsl_matrix_set (A, k, k + 1, e);
+          gsl_matrix_set (A, k + 1, k, 0.0);
+          gsl_matrix_set (A, k + 1, k + 2, 0.0);
+        }
+
+      k += kstep;
+    }
+
+  *kb = k - k0;
+
+  /* A22 := A22 - L21 W21^T, in blocks of columns: the lower triangle
+     of each diagonal block with dgemv, the rest with dgemm */
+  for (jj = k; jj < N; jj += nb)
+    {
+      const size_t jb = GSL_MIN (nb, N - jj);
+
+      for (j = jj; j < jj + jb; ++j)
+        {
+          gsl_vector_view aj = gsl_matrix_subcolumn (A, j, j, jj + jb - j);
+          gsl_matrix_view L = gsl_matrix_submatrix (A, j, k0, jj + jb - j, *kb);
+          gsl_vector_view wj = gsl_matrix_subrow (W, j - k0, 0, *kb);
+
+          gsl_blas_dgemv (CblasNoTrans, -1.0, &L.matrix, &wj.vector, 1.0, &aj.vector);
+        }
+
+      if (jj + jb < N)
+        {
+          gsl_matrix_view A21 = gsl_matrix_submatrix (A, jj + jb, jj, N - jj - jb, jb);
+          gsl_matrix_view L = gsl_matrix_submatrix (A, jj + jb, k0, N - jj - jb, *kb);
+          gsl_matrix_view Wj = gsl_matrix_submatrix (W, jj - k0, 0, jb, *kb);
+
+          gsl_blas_dgemm (CblasNoTrans, CblasTrans, -1.0, &L.matrix, &Wj.matrix, 1.0, &A21.matrix);
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* interchange rows kk and kp of the first k columns of L */
+static void
+ldlt_bk_interchange (gsl_matrix * A, const size_t k, const size_t kk,
+                     const size_t kp)
+{
+  if (k > 0)
+    {
+      gsl_vector_view r1 = gsl_matrix_subrow (A, kk, 0, k);
+      gsl_vector_view r2 = gsl_matrix_subrow (A, kp, 0, k);
+      gsl_blas_dswap (&r1.vector, &r2.vector);
+    }
+}
+
+/* x := D^{-1} x, for the block diagonal D stored in LDLT */
+static int
+ldlt_bk_Dsolve (const gsl_matrix * LDLT, gsl_vector * x)
+{
+  const size_t N = LDLT->size1;
+  size_t k = 0;
+
+  while (k < N)
+    {
+      double e = (k < N - 1) ? gsl_matrix_get (LDLT, k, k + 1) : 0.0;
+
+      if (e == 0.0)
+        {
+          double dk = gsl_matrix_get (LDLT, k, k);
+          gsl_vector_set (x, k, gsl_vector_get (x, k) / dk);
+          k += 1;
+        }
+      else
+        {
+          /* solve the 2-by-2 system scaled by e, as in LAPACK DSYTRS */
+          double d0 = gsl_matrix_get (LDLT, k, k) / e;
+          double d1 = gsl_matrix_get (LDLT, k + 1, k + 1) / e;
+          double b0 = gsl_vector_get (x, k) / e;
+          double b1 = gsl_vector_get (x, k + 1) / e;
+          double denom = d0 * d1 - 1.0;
+
+          gsl_vector_set (x, k, (d1 * b0 - b1) / denom);
+          gsl_vector_set (x, k + 1, (d0 * b1 - b0) / denom);
+          k += 2;
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* compute 1-norm of symmetric matrix stored in lower triangle */
+static double
+ldlt_bk_norm1 (const gsl_matrix * A)
+{
+  const size_t N = A->size1;
+  double max = 0.0;
+  size_t j;
+
+  for (j = 0; j < N; ++j)
+    {
+      gsl_vector_const_view c = gsl_matrix_const_subcolumn (A, j, j, N - j);
+      double sum = gsl_blas_dasum (&c.vector);
+
+      /* now add symmetric elements from above diagonal */
+      if (j > 0)
+        {
+          gsl_vector_const_view r = gsl_matrix_const_subrow (A, j, 0, j);
+          sum += gsl_blas_dasum (&r.vector);
+        }
+
+      if (sum > max)
+        max = sum;
+    }
+
+  return max;
+}
+
+/* x := A^{-1} x = A^{-t} x, P A P^T = L D L^T */
+static int
+ldlt_bk_Ainv (CBLAS_TRANSPOSE_t TransA, gsl_vector * x, void * params)
+{
+  int status;
+  ldlt_bk_params *par = (ldlt_bk_params *) params;
+
+  (void) TransA; /* unused parameter warning */
+
+  status = gsl_linalg_ldlt_bk_svx (par->LDLT, par->perm, x);
+
+  return status;
+}
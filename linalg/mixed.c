@@ -0,0 +1,608 @@
+/* linalg/mixed.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <math.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_permutation.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_linalg.h>
+
+#include "recurse.h"
+
+/*
+ * this module contains mixed precision solvers for dense linear
+ * systems. The matrix is factored in single precision, which halves the
+ * memory traffic of the factorization and doubles the throughput of the
+ * Level 3 BLAS, and the solution is then improved to double precision
+ * accuracy by iterative refinement with residuals computed in double
+ * precision. If the refinement does not converge, the matrix is factored
+ * again in double precision.
+ *
+ * See LAPACK routines DSGESV and DSPOSV.
+ */
+
+/* maximum number of refinement steps */
+#define MIXED_MAXITER 30
+
+static int mixed_LU_decomp_L2 (gsl_matrix_float * A, gsl_vector_uint * ipiv);
+static int mixed_LU_decomp_L3 (gsl_matrix_float * A, gsl_vector_uint * ipiv);
+static void mixed_apply_pivots (gsl_matrix_float * A, const gsl_vector_uint * ipiv);
+static int mixed_cholesky_decomp_L2 (gsl_matrix_float * A);
+static int mixed_cholesky_decomp_L3 (gsl_matrix_float * A);
+static int mixed_matrix_float (const gsl_matrix * A, const int lower, gsl_matrix_float * F);
+static int mixed_vector_float (const gsl_vector * v, gsl_vector_float * f);
+static void mixed_svx (const gsl_matrix_float * F, const gsl_vector_uint * ipiv,
+                       gsl_vector_float * x);
+static int mixed_refine (const gsl_matrix * A, const gsl_matrix_float * F,
+                         const gsl_vector_uint * ipiv, const gsl_vector * b,
+                         gsl_vector * x, gsl_vector * r, gsl_vector_float * xf);
+
+/*
+gsl_linalg_LU_solve_mixed()
+  Solve a general square system A x = b with an LU decomposition
+computed in single precision, followed by iterative refinement in double
+precision
+
+Inputs: A    - on input, N-by-N matrix
+               on output, unchanged if *iter >= 0, otherwise the LU
+               decomposition of A computed in double precision
+        p    - (output) permutation of the double precision LU decomposition,
+               if *iter < 0
+        b    - right hand side vector, length N
+        x    - (output) solution vector, length N
+        iter - (output) number of refinement steps if the refinement
+               converged; -1 if A could not be stored or factored in
+               single precision; -2 if the refinement did not converge
+
+Return: success/error
+*/
+
+int
+gsl_linalg_LU_solve_mixed (gsl_matrix * A, gsl_permutation * p,
+                           const gsl_vector * b, gsl_vector * x, int * iter)
+{
+  const size_t N = A->size1;
+
+  if (N != A->size2)
+    {
+      GSL_ERROR ("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (p->size != N)
+    {
+      GSL_ERROR ("permutation length must match matrix size", GSL_EBADLEN);
+    }
+  else if (b->size != N)
+    {
+      GSL_ERROR ("matrix size must match b size", GSL_EBADLEN);
+    }
+  else if (x->size != N)
+    {
+      GSL_ERROR ("matrix size must match solution size", GSL_EBADLEN);
+    }
+  else
+    {
+      gsl_matrix_float * F = gsl_matrix_float_alloc (N, N);
+      gsl_vector_uint * ipiv = gsl_vector_uint_alloc (N);
+      gsl_vector_float * xf = gsl_vector_float_alloc (N);
+      gsl_vector * r = gsl_vector_alloc (N);
+      int status;
+
+      if (F == NULL || ipiv == NULL || xf == NULL || r == NULL)
+        {
+          if (F) gsl_matrix_float_free (F);
+          if (ipiv) gsl_vector_uint_free (ipiv);
+          if (xf) gsl_vector_float_free (xf);
+          if (r) gsl_vector_free (r);
+          GSL_ERROR ("failed to allocate workspace", GSL_ENOMEM);
+        }
+
+      if (mixed_matrix_float (A, 0, F) || mixed_LU_decomp_L3 (F, ipiv))
+        *iter = -1;
+      else
+        *iter = mixed_refine (A, F, ipiv, b, x, r, xf);
+
+      gsl_matrix_float_free (F);
+      gsl_vector_uint_free (ipiv);
+      gsl_vector_float_free (xf);
+      gsl_vector_free (r);
+
+      if (*iter < 0)
+        {
+          int signum;
+
+          /* fall back to a double precision factorization */
+          status = gsl_linalg_LU_decomp (A, p, &signum);
+          if (status)
+            return status;
+
+          status = gsl_linalg_LU_solve (A, p, b, x);
+          if (status)
+            return status;
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_linalg_cholesky_solve_mixed()
+  Solve a symmetric positive definite system A x = b with a Cholesky
+decomposition computed in single precision, followed by iterative
+refinement in double precision
+
+Inputs: A    - on input, N-by-N symmetric positive definite matrix in
+               the lower triangle
+               on output, unchanged if *iter >= 0, otherwise the Cholesky
+               decomposition of A computed in double precision, in the
+               format of gsl_linalg_cholesky_decomp1
+        b    - right hand side vector, length N
+        x    - (output) solution vector, length N
+        iter - (output) number of refinement steps if the refinement
+               converged; -1 if A could not be stored or factored in
+               single precision; -2 if the refinement did not converge
+
+Return: success/error
+*/
+
+int
+gsl_linalg_cholesky_solve_mixed (gsl_matrix * A, const gsl_vector * b,
+                                 gsl_vector * x, int * iter)
+{
+  const size_t N = A->size1;
+
+  if (N != A->size2)
+    {
+      GSL_ERROR ("matrix must be square", GSL_ENOTSQR);
+    }
+  else if (b->size != N)
+    {
+      GSL_ERROR ("matrix size must match b size", GSL_EBADLEN);
+    }
+  else if (x->size != N)
+    {
+      GSL_ERROR ("matrix size must match solution size", GSL_EBADLEN);
+    }
+  else
+    {
+      gsl_matrix_float * F = gsl_matrix_float_alloc (N, N);
+      gsl_vector_float * xf = gsl_vector_float_alloc (N);
+      gsl_vector * r = gsl_vector_alloc (N);
+      int status;
+
+      if (F == NULL || xf == NULL || r == NULL)
+        {
+          if (F) gsl_matrix_float_free (F);
+          if (xf) gsl_vector_float_free (xf);
+          if (r) gsl_vector_free (r);
+          GSL_ERROR ("failed to allocate workspace", GSL_ENOMEM);
+        }
+
+      if (mixed_matrix_float (A, 1, F) || mixed_cholesky_decomp_L3 (F))
+        *iter = -1;
+      else
+        *iter = mixed_refine (A, F, NULL, b, x, r, xf);
+
+      gsl_matrix_float_free (F);
+      gsl_vector_float_free (xf);
+      gsl_vector_free (r);
+
+      if (*iter < 0)
+        {
+          /* fall back to a double precision factorization */
+          status = gsl_linalg_cholesky_decomp1 (A);
+          if (status)
+            return status;
+
+          status = gsl_linalg_cholesky_solve (A, b, x);
+          if (status)
+            return status;
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+mixed_refine()
+  Compute the solution of A x = b from the single precision factors of A,
+and refine it in double precision until
+
+||b - A x||_inf <= ||x||_inf ||A||_inf sqrt(N) eps
+
+Inputs: A    - N-by-N matrix, only the lower triangle is used if ipiv = NULL
+        F    - single precision LU factors of A, or Cholesky factor if ipiv = NULL
+        ipiv - row interchanges of the LU decomposition, or NULL
+        b    - right hand side
+        x    - (output) solution
+        r    - workspace, length N
+        xf   - workspace, length N
+
+Return: number of refinement steps, or -1 if a residual could not be
+stored in single precision, or -2 if the refinement stalled or did not
+converge in MIXED_MAXITER steps
+*/
+
+static int
+mixed_refine (const gsl_matrix * A, const gsl_matrix_float * F,
+              const gsl_vector_uint * ipiv, const gsl_vector * b,
+              gsl_vector * x, gsl_vector * r, gsl_vector_float * xf)
+{
+  const size_t N = A->size1;
+  double anorm = 0.0, cte, rnorm_prev = 0.0;
+  size_t i, j;
+  int iter;
+
+  /* ||A||_inf */
+  for (i = 0; i < N; ++i)
+    {
+      double sum = 0.0;
+
+      for (j = 0; j < N; ++j)
+        {
+          const double aij = (ipiv == NULL && j > i) ? gsl_matrix_get (A, j, i) : gsl_matrix_get (A, i, j);
+          sum += fabs (aij);
+        }
+
+      anorm = GSL_MAX (anorm, sum);
+    }
+
+  cte = anorm * GSL_DBL_EPSILON * sqrt ((double) N);
+
+  /* initial solution x = A^{-1} b in single precision */
+  if (mixed_vector_float (b, xf))
+    return -1;
+
+  mixed_svx (F, ipiv, xf);
+
+  for (i = 0; i < N; ++i)
+    gsl_vector_set (x, i, gsl_vector_float_get (xf, i));
+
+  for (iter = 0; iter <= MIXED_MAXITER; ++iter)
+    {
+      double rnorm, xnorm;
+
+      /* r = b - A x */
+      gsl_vector_memcpy (r, b);
+
+      if (ipiv != NULL)
+        gsl_blas_dgemv (CblasNoTrans, -1.0, A, x, 1.0, r);
+      else
+        gsl_blas_dsymv (CblasLower, -1.0, A, x, 1.0, r);
+
+      rnorm = fabs (gsl_vector_get (r, gsl_blas_idamax (r)));
+      xnorm = fabs (gsl_vector_get (x, gsl_blas_idamax (x)));
+
+      if (rnorm <= xnorm * cte)
+        return iter;
+
+      /* the residual did not decrease, or too many steps */
+      if ((iter > 0 && !(rnorm < rnorm_prev)) || iter == MIXED_MAXITER)
+        return -2;
+
+      rnorm_prev = rnorm;
+
+      /* x += A^{-1} r */
+      if (mixed_vector_float (r, xf))
+        return -1;
+
+      mixed_svx (F, ipiv, xf);
+
+      for (i = 0; i < N; ++i)
+        {
+          double * xi = gsl_vector_ptr (x, i);
+          *xi += gsl_vector_float_get (xf, i);
+        }
+    }
+
+  return -2;
+}
+
+/* solve F x = b in single precision; x contains b on input */
+
+static void
+mixed_svx (const gsl_matrix_float * F, const gsl_vector_uint * ipiv,
+           gsl_vector_float * x)
+{
+  if (ipiv != NULL)
+    {
+      size_t i;
+
+      /* apply row interchanges in the order they were made */
+      for (i = 0; i < ipiv->size; ++i)
+        {
+          size_t pi = gsl_vector_uint_get (ipiv, i);
+
+          if (i != pi)
+            gsl_vector_float_swap_elements (x, i, pi);
+        }
+
+      gsl_blas_strsv (CblasLower, CblasNoTrans, CblasUnit, F, x);
+      gsl_blas_strsv (CblasUpper, CblasNoTrans, CblasNonUnit, F, x);
+    }
+  else
+    {
+      gsl_blas_strsv (CblasLower, CblasNoTrans, CblasNonUnit, F, x);
+      gsl_blas_strsv (CblasLower, CblasTrans, CblasNonUnit, F, x);
+    }
+}
+
+/* copy A (or its lower triangle) to single precision; return 1 on overflow */
+
+static int
+mixed_matrix_float (const gsl_matrix * A, const int lower, gsl_matrix_float * F)
+{
+  const size_t N = A->size1;
+  size_t i, j;
+
+  for (i = 0; i < N; ++i)
+    {
+      const size_t jmax = lower ? i + 1 : N;
+
+      for (j = 0; j < jmax; ++j)
+        {
+          const double aij = gsl_matrix_get (A, i, j);
+
+          if (fabs (aij) > GSL_FLT_MAX)
+            return 1;
+
+          gsl_matrix_float_set (F, i, j, (float) aij);
+        }
+    }
+
+  return 0;
+}
+
+/* copy v to single precision; return 1 on overflow */
+
+static int
+mixed_vector_float (const gsl_vector * v, gsl_vector_float * f)
+{
+  size_t i;
+
+  for (i = 0; i < v->size; ++i)
+    {
+      const double vi = gsl_vector_get (v, i);
+
+      if (fabs (vi) > GSL_FLT_MAX)
+        return 1;
+
+      gsl_vector_float_set (f, i, (float) vi);
+    }
+
+  return 0;
+}
+
+/*
+mixed_LU_decomp_L2
+  LU decomposition with partial pivoting in single precision using
+Level 2 BLAS, as LU_decomp_L2 in lu.c
+
+Return: 0 on success, GSL_EDOM if a pivot is zero
+*/
+
+static int
+mixed_LU_decomp_L2 (gsl_matrix_float * A, gsl_vector_uint * ipiv)
+{
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+  size_t j;
+
+  for (j = 0; j < N; ++j)
+    {
+      gsl_vector_float_view v = gsl_matrix_float_subcolumn (A, j, j, M - j);
+      size_t j_pivot = j + gsl_blas_isamax (&v.vector);
+      gsl_vector_float_view v1, v2;
+      float Ajj;
+
+      gsl_vector_uint_set (ipiv, j, j_pivot);
+
+      if (j_pivot != j)
+        {
+          v1 = gsl_matrix_float_row (A, j);
+          v2 = gsl_matrix_float_row (A, j_pivot);
+          gsl_blas_sswap (&v1.vector, &v2.vector);
+        }
+
+      Ajj = gsl_matrix_float_get (A, j, j);
+
+      /* a tiny pivot would not give a useful preconditioner */
+      if (fabs (Ajj) < GSL_FLT_MIN)
+        return GSL_EDOM;
+
+      if (j < M - 1)
+        {
+          v1 = gsl_matrix_float_subcolumn (A, j, j + 1, M - j - 1);
+          gsl_blas_sscal (1.0f / Ajj, &v1.vector);
+        }
+
+      if (j < N - 1)
+        {
+          gsl_matrix_float_view A22 = gsl_matrix_float_submatrix (A, j + 1, j + 1, M - j - 1, N - j - 1);
+          v1 = gsl_matrix_float_subcolumn (A, j, j + 1, M - j - 1);
+          v2 = gsl_matrix_float_subrow (A, j, j + 1, N - j - 1);
+
+          gsl_blas_sger (-1.0f, &v1.vector, &v2.vector, &A22.matrix);
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+mixed_LU_decomp_L3
+  LU decomposition with partial pivoting in single precision using
+Level 3 BLAS, as LU_decomp_L3 in lu.c
+
+Return: 0 on success, GSL_EDOM if a pivot is zero
+*/
+
+static int
+mixed_LU_decomp_L3 (gsl_matrix_float * A, gsl_vector_uint * ipiv)
+{
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+
+  if (N <= CROSSOVER_LU)
+    {
+      return mixed_LU_decomp_L2 (A, ipiv);
+    }
+  else
+    {
+      int status;
+      const size_t N1 = GSL_LINALG_SPLIT (N);
+      const size_t N2 = N - N1;
+      const size_t M2 = M - N1;
+      gsl_matrix_float_view A11 = gsl_matrix_float_submatrix (A, 0, 0, N1, N1);
+      gsl_matrix_float_view A12 = gsl_matrix_float_submatrix (A, 0, N1, N1, N2);
+      gsl_matrix_float_view A21 = gsl_matrix_float_submatrix (A, N1, 0, M2, N1);
+      gsl_matrix_float_view A22 = gsl_matrix_float_submatrix (A, N1, N1, M2, N2);
+      gsl_matrix_float_view AL = gsl_matrix_float_submatrix (A, 0, 0, M, N1);
+      gsl_matrix_float_view AR = gsl_matrix_float_submatrix (A, 0, N1, M, N2);
+      gsl_vector_uint_view ipiv1 = gsl_vector_uint_subvector (ipiv, 0, N1);
+      gsl_vector_uint_view ipiv2 = gsl_vector_uint_subvector (ipiv, N1, N2);
+      size_t i;
+
+      status = mixed_LU_decomp_L3 (&AL.matrix, &ipiv1.vector);
+      if (status)
+        return status;
+
+      mixed_apply_pivots (&AR.matrix, &ipiv1.vector);
+
+      /* A12 = A11^{-1} A12 */
+      gsl_blas_strsm (CblasLeft, CblasLower, CblasNoTrans, CblasUnit, 1.0f, &A11.matrix, &A12.matrix);
+
+      /* A22 = A22 - A21 * A12 */
+      gsl_blas_sgemm (CblasNoTrans, CblasNoTrans, -1.0f, &A21.matrix, &A12.matrix, 1.0f, &A22.matrix);
+
+      status = mixed_LU_decomp_L3 (&A22.matrix, &ipiv2.vector);
+      if (status)
+        return status;
+
+      mixed_apply_pivots (&A21.matrix, &ipiv2.vector);
+
+      for (i = 0; i < N2; ++i)
+        {
+          unsigned int * ptr = gsl_vector_uint_ptr (&ipiv2.vector, i);
+          *ptr += N1;
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+static void
+mixed_apply_pivots (gsl_matrix_float * A, const gsl_vector_uint * ipiv)
+{
+  size_t i;
+
+  for (i = 0; i < ipiv->size; ++i)
+    {
+      size_t pi = gsl_vector_uint_get (ipiv, i);
+
+      if (i != pi)
+        {
+          gsl_vector_float_view v1 = gsl_matrix_float_row (A, i);
+          gsl_vector_float_view v2 = gsl_matrix_float_row (A, pi);
+          gsl_blas_sswap (&v1.vector, &v2.vector);
+        }
+    }
+}
+
+/*
+mixed_cholesky_decomp_L2
+  Cholesky decomposition in single precision using Level 2 BLAS, as
+cholesky_decomp_L2 in cholesky.c
+
+Return: 0 on success, GSL_EDOM if the matrix is not positive definite
+in single precision
+*/
+
+static int
+mixed_cholesky_decomp_L2 (gsl_matrix_float * A)
+{
+  const size_t N = A->size1;
+  size_t j;
+
+  for (j = 0; j < N; ++j)
+    {
+      float ajj;
+      gsl_vector_float_view v = gsl_matrix_float_subcolumn (A, j, j, N - j);
+
+      if (j > 0)
+        {
+          gsl_vector_float_view w = gsl_matrix_float_subrow (A, j, 0, j);
+          gsl_matrix_float_view m = gsl_matrix_float_submatrix (A, j, 0, N - j, j);
+
+          gsl_blas_sgemv (CblasNoTrans, -1.0f, &m.matrix, &w.vector, 1.0f, &v.vector);
+        }
+
+      ajj = gsl_matrix_float_get (A, j, j);
+
+      if (ajj <= 0.0f)
+        return GSL_EDOM;
+
+      ajj = (float) sqrt (ajj);
+      gsl_blas_sscal (1.0f / ajj, &v.vector);
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+mixed_cholesky_decomp_L3
+  Cholesky decomposition in single precision using Level 3 BLAS, as
+cholesky_decomp_L3 in cholesky.c
+
+Return: 0 on success, GSL_EDOM if the matrix is not positive definite
+in single precision
+*/
+
+static int
+mixed_cholesky_decomp_L3 (gsl_matrix_float * A)
+{
+  const size_t N = A->size1;
+
+  if (N <= CROSSOVER_CHOLESKY)
+    {
+      return mixed_cholesky_decomp_L2 (A);
+    }
+  else
+    {
+      int status;
+      const size_t N1 = GSL_LINALG_SPLIT (N);
+      const size_t N2 = N - N1;
+      gsl_matrix_float_view A11 = gsl_matrix_float_submatrix (A, 0, 0, N1, N1);
+      gsl_matrix_float_view A21 = gsl_matrix_float_submatrix (A, N1, 0, N2, N1);
+      gsl_matrix_float_view A22 = gsl_matrix_float_submatrix (A, N1, N1, N2, N2);
+
+      status = mixed_cholesky_decomp_L3 (&A11.matrix);
+      if (status)
+        return status;
+
+      /* A21 = A21 * L11^{-T} */
+      gsl_blas_strsm (CblasRight, CblasLower, CblasTrans, CblasNonUnit, 1.0f, &A11.matrix, &A21.matrix);
+
+      /* A22 -= L21 L21^T */
+      gsl_blas_ssyrk (CblasLower, CblasNoTrans, -1.0f, &A21.matrix, 1.0f, &A22.matrix);
+
+      return mixed_cholesky_decomp_L3 (&A22.matrix);
+    }
+}
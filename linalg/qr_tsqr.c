@@ -0,0 +1,358 @@
+/* linalg/qr_tsqr.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_sys.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_blas.h>
+
+/*
+ * this module contains routines for the parallel "tall-skinny" QR
+ * factorization (TSQR) of a matrix, with reconstruction of the Householder
+ * vectors so that the result has the same format as gsl_linalg_QR_decomp_r
+ */
+
+static int tsqr_lu (gsl_matrix * A);
+
+/* first row of block k of the p blocks of M rows */
+#define TSQR_START(k,p,M) ((size_t) (((double) (k) * (M)) / (p)))
+
+/*
+gsl_linalg_QR_TSQR_decomp()
+  QR decomposition of a tall-skinny matrix using the parallel
+TSQR algorithm with Householder reconstruction of:
+
+Demmel, J., Grigori, L., Hoemmen, M. and Langou, J., 2012.
+  Communication-optimal parallel and sequential QR and LU factorizations.
+  SIAM Journal on Scientific Computing, 34(1), pp.A206-A239.
+
+Ballard, G., Demmel, J., Grigori, L., Jacquelin, M., Nguyen, H.D. and
+  Solomonik, E., 2014. Reconstructing Householder vectors from tall-skinny QR.
+  IEEE 28th International Parallel and Distributed Processing Symposium.
+
+Inputs: A - matrix to be factored, M-by-N with M >= N
+        T - N-by-N upper triangular factor of block reflector
+
+Return: success/error
+
+Notes:
+1) The rows of A are split into p blocks, one per thread (see
+gsl_set_num_threads), each with at least N rows. The blocks are
+factored independently with gsl_linalg_QR_decomp_r, and their R factors
+are combined pairwise in a binary tree with gsl_linalg_QR_UU_decomp,
+giving A = Q1 R with an implicit M-by-N factor Q1.
+
+2) Q1 is formed explicitly, and the Householder vectors are recovered
+from the LU decomposition without pivoting
+
+[ I ] - Q1 S = V U
+[ 0 ]
+
+where S = diag(-sign(Q1_ii)). Then T = U V1^{-T}, where V1 is the
+unit lower triangular top block of V, and the R factor is S R.
+
+3) On output, A and T are in the format of gsl_linalg_QR_decomp_r,
+so that the other _r functions, such as gsl_linalg_QR_QTvec_r and
+gsl_linalg_QR_lssolve_r, can be used with them. The factorization
+may differ from that of gsl_linalg_QR_decomp_r in the signs of the rows
+of R and the corresponding columns of Q.
+
+4) With one thread, or if M < 2N, gsl_linalg_QR_decomp_r is used
+directly.
+*/
+
+int
+gsl_linalg_QR_TSQR_decomp (gsl_matrix * A, gsl_matrix * T)
+{
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+
+  if (M < N)
+    {
+      GSL_ERROR ("M must be >= N", GSL_EBADLEN);
+    }
+  else if (T->size1 != T->size2)
+    {
+      GSL_ERROR ("T matrix must be square", GSL_ENOTSQR);
+    }
+  else if (T->size1 != N)
+    {
+      GSL_ERROR ("T matrix does not match dimensions of A", GSL_EBADLEN);
+    }
+  else
+    {
+      const int nthreads = gsl_get_num_threads ();
+      const int p = (int) GSL_MIN ((size_t) nthreads, M / N);
+      gsl_matrix *W, *work;
+      gsl_matrix_view A1, W1;
+      int k, s, status = GSL_SUCCESS;
+      size_t i, j;
+
+      if (p < 2)
+        return gsl_linalg_QR_decomp_r (A, T);
+
+      /*
+       * W holds Q1, and work holds four N-by-N matrices for each block k:
+       * the block reflector T_k of the block, its R factor R_k, the reflector
+       * of the tree node whose right child is k, and a temporary matrix
+       */
+      W = gsl_matrix_calloc (M, N);
+      if (W == NULL)
+        {
+          GSL_ERROR ("failed to allocate space for Q1", GSL_ENOMEM);
+        }
+
+      work = gsl_matrix_alloc (4 * p * N, N);
+      if (work == NULL)
+        {
+          gsl_matrix_free (W);
+          GSL_ERROR ("failed to allocate workspace", GSL_ENOMEM);
+        }
+
+#define TSQR_WORK(idx,k) (gsl_matrix_submatrix (work, ((idx) * p + (k)) * N, 0, N, N))
+
+      /* factor the blocks A_k = Q_k R_k */
+
+#pragma omp parallel for num_threads(p) schedule(static) reduction(|:status) private(i,j)
+      for (k = 0; k < p; k++)
+        {
+          const size_t r0 = TSQR_START (k, p, M);
+          const size_t r1 = TSQR_START (k + 1, p, M);
+          gsl_matrix_view Ak = gsl_matrix_submatrix (A, r0, 0, r1 - r0, N);
+          gsl_matrix_view Tk = TSQR_WORK (0, k);
+          gsl_matrix_view Rk = TSQR_WORK (1, k);
+
+          status |= gsl_linalg_QR_decomp_r (&Ak.matrix, &Tk.matrix);
+
+          for (i = 0; i < N; i++)
+            {
+              for (j = 0; j < N; j++)
+                {
+                  double rij = (j >= i) ? gsl_matrix_get (&Ak.matrix, i, j) : 0.0;
+                  gsl_matrix_set (&Rk.matrix, i, j, rij);
+                }
+            }
+        }
+
+      /*
+       * reduce the R factors in a binary tree: at level s, R_k and R_{k+s}
+       * are replaced by the R factor of [ R_k ; R_{k+s} ] in R_k and the
+       * upper triangular part Y of its Householder vectors in R_{k+s}
+       */
+      for (s = 1; s < p && status == GSL_SUCCESS; s *= 2)
+        {
+#pragma omp parallel for num_threads(p) schedule(static) reduction(|:status)
+          for (k = 0; k < p - s; k += 2 * s)
+            {
+              gsl_matrix_view Rk = TSQR_WORK (1, k);
+              gsl_matrix_view Y = TSQR_WORK (1, k + s);
+              gsl_matrix_view Tn = TSQR_WORK (2, k + s);
+
+              status |= gsl_linalg_QR_UU_decomp (&Rk.matrix, &Y.matrix, &Tn.matrix);
+            }
+        }
+
+      if (status)
+        {
+          gsl_matrix_free (W);
+          gsl_matrix_free (work);
+          return status;
+        }
+
+      /*
+       * apply the tree from the root down to [ I ; 0 ], leaving the N-by-N
+       * matrix X_k in the first rows of block k of W. At the node (k,k+s),
+       * X_{k+s} = 0 on input, and
+       *
+       * [ X_k     ] := (I - [ I ] T [ I Y^T ]) [ X_k ] = [ X_k - T X_k ]
+       * [ X_{k+s} ]         [ Y ]              [  0  ]   [  -Y T X_k   ]
+       */
+      W1 = gsl_matrix_submatrix (W, 0, 0, N, N);
+      gsl_matrix_set_identity (&W1.matrix);
+
+      for (s = 1; 2 * s < p; s *= 2)
+        ;
+
+      for (; s >= 1; s /= 2)
+        {
+#pragma omp parallel for num_threads(p) schedule(static)
+          for (k = 0; k < p - s; k += 2 * s)
+            {
+              gsl_matrix_view Xk = gsl_matrix_submatrix (W, TSQR_START (k, p, M), 0, N, N);
+              gsl_matrix_view Xks = gsl_matrix_submatrix (W, TSQR_START (k + s, p, M), 0, N, N);
+              gsl_matrix_view Y = TSQR_WORK (1, k + s);
+              gsl_matrix_view Tn = TSQR_WORK (2, k + s);
+
+              gsl_matrix_memcpy (&Xks.matrix, &Xk.matrix);
+              gsl_blas_dtrmm (CblasLeft, CblasUpper, CblasNoTrans, CblasNonUnit, 1.0, &Tn.matrix, &Xks.matrix);
+              gsl_matrix_sub (&Xk.matrix, &Xks.matrix);
+              gsl_blas_dtrmm (CblasLeft, CblasUpper, CblasNoTrans, CblasNonUnit, -1.0, &Y.matrix, &Xks.matrix);
+            }
+        }
+
+      /*
+       * form block k of Q1 = Q_k [ X_k ; 0 ] = [ X_k ; 0 ] - V_k Z_k, with
+       * Z_k = T_k V_k1^T X_k
+       */
+
+#pragma omp parallel for num_threads(p) schedule(static)
+      for (k = 0; k < p; k++)
+        {
+          const size_t r0 = TSQR_START (k, p, M);
+          const size_t r1 = TSQR_START (k + 1, p, M);
+          gsl_matrix_view V1 = gsl_matrix_submatrix (A, r0, 0, N, N);
+          gsl_matrix_view Xk = gsl_matrix_submatrix (W, r0, 0, N, N);
+          gsl_matrix_view Tk = TSQR_WORK (0, k);
+          gsl_matrix_view Z = TSQR_WORK (3, k);
+
+          gsl_matrix_memcpy (&Z.matrix, &Xk.matrix);
+          gsl_blas_dtrmm (CblasLeft, CblasLower, CblasTrans, CblasUnit, 1.0, &V1.matrix, &Z.matrix);
+          gsl_blas_dtrmm (CblasLeft, CblasUpper, CblasNoTrans, CblasNonUnit, 1.0, &Tk.matrix, &Z.matrix);
+
+          if (r1 - r0 > N)
+            {
+              gsl_matrix_view V2 = gsl_matrix_submatrix (A, r0 + N, 0, r1 - r0 - N, N);
+              gsl_matrix_view W2 = gsl_matrix_submatrix (W, r0 + N, 0, r1 - r0 - N, N);
+
+              gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, -1.0, &V2.matrix, &Z.matrix, 0.0, &W2.matrix);
+            }
+
+          gsl_blas_dtrmm (CblasLeft, CblasLower, CblasNoTrans, CblasUnit, 1.0, &V1.matrix, &Z.matrix);
+          gsl_matrix_sub (&Xk.matrix, &Z.matrix);
+        }
+
+      /*
+       * Householder reconstruction: store [ I ; 0 ] - Q1 S in A, with
+       * S = diag(s), and factor its top block V1 U in place
+       */
+      {
+        gsl_vector_view sgn = gsl_matrix_row (work, 0);
+        gsl_matrix_view R = TSQR_WORK (1, 0);
+
+        for (j = 0; j < N; j++)
+          {
+            double qjj = gsl_matrix_get (W, j, j);
+            gsl_vector_set (&sgn.vector, j, (qjj < 0.0) ? 1.0 : -1.0);
+          }
+
+        for (i = 0; i < N; i++)
+          {
+            for (j = 0; j < N; j++)
+              {
+                double bij = (i == j) ? 1.0 : 0.0;
+                bij -= gsl_matrix_get (W, i, j) * gsl_vector_get (&sgn.vector, j);
+                gsl_matrix_set (A, i, j, bij);
+              }
+          }
+
+        A1 = gsl_matrix_submatrix (A, 0, 0, N, N);
+        tsqr_lu (&A1.matrix);
+
+        /* V2 = -Q2 S U^{-1} */
+
+#pragma omp parallel for num_threads(p) schedule(static) private(i,j)
+        for (k = 0; k < p; k++)
+          {
+            const size_t r0 = GSL_MAX (TSQR_START (k, p, M), N);
+            const size_t r1 = TSQR_START (k + 1, p, M);
+
+            if (r1 > r0)
+              {
+                gsl_matrix_view V2 = gsl_matrix_submatrix (A, r0, 0, r1 - r0, N);
+
+                for (i = r0; i < r1; i++)
+                  {
+                    for (j = 0; j < N; j++)
+                      {
+                        double wij = gsl_matrix_get (W, i, j);
+                        gsl_matrix_set (A, i, j, -wij * gsl_vector_get (&sgn.vector, j));
+                      }
+                  }
+
+                gsl_blas_dtrsm (CblasRight, CblasUpper, CblasNoTrans, CblasNonUnit, 1.0, &A1.matrix, &V2.matrix);
+              }
+          }
+
+        /* T = U V1^{-T} */
+        for (i = 0; i < N; i++)
+          {
+            for (j = 0; j < N; j++)
+              {
+                double tij = (j >= i) ? gsl_matrix_get (A, i, j) : 0.0;
+                gsl_matrix_set (T, i, j, tij);
+              }
+          }
+
+        gsl_blas_dtrsm (CblasRight, CblasLower, CblasTrans, CblasUnit, 1.0, &A1.matrix, T);
+
+        /* upper triangle of A := S R */
+        for (i = 0; i < N; i++)
+          {
+            const double si = gsl_vector_get (&sgn.vector, i);
+
+            for (j = i; j < N; j++)
+              gsl_matrix_set (A, i, j, si * gsl_matrix_get (&R.matrix, i, j));
+          }
+      }
+
+#undef TSQR_WORK
+
+      gsl_matrix_free (W);
+      gsl_matrix_free (work);
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+tsqr_lu()
+  LU decomposition without pivoting of the N-by-N matrix A, with L
+unit lower triangular. The diagonal elements of [ I ; 0 ] - Q1 S are
+1 + |Q1_ii| >= 1, and the factorization is stable without pivoting
+(Ballard et al, 2014).
+*/
+
+static int
+tsqr_lu (gsl_matrix * A)
+{
+  const size_t N = A->size1;
+  size_t i, j, k;
+
+  for (k = 0; k < N; k++)
+    {
+      const double ukk = gsl_matrix_get (A, k, k);
+
+      for (i = k + 1; i < N; i++)
+        {
+          const double lik = gsl_matrix_get (A, i, k) / ukk;
+
+          gsl_matrix_set (A, i, k, lik);
+
+          for (j = k + 1; j < N; j++)
+            {
+              double aij = gsl_matrix_get (A, i, j);
+              gsl_matrix_set (A, i, j, aij - lik * gsl_matrix_get (A, k, j));
+            }
+        }
+    }
+
+  return GSL_SUCCESS;
+}
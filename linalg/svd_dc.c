@@ -0,0 +1,906 @@
+/* linalg/svd_dc.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_sort.h>
+
+#include <gsl/gsl_linalg.h>
+
+/* Compute the singular value decomposition A = U S V^T by reduction to
+   bidiagonal form, followed by the divide and conquer method for the
+   bidiagonal matrix B.
+
+   An n-by-(n+sqre) upper bidiagonal block, with sqre = 0 or 1, is split
+   at row k into an upper block B1 with one more column than rows, the
+   row k, and a lower block B2 with sqre extra columns,
+
+     B = [ B1               0  ]
+         [ alpha e_k^T  beta e_1^T ]
+         [ 0                B2 ]
+
+   The singular value decompositions of B1 and B2 are computed
+   recursively, which reduces B to a matrix M with nonzero elements only
+   in its first row z and on its diagonal d, with d_0 = 0.  The
+   singular values of M are the roots of the secular equation
+
+     f(sigma) = 1 + sum_j z_j^2 / (d_j^2 - sigma^2) = 0,
+
+   and its singular vectors are known in closed form, so that the
+   singular vectors of B are obtained from those of B1 and B2 with
+   matrix products.  Small blocks are diagonalized with the implicit QR
+   method of gsl_linalg_SV_decomp.
+
+   References:
+
+   Jessup, E.R. and Sorensen, D.C., 1994. A parallel algorithm for
+     computing the singular value decomposition of a matrix. SIAM
+     Journal on Matrix Analysis and Applications, 15(2), pp.530-548.
+
+   Gu, M. and Eisenstat, S.C., 1995. A divide-and-conquer algorithm for
+     the bidiagonal SVD. SIAM Journal on Matrix Analysis and
+     Applications, 16(1), pp.79-92.
+
+   The deflation criteria follow LAPACK DLASD2. */
+
+#include "svdstep.c"
+
+/* blocks of at most this size are diagonalized with QR iterations */
+#define SVD_DC_SMALL 25
+
+/* maximum iterations for a root of the secular equation */
+#define SVD_DC_MAXITER 100
+
+typedef struct
+{
+  size_t size;
+  double *d;                    /* diagonal of B */
+  double *e;                    /* superdiagonal of B */
+  double *work;                 /* workspace, length 5 N */
+  size_t *iwork;                /* workspace, length 5 N */
+  gsl_matrix *U;                /* left singular vectors of B */
+  gsl_matrix *W;                /* right singular vectors of B */
+  gsl_matrix *S;                /* workspace */
+  gsl_matrix *T;                /* singular vectors of a merged block */
+} svd_dc_workspace;
+
+static int svd_dc_alloc (const size_t N, svd_dc_workspace * w);
+static void svd_dc_free (svd_dc_workspace * w);
+static int svd_dc_solve (const size_t off, const size_t n, const int sqre,
+                         svd_dc_workspace * w);
+static int svd_dc_qr (const size_t off, const size_t n, const int sqre,
+                      svd_dc_workspace * w);
+static int svd_dc_merge (const size_t off, const size_t n, const size_t nl,
+                         const int sqre, svd_dc_workspace * w);
+static void svd_dc_sort (const size_t off, const size_t n, const int sqre,
+                         const double vals[], size_t p[], svd_dc_workspace * w);
+static int secular_root_sv (const size_t k, const size_t i, const double dl[],
+                            const double zl[], size_t * org, double * mu);
+
+/*
+gsl_linalg_SV_decomp_dc()
+  Singular value decomposition with the divide and conquer method
+
+Inputs: A - (input/output) M-by-N matrix, M >= N; on output, the
+            M-by-N matrix U
+        V - (output) N-by-N matrix V
+        S - (output) singular values, length N, in decreasing order
+
+Notes:
+1) The output is the same as for gsl_linalg_SV_decomp
+
+2) Additional workspace of size M*N + 4*N^2 is allocated internally
+*/
+
+int
+gsl_linalg_SV_decomp_dc (gsl_matrix * A, gsl_matrix * V, gsl_vector * S)
+{
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+
+  if (M < N)
+    {
+      GSL_ERROR ("svd of MxN matrix, M<N, is not implemented", GSL_EUNIMPL);
+    }
+  else if (V->size1 != N)
+    {
+      GSL_ERROR ("square matrix V must match second dimension of matrix A",
+                 GSL_EBADLEN);
+    }
+  else if (V->size1 != V->size2)
+    {
+      GSL_ERROR ("matrix V must be square", GSL_ENOTSQR);
+    }
+  else if (S->size != N)
+    {
+      GSL_ERROR ("length of vector S must match second dimension of matrix A",
+                 GSL_EBADLEN);
+    }
+  else if (N == 1)
+    {
+      gsl_vector_view column = gsl_matrix_column (A, 0);
+      double norm = gsl_blas_dnrm2 (&column.vector);
+
+      gsl_vector_set (S, 0, norm);
+      gsl_matrix_set (V, 0, 0, 1.0);
+
+      if (norm != 0.0)
+        {
+          gsl_blas_dscal (1.0 / norm, &column.vector);
+        }
+
+      return GSL_SUCCESS;
+    }
+  else
+    {
+      svd_dc_workspace w;
+      gsl_vector_view f;
+      gsl_matrix * X;
+      double scale = 0.0;
+      size_t i;
+      int status;
+
+      status = svd_dc_alloc (N, &w);
+      if (status)
+        return status;
+
+      X = gsl_matrix_alloc (M, N);
+      if (X == NULL)
+        {
+          svd_dc_free (&w);
+          GSL_ERROR ("failed to allocate space for workspace", GSL_ENOMEM);
+        }
+
+      /* scale A to unit max norm, so that neither the Householder
+         reflections nor the secular equations underflow or overflow */
+
+      for (i = 0; i < M; i++)
+        {
+          size_t j;
+
+          for (j = 0; j < N; j++)
+            scale = GSL_MAX (scale, fabs (gsl_matrix_get (A, i, j)));
+        }
+
+      if (scale > 0.0 && gsl_finite (scale))
+        gsl_matrix_scale (A, 1.0 / scale);
+
+      /* bidiagonalize A, unpack A into U S V, using e for the
+         superdiagonal */
+
+      f = gsl_vector_view_array (w.e, N - 1);
+      status = gsl_linalg_bidiag_decomp (A, S, &f.vector);
+      if (status)
+        {
+          svd_dc_free (&w);
+          gsl_matrix_free (X);
+          return status;
+        }
+
+      gsl_linalg_bidiag_unpack2 (A, S, &f.vector, V);
+
+      w.e[N - 1] = 0.0;
+
+      for (i = 0; i < N; i++)
+        w.d[i] = gsl_vector_get (S, i);
+
+      gsl_matrix_set_zero (w.U);
+      gsl_matrix_set_zero (w.W);
+
+      if (scale == 0.0)
+        {
+          svd_dc_free (&w);
+          gsl_matrix_free (X);
+          return GSL_SUCCESS;
+        }
+      else if (!gsl_finite (scale))
+        {
+          /* NaN and Inf propagate through QR iterations as in
+             gsl_linalg_SV_decomp */
+          scale = 1.0;
+          status = svd_dc_qr (0, N, 0, &w);
+        }
+      else
+        {
+          status = svd_dc_solve (0, N, 0, &w);
+        }
+
+      if (status)
+        {
+          svd_dc_free (&w);
+          gsl_matrix_free (X);
+          return status;
+        }
+
+      /* U := U_B U, V := V_B V, with the singular values in decreasing
+         order */
+
+      gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, A, w.U, 0.0, X);
+      gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, V, w.W, 0.0, w.S);
+
+      for (i = 0; i < N; i++)
+        {
+          gsl_vector_view src = gsl_matrix_column (X, N - 1 - i);
+          gsl_vector_view dest = gsl_matrix_column (A, i);
+
+          gsl_vector_memcpy (&dest.vector, &src.vector);
+
+          src = gsl_matrix_column (w.S, N - 1 - i);
+          dest = gsl_matrix_column (V, i);
+          gsl_vector_memcpy (&dest.vector, &src.vector);
+
+          gsl_vector_set (S, i, scale * w.d[N - 1 - i]);
+        }
+
+      svd_dc_free (&w);
+      gsl_matrix_free (X);
+
+      return GSL_SUCCESS;
+    }
+}
+
+static int
+svd_dc_alloc (const size_t N, svd_dc_workspace * w)
+{
+  w->size = N;
+  w->d = malloc (N * sizeof (double));
+  w->e = malloc (N * sizeof (double));
+  w->work = malloc (5 * N * sizeof (double));
+  w->iwork = malloc (5 * N * sizeof (size_t));
+  w->U = gsl_matrix_alloc (N, N);
+  w->W = gsl_matrix_alloc (N, N);
+  w->S = gsl_matrix_alloc (N, N);
+  w->T = gsl_matrix_alloc (N, N);
+
+  if (w->d == 0 || w->e == 0 || w->work == 0 || w->iwork == 0 ||
+      w->U == 0 || w->W == 0 || w->S == 0 || w->T == 0)
+    {
+      svd_dc_free (w);
+      GSL_ERROR ("failed to allocate space for workspace", GSL_ENOMEM);
+    }
+
+  return GSL_SUCCESS;
+}
+
+static void
+svd_dc_free (svd_dc_workspace * w)
+{
+  if (w->U)
+    gsl_matrix_free (w->U);
+
+  if (w->W)
+    gsl_matrix_free (w->W);
+
+  if (w->S)
+    gsl_matrix_free (w->S);
+
+  if (w->T)
+    gsl_matrix_free (w->T);
+
+  free (w->iwork);
+  free (w->work);
+  free (w->e);
+  free (w->d);
+}
+
+/* compute the singular value decomposition of the n-by-(n+sqre) block
+   of B starting at (off,off), into the diagonal blocks of U and W, with
+   the singular values in increasing order.  If sqre = 1, the last
+   column of the block of W is a null vector of the block of B */
+
+static int
+svd_dc_solve (const size_t off, const size_t n, const int sqre,
+              svd_dc_workspace * w)
+{
+  if (n <= SVD_DC_SMALL)
+    {
+      return svd_dc_qr (off, n, sqre, w);
+    }
+  else
+    {
+      const size_t nl = n / 2;
+      int status;
+
+      status = svd_dc_solve (off, nl, 1, w);
+      if (status)
+        return status;
+
+      status = svd_dc_solve (off + nl + 1, n - nl - 1, sqre, w);
+      if (status)
+        return status;
+
+      return svd_dc_merge (off, n, nl, sqre, w);
+    }
+}
+
+/* QR iterations on a small block, as in gsl_linalg_SV_decomp */
+
+static int
+svd_dc_qr (const size_t off, const size_t n, const int sqre,
+           svd_dc_workspace * w)
+{
+  const size_t nw = n + sqre;
+  double *const d = w->d + off;
+  double *const e = w->e + off;
+  gsl_matrix_view U = gsl_matrix_submatrix (w->U, off, off, n, n);
+  gsl_matrix_view W = gsl_matrix_submatrix (w->W, off, off, nw, nw);
+  size_t a, b, i, iter = 0;
+
+  gsl_matrix_set_identity (&U.matrix);
+  gsl_matrix_set_identity (&W.matrix);
+
+  if (sqre)
+    {
+      /* zero the element of the extra column with rotations from the
+         right, chasing it up the last column */
+      gsl_vector_view wn = gsl_matrix_column (&W.matrix, n);
+      double bulge = e[n - 1];
+
+      for (i = n; i-- > 0 && bulge != 0.0; )
+        {
+          gsl_vector_view wi = gsl_matrix_column (&W.matrix, i);
+          const double r = hypot (d[i], bulge);
+          const double c = d[i] / r;
+          const double s = bulge / r;
+
+          gsl_blas_drot (&wi.vector, &wn.vector, c, s);
+          d[i] = r;
+
+          if (i > 0)
+            {
+              bulge = -s * e[i - 1];
+              e[i - 1] *= c;
+            }
+        }
+
+      e[n - 1] = 0.0;
+    }
+
+  if (n > 1)
+    {
+      gsl_vector_view dv = gsl_vector_view_array (d, n);
+      gsl_vector_view fv = gsl_vector_view_array (e, n - 1);
+
+      chop_small_elements (&dv.vector, &fv.vector);
+
+      b = n - 1;
+
+      while (b > 0)
+        {
+          if (e[b - 1] == 0.0 || gsl_isnan (e[b - 1]))
+            {
+              b--;
+              continue;
+            }
+
+          a = b - 1;
+
+          while (a > 0)
+            {
+              if (e[a - 1] == 0.0 || gsl_isnan (e[a - 1]))
+                break;
+
+              a--;
+            }
+
+          if (++iter > 100 * n)
+            {
+              GSL_ERROR ("SVD decomposition failed to converge", GSL_EMAXITER);
+            }
+
+          {
+            const size_t n_block = b - a + 1;
+            gsl_vector_view d_block = gsl_vector_subvector (&dv.vector, a, n_block);
+            gsl_vector_view f_block = gsl_vector_subvector (&fv.vector, a, n_block - 1);
+            gsl_matrix_view U_block = gsl_matrix_submatrix (&U.matrix, 0, a, n, n_block);
+            gsl_matrix_view W_block = gsl_matrix_submatrix (&W.matrix, 0, a, nw, n_block);
+
+            qrstep (&d_block.vector, &f_block.vector, &U_block.matrix, &W_block.matrix);
+            chop_small_elements (&d_block.vector, &f_block.vector);
+          }
+        }
+    }
+
+  /* make the singular values positive and sort them */
+
+  for (i = 0; i < n; i++)
+    {
+      if (d[i] < 0.0)
+        {
+          gsl_vector_view wi = gsl_matrix_column (&W.matrix, i);
+          gsl_vector_scale (&wi.vector, -1.0);
+          d[i] = -d[i];
+        }
+
+      w->work[i] = d[i];
+    }
+
+  svd_dc_sort (off, n, sqre, w->work, w->iwork, w);
+
+  return GSL_SUCCESS;
+}
+
+/* merge the singular value decompositions of the blocks B1 = (off,nl)
+   and B2 = (off+nl+1,n-nl-1), given in the diagonal blocks of U and W.
+
+   With the columns of U and W ordered as in B, position nl corresponds
+   to the row k of B and to the null vector of B1, and M has the first
+   row z in row nl and the diagonal d at the other positions */
+
+static int
+svd_dc_merge (const size_t off, const size_t n, const size_t nl,
+              const int sqre, svd_dc_workspace * w)
+{
+  const size_t nw = n + sqre;
+  gsl_matrix_view U = gsl_matrix_submatrix (w->U, off, off, n, n);
+  gsl_matrix_view W = gsl_matrix_submatrix (w->W, off, off, nw, nw);
+  gsl_matrix_view SU = gsl_matrix_submatrix (w->S, 0, 0, n, n);
+  gsl_matrix_view SW = gsl_matrix_submatrix (w->S, 0, 0, nw, n);
+  double *const d = w->d + off;
+  double *const z = w->work;
+  double *const dl = z + n;
+  double *const zl = dl + n;
+  double *const mu = zl + n;
+  double *const vals = mu + n;
+  size_t *const perm = w->iwork;
+  size_t *const nd = perm + n;
+  size_t *const def = nd + n;
+  size_t *const org = def + n;
+  size_t *const p = org + n;
+  const double alpha = d[nl];
+  const double beta = w->e[off + nl];
+  double dmax, tol;
+  size_t i, j, k = 0, ndef = 0, i1, i2;
+  long prev = -1;
+
+  /* z = [ alpha * last row of W1, beta * first row of W2 ], with the
+     null vectors of B1 and B2 rotated into a single column */
+
+  for (j = 0; j < nl; j++)
+    z[j] = alpha * gsl_matrix_get (&W.matrix, nl, j);
+
+  for (j = nl + 1; j < n; j++)
+    z[j] = beta * gsl_matrix_get (&W.matrix, nl + 1, j);
+
+  if (sqre)
+    {
+      const double a1 = alpha * gsl_matrix_get (&W.matrix, nl, nl);
+      const double b2 = beta * gsl_matrix_get (&W.matrix, nl + 1, n);
+      const double r0 = hypot (a1, b2);
+
+      if (r0 != 0.0)
+        {
+          gsl_vector_view w1 = gsl_matrix_column (&W.matrix, nl);
+          gsl_vector_view w2 = gsl_matrix_column (&W.matrix, n);
+          gsl_blas_drot (&w1.vector, &w2.vector, a1 / r0, b2 / r0);
+        }
+
+      z[nl] = r0;
+    }
+  else
+    {
+      z[nl] = alpha * gsl_matrix_get (&W.matrix, nl, nl);
+    }
+
+  d[nl] = 0.0;
+  gsl_matrix_set (&U.matrix, nl, nl, 1.0);
+
+  dmax = GSL_MAX (fabs (alpha), fabs (beta));
+
+  for (j = 0; j < n; j++)
+    dmax = GSL_MAX (dmax, d[j]);
+
+  tol = 8.0 * GSL_DBL_EPSILON * dmax;
+
+  /* merge the increasing singular values of the two blocks, after the
+     first row */
+
+  perm[0] = nl;
+
+  for (i = 1, i1 = 0, i2 = nl + 1; i < n; i++)
+    {
+      if (i2 == n || (i1 < nl && d[i1] <= d[i2]))
+        perm[i] = i1++;
+      else
+        perm[i] = i2++;
+    }
+
+  /* keep the poles of the secular equation away from zero */
+
+  if (fabs (z[nl]) <= tol)
+    z[nl] = tol;
+
+  if (d[perm[1]] <= 0.5 * tol)
+    d[perm[1]] = 0.5 * tol;
+
+  /*
+   * deflation: singular values with a negligible component of z are
+   * kept, and for two close singular values rotations of U and W
+   * zero one of their components of z
+   */
+
+  nd[k++] = nl;
+
+  for (i = 1; i < n; i++)
+    {
+      j = perm[i];
+
+      if (fabs (z[j]) <= tol)
+        {
+          def[ndef++] = j;
+        }
+      else if (prev < 0)
+        {
+          prev = (long) j;
+        }
+      else
+        {
+          const size_t pj = (size_t) prev;
+
+          if (d[j] - d[pj] <= tol)
+            {
+              gsl_vector_view up = gsl_matrix_column (&U.matrix, pj);
+              gsl_vector_view uj = gsl_matrix_column (&U.matrix, j);
+              gsl_vector_view wp = gsl_matrix_column (&W.matrix, pj);
+              gsl_vector_view wj = gsl_matrix_column (&W.matrix, j);
+              const double r = hypot (z[j], z[pj]);
+              const double c = z[j] / r;
+              const double s = -z[pj] / r;
+
+              gsl_blas_drot (&up.vector, &uj.vector, c, s);
+              gsl_blas_drot (&wp.vector, &wj.vector, c, s);
+              z[j] = r;
+              z[pj] = 0.0;
+
+              def[ndef++] = pj;
+            }
+          else
+            {
+              nd[k++] = pj;
+            }
+
+          prev = (long) j;
+        }
+    }
+
+  if (prev >= 0)
+    nd[k++] = (size_t) prev;
+
+  for (i = 0; i < k; i++)
+    {
+      dl[i] = d[nd[i]];
+      zl[i] = z[nd[i]];
+    }
+
+  for (i = 0; i < ndef; i++)
+    vals[k + i] = d[def[i]];
+
+  /* roots sigma_i^2 = dl[org_i]^2 + mu_i of the secular equation */
+
+  for (i = 0; i < k; i++)
+    {
+      int status = secular_root_sv (k, i, dl, zl, &org[i], &mu[i]);
+      const double d0 = dl[org[i]];
+
+      if (status)
+        GSL_ERROR ("secular equation failed to converge", status);
+
+      vals[i] = d0 + mu[i] / (d0 + sqrt (d0 * d0 + mu[i]));
+    }
+
+#define DIFF(j,i) ((dl[j] - dl[org[i]]) * (dl[j] + dl[org[i]]) - mu[i])
+
+  /*
+   * recompute z from the computed singular values (Gu and Eisenstat),
+   * so that the singular vectors are numerically orthogonal:
+   *
+   * z_j^2 = prod_i (sigma_i^2 - d_j^2) / prod_{i != j} (d_i^2 - d_j^2)
+   */
+
+  for (j = 0; j < k; j++)
+    {
+      double wj = DIFF (j, j);
+
+      for (i = 0; i < k; i++)
+        {
+          if (i != j)
+            wj *= DIFF (j, i) / ((dl[j] - dl[i]) * (dl[j] + dl[i]));
+        }
+
+      z[j] = (zl[j] >= 0.0) ? sqrt (fabs (wj)) : -sqrt (fabs (wj));
+    }
+
+  /* left singular vectors of M: u_i = [ -1, d_j z_j / (d_j^2 - sigma_i^2) ] */
+
+  {
+    gsl_matrix_view T = gsl_matrix_submatrix (w->T, 0, 0, k, k);
+    gsl_matrix_view Sk = gsl_matrix_submatrix (&SU.matrix, 0, 0, n, k);
+    gsl_matrix_view Uk = gsl_matrix_submatrix (&U.matrix, 0, 0, n, k);
+
+    for (i = 0; i < k; i++)
+      {
+        gsl_vector_view ti = gsl_matrix_column (&T.matrix, i);
+
+        gsl_matrix_set (&T.matrix, 0, i, -1.0);
+
+        for (j = 1; j < k; j++)
+          gsl_matrix_set (&T.matrix, j, i, dl[j] * z[j] / DIFF (j, i));
+
+        gsl_vector_scale (&ti.vector, 1.0 / gsl_blas_dnrm2 (&ti.vector));
+      }
+
+    for (i = 0; i < n; i++)
+      {
+        gsl_vector_view src = gsl_matrix_column (&U.matrix, (i < k) ? nd[i] : def[i - k]);
+        gsl_vector_view dest = gsl_matrix_column (&SU.matrix, i);
+        gsl_vector_memcpy (&dest.vector, &src.vector);
+      }
+
+    gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, &Sk.matrix, &T.matrix,
+                    0.0, &Uk.matrix);
+
+    if (ndef > 0)
+      {
+        gsl_matrix_view src = gsl_matrix_submatrix (&SU.matrix, 0, k, n, ndef);
+        gsl_matrix_view dest = gsl_matrix_submatrix (&U.matrix, 0, k, n, ndef);
+        gsl_matrix_memcpy (&dest.matrix, &src.matrix);
+      }
+  }
+
+  /* right singular vectors of M: v_i = [ z_j / (d_j^2 - sigma_i^2) ] */
+
+  {
+    gsl_matrix_view T = gsl_matrix_submatrix (w->T, 0, 0, k, k);
+    gsl_matrix_view Sk = gsl_matrix_submatrix (&SW.matrix, 0, 0, nw, k);
+    gsl_matrix_view Wk = gsl_matrix_submatrix (&W.matrix, 0, 0, nw, k);
+
+    for (i = 0; i < k; i++)
+      {
+        gsl_vector_view ti = gsl_matrix_column (&T.matrix, i);
+
+        for (j = 0; j < k; j++)
+          gsl_matrix_set (&T.matrix, j, i, z[j] / DIFF (j, i));
+
+        gsl_vector_scale (&ti.vector, 1.0 / gsl_blas_dnrm2 (&ti.vector));
+      }
+
+    for (i = 0; i < n; i++)
+      {
+        gsl_vector_view src = gsl_matrix_column (&W.matrix, (i < k) ? nd[i] : def[i - k]);
+        gsl_vector_view dest = gsl_matrix_column (&SW.matrix, i);
+        gsl_vector_memcpy (&dest.vector, &src.vector);
+      }
+
+    gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, &Sk.matrix, &T.matrix,
+                    0.0, &Wk.matrix);
+
+    if (ndef > 0)
+      {
+        gsl_matrix_view src = gsl_matrix_submatrix (&SW.matrix, 0, k, nw, ndef);
+        gsl_matrix_view dest = gsl_matrix_submatrix (&W.matrix, 0, k, nw, ndef);
+        gsl_matrix_memcpy (&dest.matrix, &src.matrix);
+      }
+  }
+
+#undef DIFF
+
+  svd_dc_sort (off, n, sqre, vals, p, w);
+
+  return GSL_SUCCESS;
+}
+
+/* sort the singular values vals of the block (off,n) into increasing
+   order in d, permuting the columns of U and W accordingly */
+
+static void
+svd_dc_sort (const size_t off, const size_t n, const int sqre,
+             const double vals[], size_t p[], svd_dc_workspace * w)
+{
+  const size_t nw = n + sqre;
+  gsl_matrix_view U = gsl_matrix_submatrix (w->U, off, off, n, n);
+  gsl_matrix_view W = gsl_matrix_submatrix (w->W, off, off, nw, n);
+  gsl_matrix_view SU = gsl_matrix_submatrix (w->S, 0, 0, n, n);
+  gsl_matrix_view SW = gsl_matrix_submatrix (w->S, 0, 0, nw, n);
+  size_t i;
+
+  gsl_sort_index (p, vals, 1, n);
+
+  gsl_matrix_memcpy (&SU.matrix, &U.matrix);
+
+  for (i = 0; i < n; i++)
+    {
+      gsl_vector_view src = gsl_matrix_column (&SU.matrix, p[i]);
+      gsl_vector_view dest = gsl_matrix_column (&U.matrix, i);
+      gsl_vector_memcpy (&dest.vector, &src.vector);
+    }
+
+  gsl_matrix_memcpy (&SW.matrix, &W.matrix);
+
+  for (i = 0; i < n; i++)
+    {
+      gsl_vector_view src = gsl_matrix_column (&SW.matrix, p[i]);
+      gsl_vector_view dest = gsl_matrix_column (&W.matrix, i);
+      gsl_vector_memcpy (&dest.vector, &src.vector);
+      w->d[off + i] = vals[p[i]];
+    }
+}
+
+/*
+secular_root_sv()
+  Find the i-th root of the secular equation
+
+f(sigma) = 1 + sum_j zl_j^2 / (dl_j^2 - sigma^2)
+
+with 0 = dl_0 < dl_1 < ... < dl_{k-1}. The root lies in
+(dl_i, dl_{i+1}), or (dl_{k-1}, (dl_{k-1}^2 + |zl|^2)^{1/2}] for
+i = k - 1, and is returned as sigma^2 = dl[org]^2 + mu, where dl[org]
+is the nearest pole, so that the differences
+
+dl_j^2 - sigma^2 = (dl_j - dl[org]) (dl_j + dl[org]) - mu
+
+are computed accurately.
+
+The iteration is that of the symmetric eigenvalue problem in
+eigen/symmvdc.c, in the variable sigma^2: the rational model of Bunch,
+Nielsen and Sorensen, safeguarded by bisection on the bracket of the
+root.
+*/
+
+static int
+secular_root_sv (const size_t k, const size_t i, const double dl[],
+                 const double zl[], size_t * org, double * mu)
+{
+  double lo, hi, t;
+  size_t j, iter;
+
+  if (i < k - 1)
+    {
+      const double mid = 0.5 * (dl[i + 1] - dl[i]) * (dl[i + 1] + dl[i]);
+      double fmid = 1.0;
+
+      for (j = 0; j < k; j++)
+        fmid += zl[j] * zl[j] / ((dl[j] - dl[i]) * (dl[j] + dl[i]) - mid);
+
+      /* f is increasing, so the sign of f at the midpoint tells which
+         pole is nearest */
+
+      if (fmid >= 0.0)
+        {
+          *org = i;
+          lo = 0.0;
+          hi = mid;
+        }
+      else
+        {
+          *org = i + 1;
+          lo = -mid;
+          hi = 0.0;
+        }
+    }
+  else
+    {
+      double znrm2 = 0.0;
+
+      for (j = 0; j < k; j++)
+        znrm2 += zl[j] * zl[j];
+
+      *org = i;
+      lo = 0.0;
+      hi = znrm2;
+    }
+
+  t = 0.5 * (lo + hi);
+
+  for (iter = 0; iter < SVD_DC_MAXITER; iter++)
+    {
+      const double d0 = dl[*org];
+      double psi = 0.0, dpsi = 0.0, phi = 0.0, dphi = 0.0;
+      double f, ferr, delta1, s, tnew;
+
+      for (j = 0; j < k; j++)
+        {
+          const double delta = (dl[j] - d0) * (dl[j] + d0) - t;
+          const double r = zl[j] / delta;
+
+          if (j <= i)
+            {
+              psi += zl[j] * r;
+              dpsi += r * r;
+            }
+          else
+            {
+              phi += zl[j] * r;
+              dphi += r * r;
+            }
+        }
+
+      f = 1.0 + psi + phi;
+
+      /* bound on the rounding error in f, as in LAPACK dlasd4; near a
+         pole with a tiny zl_i the bracket cannot shrink below this */
+      ferr = GSL_DBL_EPSILON * (8.0 * (1.0 + phi - psi) + fabs (t) * (dpsi + dphi));
+
+      if (fabs (f) <= ferr)
+        break;
+      else if (f < 0.0)
+        lo = t;
+      else
+        hi = t;
+
+      /* model f with the poles of dl_i and dl_{i+1} and solve for the
+         step s of sigma^2 */
+
+      delta1 = (dl[i] - d0) * (dl[i] + d0) - t;
+
+      if (i < k - 1)
+        {
+          const double delta2 = (dl[i + 1] - d0) * (dl[i + 1] + d0) - t;
+          const double b = dpsi * delta1 * delta1;
+          const double e = dphi * delta2 * delta2;
+          const double a0 = 1.0 + (psi - dpsi * delta1) + (phi - dphi * delta2);
+          const double qb = -(a0 * (delta1 + delta2) + b + e);
+          const double qc = a0 * delta1 * delta2 + b * delta2 + e * delta1;
+          const double disc = qb * qb - 4.0 * a0 * qc;
+
+          s = GSL_NAN;
+
+          if (a0 == 0.0)
+            {
+              s = -qc / qb;
+            }
+          else if (disc >= 0.0)
+            {
+              const double q = -0.5 * (qb + ((qb >= 0.0) ? sqrt (disc) : -sqrt (disc)));
+              const double r1 = q / a0;
+              const double r2 = (q != 0.0) ? qc / q : r1;
+
+              /* the root of the model lies between its poles */
+              s = (r1 > delta1 && r1 < delta2) ? r1 : r2;
+            }
+        }
+      else
+        {
+          const double a0 = 1.0 + (psi - dpsi * delta1);
+
+          s = (a0 > 0.0) ? delta1 + dpsi * delta1 * delta1 / a0 : GSL_NAN;
+        }
+
+      tnew = t + s;
+
+      /* the upper bound of the last root is not a pole, and may be the
+         root itself */
+      if (!(tnew > lo && (tnew < hi || (i == k - 1 && tnew == hi))))
+        tnew = 0.5 * (lo + hi);
+
+      if (fabs (tnew - t) <= 2.0 * GSL_DBL_EPSILON * fabs (tnew) ||
+          hi - lo <= 2.0 * GSL_DBL_EPSILON * GSL_MAX (fabs (lo), fabs (hi)))
+        {
+          t = tnew;
+          break;
+        }
+
+      t = tnew;
+    }
+
+  *mu = t;
+
+  return (iter < SVD_DC_MAXITER) ? GSL_SUCCESS : GSL_EMAXITER;
+}
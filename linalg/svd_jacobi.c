@@ -0,0 +1,369 @@
+/* linalg/svd_jacobi.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_sys.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_linalg.h>
+
+/*
+ * this module contains a parallel version of the one-sided Jacobi SVD
+ * of gsl_linalg_SV_decomp_jacobi, with the column pairs of each sweep
+ * visited in a round-robin ordering of column blocks:
+ *
+ * Brent, R. P. and Luk, F. T., 1985. The solution of singular-value and
+ * symmetric eigenvalue problems on multiprocessor arrays. SIAM Journal on
+ * Scientific and Statistical Computing, 6(1), pp.69-84.
+ *
+ * Bečka, M., Okša, G. and Vajteršic, M., 2002. Dynamic ordering for a
+ * parallel block-Jacobi SVD algorithm. Parallel Computing, 28(2),
+ * pp.243-262.
+ */
+
+/* maximum number of columns in a block */
+#define SVD_JACOBI_BLOCK 16
+
+static int svd_jacobi_blocks (gsl_matrix * At, gsl_matrix * Qt, gsl_vector * S,
+                              size_t I, size_t J, const size_t nb,
+                              const int inner, const double tolerance);
+static int svd_jacobi_pair (gsl_matrix * At, gsl_matrix * Qt, gsl_vector * S,
+                            const size_t j, const size_t k,
+                            const double tolerance);
+
+/*
+gsl_linalg_SV_decomp_jacobi_par()
+  Singular value decomposition by parallel one-sided Jacobi
+orthogonalization
+
+Inputs: A - (input/output) M-by-N matrix, M >= N; on output, the
+            M-by-N matrix U
+        Q - (output) N-by-N matrix V
+        S - (output) singular values, length N, in decreasing order
+        nsweep - (output) number of sweeps performed, including the
+                 final one in which no rotation was applied; may be NULL
+
+Return: success/error
+
+Notes:
+1) The columns are split into blocks of at most SVD_JACOBI_BLOCK
+columns, at least two per thread (see gsl_set_num_threads). Each sweep
+consists of the rounds of a round-robin tournament between the blocks,
+and the pairs of blocks of a round are orthogonalized in parallel, by
+rotating all pairs of columns between the two blocks, and in the first
+round also the pairs within each block.
+
+2) Every pair of columns is visited once per sweep, with the same
+rotations and convergence tests as in gsl_linalg_SV_decomp_jacobi, but
+in a different order, so neither the number of sweeps nor the rounding
+errors are guaranteed to be the same. The convergence behaviour and the
+accuracy bounds are those of the serial routine.
+
+3) The rotations are applied to the transposes of A and Q, so that
+the columns are contiguous in memory. Additional workspace of size
+M*N + N^2 is allocated internally.
+*/
+
+int
+gsl_linalg_SV_decomp_jacobi_par (gsl_matrix * A, gsl_matrix * Q, gsl_vector * S,
+                                 size_t * nsweep)
+{
+  if (A->size1 < A->size2)
+    {
+      GSL_ERROR ("svd of MxN matrix, M<N, is not implemented", GSL_EUNIMPL);
+    }
+  else if (Q->size1 != A->size2)
+    {
+      GSL_ERROR ("square matrix Q must match second dimension of matrix A",
+                 GSL_EBADLEN);
+    }
+  else if (Q->size1 != Q->size2)
+    {
+      GSL_ERROR ("matrix Q must be square", GSL_ENOTSQR);
+    }
+  else if (S->size != A->size2)
+    {
+      GSL_ERROR ("length of vector S must match second dimension of matrix A",
+                 GSL_EBADLEN);
+    }
+  else
+    {
+      const size_t M = A->size1;
+      const size_t N = A->size2;
+      const int nthreads = gsl_get_num_threads ();
+      const size_t nb = GSL_MAX (1, GSL_MIN (SVD_JACOBI_BLOCK,
+                                             (N + 2 * nthreads - 1) / (2 * nthreads)));
+      const size_t nblocks = (N + nb - 1) / nb;
+      const size_t P = nblocks + (nblocks % 2); /* with a dummy block if odd */
+      const double tolerance = 10 * M * GSL_DBL_EPSILON;
+      int sweepmax = GSL_MAX (5 * N, 12);
+      int sweep = 0;
+      int count = 1;
+      gsl_matrix *At, *Qt;
+      size_t *order;
+      size_t j, round;
+
+      At = gsl_matrix_alloc (N, M);
+      if (At == NULL)
+        {
+          GSL_ERROR ("failed to allocate space for A^T", GSL_ENOMEM);
+        }
+
+      Qt = gsl_matrix_alloc (N, N);
+      if (Qt == NULL)
+        {
+          gsl_matrix_free (At);
+          GSL_ERROR ("failed to allocate space for Q^T", GSL_ENOMEM);
+        }
+
+      order = malloc (P * sizeof (size_t));
+      if (order == NULL)
+        {
+          gsl_matrix_free (At);
+          gsl_matrix_free (Qt);
+          GSL_ERROR ("failed to allocate space for block order", GSL_ENOMEM);
+        }
+
+      gsl_matrix_transpose_memcpy (At, A);
+      gsl_matrix_set_identity (Qt);
+
+      /* Store the column error estimates in S, for use during the
+         orthogonalization */
+
+      for (j = 0; j < N; j++)
+        {
+          gsl_vector_view cj = gsl_matrix_row (At, j);
+          double sj = gsl_blas_dnrm2 (&cj.vector);
+          gsl_vector_set (S, j, GSL_DBL_EPSILON * sj);
+        }
+
+      /* Orthogonalize A by plane rotations, counting the rotations
+         which were not skipped */
+
+      while (count > 0 && sweep <= sweepmax)
+        {
+          count = 0;
+
+          for (j = 0; j < P; j++)
+            order[j] = j;
+
+          for (round = 0; round < P - 1; round++)
+            {
+              const int npairs = (int) (P / 2);
+              int rcount = 0;
+              int t;
+
+#pragma omp parallel for num_threads(nthreads) schedule(dynamic) reduction(+:rcount)
+              for (t = 0; t < npairs; t++)
+                {
+                  rcount += svd_jacobi_blocks (At, Qt, S, order[t],
+                                               order[P - 1 - t], nb,
+                                               round == 0, tolerance);
+                }
+
+              count += rcount;
+
+              /* next round: keep block order[0] fixed and rotate the
+                 others */
+              {
+                const size_t last = order[P - 1];
+
+                for (j = P - 1; j > 1; j--)
+                  order[j] = order[j - 1];
+
+                order[1] = last;
+              }
+            }
+
+          /* Sweep completed. */
+          sweep++;
+        }
+
+      /*
+       * Orthogonalization complete. Compute singular values.
+       */
+
+      {
+        double prev_norm = -1.0;
+
+        for (j = 0; j < N; j++)
+          {
+            gsl_vector_view column = gsl_matrix_row (At, j);
+            double norm = gsl_blas_dnrm2 (&column.vector);
+
+            /* Determine if singular value is zero, according to the
+               criteria used in the main loop above (i.e. comparison
+               with norm of previous column). */
+
+            if (norm == 0.0 || prev_norm == 0.0
+                || (j > 0 && norm <= tolerance * prev_norm))
+              {
+                gsl_vector_set (S, j, 0.0);     /* singular */
+                gsl_vector_set_zero (&column.vector);   /* annihilate column */
+
+                prev_norm = 0.0;
+              }
+            else
+              {
+                gsl_vector_set (S, j, norm);    /* non-singular */
+                gsl_vector_scale (&column.vector, 1.0 / norm);  /* normalize column */
+
+                prev_norm = norm;
+              }
+          }
+      }
+
+      gsl_matrix_transpose_memcpy (A, At);
+      gsl_matrix_transpose_memcpy (Q, Qt);
+
+      gsl_matrix_free (At);
+      gsl_matrix_free (Qt);
+      free (order);
+
+      if (nsweep != NULL)
+        *nsweep = (size_t) sweep;
+
+      if (count > 0)
+        {
+          /* reached sweep limit */
+          GSL_ERROR ("Jacobi iterations did not reach desired tolerance",
+                     GSL_ETOL);
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/* orthogonalize the columns of blocks I and J, where a block index
+   beyond the last block denotes the dummy block. If inner is set, the
+   pairs within each block are also rotated. Returns the number of
+   rotations applied */
+
+static int
+svd_jacobi_blocks (gsl_matrix * At, gsl_matrix * Qt, gsl_vector * S,
+                   size_t I, size_t J, const size_t nb,
+                   const int inner, const double tolerance)
+{
+  const size_t N = At->size1;
+  size_t i0, i1, j0, j1, j, k;
+  int count = 0;
+
+  if (I * nb >= N)
+    {
+      const size_t tmp = I;
+      I = J;
+      J = tmp;
+    }
+
+  i0 = I * nb;
+  i1 = GSL_MIN (i0 + nb, N);
+
+  if (i0 >= N)
+    return 0;
+
+  if (inner)
+    {
+      for (j = i0; j < i1; j++)
+        for (k = j + 1; k < i1; k++)
+          count += svd_jacobi_pair (At, Qt, S, j, k, tolerance);
+    }
+
+  j0 = J * nb;
+  j1 = GSL_MIN (j0 + nb, N);
+
+  if (j0 >= N)
+    return count;
+
+  if (inner)
+    {
+      for (j = j0; j < j1; j++)
+        for (k = j + 1; k < j1; k++)
+          count += svd_jacobi_pair (At, Qt, S, j, k, tolerance);
+    }
+
+  for (j = i0; j < i1; j++)
+    for (k = j0; k < j1; k++)
+      count += svd_jacobi_pair (At, Qt, S, GSL_MIN (j, k), GSL_MAX (j, k),
+                                tolerance);
+
+  return count;
+}
+
+/* rotate columns j < k of A (rows of At) to orthogonalize them, or
+   swap them if column k has the larger norm, as in
+   gsl_linalg_SV_decomp_jacobi. Returns 1 if a rotation was applied and 0
+   if the pair was skipped */
+
+static int
+svd_jacobi_pair (gsl_matrix * At, gsl_matrix * Qt, gsl_vector * S,
+                 const size_t j, const size_t k, const double tolerance)
+{
+  gsl_vector_view cj = gsl_matrix_row (At, j);
+  gsl_vector_view ck = gsl_matrix_row (At, k);
+  gsl_vector_view qj = gsl_matrix_row (Qt, j);
+  gsl_vector_view qk = gsl_matrix_row (Qt, k);
+  double a, b, p, q, v;
+  double cosine, sine;
+  double abserr_a, abserr_b;
+  int sorted, orthog, noisya, noisyb;
+
+  gsl_blas_ddot (&cj.vector, &ck.vector, &p);
+  p *= 2.0 ;  /* equation 9a:  p = 2 x.y */
+
+  a = gsl_blas_dnrm2 (&cj.vector);
+  b = gsl_blas_dnrm2 (&ck.vector);
+
+  q = a * a - b * b;
+  v = hypot(p, q);
+
+  /* test for columns j,k orthogonal, or dominant errors */
+
+  abserr_a = gsl_vector_get(S,j);
+  abserr_b = gsl_vector_get(S,k);
+
+  sorted = (GSL_COERCE_DBL(a) >= GSL_COERCE_DBL(b));
+  orthog = (fabs (p) <= tolerance * GSL_COERCE_DBL(a * b));
+  noisya = (a < abserr_a);
+  noisyb = (b < abserr_b);
+
+  if (sorted && (orthog || noisya || noisyb))
+    return 0;
+
+  /* calculate rotation angles */
+  if (v == 0 || !sorted)
+    {
+      cosine = 0.0;
+      sine = 1.0;
+    }
+  else
+    {
+      cosine = sqrt((v + q) / (2.0 * v));
+      sine = p / (2.0 * v * cosine);
+    }
+
+  /* apply rotation to A and Q */
+  gsl_blas_drot (&cj.vector, &ck.vector, cosine, sine);
+  gsl_blas_drot (&qj.vector, &qk.vector, cosine, sine);
+
+  gsl_vector_set(S, j, fabs(cosine) * abserr_a + fabs(sine) * abserr_b);
+  gsl_vector_set(S, k, fabs(sine) * abserr_a + fabs(cosine) * abserr_b);
+
+  return 1;
+}
@@ -0,0 +1,358 @@
+/* linalg/svd_rand.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_rng.h>
+#include <gsl/gsl_randist.h>
+#include <gsl/gsl_linalg.h>
+
+/*
+ * this module contains routines for the randomized truncated singular
+ * value decomposition of a matrix, which may be given only through
+ * its products with blocks of vectors:
+ *
+ * Halko, N., Martinsson, P.G. and Tropp, J.A., 2011. Finding structure
+ * with randomness: Probabilistic algorithms for constructing approximate
+ * matrix decompositions. SIAM Review, 53(2), pp.217-288.
+ */
+
+static int svd_rand_mult (CBLAS_TRANSPOSE_t TransA, const gsl_matrix * X,
+                          void * params, gsl_matrix * Y);
+static int svd_rand_orth (gsl_matrix * A, gsl_matrix * T, gsl_matrix * work);
+
+/*
+gsl_linalg_SV_rand_alloc()
+  Allocate a workspace for the randomized SVD of M-by-N matrices
+
+Inputs: M - number of rows of A
+        N - number of columns of A
+        k - number of singular values to compute, 0 < k <= min(M,N)
+        p - oversampling; the range of A is sampled with
+            l = min(k + p, M, N) random vectors
+
+Return: pointer to workspace
+*/
+
+gsl_linalg_SV_rand_workspace *
+gsl_linalg_SV_rand_alloc (const size_t M, const size_t N, const size_t k,
+                          const size_t p)
+{
+  gsl_linalg_SV_rand_workspace *w;
+
+  if (k == 0)
+    {
+      GSL_ERROR_NULL ("number of singular values must be positive",
+                      GSL_EINVAL);
+    }
+  else if (k > GSL_MIN (M, N))
+    {
+      GSL_ERROR_NULL ("number of singular values must not exceed min(M,N)",
+                      GSL_EBADLEN);
+    }
+
+  w = calloc (1, sizeof (gsl_linalg_SV_rand_workspace));
+  if (w == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for workspace", GSL_ENOMEM);
+    }
+
+  w->size1 = M;
+  w->size2 = N;
+  w->k = k;
+  w->l = GSL_MIN (k + p, GSL_MIN (M, N));
+
+  w->Q = gsl_matrix_alloc (M, w->l);
+  w->Z = gsl_matrix_alloc (N, w->l);
+  w->T = gsl_matrix_alloc (w->l, w->l);
+  w->X = gsl_matrix_alloc (w->l, w->l);
+  w->S = gsl_vector_alloc (w->l);
+  w->work = gsl_vector_alloc (w->l);
+
+  if (w->Q == NULL || w->Z == NULL || w->T == NULL || w->X == NULL ||
+      w->S == NULL || w->work == NULL)
+    {
+      gsl_linalg_SV_rand_free (w);
+      GSL_ERROR_NULL ("failed to allocate space for workspace", GSL_ENOMEM);
+    }
+
+  return w;
+}
+
+void
+gsl_linalg_SV_rand_free (gsl_linalg_SV_rand_workspace * w)
+{
+  RETURN_IF_NULL (w);
+
+  if (w->Q)
+    gsl_matrix_free (w->Q);
+
+  if (w->Z)
+    gsl_matrix_free (w->Z);
+
+  if (w->T)
+    gsl_matrix_free (w->T);
+
+  if (w->X)
+    gsl_matrix_free (w->X);
+
+  if (w->S)
+    gsl_vector_free (w->S);
+
+  if (w->work)
+    gsl_vector_free (w->work);
+
+  free (w);
+}
+
+/*
+gsl_linalg_SV_rand_range()
+  Compute an orthonormal basis Q for the approximate range of A by
+randomized subspace iteration (Halko et al, algorithm 4.4)
+
+Inputs: f - matrix A, given by its products with blocks of vectors
+        q - number of power iterations
+        r - random number generator
+        w - workspace; on output w->Q contains the M-by-l matrix Q
+
+Return: success/error
+
+Notes:
+1) Y = A Omega is computed for a Gaussian random N-by-l matrix Omega,
+and then q times Y = A A^T Y. The columns are orthonormalized after
+each product, so that the basis does not lose accuracy to rounding.
+
+2) Power iterations improve the approximation when the singular values
+of A decay slowly, each one at the cost of two more products with A.
+*/
+
+int
+gsl_linalg_SV_rand_range (gsl_linalg_SV_rand_function * f, const size_t q,
+                          gsl_rng * r, gsl_linalg_SV_rand_workspace * w)
+{
+  if (f->size1 != w->size1 || f->size2 != w->size2)
+    {
+      GSL_ERROR ("matrix size does not match workspace", GSL_EBADLEN);
+    }
+  else
+    {
+      gsl_matrix * Q = w->Q;
+      gsl_matrix * Z = w->Z;
+      size_t i, j;
+      int status;
+
+      /* Y = A Omega */
+      for (i = 0; i < Z->size1; i++)
+        {
+          for (j = 0; j < Z->size2; j++)
+            gsl_matrix_set (Z, i, j, gsl_ran_gaussian (r, 1.0));
+        }
+
+      status = GSL_SV_RAND_FN_EVAL (f, CblasNoTrans, Z, Q);
+      if (status)
+        return status;
+
+      svd_rand_orth (Q, w->T, w->X);
+
+      for (i = 0; i < q; i++)
+        {
+          /* Z = A^T Q, Q = A Z */
+          status = GSL_SV_RAND_FN_EVAL (f, CblasTrans, Q, Z);
+          if (status)
+            return status;
+
+          svd_rand_orth (Z, w->T, w->X);
+
+          status = GSL_SV_RAND_FN_EVAL (f, CblasNoTrans, Z, Q);
+          if (status)
+            return status;
+
+          svd_rand_orth (Q, w->T, w->X);
+        }
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_linalg_SV_decomp_rand_fn()
+  Compute the k largest singular values and the corresponding singular
+vectors of A by randomized SVD (Halko et al, algorithm 5.1)
+
+A ~ U S V^T
+
+Inputs: f - matrix A, M-by-N, given by its products with blocks of vectors
+        U - (output) M-by-k left singular vectors
+        S - (output) k largest singular values, in decreasing order
+        V - (output) N-by-k right singular vectors
+        q - number of power iterations, see gsl_linalg_SV_rand_range
+        r - random number generator
+        w - workspace
+
+Return: success/error
+
+Notes: with Q from gsl_linalg_SV_rand_range, the SVD of the small
+l-by-N matrix B = Q^T A = W S X^T gives A ~ (Q W) S X^T. It is computed
+from the SVD of B^T = A^T Q with gsl_linalg_SV_decomp.
+*/
+
+int
+gsl_linalg_SV_decomp_rand_fn (gsl_linalg_SV_rand_function * f, gsl_matrix * U,
+                              gsl_vector * S, gsl_matrix * V, const size_t q,
+                              gsl_rng * r, gsl_linalg_SV_rand_workspace * w)
+{
+  const size_t M = w->size1;
+  const size_t N = w->size2;
+  const size_t k = w->k;
+
+  if (U->size1 != M || U->size2 != k)
+    {
+      GSL_ERROR ("U matrix must be M-by-k", GSL_EBADLEN);
+    }
+  else if (S->size != k)
+    {
+      GSL_ERROR ("S vector must have length k", GSL_EBADLEN);
+    }
+  else if (V->size1 != N || V->size2 != k)
+    {
+      GSL_ERROR ("V matrix must be N-by-k", GSL_EBADLEN);
+    }
+  else
+    {
+      gsl_matrix_view Xk = gsl_matrix_submatrix (w->X, 0, 0, w->l, k);
+      gsl_matrix_view Zk = gsl_matrix_submatrix (w->Z, 0, 0, N, k);
+      gsl_vector_view Sk = gsl_vector_subvector (w->S, 0, k);
+      int status;
+
+      status = gsl_linalg_SV_rand_range (f, q, r, w);
+      if (status)
+        return status;
+
+      /* B^T = A^T Q */
+      status = GSL_SV_RAND_FN_EVAL (f, CblasTrans, w->Q, w->Z);
+      if (status)
+        return status;
+
+      /* B^T = X S W^T */
+      status = gsl_linalg_SV_decomp (w->Z, w->X, w->S, w->work);
+      if (status)
+        return status;
+
+      /* U = Q W */
+      gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, w->Q, &Xk.matrix, 0.0, U);
+      gsl_matrix_memcpy (V, &Zk.matrix);
+      gsl_vector_memcpy (S, &Sk.vector);
+
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_linalg_SV_decomp_rand()
+  Randomized SVD of a matrix A stored in memory, see
+gsl_linalg_SV_decomp_rand_fn
+*/
+
+int
+gsl_linalg_SV_decomp_rand (const gsl_matrix * A, gsl_matrix * U, gsl_vector * S,
+                           gsl_matrix * V, const size_t q, gsl_rng * r,
+                           gsl_linalg_SV_rand_workspace * w)
+{
+  gsl_linalg_SV_rand_function f;
+
+  f.mult = svd_rand_mult;
+  f.size1 = A->size1;
+  f.size2 = A->size2;
+  f.params = (void *) A;
+
+  return gsl_linalg_SV_decomp_rand_fn (&f, U, S, V, q, r, w);
+}
+
+/* Y = op(A) X for a matrix A stored in memory */
+
+static int
+svd_rand_mult (CBLAS_TRANSPOSE_t TransA, const gsl_matrix * X, void * params,
+               gsl_matrix * Y)
+{
+  const gsl_matrix * A = (const gsl_matrix *) params;
+
+  return gsl_blas_dgemm (TransA, CblasNoTrans, 1.0, A, X, 0.0, Y);
+}
+
+/*
+svd_rand_orth()
+  Replace the m-by-n matrix A, m >= n, by the first n columns of the
+orthogonal factor of its QR decomposition
+
+Inputs: A    - (input/output) m-by-n matrix
+        T    - n-by-n workspace
+        work - n-by-n workspace
+
+Notes: with A = Q R and Q = I - V T V^T from gsl_linalg_QR_decomp_r,
+
+Q [ I ] = [ I - V1 T V1^T ]
+  [ 0 ]   [   - V2 T V1^T ]
+*/
+
+static int
+svd_rand_orth (gsl_matrix * A, gsl_matrix * T, gsl_matrix * work)
+{
+  const size_t m = A->size1;
+  const size_t n = A->size2;
+  gsl_matrix_view V1 = gsl_matrix_submatrix (A, 0, 0, n, n);
+  size_t i, j;
+
+  gsl_linalg_QR_decomp_r (A, T);
+
+  /* work = T V1^T */
+  for (i = 0; i < n; i++)
+    {
+      for (j = 0; j < n; j++)
+        {
+          double wij = (j > i) ? gsl_matrix_get (A, j, i) : (j == i) ? 1.0 : 0.0;
+          gsl_matrix_set (work, i, j, wij);
+        }
+    }
+
+  gsl_blas_dtrmm (CblasLeft, CblasUpper, CblasNoTrans, CblasNonUnit, 1.0, T, work);
+
+  if (m > n)
+    {
+      gsl_matrix_view V2 = gsl_matrix_submatrix (A, n, 0, m - n, n);
+      gsl_blas_dtrmm (CblasRight, CblasUpper, CblasNoTrans, CblasNonUnit, -1.0,
+                      work, &V2.matrix);
+    }
+
+  /* work = V1 T V1^T and A1 = I - work */
+  gsl_blas_dtrmm (CblasLeft, CblasLower, CblasNoTrans, CblasUnit, 1.0,
+                  &V1.matrix, work);
+
+  for (i = 0; i < n; i++)
+    {
+      for (j = 0; j < n; j++)
+        {
+          double wij = gsl_matrix_get (work, i, j);
+          gsl_matrix_set (A, i, j, ((i == j) ? 1.0 : 0.0) - wij);
+        }
+    }
+
+  return GSL_SUCCESS;
+}
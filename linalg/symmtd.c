@@ -61,6 +61,31 @@
 
 #include <gsl/gsl_linalg.h>
 
+/* block size and crossover point of the blocked algorithm: the
+   trailing matrix is reduced with the unblocked algorithm once it has
+   at most SYMMTD_CROSSOVER rows */
+#define SYMMTD_BLOCK      32
+#define SYMMTD_CROSSOVER  64
+
+static int symmtd_decomp_L2 (gsl_matrix * A, gsl_vector * tau);
+static int symmtd_panel (gsl_matrix * A, gsl_vector * tau, gsl_vector * e, gsl_matrix * Wt);
+
+/*
+gsl_linalg_symmtd_decomp()
+  Blocked tridiagonal reduction, as in LAPACK DSYTRD
+
+The reflectors of a panel of SYMMTD_BLOCK columns are computed with
+the trailing matrix updated only implicitly, accumulating the matrix
+W such that the updated trailing matrix is
+
+A22 - V W^T - W V^T
+
+which is then formed with a single call to dsyr2k.  Half of the
+operations are in dsyr2k, and the other half in the dsymv products
+with the trailing matrix required for each reflector.  The reflectors
+and tau are the same as for the unblocked algorithm.
+*/
+
 int 
 gsl_linalg_symmtd_decomp (gsl_matrix * A, gsl_vector * tau)  
 {
@@ -73,50 +98,190 @@ gsl_linalg_symmtd_decomp (gsl_matrix * A, gsl_vector * tau)
     {
       GSL_ERROR ("size of tau must be N-1", GSL_EBADLEN);
     }
+  else if (A->size1 <= SYMMTD_CROSSOVER)
+    {
+      return symmtd_decomp_L2 (A, tau);
+    }
   else
     {
       const size_t N = A->size1;
-      size_t i;
-  
-      for (i = 0 ; i < N - 2; i++)
+      const size_t nb = SYMMTD_BLOCK;
+      gsl_matrix * W = gsl_matrix_alloc (N, nb);
+      gsl_matrix * Wt = gsl_matrix_alloc (nb, N);
+      double e_data[SYMMTD_BLOCK];
+      gsl_vector_view e = gsl_vector_view_array (e_data, nb);
+      gsl_matrix_view m;
+      gsl_vector_view t;
+      size_t i, j;
+
+      if (W == NULL || Wt == NULL)
+        {
+          if (W)
+            gsl_matrix_free (W);
+          if (Wt)
+            gsl_matrix_free (Wt);
+          GSL_ERROR ("failed to allocate workspace", GSL_ENOMEM);
+        }
+
+      for (i = 0; N - i > SYMMTD_CROSSOVER; i += nb)
         {
-          gsl_vector_view v = gsl_matrix_subcolumn (A, i, i + 1, N - i - 1);
-          double tau_i = gsl_linalg_householder_transform (&v.vector);
+          const size_t n = N - i;
+          gsl_matrix_view Ai = gsl_matrix_submatrix (A, i, i, n, n);
+          gsl_matrix_view Wi = gsl_matrix_submatrix (Wt, 0, 0, nb, n);
+          gsl_vector_view ti = gsl_vector_subvector (tau, i, nb);
+          gsl_matrix_view V = gsl_matrix_submatrix (A, i + nb, i, n - nb, nb);
+          gsl_matrix_view W2 = gsl_matrix_submatrix (W, nb, 0, n - nb, nb);
+          gsl_matrix_view Wt2 = gsl_matrix_submatrix (Wt, 0, nb, nb, n - nb);
+          gsl_matrix_view A22 = gsl_matrix_submatrix (A, i + nb, i + nb, n - nb, n - nb);
+
+          symmtd_panel (&Ai.matrix, &ti.vector, &e.vector, &Wi.matrix);
+          gsl_matrix_transpose_memcpy (&W2.matrix, &Wt2.matrix);
+
+          /* A22 := A22 - V W^T - W V^T */
+          gsl_blas_dsyr2k (CblasLower, CblasNoTrans, -1.0, &V.matrix, &W2.matrix, 1.0, &A22.matrix);
+
+          /* restore the subdiagonal */
+          for (j = 0; j < nb; j++)
+            gsl_matrix_set (A, i + j + 1, i + j, e_data[j]);
+        }
+
+      m = gsl_matrix_submatrix (A, i, i, N - i, N - i);
+      t = gsl_vector_subvector (tau, i, N - i - 1);
+      symmtd_decomp_L2 (&m.matrix, &t.vector);
+
+      gsl_matrix_free (W);
+      gsl_matrix_free (Wt);
+
+      return GSL_SUCCESS;
+    }
+}  
+
+/* unblocked algorithm, applying one reflector at a time */
+
+static int
+symmtd_decomp_L2 (gsl_matrix * A, gsl_vector * tau)
+{
+  const size_t N = A->size1;
+  size_t i;
+
+  for (i = 0 ; i < N - 2; i++)
+    {
+      gsl_vector_view v = gsl_matrix_subcolumn (A, i, i + 1, N - i - 1);
+      double tau_i = gsl_linalg_householder_transform (&v.vector);
+      
+      /* Apply the transformation H^T A H to the remaining columns */
+
+      if (tau_i != 0.0) 
+        {
+          gsl_matrix_view m = gsl_matrix_submatrix (A, i + 1, i + 1, N - i - 1, N - i - 1);
+          double ei = gsl_vector_get(&v.vector, 0);
+          gsl_vector_view x = gsl_vector_subvector (tau, i, N - i - 1);
+
+          gsl_vector_set (&v.vector, 0, 1.0);
           
-          /* Apply the transformation H^T A H to the remaining columns */
-
-          if (tau_i != 0.0) 
-            {
-              gsl_matrix_view m = gsl_matrix_submatrix (A, i + 1, i + 1, N - i - 1, N - i - 1);
-              double ei = gsl_vector_get(&v.vector, 0);
-              gsl_vector_view x = gsl_vector_subvector (tau, i, N - i - 1);
-
-              gsl_vector_set (&v.vector, 0, 1.0);
-              
-              /* x = tau * A * v */
-              gsl_blas_dsymv (CblasLower, tau_i, &m.matrix, &v.vector, 0.0, &x.vector);
-
-              /* w = x - (1/2) tau * (x' * v) * v  */
-              {
-                double xv, alpha;
-                gsl_blas_ddot(&x.vector, &v.vector, &xv);
-                alpha = -0.5 * tau_i * xv;
-                gsl_blas_daxpy(alpha, &v.vector, &x.vector);
-              }
-              
-              /* apply the transformation A = A - v w' - w v' */
-              gsl_blas_dsyr2(CblasLower, -1.0, &v.vector, &x.vector, &m.matrix);
-
-              gsl_vector_set (&v.vector, 0, ei);
-            }
+          /* x = tau * A * v */
+          gsl_blas_dsymv (CblasLower, tau_i, &m.matrix, &v.vector, 0.0, &x.vector);
+
+          /* w = x - (1/2) tau * (x' * v) * v  */
+          {
+            double xv, alpha;
+            gsl_blas_ddot(&x.vector, &v.vector, &xv);
+            alpha = -0.5 * tau_i * xv;
+            gsl_blas_daxpy(alpha, &v.vector, &x.vector);
+          }
           
-          gsl_vector_set (tau, i, tau_i);
+          /* apply the transformation A = A - v w' - w v' */
+          gsl_blas_dsyr2(CblasLower, -1.0, &v.vector, &x.vector, &m.matrix);
+
+          gsl_vector_set (&v.vector, 0, ei);
         }
       
-      return GSL_SUCCESS;
+      gsl_vector_set (tau, i, tau_i);
     }
-}  
+  
+  return GSL_SUCCESS;
+}
+
+/*
+symmtd_panel()
+  Reduce the first nb = Wt->size1 columns of the n-by-n matrix A, as in
+LAPACK DLATRD
+
+Inputs: A   - n-by-n trailing matrix, n > nb
+        tau - (output) Householder coefficients, length nb
+        e   - (output) subdiagonal elements, length nb
+        Wt  - (output) nb-by-n matrix W^T; columns nb:n-1 are used for
+              the update of the trailing matrix
+
+Notes:
+1) On output the leading elements of the Householder vectors, below
+the diagonal of A, are set to 1 so that the vectors can be used in the
+update; the subdiagonal is stored in e.
+
+2) Row i of W^T is computed as in the unblocked algorithm, with the
+product A22 v_i corrected for the updates of the previous reflectors
+in the panel, which have not yet been applied to A22.  W is stored
+transposed so that these vectors are contiguous.
+*/
+
+static int
+symmtd_panel (gsl_matrix * A, gsl_vector * tau, gsl_vector * e, gsl_matrix * Wt)
+{
+  const size_t n = A->size1;
+  const size_t nb = Wt->size1;
+  size_t i;
+
+  for (i = 0; i < nb; i++)
+    {
+      gsl_vector_view ai = gsl_matrix_subcolumn (A, i, i, n - i);
+      gsl_vector_view v = gsl_matrix_subcolumn (A, i, i + 1, n - i - 1);
+      gsl_vector_view wi = gsl_matrix_subrow (Wt, i, i + 1, n - i - 1);
+      gsl_matrix_view m = gsl_matrix_submatrix (A, i + 1, i + 1, n - i - 1, n - i - 1);
+      double tau_i, alpha, wv;
+
+      if (i > 0)
+        {
+          /* apply the previous reflectors to column i:
+             A(i:n,i) -= V(i:n,:) W(i,:)^T + W(i:n,:) V(i,:)^T */
+          gsl_matrix_view Vi = gsl_matrix_submatrix (A, i, 0, n - i, i);
+          gsl_matrix_view Wi = gsl_matrix_submatrix (Wt, 0, i, i, n - i);
+          gsl_vector_view vr = gsl_matrix_subrow (A, i, 0, i);
+          gsl_vector_view wc = gsl_matrix_subcolumn (Wt, i, 0, i);
+
+          gsl_blas_dgemv (CblasNoTrans, -1.0, &Vi.matrix, &wc.vector, 1.0, &ai.vector);
+          gsl_blas_dgemv (CblasTrans, -1.0, &Wi.matrix, &vr.vector, 1.0, &ai.vector);
+        }
+
+      tau_i = gsl_linalg_householder_transform (&v.vector);
+      gsl_vector_set (e, i, gsl_vector_get (&v.vector, 0));
+      gsl_vector_set (&v.vector, 0, 1.0);
+      gsl_vector_set (tau, i, tau_i);
+
+      /* w = A22 v - V (W^T v) - W (V^T v), using W(0:i,i) as workspace */
+
+      gsl_blas_dsymv (CblasLower, 1.0, &m.matrix, &v.vector, 0.0, &wi.vector);
 
+      if (i > 0)
+        {
+          gsl_matrix_view V2 = gsl_matrix_submatrix (A, i + 1, 0, n - i - 1, i);
+          gsl_matrix_view W2 = gsl_matrix_submatrix (Wt, 0, i + 1, i, n - i - 1);
+          gsl_vector_view x = gsl_matrix_subrow (Wt, i, 0, i);
+
+          gsl_blas_dgemv (CblasNoTrans, 1.0, &W2.matrix, &v.vector, 0.0, &x.vector);
+          gsl_blas_dgemv (CblasNoTrans, -1.0, &V2.matrix, &x.vector, 1.0, &wi.vector);
+          gsl_blas_dgemv (CblasTrans, 1.0, &V2.matrix, &v.vector, 0.0, &x.vector);
+          gsl_blas_dgemv (CblasTrans, -1.0, &W2.matrix, &x.vector, 1.0, &wi.vector);
+        }
+
+      /* w = tau w - (1/2) tau (w' v) v */
+      gsl_blas_dscal (tau_i, &wi.vector);
+      gsl_blas_ddot (&wi.vector, &v.vector, &wv);
+      alpha = -0.5 * tau_i * wv;
+      gsl_blas_daxpy (alpha, &v.vector, &wi.vector);
+    }
+
+  return GSL_SUCCESS;
+}
 
 /*  Form the orthogonal matrix Q from the packed QR matrix */
 
@@ -75,6 +75,14 @@ int test_SV_decomp_mod_dim(const gsl_matrix * m, double eps);
 int test_SV_decomp_mod(void);
 int test_SV_decomp_jacobi_dim(const gsl_matrix * m, double eps);
 int test_SV_decomp_jacobi(void);
+int test_SV_decomp_dc_dim(const gsl_matrix * m, double eps);
+int test_SV_decomp_dc(void);
+int test_SV_decomp_jacobi_par_dim(const gsl_matrix * m, int relative, double eps);
+int test_SV_decomp_jacobi_par(void);
+int test_SV_decomp_rand_dim(const gsl_matrix * A, const gsl_vector * sigma,
+                            const size_t k, const size_t p, const size_t q,
+                            double eps);
+int test_SV_decomp_rand(void);
 int test_cholesky_solve_dim(const gsl_matrix * m, const double * actual, double eps);
 int test_cholesky_solve(void);
 int test_HH_solve_dim(const gsl_matrix * m, const double * actual, double eps);
@@ -90,6 +98,8 @@ int test_TDN_cyc_solve_dim(unsigned long dim, double d, double a, double b, cons
 int test_TDN_cyc_solve(void);
 int test_bidiag_decomp_dim(const gsl_matrix * m, double eps);
 int test_bidiag_decomp(void);
+int test_hessenberg_decomp_dim(const gsl_matrix * m, double eps);
+int test_hessenberg_decomp(void);
 
 int 
 check (double x, double actual, double eps)
@@ -387,9 +397,11 @@ double vander12_solution[] = {0.0, 0.0, 0.0, 0.0,
 gsl_matrix * moler10;
 
 #include "test_common.c"
+#include "test_batch.c"
 #include "test_cholesky.c"
 #include "test_choleskyc.c"
 #include "test_cod.c"
+#include "test_exponential.c"
 #include "test_ldlt.c"
 #include "test_lu.c"
 #include "test_luc.c"
@@ -2336,6 +2348,625 @@ int test_SV_decomp_jacobi(void)
   return s;
 }
 
+/* check A = U S V^T, the orthogonality of U and V and the order of S,
+   with errors relative to the largest element of A */
+
+int
+test_SV_decomp_dc_dim(const gsl_matrix * m, double eps)
+{
+  int s = 0;
+  size_t i, j;
+  const size_t M = m->size1, N = m->size2;
+  gsl_matrix * U = gsl_matrix_alloc(M, N);
+  gsl_matrix * V = gsl_matrix_alloc(N, N);
+  gsl_matrix * US = gsl_matrix_alloc(M, N);
+  gsl_matrix * A = gsl_matrix_alloc(M, N);
+  gsl_matrix * I = gsl_matrix_alloc(N, N);
+  gsl_vector * S = gsl_vector_alloc(N);
+  double anorm = 0.0, err = 0.0, orth = 0.0;
+
+  gsl_matrix_memcpy(U, m);
+
+  s = gsl_linalg_SV_decomp_dc(U, V, S);
+
+  if (s) printf("returned error code %d = %s\n", s, gsl_strerror(s));
+
+  for (i = 0; i < N; i++)
+    {
+      double si = gsl_vector_get(S, i);
+
+      if (si < 0.0 || (i > 0 && si > gsl_vector_get(S, i - 1)))
+        {
+          s++;
+          printf("singular value %lu = %22.18g out of order\n", (unsigned long) i, si);
+        }
+    }
+
+  /* A = U S V^T */
+
+  gsl_matrix_memcpy(US, U);
+
+  for (j = 0; j < N; j++)
+    {
+      gsl_vector_view c = gsl_matrix_column(US, j);
+      gsl_vector_scale(&c.vector, gsl_vector_get(S, j));
+    }
+
+  gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1.0, US, V, 0.0, A);
+
+  for (i = 0; i < M; i++)
+    {
+      for (j = 0; j < N; j++)
+        {
+          double mij = gsl_matrix_get(m, i, j);
+          anorm = GSL_MAX(anorm, fabs(mij));
+          err = GSL_MAX(err, fabs(gsl_matrix_get(A, i, j) - mij));
+        }
+    }
+
+  /* U^T U = I and V^T V = I */
+
+  gsl_blas_dgemm(CblasTrans, CblasNoTrans, 1.0, U, U, 0.0, I);
+
+  for (i = 0; i < N; i++)
+    for (j = 0; j < N; j++)
+      orth = GSL_MAX(orth, fabs(gsl_matrix_get(I, i, j) - (i == j)));
+
+  gsl_blas_dgemm(CblasTrans, CblasNoTrans, 1.0, V, V, 0.0, I);
+
+  for (i = 0; i < N; i++)
+    for (j = 0; j < N; j++)
+      orth = GSL_MAX(orth, fabs(gsl_matrix_get(I, i, j) - (i == j)));
+
+  if (err > eps * anorm)
+    {
+      s++;
+      printf("(%3lu,%3lu): |A - U S V^T| = %g\n", (unsigned long) M, (unsigned long) N, err / anorm);
+    }
+
+  if (orth > eps)
+    {
+      s++;
+      printf("(%3lu,%3lu): |U^T U - I|, |V^T V - I| = %g\n", (unsigned long) M, (unsigned long) N, orth);
+    }
+
+  gsl_matrix_free(U);
+  gsl_matrix_free(V);
+  gsl_matrix_free(US);
+  gsl_matrix_free(A);
+  gsl_matrix_free(I);
+  gsl_vector_free(S);
+
+  return s;
+}
+
+/* A = Q_1 diag(sigma) Q_2^T with random orthogonal Q_1 and Q_2 */
+
+static void
+create_svd_matrix(gsl_matrix * A, const gsl_vector * sigma, gsl_rng * r)
+{
+  const size_t M = A->size1, N = A->size2;
+  gsl_matrix * X = gsl_matrix_alloc(M, M);
+  gsl_matrix * Q1 = gsl_matrix_alloc(M, M);
+  gsl_matrix * T1 = gsl_matrix_alloc(M, M);
+  gsl_matrix * R1 = gsl_matrix_alloc(M, M);
+  gsl_matrix * Y = gsl_matrix_alloc(N, N);
+  gsl_matrix * Q2 = gsl_matrix_alloc(N, N);
+  gsl_matrix * T2 = gsl_matrix_alloc(N, N);
+  gsl_matrix * R2 = gsl_matrix_alloc(N, N);
+  gsl_matrix_view Q1n = gsl_matrix_submatrix(Q1, 0, 0, M, N);
+  size_t j;
+
+  create_random_matrix(X, r);
+  create_random_matrix(Y, r);
+  gsl_linalg_QR_decomp_r(X, T1);
+  gsl_linalg_QR_unpack_r(X, T1, Q1, R1);
+  gsl_linalg_QR_decomp_r(Y, T2);
+  gsl_linalg_QR_unpack_r(Y, T2, Q2, R2);
+
+  for (j = 0; j < N; j++)
+    {
+      gsl_vector_view c = gsl_matrix_column(&Q1n.matrix, j);
+      gsl_vector_scale(&c.vector, gsl_vector_get(sigma, j));
+    }
+
+  gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1.0, &Q1n.matrix, Q2, 0.0, A);
+
+  gsl_matrix_free(X);
+  gsl_matrix_free(Q1);
+  gsl_matrix_free(T1);
+  gsl_matrix_free(R1);
+  gsl_matrix_free(Y);
+  gsl_matrix_free(Q2);
+  gsl_matrix_free(T2);
+  gsl_matrix_free(R2);
+}
+
+int
+test_SV_decomp_dc(void)
+{
+  gsl_rng * r = gsl_rng_alloc(gsl_rng_default);
+  int f;
+  int s = 0;
+  const gsl_matrix * fixed[] = { m11, m51, m53, moler10, hilb2, hilb3, hilb4,
+                                 hilb12, vander2, vander3, vander4, vander12,
+                                 row3, row5, row12, dblmin3, dblmin5, bigsparse };
+  const char * fixed_names[] = { "m(1,1)", "m(5,1)", "m(5,3)", "moler(10)",
+                                 "hilbert(2)", "hilbert(3)", "hilbert(4)",
+                                 "hilbert(12)", "vander(2)", "vander(3)",
+                                 "vander(4)", "vander(12)", "row3", "row5",
+                                 "row12", "dblmin3", "dblmin5", "bigsparse" };
+  const size_t dims[][2] = { { 26, 26 }, { 40, 30 }, { 64, 64 }, { 100, 51 },
+                             { 150, 150 }, { 173, 120 } };
+  size_t i, j;
+
+  for (i = 0; i < sizeof(fixed) / sizeof(fixed[0]); i++)
+    {
+      f = test_SV_decomp_dc_dim(fixed[i], 1024.0 * GSL_DBL_EPSILON);
+      gsl_test(f, "  SV_decomp_dc %s", fixed_names[i]);
+      s += f;
+    }
+
+  for (i = 0; i < sizeof(dims) / sizeof(dims[0]); i++)
+    {
+      const size_t M = dims[i][0], N = dims[i][1];
+      const double eps = 32.0 * N * GSL_DBL_EPSILON;
+      gsl_matrix * A = gsl_matrix_alloc(M, N);
+      gsl_vector * sigma = gsl_vector_alloc(N);
+
+      create_random_matrix(A, r);
+      f = test_SV_decomp_dc_dim(A, eps);
+      gsl_test(f, "  SV_decomp_dc random (%lu,%lu)", (unsigned long) M, (unsigned long) N);
+      s += f;
+
+      /* rank deficient, with half of the columns repeated */
+      for (j = N / 2; j < N; j++)
+        {
+          gsl_vector_view src = gsl_matrix_column(A, j - N / 2);
+          gsl_vector_view dest = gsl_matrix_column(A, j);
+          gsl_vector_memcpy(&dest.vector, &src.vector);
+        }
+
+      f = test_SV_decomp_dc_dim(A, eps);
+      gsl_test(f, "  SV_decomp_dc rank deficient (%lu,%lu)", (unsigned long) M, (unsigned long) N);
+      s += f;
+
+      /* clusters of equal singular values */
+      for (j = 0; j < N; j++)
+        gsl_vector_set(sigma, j, (double) (1 + j % 4));
+
+      create_svd_matrix(A, sigma, r);
+      f = test_SV_decomp_dc_dim(A, eps);
+      gsl_test(f, "  SV_decomp_dc clustered (%lu,%lu)", (unsigned long) M, (unsigned long) N);
+      s += f;
+
+      /* graded singular values */
+      for (j = 0; j < N; j++)
+        gsl_vector_set(sigma, j, pow(0.75, (double) j));
+
+      create_svd_matrix(A, sigma, r);
+      f = test_SV_decomp_dc_dim(A, eps);
+      gsl_test(f, "  SV_decomp_dc graded (%lu,%lu)", (unsigned long) M, (unsigned long) N);
+      s += f;
+
+      /* upper bidiagonal with unit elements */
+      gsl_matrix_set_zero(A);
+
+      for (j = 0; j < N; j++)
+        {
+          gsl_matrix_set(A, j, j, 1.0);
+
+          if (j + 1 < N)
+            gsl_matrix_set(A, j, j + 1, 1.0);
+        }
+
+      f = test_SV_decomp_dc_dim(A, eps);
+      gsl_test(f, "  SV_decomp_dc bidiagonal (%lu,%lu)", (unsigned long) M, (unsigned long) N);
+      s += f;
+
+      gsl_matrix_free(A);
+      gsl_vector_free(sigma);
+    }
+
+  /* clustered spectra: some merged secular equations have a root within
+     a few ulps of a pole, which previously exhausted the iteration limit
+     (GSL_EMAXITER); which seeds trigger this depends on the rounding of
+     the BLAS kernels, so run a range of them */
+  {
+    const size_t N = 30;
+    const double eps = 32.0 * N * GSL_DBL_EPSILON;
+    gsl_matrix * A = gsl_matrix_alloc(N, N);
+    gsl_vector * sigma = gsl_vector_alloc(N);
+    unsigned long seed;
+
+    for (j = 0; j < N; j++)
+      gsl_vector_set(sigma, j, (double) (1 + j % 4));
+
+    for (seed = 0; seed < 50; seed++)
+      {
+        gsl_rng_set(r, seed);
+        create_svd_matrix(A, sigma, r);
+        f = test_SV_decomp_dc_dim(A, eps);
+        gsl_test(f, "  SV_decomp_dc clustered (%lu,%lu) seed %lu",
+                 (unsigned long) N, (unsigned long) N, seed);
+        s += f;
+      }
+
+    gsl_matrix_free(A);
+    gsl_vector_free(sigma);
+  }
+
+  gsl_rng_free(r);
+
+  return s;
+}
+
+/* bound on the number of sweeps of the parallel Jacobi SVD for the
+   test matrices */
+#define SVD_JACOBI_PAR_MAXSWEEP 25
+
+int
+test_SV_decomp_jacobi_par_dim(const gsl_matrix * m, int relative, double eps)
+{
+  int s = 0;
+  size_t i, j;
+  const size_t M = m->size1, N = m->size2;
+  gsl_matrix * U = gsl_matrix_alloc(M, N);
+  gsl_matrix * V = gsl_matrix_alloc(N, N);
+  gsl_matrix * U0 = gsl_matrix_alloc(M, N);
+  gsl_matrix * V0 = gsl_matrix_alloc(N, N);
+  gsl_matrix * A = gsl_matrix_alloc(M, N);
+  gsl_matrix * I = gsl_matrix_alloc(N, N);
+  gsl_vector * S = gsl_vector_alloc(N);
+  gsl_vector * S0 = gsl_vector_alloc(N);
+  double anorm = 0.0, err = 0.0, orth = 0.0;
+  size_t nsweep = 0;
+
+  gsl_matrix_memcpy(U, m);
+  gsl_matrix_memcpy(U0, m);
+
+  s = gsl_linalg_SV_decomp_jacobi_par(U, V, S, &nsweep);
+
+  if (s) printf("returned error code %d = %s\n", s, gsl_strerror(s));
+
+  /* the Jacobi iteration converges quadratically, and at least one
+     sweep is needed to find that no rotation remains */
+  if (nsweep < 1 || nsweep > SVD_JACOBI_PAR_MAXSWEEP)
+    {
+      s++;
+      printf("number of sweeps %lu out of range\n", (unsigned long) nsweep);
+    }
+
+  gsl_linalg_SV_decomp_jacobi(U0, V0, S0);
+
+  /* singular values in decreasing order, and equal to those of the
+     serial version, to relative accuracy if requested */
+
+  for (i = 0; i < N; i++)
+    {
+      double si = gsl_vector_get(S, i);
+      double s0 = gsl_vector_get(S0, i);
+
+      if (si < 0.0 || (i > 0 && si > gsl_vector_get(S, i - 1)))
+        {
+          s++;
+          printf("singular value %lu = %22.18g out of order\n", (unsigned long) i, si);
+        }
+
+      if (fabs(si - s0) > eps * (relative ? s0 : gsl_vector_get(S0, 0)))
+        {
+          s++;
+          printf("singular value %lu = %22.18g, serial %22.18g\n", (unsigned long) i, si, s0);
+        }
+    }
+
+  /* A = U S V^T */
+
+  for (j = 0; j < N; j++)
+    {
+      gsl_vector_view c = gsl_matrix_column(U, j);
+      gsl_vector_scale(&c.vector, gsl_vector_get(S, j));
+    }
+
+  gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1.0, U, V, 0.0, A);
+
+  for (i = 0; i < M; i++)
+    {
+      for (j = 0; j < N; j++)
+        {
+          double mij = gsl_matrix_get(m, i, j);
+          anorm = GSL_MAX(anorm, fabs(mij));
+          err = GSL_MAX(err, fabs(gsl_matrix_get(A, i, j) - mij));
+        }
+    }
+
+  /* V^T V = I */
+
+  gsl_blas_dgemm(CblasTrans, CblasNoTrans, 1.0, V, V, 0.0, I);
+
+  for (i = 0; i < N; i++)
+    for (j = 0; j < N; j++)
+      orth = GSL_MAX(orth, fabs(gsl_matrix_get(I, i, j) - (i == j)));
+
+  if (err > eps * anorm)
+    {
+      s++;
+      printf("(%3lu,%3lu): |A - U S V^T| = %g\n", (unsigned long) M, (unsigned long) N, err / anorm);
+    }
+
+  if (orth > eps)
+    {
+      s++;
+      printf("(%3lu,%3lu): |V^T V - I| = %g\n", (unsigned long) M, (unsigned long) N, orth);
+    }
+
+  gsl_matrix_free(U);
+  gsl_matrix_free(V);
+  gsl_matrix_free(U0);
+  gsl_matrix_free(V0);
+  gsl_matrix_free(A);
+  gsl_matrix_free(I);
+  gsl_vector_free(S);
+  gsl_vector_free(S0);
+
+  return s;
+}
+
+int
+test_SV_decomp_jacobi_par(void)
+{
+  gsl_rng * r = gsl_rng_alloc(gsl_rng_default);
+  const int nthreads = gsl_get_num_threads();
+  const gsl_matrix * fixed[] = { m11, m51, m53, moler10, hilb2, hilb3, hilb4,
+                                 hilb12, vander2, vander3, vander4, row3, row5,
+                                 row12 };
+  const char * fixed_names[] = { "m(1,1)", "m(5,1)", "m(5,3)", "moler(10)",
+                                 "hilbert(2)", "hilbert(3)", "hilbert(4)",
+                                 "hilbert(12)", "vander(2)", "vander(3)",
+                                 "vander(4)", "row3", "row5", "row12" };
+  const size_t dims[][2] = { { 7, 7 }, { 20, 13 }, { 40, 33 }, { 64, 64 },
+                             { 100, 71 } };
+  int f;
+  int s = 0;
+  int p;
+  size_t i, j;
+
+  for (i = 0; i < sizeof(fixed) / sizeof(fixed[0]); i++)
+    {
+      f = test_SV_decomp_jacobi_par_dim(fixed[i], 0, 1024.0 * GSL_DBL_EPSILON);
+      gsl_test(f, "  SV_decomp_jacobi_par %s", fixed_names[i]);
+      s += f;
+    }
+
+  /* exercise different block sizes and numbers of blocks, independently
+     of the number of processors */
+  for (p = 1; p <= 4; p++)
+    {
+      gsl_set_num_threads(p);
+
+      for (i = 0; i < sizeof(dims) / sizeof(dims[0]); i++)
+        {
+          const size_t M = dims[i][0], N = dims[i][1];
+          const double eps = 32.0 * N * GSL_DBL_EPSILON;
+          gsl_matrix * A = gsl_matrix_alloc(M, N);
+
+          create_random_matrix(A, r);
+          f = test_SV_decomp_jacobi_par_dim(A, 0, eps);
+          gsl_test(f, "  SV_decomp_jacobi_par random (%lu,%lu) threads=%d",
+                   (unsigned long) M, (unsigned long) N, p);
+          s += f;
+
+          /* graded columns, with singular values determined to high
+             relative accuracy */
+          for (j = 0; j < N; j++)
+            {
+              gsl_vector_view c = gsl_matrix_column(A, j);
+              gsl_vector_scale(&c.vector, pow(0.5, (double) j));
+            }
+
+          f = test_SV_decomp_jacobi_par_dim(A, 1, eps);
+          gsl_test(f, "  SV_decomp_jacobi_par graded (%lu,%lu) threads=%d",
+                   (unsigned long) M, (unsigned long) N, p);
+          s += f;
+
+          gsl_matrix_free(A);
+        }
+    }
+
+  gsl_set_num_threads(nthreads);
+
+  gsl_rng_free(r);
+
+  return s;
+}
+
+/* create_svd_matrix for any M and N */
+static void
+create_svd_matrix_mn(gsl_matrix * A, const gsl_vector * sigma, gsl_rng * r)
+{
+  if (A->size1 >= A->size2)
+    {
+      create_svd_matrix(A, sigma, r);
+    }
+  else
+    {
+      gsl_matrix * At = gsl_matrix_alloc(A->size2, A->size1);
+      create_svd_matrix(At, sigma, r);
+      gsl_matrix_transpose_memcpy(A, At);
+      gsl_matrix_free(At);
+    }
+}
+
+/* product with a matrix stored transposed, to test the matrix-free
+   interface */
+static int
+test_SV_rand_mult(CBLAS_TRANSPOSE_t TransA, const gsl_matrix * X,
+                  void * params, gsl_matrix * Y)
+{
+  const gsl_matrix * At = (const gsl_matrix *) params;
+  CBLAS_TRANSPOSE_t TransAt = (TransA == CblasNoTrans) ? CblasTrans : CblasNoTrans;
+
+  return gsl_blas_dgemm(TransAt, CblasNoTrans, 1.0, At, X, 0.0, Y);
+}
+
+/* compare the randomized SVD of A with its singular values sigma,
+   using the same random numbers for the dense and matrix-free
+   interfaces */
+int
+test_SV_decomp_rand_dim(const gsl_matrix * A, const gsl_vector * sigma,
+                        const size_t k, const size_t p, const size_t q,
+                        double eps)
+{
+  int s = 0;
+  const size_t M = A->size1, N = A->size2;
+  const double smax = gsl_vector_get(sigma, 0);
+  const double tail = (k < GSL_MIN(M, N)) ? gsl_vector_get(sigma, k) : 0.0;
+  gsl_linalg_SV_rand_workspace * w = gsl_linalg_SV_rand_alloc(M, N, k, p);
+  gsl_linalg_SV_rand_function f;
+  gsl_rng * r1 = gsl_rng_alloc(gsl_rng_default);
+  gsl_rng * r2 = gsl_rng_alloc(gsl_rng_default);
+  gsl_matrix * At = gsl_matrix_alloc(N, M);
+  gsl_matrix * U = gsl_matrix_alloc(M, k);
+  gsl_matrix * V = gsl_matrix_alloc(N, k);
+  gsl_vector * S = gsl_vector_alloc(k);
+  gsl_matrix * U2 = gsl_matrix_alloc(M, k);
+  gsl_matrix * V2 = gsl_matrix_alloc(N, k);
+  gsl_vector * S2 = gsl_vector_alloc(k);
+  gsl_matrix * US = gsl_matrix_alloc(M, k);
+  gsl_matrix * R = gsl_matrix_alloc(M, N);
+  gsl_matrix * I = gsl_matrix_alloc(k, k);
+  size_t i, j;
+
+  s += gsl_linalg_SV_decomp_rand(A, U, S, V, q, r1, w);
+
+  gsl_matrix_transpose_memcpy(At, A);
+  f.mult = test_SV_rand_mult;
+  f.size1 = M;
+  f.size2 = N;
+  f.params = At;
+  s += gsl_linalg_SV_decomp_rand_fn(&f, U2, S2, V2, q, r2, w);
+
+  /* singular values */
+  for (i = 0; i < k; i++)
+    {
+      double si = gsl_vector_get(S, i);
+      double ei = gsl_vector_get(sigma, i);
+
+      gsl_test_abs(si, ei, eps * smax, "SV_decomp_rand (%lu,%lu) k=%lu q=%lu S(%lu)",
+                   (unsigned long) M, (unsigned long) N, (unsigned long) k,
+                   (unsigned long) q, (unsigned long) i);
+      gsl_test_rel(gsl_vector_get(S2, i), si, 1.0e3 * GSL_DBL_EPSILON,
+                   "SV_decomp_rand_fn (%lu,%lu) k=%lu q=%lu S(%lu)",
+                   (unsigned long) M, (unsigned long) N, (unsigned long) k,
+                   (unsigned long) q, (unsigned long) i);
+    }
+
+  /* orthonormality of U and V */
+  gsl_blas_dgemm(CblasTrans, CblasNoTrans, 1.0, U, U, 0.0, I);
+  for (i = 0; i < k; i++)
+    {
+      for (j = 0; j < k; j++)
+        {
+          gsl_test_abs(gsl_matrix_get(I, i, j), (i == j) ? 1.0 : 0.0, 1.0e3 * GSL_DBL_EPSILON,
+                       "SV_decomp_rand (%lu,%lu) k=%lu q=%lu U^T U(%lu,%lu)",
+                       (unsigned long) M, (unsigned long) N, (unsigned long) k,
+                       (unsigned long) q, (unsigned long) i, (unsigned long) j);
+        }
+    }
+
+  gsl_blas_dgemm(CblasTrans, CblasNoTrans, 1.0, V, V, 0.0, I);
+  for (i = 0; i < k; i++)
+    {
+      for (j = 0; j < k; j++)
+        {
+          gsl_test_abs(gsl_matrix_get(I, i, j), (i == j) ? 1.0 : 0.0, 1.0e3 * GSL_DBL_EPSILON,
+                       "SV_decomp_rand (%lu,%lu) k=%lu q=%lu V^T V(%lu,%lu)",
+                       (unsigned long) M, (unsigned long) N, (unsigned long) k,
+                       (unsigned long) q, (unsigned long) i, (unsigned long) j);
+        }
+    }
+
+  /* the residual A - U S V^T is of the order of sigma_{k+1} */
+  gsl_matrix_memcpy(US, U);
+  for (j = 0; j < k; j++)
+    {
+      gsl_vector_view c = gsl_matrix_column(US, j);
+      gsl_vector_scale(&c.vector, gsl_vector_get(S, j));
+    }
+
+  gsl_matrix_memcpy(R, A);
+  gsl_blas_dgemm(CblasNoTrans, CblasTrans, -1.0, US, V, 1.0, R);
+
+  for (i = 0; i < M; i++)
+    {
+      for (j = 0; j < N; j++)
+        {
+          gsl_test_abs(gsl_matrix_get(R, i, j), 0.0, 2.0 * tail + eps * smax,
+                       "SV_decomp_rand (%lu,%lu) k=%lu q=%lu residual(%lu,%lu)",
+                       (unsigned long) M, (unsigned long) N, (unsigned long) k,
+                       (unsigned long) q, (unsigned long) i, (unsigned long) j);
+        }
+    }
+
+  gsl_linalg_SV_rand_free(w);
+  gsl_rng_free(r1);
+  gsl_rng_free(r2);
+  gsl_matrix_free(At);
+  gsl_matrix_free(U);
+  gsl_matrix_free(V);
+  gsl_vector_free(S);
+  gsl_matrix_free(U2);
+  gsl_matrix_free(V2);
+  gsl_vector_free(S2);
+  gsl_matrix_free(US);
+  gsl_matrix_free(R);
+  gsl_matrix_free(I);
+
+  return s;
+}
+
+int
+test_SV_decomp_rand(void)
+{
+  gsl_rng * r = gsl_rng_alloc(gsl_rng_default);
+  const size_t dims[][2] = { { 50, 20 }, { 200, 80 }, { 80, 200 }, { 300, 300 } };
+  int s = 0;
+  size_t i, j;
+
+  for (i = 0; i < sizeof(dims) / sizeof(dims[0]); i++)
+    {
+      const size_t M = dims[i][0], N = dims[i][1];
+      const size_t minMN = GSL_MIN(M, N);
+      gsl_matrix * A = gsl_matrix_alloc(M, N);
+      gsl_vector * sigma = gsl_vector_alloc(minMN);
+
+      /* exact rank 5 */
+      gsl_vector_set_zero(sigma);
+      for (j = 0; j < 5; j++)
+        gsl_vector_set(sigma, j, 5.0 - j);
+
+      create_svd_matrix_mn(A, sigma, r);
+      s += test_SV_decomp_rand_dim(A, sigma, 5, 5, 0, 1.0e3 * GSL_DBL_EPSILON);
+
+      /* geometrically decaying singular values, with power iterations */
+      for (j = 0; j < minMN; j++)
+        gsl_vector_set(sigma, j, pow(0.6, (double) j));
+
+      create_svd_matrix_mn(A, sigma, r);
+      s += test_SV_decomp_rand_dim(A, sigma, 10, 10, 2, 1.0e-8);
+
+      /* k = min(M,N) and oversampling clipped to the matrix size */
+      s += test_SV_decomp_rand_dim(A, sigma, minMN, 4, 1, 1.0e3 * GSL_DBL_EPSILON);
+
+      gsl_matrix_free(A);
+      gsl_vector_free(sigma);
+    }
+
+  gsl_rng_free(r);
+
+  return s;
+}
+
 
 int
 test_cholesky_solve_dim(const gsl_matrix * m, const double * actual, double eps)
@@ -2989,6 +3620,177 @@ int test_TDN_cyc_solve(void)
   return s;
 }
 
+/* solve random diagonally dominant systems in batches and compare
+   with gsl_linalg_solve_tridiag for each system */
+int
+test_TD_batch_solve_dim(const size_t N, const size_t nsys, const int symm,
+                        gsl_rng * r)
+{
+  const double eps = 16.0 * GSL_DBL_EPSILON;
+  int s = 0;
+  size_t i, k;
+  gsl_matrix * diag = gsl_matrix_alloc(N, nsys);
+  gsl_matrix * above = gsl_matrix_alloc(N - 1, nsys);
+  gsl_matrix * below = symm ? above : gsl_matrix_alloc(N - 1, nsys);
+  gsl_matrix * B = gsl_matrix_alloc(N, nsys);
+  gsl_matrix * X = gsl_matrix_alloc(N, nsys);
+  gsl_vector * x = gsl_vector_alloc(N);
+
+  create_random_matrix(above, r);
+  create_random_matrix(below, r);
+  create_random_matrix(B, r);
+  create_random_matrix(diag, r);
+  gsl_matrix_add_constant(diag, 3.0);
+
+  if (symm)
+    s += gsl_linalg_solve_symm_tridiag_batch(diag, above, B, X);
+  else
+    s += gsl_linalg_solve_tridiag_batch(diag, above, below, B, X);
+
+  for (k = 0; k < nsys; k++)
+    {
+      gsl_vector_view dk = gsl_matrix_column(diag, k);
+      gsl_vector_view ak = gsl_matrix_column(above, k);
+      gsl_vector_view bk = gsl_matrix_column(below, k);
+      gsl_vector_view rk = gsl_matrix_column(B, k);
+
+      double tol;
+
+      gsl_linalg_solve_tridiag(&dk.vector, &ak.vector, &bk.vector, &rk.vector, x);
+      tol = eps * gsl_blas_dnrm2(x);
+
+      for (i = 0; i < N; i++)
+        {
+          double xi = gsl_matrix_get(X, i, k);
+          double yi = gsl_vector_get(x, i);
+
+          gsl_test_abs(xi, yi, tol, "  solve_TD_batch symm=%d N=%lu nsys=%lu x(%lu,%lu)",
+                       symm, (unsigned long) N, (unsigned long) nsys,
+                       (unsigned long) i, (unsigned long) k);
+        }
+    }
+
+  /* in-place solve */
+  if (symm)
+    s += gsl_linalg_solve_symm_tridiag_batch(diag, above, B, B);
+  else
+    s += gsl_linalg_solve_tridiag_batch(diag, above, below, B, B);
+
+  for (k = 0; k < nsys; k++)
+    {
+      for (i = 0; i < N; i++)
+        {
+          double xi = gsl_matrix_get(B, i, k);
+          double yi = gsl_matrix_get(X, i, k);
+
+          gsl_test_rel(xi, yi, GSL_DBL_EPSILON, "  solve_TD_batch in-place symm=%d N=%lu nsys=%lu x(%lu,%lu)",
+                       symm, (unsigned long) N, (unsigned long) nsys,
+                       (unsigned long) i, (unsigned long) k);
+        }
+    }
+
+  gsl_matrix_free(diag);
+  gsl_matrix_free(above);
+  if (!symm)
+    gsl_matrix_free(below);
+  gsl_matrix_free(B);
+  gsl_matrix_free(X);
+  gsl_vector_free(x);
+
+  return s;
+}
+
+int
+test_TD_batch_solve(gsl_rng * r)
+{
+  const int nthreads = gsl_get_num_threads();
+  int s = 0;
+  int p;
+
+  for (p = 1; p <= 3; p += 2)
+    {
+      gsl_set_num_threads(p);
+
+      s += test_TD_batch_solve_dim(2, 1, 0, r);
+      s += test_TD_batch_solve_dim(5, 3, 1, r);
+      s += test_TD_batch_solve_dim(17, 64, 0, r);
+      s += test_TD_batch_solve_dim(30, 150, 1, r);
+      s += test_TD_batch_solve_dim(20, 131, 0, r);
+    }
+
+  gsl_set_num_threads(nthreads);
+
+  return s;
+}
+
+/* solve random diagonally dominant systems by the partition method
+   and compare with gsl_linalg_solve_tridiag */
+int
+test_TD_par_solve_dim(const size_t N, gsl_rng * r)
+{
+  const double eps = 16.0 * GSL_DBL_EPSILON;
+  double tol;
+  int s = 0;
+  size_t i;
+  gsl_vector * diag = gsl_vector_alloc(N);
+  gsl_vector * above = gsl_vector_alloc(N - 1);
+  gsl_vector * below = gsl_vector_alloc(N - 1);
+  gsl_vector * rhs = gsl_vector_alloc(N);
+  gsl_vector * x = gsl_vector_alloc(N);
+  gsl_vector * y = gsl_vector_alloc(N);
+
+  create_random_vector(diag, r);
+  create_random_vector(above, r);
+  create_random_vector(below, r);
+  create_random_vector(rhs, r);
+  gsl_vector_add_constant(diag, 3.0);
+
+  s += gsl_linalg_solve_tridiag_par(diag, above, below, rhs, x);
+  s += gsl_linalg_solve_tridiag(diag, above, below, rhs, y);
+  tol = eps * gsl_blas_dnrm2(y);
+
+  for (i = 0; i < N; i++)
+    {
+      double xi = gsl_vector_get(x, i);
+      double yi = gsl_vector_get(y, i);
+
+      gsl_test_abs(xi, yi, tol, "  solve_TD_par N=%lu threads=%d x(%lu)",
+                   (unsigned long) N, gsl_get_num_threads(), (unsigned long) i);
+    }
+
+  gsl_vector_free(diag);
+  gsl_vector_free(above);
+  gsl_vector_free(below);
+  gsl_vector_free(rhs);
+  gsl_vector_free(x);
+  gsl_vector_free(y);
+
+  return s;
+}
+
+int
+test_TD_par_solve(gsl_rng * r)
+{
+  const int nthreads = gsl_get_num_threads();
+  int s = 0;
+  int p;
+
+  /* exercise different numbers of partitions, independently of the
+     number of processors */
+  for (p = 1; p <= 5; p++)
+    {
+      gsl_set_num_threads(p);
+
+      s += test_TD_par_solve_dim(10, r);
+      s += test_TD_par_solve_dim(600, r);
+      s += test_TD_par_solve_dim(1283, r);
+    }
+
+  gsl_set_num_threads(nthreads);
+
+  return s;
+}
+
 int
 test_bidiag_decomp_dim(const gsl_matrix * m, double eps)
 {
@@ -3093,6 +3895,116 @@ int test_bidiag_decomp(void)
   return s;
 }
 
+int
+test_hessenberg_decomp_dim(const gsl_matrix * m, double eps)
+{
+  int s = 0;
+  const size_t N = m->size1;
+  size_t i, j;
+  double anorm = 0.0;
+
+  gsl_matrix * H  = gsl_matrix_alloc(N, N);
+  gsl_matrix * U  = gsl_matrix_alloc(N, N);
+  gsl_matrix * UH = gsl_matrix_alloc(N, N);
+  gsl_matrix * a  = gsl_matrix_alloc(N, N);
+  gsl_vector * tau = gsl_vector_alloc(N);
+
+  gsl_matrix_memcpy(H, m);
+
+  s += gsl_linalg_hessenberg_decomp(H, tau);
+  s += gsl_linalg_hessenberg_unpack(H, tau, U);
+  s += gsl_linalg_hessenberg_set_zero(H);
+
+  /* compute A = U H U^T */
+  gsl_blas_dgemm(CblasNoTrans, CblasNoTrans, 1.0, U, H, 0.0, UH);
+  gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1.0, UH, U, 0.0, a);
+
+  for (i = 0; i < N; i++)
+    for (j = 0; j < N; j++)
+      anorm = GSL_MAX(anorm, fabs(gsl_matrix_get(m, i, j)));
+
+  for (i = 0; i < N; i++)
+    {
+      for (j = 0; j < N; j++)
+        {
+          double aij = gsl_matrix_get(a, i, j);
+          double mij = gsl_matrix_get(m, i, j);
+
+          if (fabs(aij - mij) > eps * anorm)
+            {
+              printf("(%3lu,%3lu)[%lu,%lu]: %22.18g   %22.18g\n",
+                     (unsigned long) N, (unsigned long) N,
+                     (unsigned long) i, (unsigned long) j, aij, mij);
+              s++;
+            }
+        }
+    }
+
+  /* check that U is orthogonal */
+  gsl_blas_dgemm(CblasTrans, CblasNoTrans, 1.0, U, U, 0.0, a);
+
+  for (i = 0; i < N; i++)
+    {
+      for (j = 0; j < N; j++)
+        {
+          double aij = gsl_matrix_get(a, i, j);
+          double expected = (i == j) ? 1.0 : 0.0;
+
+          if (fabs(aij - expected) > eps)
+            {
+              printf("(%3lu,%3lu)[%lu,%lu]: U^T U %22.18g   %22.18g\n",
+                     (unsigned long) N, (unsigned long) N,
+                     (unsigned long) i, (unsigned long) j, aij, expected);
+              s++;
+            }
+        }
+    }
+
+  gsl_matrix_free(H);
+  gsl_matrix_free(U);
+  gsl_matrix_free(UH);
+  gsl_matrix_free(a);
+  gsl_vector_free(tau);
+
+  return s;
+}
+
+int
+test_hessenberg_decomp(void)
+{
+  gsl_rng * r = gsl_rng_alloc(gsl_rng_default);
+  const size_t dims[] = { 3, 10, 64, 65, 97, 160, 257 };
+  int f;
+  int s = 0;
+  size_t k;
+
+  for (k = 0; k < sizeof(dims) / sizeof(dims[0]); k++)
+    {
+      const size_t N = dims[k];
+      gsl_matrix * m = gsl_matrix_alloc(N, N);
+
+      create_random_matrix(m, r);
+
+      f = test_hessenberg_decomp_dim(m, 16.0 * N * GSL_DBL_EPSILON);
+      gsl_test(f, "  hessenberg_decomp random(%lu)", (unsigned long) N);
+      s += f;
+
+      gsl_matrix_free(m);
+    }
+
+  f = test_hessenberg_decomp_dim(hilb12, 256.0 * GSL_DBL_EPSILON);
+  gsl_test(f, "  hessenberg_decomp hilbert(12)");
+  s += f;
+
+  f = test_hessenberg_decomp_dim(moler10, 256.0 * GSL_DBL_EPSILON);
+  gsl_test(f, "  hessenberg_decomp moler(10)");
+  s += f;
+
+  gsl_rng_free(r);
+
+  return s;
+}
+
 int
 test_tri_invert2(CBLAS_UPLO_t Uplo, CBLAS_DIAG_t Diag, gsl_rng * r, const double tol)
 {
@@ -3252,6 +4164,7 @@ main(void)
   gsl_test(test_tri_invert(r),           "Triangular Inverse");
 
   gsl_test(test_bidiag_decomp(),         "Bidiagonal Decomposition");
+  gsl_test(test_hessenberg_decomp(),     "Hessenberg Decomposition");
   gsl_test(test_LU_decomp(r),            "LU Decomposition");
   gsl_test(test_LU_solve(r),             "LU Solve");
   gsl_test(test_LU_invert(r),            "LU Inverse");
@@ -3270,6 +4183,7 @@ main(void)
   gsl_test(test_QR_QTmat_r(r),           "QR QTmat (recursive)");
   gsl_test(test_QR_solve_r(r),           "QR Solve (recursive)");
   gsl_test(test_QR_lssolve_r(r),         "QR LS Solve (recursive)");
+  gsl_test(test_QR_TSQR_decomp(),        "QR Decomposition (TSQR)");
 
   gsl_test(test_QRc_decomp_r(r),         "Complex QR Decomposition (recursive)");
   gsl_test(test_QRc_solve_r(r),          "Complex QR Solve (recursive)");
@@ -3314,6 +4228,9 @@ main(void)
 
   gsl_test(test_SV_decomp(),             "Singular Value Decomposition");
   gsl_test(test_SV_decomp_jacobi(),      "Singular Value Decomposition (Jacobi)");
+  gsl_test(test_SV_decomp_dc(),          "Singular Value Decomposition (Divide and Conquer)");
+  gsl_test(test_SV_decomp_jacobi_par(),  "Singular Value Decomposition (Parallel Jacobi)");
+  gsl_test(test_SV_decomp_rand(),        "Singular Value Decomposition (Randomized)");
   gsl_test(test_SV_decomp_mod(),         "Singular Value Decomposition (Mod)");
   gsl_test(test_SV_solve(),              "SVD Solve");
 
@@ -3321,6 +4238,7 @@ main(void)
   gsl_test(test_cholesky_solve(),        "Cholesky Solve");
   gsl_test(test_cholesky_decomp(r),      "Cholesky Decomposition");
   gsl_test(test_cholesky_invert(r),      "Cholesky Inverse");
+  gsl_test(test_cholesky_update(),       "Cholesky Update");
 
   gsl_test(test_pcholesky_decomp(r),     "Pivoted Cholesky Decomposition");
   gsl_test(test_pcholesky_solve(r),      "Pivoted Cholesky Solve");
@@ -3337,9 +4255,13 @@ main(void)
   gsl_test(test_cholesky_band_decomp(r), "Banded Cholesky Decomposition");
   gsl_test(test_cholesky_band_solve(r),  "Banded Cholesky Solve");
   gsl_test(test_cholesky_band_invert(r), "Banded Cholesky Inverse");
+  gsl_test(test_cholesky_band_update(),  "Banded Cholesky Update");
 
   gsl_test(test_ldlt_decomp(r),          "LDLT Decomposition");
   gsl_test(test_ldlt_solve(r),           "LDLT Solve");
+  gsl_test(test_ldlt_bk_decomp(),        "Pivoted LDLT Decomposition");
+  gsl_test(test_ldlt_bk_solve(),         "Pivoted LDLT Solve");
+  gsl_test(test_ldlt_bk_rcond(),         "Pivoted LDLT Condition Number");
 
   gsl_test(test_ldlt_band_decomp(r),     "Banded LDLT Decomposition");
   gsl_test(test_ldlt_band_solve(r),      "Banded LDLT Solve");
@@ -3352,6 +4274,12 @@ main(void)
   gsl_test(test_TDS_cyc_solve(),         "Tridiagonal symmetric cyclic solve");
   gsl_test(test_TDN_solve(),             "Tridiagonal nonsymmetric solve");
   gsl_test(test_TDN_cyc_solve(),         "Tridiagonal nonsymmetric cyclic solve");
+  gsl_test(test_TD_batch_solve(r),       "Tridiagonal batched solve");
+  gsl_test(test_TD_par_solve(r),         "Tridiagonal parallel solve");
+  gsl_test(test_batch_solve(r),          "Batched Small Matrix Solve");
+  gsl_test(test_LU_solve_mixed(r),       "LU Mixed Precision Solve");
+  gsl_test(test_cholesky_solve_mixed(r), "Cholesky Mixed Precision Solve");
+  gsl_test(test_exponential(r),          "Matrix Exponential");
 
   gsl_matrix_free(m11);
   gsl_matrix_free(m35);
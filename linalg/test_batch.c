@@ -0,0 +1,352 @@
+/* linalg/test_batch.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_test.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_sys.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_rng.h>
+
+/* largest normwise backward error || A_k x_k - b_k || / (||A_k|| ||x_k|| + ||b_k||)
+   of the systems of a batch, in the infinity norm */
+static double
+test_batch_residual(const gsl_matrix * A, const gsl_vector * x, const gsl_vector * b)
+{
+  const size_t n = A->size2;
+  const size_t nbatch = A->size1 / n;
+  gsl_vector * r = gsl_vector_alloc(n);
+  double err = 0.0;
+  size_t k, i, j;
+
+  for (k = 0; k < nbatch; k++)
+    {
+      gsl_matrix_const_view Ak = gsl_matrix_const_submatrix(A, k * n, 0, n, n);
+      gsl_vector_const_view xk = gsl_vector_const_subvector(x, k * n, n);
+      gsl_vector_const_view bk = gsl_vector_const_subvector(b, k * n, n);
+      double anorm = 0.0, rnorm, xnorm, bnorm;
+
+      for (i = 0; i < n; i++)
+        {
+          double sum = 0.0;
+
+          for (j = 0; j < n; j++)
+            sum += fabs(gsl_matrix_get(&Ak.matrix, i, j));
+
+          anorm = GSL_MAX(anorm, sum);
+        }
+
+      gsl_vector_memcpy(r, &bk.vector);
+      gsl_blas_dgemv(CblasNoTrans, 1.0, &Ak.matrix, &xk.vector, -1.0, r);
+
+      rnorm = fabs(gsl_vector_get(r, gsl_blas_idamax(r)));
+      xnorm = fabs(gsl_vector_get(&xk.vector, gsl_blas_idamax(&xk.vector)));
+      bnorm = fabs(gsl_vector_get(&bk.vector, gsl_blas_idamax(&bk.vector)));
+
+      err = GSL_MAX(err, rnorm / (anorm * xnorm + bnorm));
+    }
+
+  gsl_vector_free(r);
+
+  return err;
+}
+
+static int
+test_batch_solve_eps(const size_t n, const size_t nbatch, gsl_rng * r)
+{
+  int s = 0;
+  const double eps = 64.0 * n * GSL_DBL_EPSILON;
+  const size_t M = n * nbatch;
+  gsl_matrix * A = gsl_matrix_alloc(M, n);
+  gsl_matrix * F = gsl_matrix_alloc(M, n);
+  gsl_vector_uint * piv = gsl_vector_uint_alloc(M);
+  gsl_vector * tau = gsl_vector_alloc(M);
+  gsl_vector * b = gsl_vector_alloc(M);
+  gsl_vector * x = gsl_vector_alloc(M);
+  double err;
+  size_t k;
+
+  create_random_matrix(A, r);
+  create_random_vector(b, r);
+
+  /* LU */
+  gsl_matrix_memcpy(F, A);
+  s += gsl_linalg_LU_decomp_batch(F, piv);
+  s += gsl_linalg_LU_solve_batch(F, piv, b, x);
+  err = test_batch_residual(A, x, b);
+  gsl_test(err > eps, "  LU_solve_batch n=%zu nbatch=%zu threads=%d error=%e",
+           n, nbatch, gsl_get_num_threads(), err);
+
+  /* in-place solve */
+  gsl_vector_memcpy(x, b);
+  s += gsl_linalg_LU_solve_batch(F, piv, x, x);
+  err = test_batch_residual(A, x, b);
+  gsl_test(err > eps, "  LU_solve_batch in-place n=%zu nbatch=%zu threads=%d error=%e",
+           n, nbatch, gsl_get_num_threads(), err);
+
+  /* QR */
+  gsl_matrix_memcpy(F, A);
+  s += gsl_linalg_QR_decomp_batch(F, tau);
+  s += gsl_linalg_QR_solve_batch(F, tau, b, x);
+  err = test_batch_residual(A, x, b);
+  gsl_test(err > eps, "  QR_solve_batch n=%zu nbatch=%zu threads=%d error=%e",
+           n, nbatch, gsl_get_num_threads(), err);
+
+  /* Cholesky */
+  for (k = 0; k < nbatch; k++)
+    {
+      gsl_matrix_view Ak = gsl_matrix_submatrix(A, k * n, 0, n, n);
+      create_posdef_matrix(&Ak.matrix, r);
+    }
+
+  gsl_matrix_memcpy(F, A);
+  s += gsl_linalg_cholesky_decomp_batch(F);
+  s += gsl_linalg_cholesky_solve_batch(F, b, x);
+  err = test_batch_residual(A, x, b);
+  gsl_test(err > eps, "  cholesky_solve_batch n=%zu nbatch=%zu threads=%d error=%e",
+           n, nbatch, gsl_get_num_threads(), err);
+
+  gsl_matrix_free(A);
+  gsl_matrix_free(F);
+  gsl_vector_uint_free(piv);
+  gsl_vector_free(tau);
+  gsl_vector_free(b);
+  gsl_vector_free(x);
+
+  return s;
+}
+
+/* compare the batched SVD with gsl_linalg_SV_decomp_jacobi and check
+   that U_k S_k V_k^T reproduces A_k */
+static int
+test_batch_SV_eps(const size_t n, const size_t nbatch, gsl_rng * r)
+{
+  int s = 0;
+  const double eps = 64.0 * n * GSL_DBL_EPSILON;
+  const size_t M = n * nbatch;
+  gsl_matrix * A = gsl_matrix_alloc(M, n);
+  gsl_matrix * U = gsl_matrix_alloc(M, n);
+  gsl_matrix * V = gsl_matrix_alloc(M, n);
+  gsl_vector * S = gsl_vector_alloc(M);
+  gsl_matrix * B = gsl_matrix_alloc(n, n);
+  gsl_matrix * W = gsl_matrix_alloc(n, n);
+  gsl_vector * T = gsl_vector_alloc(n);
+  double err = 0.0, serr = 0.0;
+  size_t k, i, j;
+
+  create_random_matrix(A, r);
+
+  /* make the last matrix rank deficient */
+  if (n > 1)
+    {
+      gsl_vector_view c0 = gsl_matrix_subcolumn(A, 0, M - n, n);
+      gsl_vector_view c1 = gsl_matrix_subcolumn(A, n - 1, M - n, n);
+      gsl_vector_memcpy(&c1.vector, &c0.vector);
+    }
+
+  gsl_matrix_memcpy(U, A);
+  s += gsl_linalg_SV_decomp_batch(U, V, S);
+
+  for (k = 0; k < nbatch; k++)
+    {
+      gsl_matrix_const_view Ak = gsl_matrix_const_submatrix(A, k * n, 0, n, n);
+      gsl_matrix_view Uk = gsl_matrix_submatrix(U, k * n, 0, n, n);
+      gsl_matrix_view Vk = gsl_matrix_submatrix(V, k * n, 0, n, n);
+      gsl_vector_view Sk = gsl_vector_subvector(S, k * n, n);
+      const double s0 = gsl_vector_get(&Sk.vector, 0);
+
+      gsl_matrix_memcpy(B, &Ak.matrix);
+      s += gsl_linalg_SV_decomp_jacobi(B, W, T);
+
+      for (i = 0; i < n; i++)
+        {
+          const double si = gsl_vector_get(&Sk.vector, i);
+
+          serr = GSL_MAX(serr, fabs(si - gsl_vector_get(T, i)) / s0);
+
+          if (i > 0 && si > gsl_vector_get(&Sk.vector, i - 1))
+            serr = GSL_POSINF;
+        }
+
+      /* B = U S V^T - A */
+      gsl_matrix_memcpy(W, &Uk.matrix);
+      for (j = 0; j < n; j++)
+        {
+          gsl_vector_view wj = gsl_matrix_column(W, j);
+          gsl_vector_scale(&wj.vector, gsl_vector_get(&Sk.vector, j));
+        }
+
+      gsl_matrix_memcpy(B, &Ak.matrix);
+      gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1.0, W, &Vk.matrix, -1.0, B);
+
+      for (i = 0; i < n; i++)
+        {
+          for (j = 0; j < n; j++)
+            err = GSL_MAX(err, fabs(gsl_matrix_get(B, i, j)) / s0);
+        }
+    }
+
+  gsl_test(serr > eps, "  SV_decomp_batch singular values n=%zu nbatch=%zu threads=%d error=%e",
+           n, nbatch, gsl_get_num_threads(), serr);
+  gsl_test(err > eps, "  SV_decomp_batch reconstruction n=%zu nbatch=%zu threads=%d error=%e",
+           n, nbatch, gsl_get_num_threads(), err);
+
+  gsl_matrix_free(A);
+  gsl_matrix_free(U);
+  gsl_matrix_free(V);
+  gsl_vector_free(S);
+  gsl_matrix_free(B);
+  gsl_matrix_free(W);
+  gsl_vector_free(T);
+
+  return s;
+}
+
+/* a singular or indefinite matrix in a batch must be reported without
+   affecting the other systems */
+static int
+test_batch_singular(gsl_rng * r)
+{
+  int s = 0;
+  const size_t n = 4, nbatch = 3, M = n * nbatch;
+  const double eps = 64.0 * n * GSL_DBL_EPSILON;
+  gsl_matrix * A = gsl_matrix_alloc(M, n);
+  gsl_vector_uint * piv = gsl_vector_uint_alloc(M);
+  gsl_vector * b = gsl_vector_alloc(M);
+  gsl_vector * x = gsl_vector_alloc(M);
+  gsl_matrix_view A0 = gsl_matrix_submatrix(A, 0, 0, n, n);
+  gsl_matrix_view A1 = gsl_matrix_submatrix(A, n, 0, n, n);
+  gsl_vector_view b0 = gsl_vector_subvector(b, 0, n);
+  gsl_vector_view x0 = gsl_vector_subvector(x, 0, n);
+  gsl_matrix * F = gsl_matrix_alloc(n, n);
+  int status;
+
+  create_random_matrix(A, r);
+  create_random_vector(b, r);
+
+  /* A_1 has two equal rows */
+  {
+    gsl_vector_view row0 = gsl_matrix_row(&A1.matrix, 0);
+    gsl_vector_view row2 = gsl_matrix_row(&A1.matrix, 2);
+    gsl_vector_memcpy(&row2.vector, &row0.vector);
+  }
+
+  gsl_matrix_memcpy(F, &A0.matrix);
+
+  s += gsl_linalg_LU_decomp_batch(A, piv);
+  status = gsl_linalg_LU_solve_batch(A, piv, b, x);
+  gsl_test(status != GSL_EDOM, "  LU_solve_batch singular status=%d", status);
+
+  {
+    double err = test_batch_residual(F, &x0.vector, &b0.vector);
+    gsl_test(err > eps, "  LU_solve_batch singular, first system error=%e", err);
+  }
+
+  /* Cholesky of a batch with an indefinite matrix */
+  create_posdef_matrix(&A0.matrix, r);
+  create_posdef_matrix(&A1.matrix, r);
+  gsl_matrix_set_identity(F);
+  gsl_matrix_set(F, 0, 0, -1.0);
+  {
+    gsl_matrix_view A2 = gsl_matrix_submatrix(A, 2 * n, 0, n, n);
+    gsl_matrix_memcpy(&A2.matrix, F);
+  }
+
+  status = gsl_linalg_cholesky_decomp_batch(A);
+  gsl_test(status != GSL_EDOM, "  cholesky_decomp_batch indefinite status=%d", status);
+
+  gsl_matrix_free(A);
+  gsl_matrix_free(F);
+  gsl_vector_uint_free(piv);
+  gsl_vector_free(b);
+  gsl_vector_free(x);
+
+  return s;
+}
+
+/* empty batches, stored in 0-by-0 matrices, and matrices with no columns */
+static int
+test_batch_empty(void)
+{
+  int s = 0;
+  gsl_matrix * A = gsl_matrix_alloc(0, 0);
+  gsl_matrix * V = gsl_matrix_alloc(0, 0);
+  gsl_matrix * B = gsl_matrix_alloc(3, 0);
+  gsl_vector * x = gsl_vector_alloc(0);
+  gsl_vector * b = gsl_vector_alloc(0);
+  gsl_vector * tau = gsl_vector_alloc(0);
+  gsl_vector_uint * piv = gsl_vector_uint_alloc(0);
+  int status;
+
+  status = gsl_linalg_LU_decomp_batch(A, piv);
+  status |= gsl_linalg_LU_solve_batch(A, piv, b, x);
+  gsl_test(status, "  LU_solve_batch empty batch status=%d", status);
+
+  status = gsl_linalg_cholesky_decomp_batch(A);
+  status |= gsl_linalg_cholesky_solve_batch(A, b, x);
+  gsl_test(status, "  cholesky_solve_batch empty batch status=%d", status);
+
+  status = gsl_linalg_QR_decomp_batch(A, tau);
+  status |= gsl_linalg_QR_solve_batch(A, tau, b, x);
+  gsl_test(status, "  QR_solve_batch empty batch status=%d", status);
+
+  status = gsl_linalg_SV_decomp_batch(A, V, x);
+  gsl_test(status, "  SV_decomp_batch empty batch status=%d", status);
+
+  status = gsl_linalg_cholesky_decomp_batch(B);
+  gsl_test(status != GSL_EBADLEN, "  cholesky_decomp_batch 3-by-0 status=%d", status);
+
+  gsl_matrix_free(A);
+  gsl_matrix_free(V);
+  gsl_matrix_free(B);
+  gsl_vector_free(x);
+  gsl_vector_free(b);
+  gsl_vector_free(tau);
+  gsl_vector_uint_free(piv);
+
+  return s;
+}
+
+static int
+test_batch_solve(gsl_rng * r)
+{
+  const int nthreads = gsl_get_num_threads();
+  int s = 0;
+  int p;
+  size_t n;
+
+  /* sizes up to and beyond the largest size-specific kernel */
+  for (p = 1; p <= 3; p += 2)
+    {
+      gsl_set_num_threads(p);
+
+      for (n = 1; n <= 20; n++)
+        {
+          s += test_batch_solve_eps(n, 7, r);
+          s += test_batch_SV_eps(n, 7, r);
+        }
+    }
+
+  gsl_set_num_threads(nthreads);
+
+  s += test_batch_singular(r);
+  s += test_batch_empty();
+
+  return s;
+}
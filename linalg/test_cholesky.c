@@ -77,7 +77,8 @@ test_cholesky_decomp_eps(const int scale, const gsl_matrix * m,
                          const char * desc)
 {
   int s = 0;
-  size_t i, j, N = m->size2;
+  size_t i, N = m->size2;
+  double err;
 
   gsl_matrix * V  = gsl_matrix_alloc(N, N);
   gsl_matrix * A  = gsl_matrix_alloc(N, N);
@@ -113,18 +114,8 @@ test_cholesky_decomp_eps(const int scale, const gsl_matrix * m,
   /* compute A = L LT */
   gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, L, LT, 0.0, A);
 
-  for (i = 0; i < N; i++)
-    {
-      for (j = 0; j < N; j++)
-        {
-          double Aij = gsl_matrix_get(A, i, j);
-          double mij = gsl_matrix_get(m, i, j);
-
-          gsl_test_rel(Aij, mij, eps,
-                       "%s: (%3lu,%3lu)[%lu,%lu]: %22.18g   %22.18g\n",
-                       desc, N, N, i, j, Aij, mij);
-        }
-    }
+  err = test_backward_error(m, A);
+  gsl_test(!(err <= eps), "%s: (%3lu,%3lu) error %e", desc, N, N, err);
 
   if (expected_rcond > 0 && !scale)
     {
@@ -1127,3 +1118,333 @@ test_cholesky_band_invert(gsl_rng * r)
 
   return s;
 }
+
+static int
+test_cholesky_update_eps(const gsl_matrix * m, const gsl_matrix * V, const double eps, const char * desc)
+{
+  int s = 0;
+  size_t i, j, N = m->size1, k = V->size2;
+  gsl_matrix * LLT = gsl_matrix_alloc(N, N);
+  gsl_matrix * LLT_expected = gsl_matrix_alloc(N, N);
+  gsl_matrix * A = gsl_matrix_alloc(N, N);
+  gsl_matrix * W = gsl_matrix_alloc(N, k);
+  gsl_vector * work = gsl_vector_alloc(3 * N);
+  double norm1 = test_cholesky_norm1(m);
+  double rcond, rcond_expected;
+
+  /* factor A = m + V V^T directly */
+  gsl_matrix_memcpy(A, m);
+  gsl_blas_dsyrk(CblasLower, CblasNoTrans, 1.0, V, 1.0, A);
+  gsl_matrix_transpose_tricpy(CblasLower, CblasUnit, A, A);
+  gsl_matrix_memcpy(LLT_expected, A);
+  s += gsl_linalg_cholesky_decomp1(LLT_expected);
+
+  /* factor m and update */
+  gsl_matrix_memcpy(LLT, m);
+  gsl_matrix_memcpy(W, V);
+  s += gsl_linalg_cholesky_decomp1(LLT);
+  s += gsl_linalg_cholesky_update(LLT, W);
+
+  /* lower triangle contains L, upper triangle contains A */
+  for (i = 0; i < N; i++)
+    {
+      for (j = 0; j < N; j++)
+        {
+          double aij = gsl_matrix_get(LLT, i, j);
+          double bij = gsl_matrix_get(LLT_expected, i, j);
+
+          gsl_test_rel(aij, bij, eps,
+                       "%s update: (%zu,%zu,k=%zu)[%lu,%lu]: %22.18g   %22.18g\n",
+                       desc, N, N, k, i, j, aij, bij);
+        }
+    }
+
+  s += gsl_linalg_cholesky_rcond(LLT, &rcond, work);
+  s += gsl_linalg_cholesky_rcond(LLT_expected, &rcond_expected, work);
+  gsl_test_rel(rcond, rcond_expected, eps,
+               "%s update: (%zu,%zu,k=%zu) rcond: %22.18g   %22.18g\n",
+               desc, N, N, k, rcond, rcond_expected);
+
+  /* downdate back to the factorization of m */
+  gsl_matrix_memcpy(LLT_expected, m);
+  s += gsl_linalg_cholesky_decomp1(LLT_expected);
+
+  gsl_matrix_memcpy(W, V);
+  s += gsl_linalg_cholesky_downdate(LLT, W);
+
+  /* the hyperbolic rotations of the downdate are only normwise stable */
+  for (i = 0; i < N; i++)
+    {
+      for (j = 0; j < N; j++)
+        {
+          double aij = gsl_matrix_get(LLT, i, j);
+          double bij = gsl_matrix_get(LLT_expected, i, j);
+
+          gsl_test_abs(aij, bij, eps * norm1,
+                       "%s downdate: (%zu,%zu,k=%zu)[%lu,%lu]: %22.18g   %22.18g\n",
+                       desc, N, N, k, i, j, aij, bij);
+        }
+    }
+
+  gsl_matrix_free(LLT);
+  gsl_matrix_free(LLT_expected);
+  gsl_matrix_free(A);
+  gsl_matrix_free(W);
+  gsl_vector_free(work);
+
+  return s;
+}
+
+static int
+test_cholesky_update(void)
+{
+  gsl_rng * r = gsl_rng_alloc(gsl_rng_default);
+  int s = 0;
+  const size_t N_max = 50;
+  const size_t k_vals[] = { 1, 3, 40 };
+  size_t N, i;
+
+  for (N = 1; N <= N_max; ++N)
+    {
+      gsl_matrix * m = gsl_matrix_alloc(N, N);
+      gsl_matrix * V;
+      int status;
+
+      create_posdef_matrix(m, r);
+
+      for (i = 0; i < sizeof(k_vals) / sizeof(size_t); ++i)
+        {
+          V = gsl_matrix_alloc(N, k_vals[i]);
+          create_random_matrix(V, r);
+          s += test_cholesky_update_eps(m, V, 1.0e3 * N * GSL_DBL_EPSILON, "cholesky random");
+          gsl_matrix_free(V);
+        }
+
+      /* downdate to an indefinite matrix */
+      V = gsl_matrix_calloc(N, 1);
+      gsl_matrix_set(V, 0, 0, 2.0 * sqrt(gsl_matrix_get(m, 0, 0)));
+      s += gsl_linalg_cholesky_decomp1(m);
+      status = gsl_linalg_cholesky_downdate(m, V);
+      gsl_test(status != GSL_EDOM, "cholesky_downdate indefinite N=%zu", N);
+      gsl_matrix_free(V);
+
+      gsl_matrix_free(m);
+    }
+
+  gsl_rng_free(r);
+
+  return s;
+}
+
+static int
+test_cholesky_band_update_eps(const size_t p, const gsl_matrix * m, const gsl_matrix * V,
+                              const double eps, const char * desc)
+{
+  int s = 0;
+  size_t i, j, N = m->size1, k = V->size2;
+  gsl_matrix * LLT = gsl_matrix_alloc(N, p + 1);
+  gsl_matrix * LLT_expected = gsl_matrix_alloc(N, p + 1);
+  gsl_matrix * A = gsl_matrix_alloc(N, N);
+  gsl_matrix * W = gsl_matrix_alloc(N, k);
+
+  /* factor A = m + V V^T directly */
+  gsl_matrix_memcpy(A, m);
+  gsl_blas_dsyrk(CblasLower, CblasNoTrans, 1.0, V, 1.0, A);
+  gsl_matrix_transpose_tricpy(CblasLower, CblasUnit, A, A);
+  symm2band_matrix(p, A, LLT_expected);
+  s += gsl_linalg_cholesky_band_decomp(LLT_expected);
+
+  /* factor m and update */
+  symm2band_matrix(p, m, LLT);
+  gsl_matrix_memcpy(W, V);
+  s += gsl_linalg_cholesky_band_decomp(LLT);
+  s += gsl_linalg_cholesky_band_update(LLT, W);
+
+  /* compare factors, including the stored 1-norm */
+  for (i = 0; i < N; i++)
+    {
+      for (j = 0; j <= p; j++)
+        {
+          double aij = gsl_matrix_get(LLT, i, j);
+          double bij = gsl_matrix_get(LLT_expected, i, j);
+
+          if (i + j >= N && !(i == N - 1 && j == p))
+            continue;
+
+          gsl_test_rel(aij, bij, eps,
+                       "%s update: (p=%zu,N=%zu,k=%zu)[%lu,%lu]: %22.18g   %22.18g\n",
+                       desc, p, N, k, i, j, aij, bij);
+        }
+    }
+
+  /* downdate back to the factorization of m */
+  symm2band_matrix(p, m, LLT_expected);
+  s += gsl_linalg_cholesky_band_decomp(LLT_expected);
+
+  gsl_matrix_memcpy(W, V);
+  s += gsl_linalg_cholesky_band_downdate(LLT, W);
+
+  for (i = 0; i < N; i++)
+    {
+      for (j = 0; j <= p; j++)
+        {
+          double aij = gsl_matrix_get(LLT, i, j);
+          double bij = gsl_matrix_get(LLT_expected, i, j);
+
+          if (i + j >= N && !(i == N - 1 && j == p))
+            continue;
+
+          gsl_test_rel(aij, bij, eps,
+                       "%s downdate: (p=%zu,N=%zu,k=%zu)[%lu,%lu]: %22.18g   %22.18g\n",
+                       desc, p, N, k, i, j, aij, bij);
+        }
+    }
+
+  gsl_matrix_free(LLT);
+  gsl_matrix_free(LLT_expected);
+  gsl_matrix_free(A);
+  gsl_matrix_free(W);
+
+  return s;
+}
+
+static int
+test_cholesky_band_update(void)
+{
+  gsl_rng * r = gsl_rng_alloc(gsl_rng_default);
+  int s = 0;
+  const size_t N_max = 50;
+  const size_t k = 3;
+  size_t N, p, i, l;
+
+  for (N = 1; N <= N_max; ++N)
+    {
+      gsl_matrix * m = gsl_matrix_alloc(N, N);
+      gsl_matrix * V = gsl_matrix_alloc(N, k);
+
+      for (p = 0; p < GSL_MIN(N, 10); ++p)
+        {
+          create_posdef_band_matrix(p, m, r);
+
+          /* columns of V are nonzero in p + 1 consecutive rows */
+          gsl_matrix_set_zero(V);
+          for (l = 0; l < k; ++l)
+            {
+              size_t i0 = (size_t) gsl_rng_uniform_int(r, N);
+
+              for (i = i0; i <= GSL_MIN(i0 + p, N - 1); ++i)
+                gsl_matrix_set(V, i, l, gsl_rng_uniform(r));
+            }
+
+          s += test_cholesky_band_update_eps(p, m, V, 1.0e3 * N * GSL_DBL_EPSILON, "cholesky_band random");
+        }
+
+      gsl_matrix_free(m);
+      gsl_matrix_free(V);
+    }
+
+  gsl_rng_free(r);
+
+  return s;
+}
+
+static int
+test_cholesky_solve_mixed_eps(const gsl_matrix * m, const gsl_vector * rhs, const int expect_fallback,
+                              const double eps, const char * desc)
+{
+  int s = 0;
+  const size_t N = m->size1;
+  gsl_matrix * A = gsl_matrix_alloc(N, N);
+  gsl_matrix * llt = gsl_matrix_alloc(N, N);
+  gsl_vector * x = gsl_vector_alloc(N);
+  gsl_vector * res = gsl_vector_alloc(N);
+  double anorm = 0.0, rnorm, xnorm, err;
+  size_t i, j;
+  int iter;
+
+  gsl_matrix_memcpy(A, m);
+  s += gsl_linalg_cholesky_solve_mixed(A, rhs, x, &iter);
+
+  /* normwise backward error */
+  for (i = 0; i < N; ++i)
+    {
+      double sum = 0.0;
+
+      for (j = 0; j < N; ++j)
+        sum += fabs(gsl_matrix_get(m, i, j));
+
+      anorm = GSL_MAX(anorm, sum);
+    }
+
+  gsl_vector_memcpy(res, rhs);
+  gsl_blas_dsymv(CblasLower, -1.0, m, x, 1.0, res);
+  rnorm = fabs(gsl_vector_get(res, gsl_blas_idamax(res)));
+  xnorm = fabs(gsl_vector_get(x, gsl_blas_idamax(x)));
+  err = rnorm / (anorm * xnorm);
+
+  gsl_test(err > eps, "%s: cholesky_solve_mixed N=%lu iter=%d backward error=%e",
+           desc, N, iter, err);
+
+  if (expect_fallback)
+    {
+      gsl_test(iter >= 0, "%s: cholesky_solve_mixed N=%lu fallback iter=%d", desc, N, iter);
+
+      /* A must contain the double precision Cholesky decomposition */
+      gsl_matrix_memcpy(llt, m);
+      s += gsl_linalg_cholesky_decomp1(llt);
+      gsl_test(!gsl_matrix_equal(A, llt), "%s: cholesky_solve_mixed N=%lu fallback factorization",
+               desc, N);
+    }
+  else
+    {
+      gsl_test(iter < 0, "%s: cholesky_solve_mixed N=%lu iter=%d", desc, N, iter);
+      gsl_test(!gsl_matrix_equal(A, m), "%s: cholesky_solve_mixed N=%lu matrix modified", desc, N);
+    }
+
+  gsl_matrix_free(A);
+  gsl_matrix_free(llt);
+  gsl_vector_free(x);
+  gsl_vector_free(res);
+
+  return s;
+}
+
+static int
+test_cholesky_solve_mixed(gsl_rng * r)
+{
+  int s = 0;
+  size_t n;
+
+  for (n = 1; n <= 300; n += (n < 50) ? 1 : 83)
+    {
+      gsl_matrix * m = gsl_matrix_alloc(n, n);
+      gsl_vector * rhs = gsl_vector_alloc(n);
+
+      create_posdef_matrix(m, r);
+      create_random_vector(rhs, r);
+      s += test_cholesky_solve_mixed_eps(m, rhs, 0, 16.0 * n * GSL_DBL_EPSILON, "random");
+
+      /* out of the range of single precision */
+      gsl_matrix_scale(m, 1.0e300);
+      s += test_cholesky_solve_mixed_eps(m, rhs, 1, 16.0 * n * GSL_DBL_EPSILON, "scaled");
+
+      gsl_matrix_free(m);
+      gsl_vector_free(rhs);
+    }
+
+  /* too ill-conditioned for single precision */
+  {
+    const size_t N = 12;
+    gsl_matrix * m = gsl_matrix_alloc(N, N);
+    gsl_vector * rhs = gsl_vector_alloc(N);
+
+    create_hilbert_matrix2(m);
+    gsl_vector_set_all(rhs, 1.0);
+    s += test_cholesky_solve_mixed_eps(m, rhs, 1, 16.0 * N * GSL_DBL_EPSILON, "hilbert");
+
+    gsl_matrix_free(m);
+    gsl_vector_free(rhs);
+  }
+
+  return s;
+}
@@ -29,6 +29,8 @@ static int create_random_vector(gsl_vector * v, gsl_rng * r);
 static int create_random_matrix(gsl_matrix * m, gsl_rng * r);
 static int create_posdef_matrix(gsl_matrix * m, gsl_rng * r);
 static int create_hilbert_matrix2(gsl_matrix * m);
+static double test_backward_error(const gsl_matrix * A, const gsl_matrix * B);
+static double test_backward_error_complex(const gsl_matrix_complex * A, const gsl_matrix_complex * B);
 
 static int
 create_random_vector(gsl_vector * v, gsl_rng * r)
@@ -274,6 +276,67 @@ create_posdef_band_matrix(const size_t p, gsl_matrix * m, gsl_rng * r)
   return GSL_SUCCESS;
 }
 
+/*
+ * normwise error max |B_ij - A_ij| / max |A_ij| of the product B of the
+ * factors of A. Unlike the error of each element relative to itself, this
+ * does not depend on the order in which the BLAS sum the terms of elements
+ * which are small through cancellation. A NaN in B gives a NaN error.
+ */
+static double
+test_backward_error(const gsl_matrix * A, const gsl_matrix * B)
+{
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+  double amax = 0.0;
+  double emax = 0.0;
+  size_t i, j;
+
+  for (i = 0; i < M; ++i)
+    {
+      for (j = 0; j < N; ++j)
+        {
+          double aij = gsl_matrix_get(A, i, j);
+          double eij = fabs(gsl_matrix_get(B, i, j) - aij);
+
+          if (gsl_isnan(eij))
+            return GSL_NAN;
+
+          amax = GSL_MAX(amax, fabs(aij));
+          emax = GSL_MAX(emax, eij);
+        }
+    }
+
+  return (amax > 0.0) ? emax / amax : emax;
+}
+
+static double
+test_backward_error_complex(const gsl_matrix_complex * A, const gsl_matrix_complex * B)
+{
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+  double amax = 0.0;
+  double emax = 0.0;
+  size_t i, j;
+
+  for (i = 0; i < M; ++i)
+    {
+      for (j = 0; j < N; ++j)
+        {
+          gsl_complex aij = gsl_matrix_complex_get(A, i, j);
+          gsl_complex bij = gsl_matrix_complex_get(B, i, j);
+          double eij = gsl_hypot(GSL_REAL(bij) - GSL_REAL(aij), GSL_IMAG(bij) - GSL_IMAG(aij));
+
+          if (gsl_isnan(eij))
+            return GSL_NAN;
+
+          amax = GSL_MAX(amax, gsl_hypot(GSL_REAL(aij), GSL_IMAG(aij)));
+          emax = GSL_MAX(emax, eij);
+        }
+    }
+
+  return (amax > 0.0) ? emax / amax : emax;
+}
+
 /* transform dense symmetric banded matrix to compact form, with bandwidth p */
 static int
 symm2band_matrix(const size_t p, const gsl_matrix * m, gsl_matrix * bm)
@@ -0,0 +1,253 @@
+/* linalg/test_exponential.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_test.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_linalg.h>
+#include <gsl/gsl_rng.h>
+
+/* largest absolute element of A - B, relative to that of B */
+static double
+test_exponential_err(const gsl_matrix * A, const gsl_matrix * B)
+{
+  double amin, amax, bmin, bmax;
+  gsl_matrix * D = gsl_matrix_alloc(A->size1, A->size2);
+
+  gsl_matrix_memcpy(D, A);
+  gsl_matrix_sub(D, B);
+  gsl_matrix_minmax(D, &amin, &amax);
+  gsl_matrix_minmax(B, &bmin, &bmax);
+  gsl_matrix_free(D);
+
+  return GSL_MAX(fabs(amin), fabs(amax)) / GSL_MAX(fabs(bmin), fabs(bmax));
+}
+
+static int
+test_exponential_pade_eps(const gsl_matrix * A, const gsl_matrix * expected,
+                          const double eps, const char * desc)
+{
+  int s = 0;
+  const size_t N = A->size1;
+  gsl_matrix * eA = gsl_matrix_alloc(N, N);
+  double err;
+
+  s += gsl_linalg_exponential_pade(A, eA);
+
+  err = test_exponential_err(eA, expected);
+  gsl_test(err > eps, "%s: exponential_pade N=%lu error=%e", desc, N, err);
+
+  gsl_matrix_free(eA);
+
+  return s;
+}
+
+/* A = Q diag(d) Q^T with eigenvalues d in [-c,c], and exp(A) = Q diag(e^d) Q^T */
+static int
+test_exponential_pade_symm(const size_t N, const double c, gsl_rng * r)
+{
+  int s = 0;
+  gsl_matrix * Q = gsl_matrix_alloc(N, N);
+  gsl_matrix * R = gsl_matrix_alloc(N, N);
+  gsl_matrix * T = gsl_matrix_alloc(N, N);
+  gsl_matrix * QD = gsl_matrix_alloc(N, N);
+  gsl_matrix * A = gsl_matrix_alloc(N, N);
+  gsl_matrix * eA = gsl_matrix_alloc(N, N);
+  size_t j;
+
+  create_random_matrix(A, r);
+  gsl_linalg_QR_decomp_r(A, T);
+  gsl_linalg_QR_unpack_r(A, T, Q, R);
+
+  gsl_matrix_memcpy(QD, Q);
+  gsl_matrix_memcpy(R, Q);
+
+  for (j = 0; j < N; ++j)
+    {
+      const double dj = c * (2.0 * gsl_rng_uniform(r) - 1.0);
+      gsl_vector_view v = gsl_matrix_column(QD, j);
+      gsl_vector_view w = gsl_matrix_column(R, j);
+
+      gsl_vector_scale(&v.vector, dj);
+      gsl_vector_scale(&w.vector, exp(dj));
+    }
+
+  gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1.0, QD, Q, 0.0, A);
+  gsl_blas_dgemm(CblasNoTrans, CblasTrans, 1.0, R, Q, 0.0, eA);
+
+  s += test_exponential_pade_eps(A, eA, 64.0 * N * (1.0 + c) * GSL_DBL_EPSILON, "symmetric");
+
+  gsl_matrix_free(Q);
+  gsl_matrix_free(R);
+  gsl_matrix_free(T);
+  gsl_matrix_free(QD);
+  gsl_matrix_free(A);
+  gsl_matrix_free(eA);
+
+  return s;
+}
+
+/* A = alpha J, with J the shift matrix, and exp(A)_{ij} = alpha^{j-i} / (j-i)! */
+static int
+test_exponential_pade_shift(const size_t N, const double alpha)
+{
+  int s = 0;
+  gsl_matrix * A = gsl_matrix_calloc(N, N);
+  gsl_matrix * eA = gsl_matrix_calloc(N, N);
+  size_t i, j;
+
+  for (i = 0; i < N; ++i)
+    {
+      if (i + 1 < N)
+        gsl_matrix_set(A, i, i + 1, alpha);
+
+      gsl_matrix_set(eA, i, i, 1.0);
+
+      for (j = i + 1; j < N; ++j)
+        {
+          const double eij = gsl_matrix_get(eA, i, j - 1) * alpha / (double) (j - i);
+          gsl_matrix_set(eA, i, j, eij);
+        }
+    }
+
+  s += test_exponential_pade_eps(A, eA, 256.0 * N * GSL_DBL_EPSILON, "shift");
+
+  gsl_matrix_free(A);
+  gsl_matrix_free(eA);
+
+  return s;
+}
+
+static int
+test_exponential_action_eps(const double t, const gsl_matrix * A, const gsl_vector * v,
+                            const double eps, const char * desc)
+{
+  int s = 0;
+  const size_t N = A->size1;
+  gsl_matrix * tA = gsl_matrix_alloc(N, N);
+  gsl_matrix * eA = gsl_matrix_alloc(N, N);
+  gsl_vector * w = gsl_vector_alloc(N);
+  gsl_vector * expected = gsl_vector_alloc(N);
+  double err;
+
+  gsl_matrix_memcpy(tA, A);
+  gsl_matrix_scale(tA, t);
+  s += gsl_linalg_exponential_pade(tA, eA);
+  gsl_blas_dgemv(CblasNoTrans, 1.0, eA, v, 0.0, expected);
+
+  s += gsl_linalg_exponential_action(t, A, v, w);
+
+  gsl_vector_sub(w, expected);
+  err = fabs(gsl_vector_get(w, gsl_blas_idamax(w))) /
+        fabs(gsl_vector_get(expected, gsl_blas_idamax(expected)));
+  gsl_test(err > eps, "%s: exponential_action N=%lu t=%g error=%e", desc, N, t, err);
+
+  gsl_matrix_free(tA);
+  gsl_matrix_free(eA);
+  gsl_vector_free(w);
+  gsl_vector_free(expected);
+
+  return s;
+}
+
+/* generator of a continuous time Markov chain; exp(t A) has unit row sums */
+static int
+test_exponential_action_markov(const size_t N, const double t, gsl_rng * r)
+{
+  int s = 0;
+  gsl_matrix * A = gsl_matrix_alloc(N, N);
+  gsl_vector * v = gsl_vector_alloc(N);
+  gsl_vector * w = gsl_vector_alloc(N);
+  size_t i, j;
+  double err = 0.0;
+
+  for (i = 0; i < N; ++i)
+    {
+      double sum = 0.0;
+
+      for (j = 0; j < N; ++j)
+        {
+          if (i != j)
+            {
+              const double aij = gsl_rng_uniform(r);
+              gsl_matrix_set(A, i, j, aij);
+              sum += aij;
+            }
+        }
+
+      gsl_matrix_set(A, i, i, -sum);
+    }
+
+  gsl_vector_set_all(v, 1.0);
+  s += gsl_linalg_exponential_action(t, A, v, w);
+
+  for (i = 0; i < N; ++i)
+    err = GSL_MAX(err, fabs(gsl_vector_get(w, i) - 1.0));
+
+  gsl_test(err > 1.0e3 * N * GSL_DBL_EPSILON,
+           "markov: exponential_action N=%lu t=%g error=%e", N, t, err);
+
+  gsl_matrix_free(A);
+  gsl_vector_free(v);
+  gsl_vector_free(w);
+
+  return s;
+}
+
+static int
+test_exponential(gsl_rng * r)
+{
+  int s = 0;
+  const size_t sizes[] = { 1, 2, 5, 20, 60 };
+  /* norms selecting each of the Pade degrees, and scaling */
+  const double norms[] = { 1.0e-3, 0.1, 0.5, 1.5, 4.0, 30.0 };
+  size_t i, j;
+
+  for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+    {
+      for (j = 0; j < sizeof(norms) / sizeof(norms[0]); ++j)
+        s += test_exponential_pade_symm(sizes[i], norms[j], r);
+    }
+
+  s += test_exponential_pade_shift(10, 0.5);
+  s += test_exponential_pade_shift(10, 2.0);
+  s += test_exponential_pade_shift(25, 4.0);
+
+  for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); ++i)
+    {
+      const size_t N = sizes[i];
+      const double ts[] = { 1.0e-3, 0.1, 1.0, 5.0 };
+      gsl_matrix * A = gsl_matrix_alloc(N, N);
+      gsl_vector * v = gsl_vector_alloc(N);
+
+      create_random_matrix(A, r);
+      create_random_vector(v, r);
+
+      for (j = 0; j < sizeof(ts) / sizeof(ts[0]); ++j)
+        s += test_exponential_action_eps(ts[j], A, v, 1.0e3 * N * GSL_DBL_EPSILON, "random");
+
+      gsl_matrix_free(A);
+      gsl_vector_free(v);
+    }
+
+  s += test_exponential_action_markov(50, 1.0, r);
+  s += test_exponential_action_markov(50, 100.0, r);
+
+  return s;
+}
@@ -210,6 +210,302 @@ test_ldlt_solve(gsl_rng * r)
   return s;
 }
 
+/*
+ * create a KKT matrix [ 0 B ; B^T H ] with m constraints, H positive
+ * definite with unit diagonal dominance and the elements of B uniform
+ * in [-1,1]
+ */
+static int
+create_kkt_matrix(const size_t m, gsl_matrix * K, gsl_rng * r)
+{
+  const size_t N = K->size1;
+  gsl_matrix_view B = gsl_matrix_submatrix(K, 0, m, m, N - m);
+  gsl_matrix_view H = gsl_matrix_submatrix(K, m, m, N - m, N - m);
+  gsl_matrix_view Z = gsl_matrix_submatrix(K, 0, 0, m, m);
+  size_t i, j;
+
+  create_posdef_matrix(&H.matrix, r);
+  gsl_matrix_scale(&H.matrix, 1.0 / (10.0 * (N - m)));
+  gsl_matrix_set_zero(&Z.matrix);
+
+  for (i = 0; i < m; ++i)
+    {
+      for (j = 0; j < N - m; ++j)
+        gsl_matrix_set(&B.matrix, i, j, 2.0 * gsl_rng_uniform(r) - 1.0);
+    }
+
+  /* copy upper triangle to lower */
+  gsl_matrix_transpose_tricpy(CblasUpper, CblasUnit, K, K);
+
+  return GSL_SUCCESS;
+}
+
+static int
+test_ldlt_bk_decomp_eps(const gsl_matrix * m, const double expected_rcond,
+                        const double eps, const char * desc)
+{
+  int s = 0;
+  size_t i, j, N = m->size2;
+
+  gsl_matrix * V  = gsl_matrix_alloc(N, N);
+  gsl_matrix * A  = gsl_matrix_alloc(N, N);
+  gsl_matrix * L  = gsl_matrix_calloc(N, N);
+  gsl_matrix * LD = gsl_matrix_calloc(N, N);
+  gsl_matrix * D  = gsl_matrix_calloc(N, N);
+  gsl_permutation * p = gsl_permutation_alloc(N);
+  double norm1 = test_ldlt_norm1(m);
+  gsl_vector_view d;
+
+  gsl_matrix_memcpy(V, m);
+
+  s += gsl_linalg_ldlt_bk_decomp(V, p);
+
+  /* compute L */
+  gsl_matrix_tricpy(CblasLower, CblasUnit, L, V);
+  d = gsl_matrix_diagonal(L);
+  gsl_vector_set_all(&d.vector, 1.0);
+
+  /* compute block diagonal D */
+  for (i = 0; i < N; ++i)
+    {
+      gsl_matrix_set(D, i, i, gsl_matrix_get(V, i, i));
+
+      if (i < N - 1)
+        {
+          double e = gsl_matrix_get(V, i, i + 1);
+          gsl_matrix_set(D, i, i + 1, e);
+          gsl_matrix_set(D, i + 1, i, e);
+        }
+    }
+
+  /* compute A = L D LT */
+  gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, L, D, 0.0, LD);
+  gsl_blas_dgemm (CblasNoTrans, CblasTrans, 1.0, LD, L, 0.0, A);
+
+  /* compare P A P^T with L D L^T, relative to ||A||_1 since pivoting
+   * bounds the backward error only normwise */
+  for (i = 0; i < N; i++)
+    {
+      for (j = 0; j < N; j++)
+        {
+          double Aij = gsl_matrix_get(A, i, j);
+          double mij = gsl_matrix_get(m, gsl_permutation_get(p, i), gsl_permutation_get(p, j));
+
+          gsl_test_abs(Aij, mij, eps * norm1,
+                       "%s: (%3lu,%3lu)[%lu,%lu]: %22.18g   %22.18g\n",
+                       desc, N, N, i, j, Aij, mij);
+        }
+    }
+
+  /* test 1-norm calculation */
+  if (N > 2)
+    {
+      double norm1_stored = gsl_matrix_get(V, 0, N - 1);
+
+      gsl_test_rel(norm1_stored, norm1, eps,
+                   "%s: (%3lu,%3lu) 1-norm: %22.18g   %22.18g\n",
+                   desc, N, N, norm1_stored, norm1);
+    }
+
+  if (expected_rcond > 0)
+    {
+      gsl_vector *work = gsl_vector_alloc(3 * N);
+      double rcond;
+
+      gsl_linalg_ldlt_bk_rcond(V, p, &rcond, work);
+
+      gsl_test_rel(rcond, expected_rcond, 1.0e-6,
+                   "%s rcond: (%3lu,%3lu): %22.18g   %22.18g\n",
+                   desc, N, N, rcond, expected_rcond);
+
+      gsl_vector_free(work);
+    }
+
+  gsl_matrix_free(V);
+  gsl_matrix_free(A);
+  gsl_matrix_free(L);
+  gsl_matrix_free(LD);
+  gsl_matrix_free(D);
+  gsl_permutation_free(p);
+
+  return s;
+}
+
+static int
+test_ldlt_bk_decomp(void)
+{
+  gsl_rng * r = gsl_rng_alloc(gsl_rng_default);
+  int s = 0;
+  const size_t N_max = 50;
+  const size_t N_blocked[] = { 65, 100, 173 };
+  size_t N, i;
+
+  for (N = 1; N <= N_max; ++N)
+    {
+      gsl_matrix * m = gsl_matrix_alloc(N, N);
+
+      create_symm_matrix(m, r);
+      s += test_ldlt_bk_decomp_eps(m, -1.0, 1.0e3 * N * GSL_DBL_EPSILON, "ldlt_bk_decomp random");
+
+      if (N > 1)
+        {
+          create_kkt_matrix(N / 2, m, r);
+          s += test_ldlt_bk_decomp_eps(m, -1.0, 1.0e3 * N * GSL_DBL_EPSILON, "ldlt_bk_decomp kkt");
+        }
+
+      if (N <= 12)
+        {
+          double expected_rcond = -1.0;
+
+          if (hilb_rcond[N - 1] > 1.0e-12)
+            expected_rcond = hilb_rcond[N - 1];
+
+          create_hilbert_matrix2(m);
+          s += test_ldlt_bk_decomp_eps(m, expected_rcond, N * GSL_DBL_EPSILON, "ldlt_bk_decomp hilbert");
+        }
+
+      gsl_matrix_free(m);
+    }
+
+  /* sizes which use the blocked algorithm */
+  for (i = 0; i < sizeof(N_blocked) / sizeof(size_t); ++i)
+    {
+      gsl_matrix * m;
+
+      N = N_blocked[i];
+      m = gsl_matrix_alloc(N, N);
+
+      create_symm_matrix(m, r);
+      s += test_ldlt_bk_decomp_eps(m, -1.0, 1.0e3 * N * GSL_DBL_EPSILON, "ldlt_bk_decomp random");
+
+      create_kkt_matrix(N / 3, m, r);
+      s += test_ldlt_bk_decomp_eps(m, -1.0, 1.0e3 * N * GSL_DBL_EPSILON, "ldlt_bk_decomp kkt");
+
+      gsl_matrix_free(m);
+    }
+
+  gsl_rng_free(r);
+
+  return s;
+}
+
+static int
+test_ldlt_bk_solve_eps(const gsl_matrix * m, const gsl_vector * rhs,
+                       const gsl_vector * sol, const double eps,
+                       const char * desc)
+{
+  int s = 0;
+  size_t i, N = m->size1;
+  gsl_matrix * u  = gsl_matrix_alloc(N, N);
+  gsl_vector * x = gsl_vector_calloc(N);
+  gsl_permutation * p = gsl_permutation_alloc(N);
+  double solmax;
+
+  gsl_matrix_memcpy(u, m);
+
+  s += gsl_linalg_ldlt_bk_decomp(u, p);
+  s += gsl_linalg_ldlt_bk_solve(u, p, rhs, x);
+
+  /* normwise error, since the components of sol may be arbitrarily small */
+  solmax = fabs(gsl_vector_get(sol, gsl_blas_idamax(sol)));
+
+  for (i = 0; i < N; i++)
+    {
+      double xi = gsl_vector_get(x, i);
+      double yi = gsl_vector_get(sol, i);
+
+      gsl_test_abs(xi, yi, eps * solmax,
+                   "%s: %3lu[%lu]: %22.18g   %22.18g\n",
+                   desc, N, i, xi, yi);
+    }
+
+  gsl_vector_free(x);
+  gsl_matrix_free(u);
+  gsl_permutation_free(p);
+
+  return s;
+}
+
+static int
+test_ldlt_bk_solve(void)
+{
+  gsl_rng * r = gsl_rng_alloc(gsl_rng_default);
+  int s = 0;
+  const size_t N_max = 50;
+  const size_t N_blocked[] = { 65, 100, 173 };
+  const size_t nblocked = sizeof(N_blocked) / sizeof(size_t);
+  size_t i;
+
+  /* small sizes, followed by sizes which use the blocked algorithm */
+  for (i = 3; i <= N_max + nblocked; ++i)
+    {
+      const size_t N = (i <= N_max) ? i : N_blocked[i - N_max - 1];
+      gsl_matrix * m = gsl_matrix_alloc(N, N);
+      gsl_vector * rhs = gsl_vector_alloc(N);
+      gsl_vector * sol = gsl_vector_alloc(N);
+
+      create_kkt_matrix(N / 3, m, r);
+      create_random_vector(sol, r);
+      gsl_blas_dsymv(CblasLower, 1.0, m, sol, 0.0, rhs);
+
+      s += test_ldlt_bk_solve_eps(m, rhs, sol, 1.0e3 * N * GSL_DBL_EPSILON, "ldlt_bk_solve kkt");
+
+      create_posdef_matrix(m, r);
+      gsl_blas_dsymv(CblasLower, 1.0, m, sol, 0.0, rhs);
+
+      s += test_ldlt_bk_solve_eps(m, rhs, sol, 64.0 * N * GSL_DBL_EPSILON, "ldlt_bk_solve random");
+
+      gsl_matrix_free(m);
+      gsl_vector_free(rhs);
+      gsl_vector_free(sol);
+    }
+
+  gsl_rng_free(r);
+
+  return s;
+}
+
+static int
+test_ldlt_bk_rcond(void)
+{
+  gsl_rng * r = gsl_rng_alloc(gsl_rng_default);
+  int s = 0;
+  const size_t N_max = 50;
+  size_t N;
+
+  for (N = 1; N <= N_max; ++N)
+    {
+      gsl_matrix * m = gsl_matrix_alloc(N, N);
+      gsl_matrix * u = gsl_matrix_alloc(N, N);
+      gsl_permutation * p = gsl_permutation_alloc(N);
+      gsl_vector * work = gsl_vector_alloc(3 * N);
+      double rcond, rcond_expected;
+
+      create_posdef_matrix(m, r);
+
+      gsl_matrix_memcpy(u, m);
+      s += gsl_linalg_ldlt_decomp(u);
+      s += gsl_linalg_ldlt_rcond(u, &rcond_expected, work);
+
+      gsl_matrix_memcpy(u, m);
+      s += gsl_linalg_ldlt_bk_decomp(u, p);
+      s += gsl_linalg_ldlt_bk_rcond(u, p, &rcond, work);
+
+      gsl_test_rel(rcond, rcond_expected, 1.0e-10,
+                   "ldlt_bk_rcond random: (%3lu,%3lu): %22.18g   %22.18g\n",
+                   N, N, rcond, rcond_expected);
+
+      gsl_matrix_free(m);
+      gsl_matrix_free(u);
+      gsl_permutation_free(p);
+      gsl_vector_free(work);
+    }
+
+  gsl_rng_free(r);
+
+  return s;
+}
+
 static int
 test_ldlt_band_decomp_eps(const size_t p, const gsl_matrix * m, const double eps, const char * desc)
 {
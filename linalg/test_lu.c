@@ -19,6 +19,7 @@
 
 #include <config.h>
 #include <stdlib.h>
+#include <string.h>
 #include <gsl/gsl_test.h>
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_ieee_utils.h>
@@ -40,6 +41,7 @@ test_LU_decomp_eps(const gsl_matrix * m, const double eps, const char * desc)
   gsl_permutation * p = gsl_permutation_alloc(M);
   size_t i, j;
   int signum;
+  double err;
 
   gsl_matrix_memcpy(A, m);
   gsl_linalg_LU_decomp(A, p, &signum);
@@ -85,18 +87,8 @@ test_LU_decomp_eps(const gsl_matrix * m, const double eps, const char * desc)
     }
 
   /* now test m = PLU */
-  for (i = 0; i < M; ++i)
-    {
-      for (j = 0; j < N; ++j)
-        {
-          double aij = gsl_matrix_get(PLU, i, j);
-          double mij = gsl_matrix_get(m, i, j);
-
-          gsl_test_rel(aij, mij, eps,
-                       "%s: (%3lu,%3lu)[%lu,%lu]: %22.18g   %22.18g\n",
-                       desc, M, N, i, j, aij, mij);
-        }
-    }
+  err = test_backward_error(m, PLU);
+  gsl_test(!(err <= eps), "%s: (%3lu,%3lu) error %e", desc, M, N, err);
 
   gsl_matrix_free(A);
   gsl_matrix_free(PLU);
@@ -286,3 +278,128 @@ test_LU_invert(gsl_rng * r)
 
   return s;
 }
+
+/* normwise backward error || b - A x ||_inf / (||A||_inf ||x||_inf) */
+static double
+test_LU_backward_error(const gsl_matrix * m, const gsl_vector * x, const gsl_vector * rhs)
+{
+  const size_t N = m->size1;
+  gsl_vector * r = gsl_vector_alloc(N);
+  double anorm = 0.0, rnorm, xnorm;
+  size_t i, j;
+
+  for (i = 0; i < N; ++i)
+    {
+      double sum = 0.0;
+
+      for (j = 0; j < N; ++j)
+        sum += fabs(gsl_matrix_get(m, i, j));
+
+      anorm = GSL_MAX(anorm, sum);
+    }
+
+  gsl_vector_memcpy(r, rhs);
+  gsl_blas_dgemv(CblasNoTrans, -1.0, m, x, 1.0, r);
+
+  rnorm = fabs(gsl_vector_get(r, gsl_blas_idamax(r)));
+  xnorm = fabs(gsl_vector_get(x, gsl_blas_idamax(x)));
+
+  gsl_vector_free(r);
+
+  return rnorm / (anorm * xnorm);
+}
+
+static int
+test_LU_solve_mixed_eps(const gsl_matrix * m, const gsl_vector * rhs, const int expect_fallback,
+                        const double eps, const char * desc)
+{
+  int s = 0;
+  const size_t N = m->size1;
+  gsl_matrix * A = gsl_matrix_alloc(N, N);
+  gsl_matrix * lu = gsl_matrix_alloc(N, N);
+  gsl_permutation * p = gsl_permutation_alloc(N);
+  gsl_permutation * perm = gsl_permutation_alloc(N);
+  gsl_vector * x = gsl_vector_alloc(N);
+  double err;
+  int iter, signum;
+
+  gsl_matrix_memcpy(A, m);
+  s += gsl_linalg_LU_solve_mixed(A, p, rhs, x, &iter);
+
+  err = test_LU_backward_error(m, x, rhs);
+  gsl_test(err > eps, "%s: LU_solve_mixed N=%lu iter=%d backward error=%e",
+           desc, N, iter, err);
+
+  if (expect_fallback)
+    {
+      gsl_test(iter >= 0, "%s: LU_solve_mixed N=%lu fallback iter=%d", desc, N, iter);
+
+      /* A must contain the double precision LU decomposition */
+      gsl_matrix_memcpy(lu, m);
+      s += gsl_linalg_LU_decomp(lu, perm, &signum);
+      gsl_test(!gsl_matrix_equal(A, lu) || memcmp(p->data, perm->data, N * sizeof(size_t)),
+               "%s: LU_solve_mixed N=%lu fallback factorization", desc, N);
+    }
+  else
+    {
+      gsl_test(iter < 0, "%s: LU_solve_mixed N=%lu iter=%d", desc, N, iter);
+      gsl_test(!gsl_matrix_equal(A, m), "%s: LU_solve_mixed N=%lu matrix modified", desc, N);
+    }
+
+  gsl_matrix_free(A);
+  gsl_matrix_free(lu);
+  gsl_permutation_free(p);
+  gsl_permutation_free(perm);
+  gsl_vector_free(x);
+
+  return s;
+}
+
+static int
+test_LU_solve_mixed(gsl_rng * r)
+{
+  int s = 0;
+  size_t n;
+
+  for (n = 1; n <= 300; n += (n < 50) ? 1 : 83)
+    {
+      gsl_matrix * m = gsl_matrix_alloc(n, n);
+      gsl_vector * rhs = gsl_vector_alloc(n);
+      size_t i;
+
+      /* diagonally dominant, well conditioned */
+      create_random_matrix(m, r);
+      create_random_vector(rhs, r);
+
+      for (i = 0; i < n; ++i)
+        {
+          double * mii = gsl_matrix_ptr(m, i, i);
+          *mii += (double) n;
+        }
+
+      s += test_LU_solve_mixed_eps(m, rhs, 0, 16.0 * n * GSL_DBL_EPSILON, "random");
+
+      /* out of the range of single precision */
+      gsl_matrix_scale(m, 1.0e300);
+      s += test_LU_solve_mixed_eps(m, rhs, 1, 16.0 * n * GSL_DBL_EPSILON, "scaled");
+
+      gsl_matrix_free(m);
+      gsl_vector_free(rhs);
+    }
+
+  /* too ill-conditioned for single precision */
+  {
+    const size_t N = 12;
+    gsl_matrix * m = gsl_matrix_alloc(N, N);
+    gsl_vector * rhs = gsl_vector_alloc(N);
+
+    create_hilbert_matrix2(m);
+    gsl_vector_set_all(rhs, 1.0);
+    s += test_LU_solve_mixed_eps(m, rhs, 1, 16.0 * N * GSL_DBL_EPSILON, "hilbert");
+
+    gsl_matrix_free(m);
+    gsl_vector_free(rhs);
+  }
+
+  return s;
+}
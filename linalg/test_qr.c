@@ -27,6 +27,7 @@
 #include <gsl/gsl_linalg.h>
 #include <gsl/gsl_rng.h>
 #include <gsl/gsl_permutation.h>
+#include <gsl/gsl_sys.h>
 
 static int
 test_QR_decomp_dim(const gsl_matrix * m, double eps)
@@ -447,6 +448,133 @@ test_QR_lssolve_r(gsl_rng * r)
   return s;
 }
 
+static int
+test_QR_TSQR_decomp_eps(const gsl_matrix * m, const gsl_vector * b, const double eps, const char * desc)
+{
+  int s = 0;
+  const size_t M = m->size1;
+  const size_t N = m->size2;
+  size_t i, j;
+
+  gsl_matrix * QR = gsl_matrix_alloc(M, N);
+  gsl_matrix * T = gsl_matrix_alloc(N, N);
+  gsl_matrix * A  = gsl_matrix_alloc(M, N);
+  gsl_matrix * R  = gsl_matrix_alloc(N, N);
+  gsl_matrix * Q  = gsl_matrix_alloc(M, M);
+  gsl_matrix * QTQ  = gsl_matrix_alloc(M, M);
+  gsl_matrix * QR_alt = gsl_matrix_alloc(M, N);
+  gsl_matrix * T_alt = gsl_matrix_alloc(N, N);
+  gsl_vector * x = gsl_vector_alloc(M);
+  gsl_vector * x_alt = gsl_vector_alloc(M);
+  gsl_vector * work = gsl_vector_alloc(N);
+  gsl_matrix_view Q1 = gsl_matrix_submatrix(Q, 0, 0, M, N);
+
+  gsl_matrix_memcpy(QR, m);
+
+  s += gsl_linalg_QR_TSQR_decomp(QR, T);
+  s += gsl_linalg_QR_unpack_r(QR, T, Q, R);
+
+  /* compute A = Q R */
+  gsl_matrix_memcpy(A, &Q1.matrix);
+  gsl_blas_dtrmm (CblasRight, CblasUpper, CblasNoTrans, CblasNonUnit, 1.0, R, A);
+
+  for (i = 0; i < M; i++)
+    {
+      for (j = 0; j < N; j++)
+        {
+          double aij = gsl_matrix_get(A, i, j);
+          double mij = gsl_matrix_get(m, i, j);
+
+          gsl_test_abs(aij, mij, eps, "%s (%3lu,%3lu)[%lu,%lu]: %22.18g   %22.18g\n",
+                       desc, M, N, i, j, aij, mij);
+        }
+    }
+
+  /* check Q^T Q = I */
+  gsl_blas_dgemm(CblasTrans, CblasNoTrans, 1.0, Q, Q, 0.0, QTQ);
+
+  for (i = 0; i < M; i++)
+    {
+      for (j = 0; j < M; j++)
+        {
+          double aij = gsl_matrix_get(QTQ, i, j);
+
+          gsl_test_abs(aij, (double) (i == j), eps, "%s Q^T Q (%3lu,%3lu)[%lu,%lu]: %22.18g\n",
+                       desc, M, N, i, j, aij);
+        }
+    }
+
+  /* compare least squares solution with gsl_linalg_QR_decomp_r */
+  gsl_matrix_memcpy(QR_alt, m);
+  s += gsl_linalg_QR_decomp_r(QR_alt, T_alt);
+  s += gsl_linalg_QR_lssolve_r(QR_alt, T_alt, b, x_alt, work);
+  s += gsl_linalg_QR_lssolve_r(QR, T, b, x, work);
+
+  for (i = 0; i < N; i++)
+    {
+      double xi = gsl_vector_get(x, i);
+      double yi = gsl_vector_get(x_alt, i);
+
+      gsl_test_rel(xi, yi, eps, "%s lssolve (%3lu,%3lu)[%lu]: %22.18g   %22.18g\n",
+                   desc, M, N, i, xi, yi);
+    }
+
+  gsl_matrix_free(QR);
+  gsl_matrix_free(T);
+  gsl_matrix_free(A);
+  gsl_matrix_free(Q);
+  gsl_matrix_free(QTQ);
+  gsl_matrix_free(R);
+  gsl_matrix_free(QR_alt);
+  gsl_matrix_free(T_alt);
+  gsl_vector_free(x);
+  gsl_vector_free(x_alt);
+  gsl_vector_free(work);
+
+  return s;
+}
+
+static int
+test_QR_TSQR_decomp(void)
+{
+  gsl_rng * r = gsl_rng_alloc(gsl_rng_default);
+  const int nthreads = gsl_get_num_threads();
+  const size_t dims[][2] = { { 2, 1 }, { 7, 3 }, { 10, 5 }, { 17, 4 },
+                             { 40, 10 }, { 53, 7 }, { 100, 30 }, { 150, 12 } };
+  int s = 0;
+  int p;
+  size_t i;
+
+  /* exercise the tree reduction with 2 to 5 blocks, independently of the
+     number of processors */
+  for (p = 2; p <= 5; ++p)
+    {
+      gsl_set_num_threads(p);
+
+      for (i = 0; i < sizeof(dims) / sizeof(dims[0]); ++i)
+        {
+          const size_t M = dims[i][0];
+          const size_t N = dims[i][1];
+          gsl_matrix * A = gsl_matrix_alloc(M, N);
+          gsl_vector * b = gsl_vector_alloc(M);
+
+          create_random_matrix(A, r);
+          create_random_vector(b, r);
+
+          s += test_QR_TSQR_decomp_eps(A, b, 1.0e4 * M * GSL_DBL_EPSILON, "QR_TSQR_decomp random");
+
+          gsl_matrix_free(A);
+          gsl_vector_free(b);
+        }
+    }
+
+  gsl_set_num_threads(nthreads);
+
+  gsl_rng_free(r);
+
+  return s;
+}
+
 static int
 test_QR_UR_decomp_eps(const gsl_matrix * S, const gsl_matrix * A, const double eps, const char * desc)
 {
@@ -88,6 +88,17 @@ test_symmtd_decomp(gsl_rng * r)
       gsl_matrix_free(A);
     }
 
+  /* sizes using the blocked algorithm */
+  for (N = 65; N <= 200; N += 45)
+    {
+      gsl_matrix * A = gsl_matrix_alloc(N, N);
+
+      create_symm_matrix(A, r);
+      s += test_symmtd_decomp_eps(A, 1.0e5 * N * GSL_DBL_EPSILON, "symmtd_decomp blocked random");
+
+      gsl_matrix_free(A);
+    }
+
   return s;
 }
 
@@ -163,5 +174,16 @@ test_hermtd_decomp(gsl_rng * r)
       gsl_matrix_complex_free(A);
     }
 
+  /* sizes using the blocked algorithm */
+  for (N = 65; N <= 200; N += 45)
+    {
+      gsl_matrix_complex * A = gsl_matrix_complex_alloc(N, N);
+
+      create_herm_matrix(A, r);
+      s += test_hermtd_decomp_eps(A, 1.0e5 * N * GSL_DBL_EPSILON, "hermtd_decomp blocked random");
+
+      gsl_matrix_complex_free(A);
+    }
+
   return s;
 }
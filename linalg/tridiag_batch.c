@@ -0,0 +1,562 @@
+/* linalg/tridiag_batch.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_sys.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_linalg.h>
+
+/*
+ * this module contains routines for solving many tridiagonal systems
+ * of the same size at once, and for solving one long tridiagonal system
+ * in parallel:
+ *
+ * Wang, H. H., 1981. A parallel method for tridiagonal equations. ACM
+ * Transactions on Mathematical Software, 7(2), pp.170-183.
+ *
+ * Polizzi, E. and Sameh, A. H., 2006. A parallel hybrid banded system
+ * solver: the SPIKE algorithm. Parallel Computing, 32(2), pp.177-194.
+ */
+
+/* number of systems eliminated together in the batched solvers */
+#define TRIDIAG_BATCH_BLOCK      64
+
+/* minimum number of rows of each partition in gsl_linalg_solve_tridiag_par */
+#define TRIDIAG_PAR_MIN_ROWS     256
+
+/* first row of partition k of p partitions of N rows */
+#define TRIDIAG_PAR_START(k,p,N) (((k) * (N)) / (p))
+
+static int tridiag_batch (const gsl_matrix * diag, const gsl_matrix * abovediag,
+                          const gsl_matrix * belowdiag, const gsl_matrix * B,
+                          gsl_matrix * X);
+static int tridiag_batch_block (const size_t N, const size_t m,
+                                const double * d, const size_t tda_d,
+                                const double * a, const size_t tda_a,
+                                const double * b, const size_t tda_b,
+                                const double * r, const size_t tda_r,
+                                double * x, const size_t tda_x, double * c);
+static int tridiag_par_spikes (const size_t r0, const size_t r1,
+                               const int left, const int right,
+                               const gsl_vector * diag, const gsl_vector * abovediag,
+                               const gsl_vector * belowdiag, const gsl_vector * rhs,
+                               gsl_vector * x, double * c, double * v, double * w);
+
+/*
+gsl_linalg_solve_symm_tridiag_batch()
+  Solve nsys symmetric tridiagonal systems A_s x_s = b_s of the same
+size N
+
+Inputs: diag    - N-by-nsys, column s is the diagonal of A_s
+        offdiag - (N-1)-by-nsys, column s is the off-diagonal of A_s
+        B       - N-by-nsys, column s is the right hand side b_s
+        X       - (output) N-by-nsys, column s is the solution x_s
+
+Return: success/error
+
+Notes: see gsl_linalg_solve_tridiag_batch
+*/
+
+int
+gsl_linalg_solve_symm_tridiag_batch (const gsl_matrix * diag,
+                                     const gsl_matrix * offdiag,
+                                     const gsl_matrix * B, gsl_matrix * X)
+{
+  const size_t N = B->size1;
+  const size_t nsys = B->size2;
+
+  if (diag->size1 != N || diag->size2 != nsys)
+    {
+      GSL_ERROR ("diag matrix must match B", GSL_EBADLEN);
+    }
+  else if (N > 1 && (offdiag->size1 != N - 1 || offdiag->size2 != nsys))
+    {
+      GSL_ERROR ("offdiag matrix must be (N-1)-by-nsys", GSL_EBADLEN);
+    }
+  else if (X->size1 != N || X->size2 != nsys)
+    {
+      GSL_ERROR ("X matrix must match B", GSL_EBADLEN);
+    }
+  else
+    {
+      return tridiag_batch (diag, offdiag, offdiag, B, X);
+    }
+}
+
+/*
+gsl_linalg_solve_tridiag_batch()
+  Solve nsys nonsymmetric tridiagonal systems A_s x_s = b_s of the same
+size N
+
+Inputs: diag      - N-by-nsys, column s is the diagonal of A_s
+        abovediag - (N-1)-by-nsys, column s is the superdiagonal of A_s
+        belowdiag - (N-1)-by-nsys, column s is the subdiagonal of A_s
+        B         - N-by-nsys, column s is the right hand side b_s
+        X         - (output) N-by-nsys, column s is the solution x_s
+
+Return: success/error
+
+Notes:
+1) The systems are stored one per column, so that row i of each matrix
+holds element i of all systems contiguously. Each step of the Thomas
+algorithm is then applied to a row of TRIDIAG_BATCH_BLOCK systems at a
+time, in a loop which the compiler can vectorize.
+
+2) The blocks of systems are distributed over the threads (see
+gsl_set_num_threads).
+
+3) As in gsl_linalg_solve_tridiag, there is no pivoting. If a zero
+pivot is found in any system, GSL_EZERODIV is returned after all
+systems have been processed.
+
+4) X may be the same matrix as B.
+*/
+
+int
+gsl_linalg_solve_tridiag_batch (const gsl_matrix * diag,
+                                const gsl_matrix * abovediag,
+                                const gsl_matrix * belowdiag,
+                                const gsl_matrix * B, gsl_matrix * X)
+{
+  const size_t N = B->size1;
+  const size_t nsys = B->size2;
+
+  if (diag->size1 != N || diag->size2 != nsys)
+    {
+      GSL_ERROR ("diag matrix must match B", GSL_EBADLEN);
+    }
+  else if (N > 1 && (abovediag->size1 != N - 1 || abovediag->size2 != nsys))
+    {
+      GSL_ERROR ("abovediag matrix must be (N-1)-by-nsys", GSL_EBADLEN);
+    }
+  else if (N > 1 && (belowdiag->size1 != N - 1 || belowdiag->size2 != nsys))
+    {
+      GSL_ERROR ("belowdiag matrix must be (N-1)-by-nsys", GSL_EBADLEN);
+    }
+  else if (X->size1 != N || X->size2 != nsys)
+    {
+      GSL_ERROR ("X matrix must match B", GSL_EBADLEN);
+    }
+  else
+    {
+      return tridiag_batch (diag, abovediag, belowdiag, B, X);
+    }
+}
+
+/*
+gsl_linalg_solve_tridiag_par()
+  Solve a nonsymmetric tridiagonal system A x = b in parallel by the
+partition method
+
+Inputs: diag      - diagonal of A, length N
+        abovediag - superdiagonal of A, length N-1
+        belowdiag - subdiagonal of A, length N-1
+        rhs       - right hand side b, length N
+        x         - (output) solution x, length N
+
+Return: success/error
+
+Notes:
+1) The rows are split into p partitions, one per thread (see
+gsl_set_num_threads), each with at least TRIDIAG_PAR_MIN_ROWS rows.
+Each thread eliminates its diagonal block A_k, giving
+
+x_k = g_k - v_k x(r1+1) - w_k x(r0-1)
+
+where r0 and r1 are the first and last rows of the partition, g_k is
+the solution of A_k g_k = b_k, and v_k and w_k are the "spikes" due to
+the elements of A coupling the partition to its neighbours.
+
+2) The first and last rows of all partitions form a reduced system of
+2p unknowns with 2-by-2 block tridiagonal structure, which is solved
+serially. The remaining unknowns are then updated in parallel.
+
+3) A symmetric system is solved by passing its off-diagonal as both
+abovediag and belowdiag.
+
+4) As in gsl_linalg_solve_tridiag, there is no pivoting, and the
+method is intended for diagonally dominant or positive definite
+systems. With one thread, or if N < 2 TRIDIAG_PAR_MIN_ROWS,
+gsl_linalg_solve_tridiag is used directly.
+*/
+
+int
+gsl_linalg_solve_tridiag_par (const gsl_vector * diag,
+                              const gsl_vector * abovediag,
+                              const gsl_vector * belowdiag,
+                              const gsl_vector * rhs, gsl_vector * x)
+{
+  const size_t N = rhs->size;
+
+  if (diag->size != N)
+    {
+      GSL_ERROR ("size of diag must match rhs", GSL_EBADLEN);
+    }
+  else if (abovediag->size != N - 1)
+    {
+      GSL_ERROR ("size of abovediag must match rhs-1", GSL_EBADLEN);
+    }
+  else if (belowdiag->size != N - 1)
+    {
+      GSL_ERROR ("size of belowdiag must match rhs-1", GSL_EBADLEN);
+    }
+  else if (x->size != N)
+    {
+      GSL_ERROR ("size of solution must match rhs", GSL_EBADLEN);
+    }
+  else
+    {
+      const int nthreads = gsl_get_num_threads ();
+      const int p = (int) GSL_MIN ((size_t) nthreads, N / TRIDIAG_PAR_MIN_ROWS);
+      double *work, *c, *v, *w, *e, *h;
+      int k, status = GSL_SUCCESS;
+
+      if (p < 2)
+        return gsl_linalg_solve_tridiag (diag, abovediag, belowdiag, rhs, x);
+
+      /*
+       * work holds the multipliers c and the spikes v and w of each row,
+       * and the 2-vectors e_k and h_k of the block elimination of the
+       * reduced system for each partition
+       */
+      work = malloc ((3 * N + 4 * p) * sizeof (double));
+      if (work == NULL)
+        {
+          GSL_ERROR ("failed to allocate working space", GSL_ENOMEM);
+        }
+
+      c = work;
+      v = c + N;
+      w = v + N;
+      e = w + N;
+      h = e + 2 * p;
+
+      /* x_k = g_k - v_k x(r1+1) - w_k x(r0-1), with g_k stored in x */
+
+#pragma omp parallel for num_threads(p) schedule(static) reduction(|:status)
+      for (k = 0; k < p; k++)
+        {
+          const size_t r0 = TRIDIAG_PAR_START (k, p, N);
+          const size_t r1 = TRIDIAG_PAR_START (k + 1, p, N) - 1;
+
+          status |= tridiag_par_spikes (r0, r1, k > 0, k < p - 1, diag,
+                                        abovediag, belowdiag, rhs, x, c, v, w);
+        }
+
+      if (status)
+        {
+          free (work);
+          GSL_ERROR ("matrix must be positive definite", GSL_EZERODIV);
+        }
+
+      /*
+       * reduced system in y_k = (x(r0), x(r1)) for partition k:
+       *
+       * y_k + [ 0 w(r0) ] y_{k-1} + [ v(r0) 0 ] y_{k+1} = [ g(r0) ]
+       *       [ 0 w(r1) ]           [ v(r1) 0 ]           [ g(r1) ]
+       *
+       * Block elimination gives y_k = h_k - e_k x(r1+1), where only the
+       * second element of y_{k-1} enters each step, so that the 2-by-2
+       * pivot blocks are lower triangular
+       */
+      for (k = 0; k < p; k++)
+        {
+          const size_t r0 = TRIDIAG_PAR_START (k, p, N);
+          const size_t r1 = TRIDIAG_PAR_START (k + 1, p, N) - 1;
+          const double ep = (k > 0) ? e[2 * k - 1] : 0.0;
+          const double hp = (k > 0) ? h[2 * k - 1] : 0.0;
+          const double wf = (k > 0) ? w[r0] : 0.0;
+          const double wl = (k > 0) ? w[r1] : 0.0;
+          const double d11 = 1.0 - wf * ep;
+          const double d21 = -wl * ep;
+
+          if (d11 == 0.0)
+            {
+              free (work);
+              GSL_ERROR ("matrix must be positive definite", GSL_EZERODIV);
+            }
+
+          e[2 * k] = v[r0] / d11;
+          e[2 * k + 1] = v[r1] - d21 * e[2 * k];
+          h[2 * k] = (gsl_vector_get (x, r0) - wf * hp) / d11;
+          h[2 * k + 1] = gsl_vector_get (x, r1) - wl * hp - d21 * h[2 * k];
+        }
+
+      for (k = p - 2; k >= 0; k--)
+        {
+          const double xnext = h[2 * (k + 1)];
+
+          h[2 * k] -= e[2 * k] * xnext;
+          h[2 * k + 1] -= e[2 * k + 1] * xnext;
+        }
+
+      /* update the rows of each partition from its neighbours */
+
+#pragma omp parallel for num_threads(p) schedule(static)
+      for (k = 0; k < p; k++)
+        {
+          const size_t r0 = TRIDIAG_PAR_START (k, p, N);
+          const size_t r1 = TRIDIAG_PAR_START (k + 1, p, N) - 1;
+          const double xl = (k > 0) ? h[2 * k - 1] : 0.0;
+          const double xr = (k < p - 1) ? h[2 * k + 2] : 0.0;
+          size_t i;
+
+          for (i = r0; i <= r1; i++)
+            {
+              double * xi = gsl_vector_ptr (x, i);
+              *xi -= v[i] * xr + w[i] * xl;
+            }
+        }
+
+      free (work);
+
+      return GSL_SUCCESS;
+    }
+}
+
+/* solve the batch of systems, with sizes already checked */
+
+static int
+tridiag_batch (const gsl_matrix * diag, const gsl_matrix * abovediag,
+               const gsl_matrix * belowdiag, const gsl_matrix * B,
+               gsl_matrix * X)
+{
+  const size_t N = B->size1;
+  const size_t nsys = B->size2;
+  const int nthreads = gsl_get_num_threads ();
+  const int nblocks = (int) ((nsys + TRIDIAG_BATCH_BLOCK - 1) / TRIDIAG_BATCH_BLOCK);
+  int nomem = 0;
+  int status = GSL_SUCCESS;
+
+  if (N == 0 || nsys == 0)
+    return GSL_SUCCESS;
+
+#pragma omp parallel num_threads(nthreads) reduction(|:nomem,status)
+  {
+    /* multipliers of one block of systems, private to each thread */
+    double * c = malloc (N * TRIDIAG_BATCH_BLOCK * sizeof (double));
+    int k;
+
+    if (c == NULL)
+      nomem = 1;
+
+#pragma omp for schedule(static)
+    for (k = 0; k < nblocks; k++)
+      {
+        const size_t s = (size_t) k * TRIDIAG_BATCH_BLOCK;
+        const size_t m = GSL_MIN (TRIDIAG_BATCH_BLOCK, nsys - s);
+
+        if (c == NULL)
+          continue;
+
+        status |= tridiag_batch_block (N, m,
+                                       diag->data + s, diag->tda,
+                                       abovediag->data + s, abovediag->tda,
+                                       belowdiag->data + s, belowdiag->tda,
+                                       B->data + s, B->tda,
+                                       X->data + s, X->tda, c);
+      }
+
+    free (c);
+  }
+
+  if (nomem)
+    {
+      GSL_ERROR ("failed to allocate working space", GSL_ENOMEM);
+    }
+  else if (status)
+    {
+      GSL_ERROR ("matrix must be positive definite", GSL_EZERODIV);
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+tridiag_batch_block()
+  Thomas algorithm for m systems of size N stored in columns
+
+Inputs: N     - size of systems
+        m     - number of systems
+        d     - diagonals, element i of system s in d[i*tda_d + s]
+        tda_d - row stride of d
+        a     - superdiagonals
+        tda_a - row stride of a
+        b     - subdiagonals
+        tda_b - row stride of b
+        r     - right hand sides
+        tda_r - row stride of r
+        x     - (output) solutions, may be the same as r
+        tda_x - row stride of x
+        c     - workspace, length (N-1)*m
+
+Return: 1 if a zero pivot was found, 0 otherwise
+*/
+
+static int
+tridiag_batch_block (const size_t N, const size_t m,
+                     const double * d, const size_t tda_d,
+                     const double * a, const size_t tda_a,
+                     const double * b, const size_t tda_b,
+                     const double * r, const size_t tda_r,
+                     double * x, const size_t tda_x, double * c)
+{
+  int zero = 0;
+  size_t i, s;
+
+  /* forward elimination: c_i = a_i / alpha_i, x_i = (r_i - b_{i-1} x_{i-1}) / alpha_i */
+  for (i = 0; i < N; i++)
+    {
+      const double * di = d + i * tda_d;
+      const double * ri = r + i * tda_r;
+      double * xi = x + i * tda_x;
+
+      if (i == 0)
+        {
+          for (s = 0; s < m; s++)
+            {
+              const double inv = 1.0 / di[s];
+
+              zero |= (di[s] == 0.0);
+              xi[s] = ri[s] * inv;
+              if (N > 1)
+                c[s] = a[s] * inv;
+            }
+        }
+      else
+        {
+          const double * bi = b + (i - 1) * tda_b;
+          const double * cp = c + (i - 1) * m;
+          const double * xp = x + (i - 1) * tda_x;
+
+          if (i < N - 1)
+            {
+              const double * ai = a + i * tda_a;
+              double * ci = c + i * m;
+
+              for (s = 0; s < m; s++)
+                {
+                  const double alpha = di[s] - bi[s] * cp[s];
+                  const double inv = 1.0 / alpha;
+
+                  zero |= (alpha == 0.0);
+                  ci[s] = ai[s] * inv;
+                  xi[s] = (ri[s] - bi[s] * xp[s]) * inv;
+                }
+            }
+          else
+            {
+              for (s = 0; s < m; s++)
+                {
+                  const double alpha = di[s] - bi[s] * cp[s];
+
+                  zero |= (alpha == 0.0);
+                  xi[s] = (ri[s] - bi[s] * xp[s]) / alpha;
+                }
+            }
+        }
+    }
+
+  /* back substitution */
+  for (i = N - 1; i > 0; i--)
+    {
+      const double * ci = c + (i - 1) * m;
+      const double * xn = x + i * tda_x;
+      double * xi = x + (i - 1) * tda_x;
+
+      for (s = 0; s < m; s++)
+        xi[s] -= ci[s] * xn[s];
+    }
+
+  return zero;
+}
+
+/*
+tridiag_par_spikes()
+  Eliminate the diagonal block of rows r0:r1 of a tridiagonal system,
+solving A_k [g v w] = [b_k, a(r1) e_last, b(r0-1) e_first]
+
+Inputs: r0        - first row of partition
+        r1        - last row of partition, r1 > r0
+        left      - partition is coupled to the rows above
+        right     - partition is coupled to the rows below
+        diag      - diagonal of A
+        abovediag - superdiagonal of A
+        belowdiag - subdiagonal of A
+        rhs       - right hand side b
+        x         - (output) g in rows r0:r1
+        c         - (output) multipliers in rows r0:r1-1
+        v         - (output) right spike in rows r0:r1
+        w         - (output) left spike in rows r0:r1
+
+Return: 1 if a zero pivot was found, 0 otherwise
+*/
+
+static int
+tridiag_par_spikes (const size_t r0, const size_t r1,
+                    const int left, const int right,
+                    const gsl_vector * diag, const gsl_vector * abovediag,
+                    const gsl_vector * belowdiag, const gsl_vector * rhs,
+                    gsl_vector * x, double * c, double * v, double * w)
+{
+  double alpha = gsl_vector_get (diag, r0);
+  double g = gsl_vector_get (rhs, r0) / alpha;
+  size_t i;
+
+  if (alpha == 0.0)
+    return 1;
+
+  c[r0] = gsl_vector_get (abovediag, r0) / alpha;
+  v[r0] = 0.0;
+  w[r0] = left ? gsl_vector_get (belowdiag, r0 - 1) / alpha : 0.0;
+  gsl_vector_set (x, r0, g);
+
+  for (i = r0 + 1; i <= r1; i++)
+    {
+      const double bi = gsl_vector_get (belowdiag, i - 1);
+
+      alpha = gsl_vector_get (diag, i) - bi * c[i - 1];
+      if (alpha == 0.0)
+        return 1;
+
+      if (i < r1)
+        c[i] = gsl_vector_get (abovediag, i) / alpha;
+
+      g = (gsl_vector_get (rhs, i) - bi * g) / alpha;
+      gsl_vector_set (x, i, g);
+      w[i] = -bi * w[i - 1] / alpha;
+      v[i] = 0.0;
+    }
+
+  if (right)
+    v[r1] = gsl_vector_get (abovediag, r1) / alpha;
+
+  for (i = r1; i > r0; i--)
+    {
+      double * xi = gsl_vector_ptr (x, i - 1);
+
+      *xi -= c[i - 1] * gsl_vector_get (x, i);
+      v[i - 1] = -c[i - 1] * v[i];
+      w[i - 1] -= c[i - 1] * w[i];
+    }
+
+  return 0;
+}
@@ -40,6 +40,18 @@
 
 __BEGIN_DECLS
 
+/* partition of a compressed sparse matrix for parallel products */
+typedef struct
+{
+  size_t size1;   /* number of rows of matrix */
+  size_t size2;   /* number of columns of matrix */
+  size_t nz;      /* number of nonzero elements of matrix */
+  int sptype;     /* storage format of matrix */
+  size_t nparts;  /* number of parts, one per thread */
+  size_t *part;   /* part k is rows (CSR) or columns (CSC) part[k] to part[k+1]-1 */
+  double *work;   /* nparts accumulation vectors of length max(size1,size2) */
+} gsl_spblas_plan;
+
 /*
  * Prototypes
  */
@@ -47,6 +59,12 @@ __BEGIN_DECLS
 int gsl_spblas_dgemv(const CBLAS_TRANSPOSE_t TransA, const double alpha,
                      const gsl_spmatrix *A, const gsl_vector *x,
                      const double beta, gsl_vector *y);
+gsl_spblas_plan *gsl_spblas_plan_alloc(const gsl_spmatrix *A);
+void gsl_spblas_plan_free(gsl_spblas_plan *plan);
+int gsl_spblas_dgemv_plan(const CBLAS_TRANSPOSE_t TransA, const double alpha,
+                          const gsl_spmatrix *A, const gsl_vector *x,
+                          const double beta, gsl_vector *y,
+                          gsl_spblas_plan *plan);
 int gsl_spblas_dgemm(const double alpha, const gsl_spmatrix *A,
                      const gsl_spmatrix *B, gsl_spmatrix *C);
 size_t gsl_spblas_scatter(const gsl_spmatrix *A, const size_t j,
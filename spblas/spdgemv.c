@@ -22,12 +22,43 @@
 #include <math.h>
 
 #include <gsl/gsl_math.h>
+#include <gsl/gsl_sys.h>
 #include <gsl/gsl_vector.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_spmatrix.h>
 #include <gsl/gsl_spblas.h>
 #include <gsl/gsl_blas.h>
 
+/*
+ * The products with compressed matrices are done in parallel by
+ * splitting the rows (CSR) or columns (CSC) into contiguous parts of
+ * about the same cost, counting one unit per nonzero element and one
+ * per row or column. When each row of op(A) is stored contiguously
+ * (CSR and no transpose, CSC and transpose) the parts compute disjoint
+ * elements of y. Otherwise each part accumulates its contribution in
+ * a private vector, and the vectors are summed afterwards.
+ */
+
+/* minimum number of nonzero elements per thread in gsl_spblas_dgemv */
+#define SPDGEMV_PAR_MIN_NZ  16384
+
+/* rows of a SELL slice accumulated together, a multiple of the SIMD width */
+#define SPDGEMV_SELL_CHUNK  8
+
+static size_t spdgemv_split (const int * Ap, const size_t n,
+                             const size_t nparts, const size_t k);
+static void spdgemv_gather (const size_t start, const size_t end,
+                            const double alpha, const int * Ap,
+                            const int * Ai, const double * Ad,
+                            const double * X, const size_t incX,
+                            const double beta, double * Y, const size_t incY);
+static void spdgemv_bsr (const CBLAS_TRANSPOSE_t TransA, const double alpha,
+                         const gsl_spmatrix * A, const double * X,
+                         const size_t incX, double * Y, const size_t incY);
+static void spdgemv_sell (const CBLAS_TRANSPOSE_t TransA, const double alpha,
+                          const gsl_spmatrix * A, const double * X,
+                          const size_t incX, double * Y, const size_t incY);
+
 /*
 gsl_spblas_dgemv()
   Multiply a sparse matrix and a vector
@@ -129,13 +160,31 @@ gsl_spblas_dgemv(const CBLAS_TRANSPOSE_t TransA, const double alpha,
       else if ((GSL_SPMATRIX_ISCCS(A) && (TransA == CblasTrans)) ||
                (GSL_SPMATRIX_ISCRS(A) && (TransA == CblasNoTrans)))
         {
+          const int nthreads = (int) GSL_MIN ((size_t) gsl_get_num_threads (),
+                                              A->nz / SPDGEMV_PAR_MIN_NZ);
+
           Ai = A->i;
 
-          for (j = 0; j < lenY; ++j)
+          if (nthreads > 1)
             {
-              for (p = Ap[j]; p < Ap[j + 1]; ++p)
+              int k;
+
+#pragma omp parallel for num_threads(nthreads) schedule(static)
+              for (k = 0; k < nthreads; ++k)
+                {
+                  spdgemv_gather (spdgemv_split (Ap, lenY, nthreads, k),
+                                  spdgemv_split (Ap, lenY, nthreads, k + 1),
+                                  alpha, Ap, Ai, Ad, X, incX, 1.0, Y, incY);
+                }
+            }
+          else
+            {
+              for (j = 0; j < lenY; ++j)
                 {
-                  Y[j * incY] += alpha * Ad[p] * X[Ai[p] * incX];
+                  for (p = Ap[j]; p < Ap[j + 1]; ++p)
+                    {
+                      Y[j * incY] += alpha * Ad[p] * X[Ai[p] * incX];
+                    }
                 }
             }
         }
@@ -157,6 +206,14 @@ gsl_spblas_dgemv(const CBLAS_TRANSPOSE_t TransA, const double alpha,
               Y[Ai[p] * incY] += alpha * Ad[p] * X[Aj[p] * incX];
             }
         }
+      else if (GSL_SPMATRIX_ISBSR(A))
+        {
+          spdgemv_bsr(TransA, alpha, A, X, incX, Y, incY);
+        }
+      else if (GSL_SPMATRIX_ISSELL(A))
+        {
+          spdgemv_sell(TransA, alpha, A, X, incX, Y, incY);
+        }
       else
         {
           GSL_ERROR("unsupported matrix type", GSL_EINVAL);
@@ -165,3 +222,415 @@ gsl_spblas_dgemv(const CBLAS_TRANSPOSE_t TransA, const double alpha,
       return GSL_SUCCESS;
     }
 } /* gsl_spblas_dgemv() */
+
+/*
+gsl_spblas_plan_alloc()
+  Compute a partition of a compressed sparse matrix for parallel
+matrix-vector products
+
+Inputs: A - sparse matrix in CSR or CSC format
+
+Return: pointer to plan, or NULL on error
+
+Notes:
+1) the number of parts is the number of threads given by
+gsl_get_num_threads at the time of the call
+2) the plan depends only on the dimensions and the row or column
+pointers of A, and remains valid while the sparsity pattern of A is
+unchanged
+3) the private accumulation vectors of the products with op(A) not
+stored by rows are allocated here, nparts * max(M,N) elements
+*/
+
+gsl_spblas_plan *
+gsl_spblas_plan_alloc (const gsl_spmatrix * A)
+{
+  if (!GSL_SPMATRIX_ISCSR (A) && !GSL_SPMATRIX_ISCSC (A))
+    {
+      GSL_ERROR_NULL ("compressed format required", GSL_EINVAL);
+    }
+  else
+    {
+      const size_t n = GSL_SPMATRIX_ISCSR (A) ? A->size1 : A->size2;
+      gsl_spblas_plan *plan;
+      size_t k;
+
+      plan = calloc (1, sizeof (gsl_spblas_plan));
+      if (plan == NULL)
+        {
+          GSL_ERROR_NULL ("failed to allocate space for plan struct",
+                          GSL_ENOMEM);
+        }
+
+      plan->size1 = A->size1;
+      plan->size2 = A->size2;
+      plan->nz = A->nz;
+      plan->sptype = A->sptype;
+      plan->nparts = GSL_MAX (GSL_MIN ((size_t) gsl_get_num_threads (), n), 1);
+
+      plan->part = malloc ((plan->nparts + 1) * sizeof (size_t));
+      if (plan->part == NULL)
+        {
+          gsl_spblas_plan_free (plan);
+          GSL_ERROR_NULL ("failed to allocate space for partition", GSL_ENOMEM);
+        }
+
+      plan->work = malloc (plan->nparts * GSL_MAX (A->size1, A->size2) * sizeof (double));
+      if (plan->work == NULL)
+        {
+          gsl_spblas_plan_free (plan);
+          GSL_ERROR_NULL ("failed to allocate space for work", GSL_ENOMEM);
+        }
+
+      for (k = 0; k <= plan->nparts; ++k)
+        plan->part[k] = spdgemv_split (A->p, n, plan->nparts, k);
+
+      return plan;
+    }
+} /* gsl_spblas_plan_alloc() */
+
+void
+gsl_spblas_plan_free (gsl_spblas_plan * plan)
+{
+  RETURN_IF_NULL (plan);
+
+  if (plan->part)
+    free (plan->part);
+
+  if (plan->work)
+    free (plan->work);
+
+  free (plan);
+}
+
+/*
+gsl_spblas_dgemv_plan()
+  Multiply a sparse matrix and a vector in parallel, with the
+partition of a plan
+
+Inputs: alpha - scalar factor
+        A     - sparse matrix in CSR or CSC format
+        x     - dense vector
+        beta  - scalar factor
+        y     - (input/output) dense vector
+        plan  - plan computed for A by gsl_spblas_plan_alloc
+
+Return: y = alpha*op(A)*x + beta*y
+
+Notes:
+1) products with op(A) not stored by rows accumulate in the work
+vectors of the plan, so they must not run concurrently with the same
+plan
+*/
+
+int
+gsl_spblas_dgemv_plan (const CBLAS_TRANSPOSE_t TransA, const double alpha,
+                       const gsl_spmatrix * A, const gsl_vector * x,
+                       const double beta, gsl_vector * y,
+                       gsl_spblas_plan * plan)
+{
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+
+  if ((TransA == CblasNoTrans && N != x->size) ||
+      (TransA == CblasTrans && M != x->size))
+    {
+      GSL_ERROR("invalid length of x vector", GSL_EBADLEN);
+    }
+  else if ((TransA == CblasNoTrans && M != y->size) ||
+           (TransA == CblasTrans && N != y->size))
+    {
+      GSL_ERROR("invalid length of y vector", GSL_EBADLEN);
+    }
+  else if (plan->size1 != M || plan->size2 != N ||
+           plan->nz != A->nz || plan->sptype != A->sptype)
+    {
+      GSL_ERROR("plan does not match matrix", GSL_EINVAL);
+    }
+  else
+    {
+      const int nparts = (int) plan->nparts;
+      const size_t *part = plan->part;
+      const int *Ap = A->p;
+      const int *Ai = A->i;
+      const double *Ad = A->data;
+      const double *X = x->data;
+      const size_t incX = x->stride;
+      double *Y = y->data;
+      const size_t incY = y->stride;
+      int k;
+
+      if ((GSL_SPMATRIX_ISCSR(A) && TransA == CblasNoTrans) ||
+          (GSL_SPMATRIX_ISCSC(A) && TransA == CblasTrans))
+        {
+          /* part k computes elements part[k] to part[k+1]-1 of y */
+#pragma omp parallel for num_threads(nparts) schedule(static)
+          for (k = 0; k < nparts; ++k)
+            {
+              spdgemv_gather (part[k], part[k + 1], alpha, Ap, Ai, Ad,
+                              X, incX, beta, Y, incY);
+            }
+        }
+      else
+        {
+          const size_t lenY = y->size;
+          double *work = plan->work;
+
+          /* part k accumulates op(A) x over its rows or columns of A */
+#pragma omp parallel for num_threads(nparts) schedule(static)
+          for (k = 0; k < nparts; ++k)
+            {
+              double *w = work + k * lenY;
+              size_t i, j;
+              int p;
+
+              for (i = 0; i < lenY; ++i)
+                w[i] = 0.0;
+
+              for (j = part[k]; j < part[k + 1]; ++j)
+                {
+                  const double xj = X[j * incX];
+
+                  for (p = Ap[j]; p < Ap[j + 1]; ++p)
+                    w[Ai[p]] += Ad[p] * xj;
+                }
+            }
+
+          /* y := alpha*sum(w) + beta*y, in slices of y */
+#pragma omp parallel for num_threads(nparts) schedule(static)
+          for (k = 0; k < nparts; ++k)
+            {
+              const size_t start = (k * lenY) / nparts;
+              const size_t end = ((k + 1) * lenY) / nparts;
+              size_t i;
+              int l;
+
+              for (i = start; i < end; ++i)
+                {
+                  double sum = 0.0;
+
+                  for (l = 0; l < nparts; ++l)
+                    sum += work[l * lenY + i];
+
+                  if (beta == 0.0)
+                    Y[i * incY] = alpha * sum;
+                  else
+                    Y[i * incY] = alpha * sum + beta * Y[i * incY];
+                }
+            }
+        }
+
+      return GSL_SUCCESS;
+    }
+} /* gsl_spblas_dgemv_plan() */
+
+/* first row (CSR) or column (CSC) of part k when the n rows or columns
+   with pointers Ap are split into nparts parts of equal cost, with the
+   cost of rows 0 to j-1 taken as Ap[j] + j */
+
+static size_t
+spdgemv_split (const int * Ap, const size_t n, const size_t nparts,
+               const size_t k)
+{
+  const double target = (double) k * ((double) Ap[n] + (double) n) / (double) nparts;
+  size_t lo = 0, hi = n;
+
+  if (k >= nparts)
+    return n;
+
+  /* smallest j with Ap[j] + j >= target */
+  while (lo < hi)
+    {
+      const size_t mid = lo + (hi - lo) / 2;
+
+      if ((double) Ap[mid] + (double) mid < target)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+
+  return lo;
+}
+
+/* y_j := alpha * (A x)_j + beta * y_j for rows start to end-1 of a
+   matrix with contiguous rows */
+
+static void
+spdgemv_gather (const size_t start, const size_t end, const double alpha,
+                const int * Ap, const int * Ai, const double * Ad,
+                const double * X, const size_t incX, const double beta,
+                double * Y, const size_t incY)
+{
+  size_t j;
+  int p;
+
+  for (j = start; j < end; ++j)
+    {
+      double sum = 0.0;
+
+      for (p = Ap[j]; p < Ap[j + 1]; ++p)
+        sum += Ad[p] * X[Ai[p] * incX];
+
+      if (beta == 0.0)
+        Y[j * incY] = alpha * sum;
+      else
+        Y[j * incY] = alpha * sum + beta * Y[j * incY];
+    }
+}
+
+/* y := alpha*op(A)*x + y for A in BSR format; without transpose the
+   block rows are distributed over the threads */
+
+static void
+spdgemv_bsr (const CBLAS_TRANSPOSE_t TransA, const double alpha,
+             const gsl_spmatrix * A, const double * X, const size_t incX,
+             double * Y, const size_t incY)
+{
+  const size_t b = A->bsize;
+  const size_t M = A->size1;
+  const size_t N = A->size2;
+  const int nbrows = (int) ((M + b - 1) / b);
+  const int *Ap = A->p;
+  const int *Aj = A->i;
+  const double *Ad = A->data;
+  int I;
+
+  if (TransA == CblasNoTrans)
+    {
+      const int nthreads = (int) GSL_MAX (GSL_MIN ((size_t) gsl_get_num_threads (),
+                                                   A->nz / SPDGEMV_PAR_MIN_NZ), 1);
+
+#pragma omp parallel for num_threads(nthreads) schedule(static)
+      for (I = 0; I < nbrows; ++I)
+        {
+          const size_t nr = GSL_MIN (b, M - I * b);
+          size_t r, c;
+          int k;
+
+          for (r = 0; r < nr; ++r)
+            {
+              double sum = 0.0;
+
+              for (k = Ap[I]; k < Ap[I + 1]; ++k)
+                {
+                  const double *block = Ad + k * b * b + r * b;
+                  const double *Xj = X + Aj[k] * b * incX;
+                  const size_t nc = GSL_MIN (b, N - Aj[k] * b);
+
+                  for (c = 0; c < nc; ++c)
+                    sum += block[c] * Xj[c * incX];
+                }
+
+              Y[(I * b + r) * incY] += alpha * sum;
+            }
+        }
+    }
+  else
+    {
+      for (I = 0; I < nbrows; ++I)
+        {
+          const size_t nr = GSL_MIN (b, M - I * b);
+          size_t r, c;
+          int k;
+
+          for (k = Ap[I]; k < Ap[I + 1]; ++k)
+            {
+              const double *block = Ad + k * b * b;
+              double *Yj = Y + Aj[k] * b * incY;
+              const size_t nc = GSL_MIN (b, N - Aj[k] * b);
+
+              for (r = 0; r < nr; ++r)
+                {
+                  const double xr = alpha * X[(I * b + r) * incX];
+
+                  for (c = 0; c < nc; ++c)
+                    Yj[c * incY] += block[r * b + c] * xr;
+                }
+            }
+        }
+    }
+}
+
+/* y := alpha*op(A)*x + y for A in SELL format; without transpose the
+   rows of a slice are accumulated in chunks of SPDGEMV_SELL_CHUNK,
+   whose inner loops over the rows are unit stride and of fixed length
+   for the compiler to vectorize, and the slices are distributed over
+   the threads */
+
+static void
+spdgemv_sell (const CBLAS_TRANSPOSE_t TransA, const double alpha,
+              const gsl_spmatrix * A, const double * X, const size_t incX,
+              double * Y, const size_t incY)
+{
+  const size_t C = A->bsize;
+  const int nslices = (int) ((A->size1 + C - 1) / C);
+  const int *Ap = A->p;
+  const int *Aj = A->i;
+  const int *perm = A->perm;
+  const double *Ad = A->data;
+  int s;
+
+  if (TransA == CblasNoTrans)
+    {
+      const int nthreads = (int) GSL_MAX (GSL_MIN ((size_t) gsl_get_num_threads (),
+                                                   A->nz / SPDGEMV_PAR_MIN_NZ), 1);
+
+#pragma omp parallel for num_threads(nthreads) schedule(static)
+      for (s = 0; s < nslices; ++s)
+        {
+          const size_t width = (Ap[s + 1] - Ap[s]) / C;
+          size_t r0, r, k;
+
+          for (r0 = 0; r0 < C; r0 += SPDGEMV_SELL_CHUNK)
+            {
+              double sum[SPDGEMV_SELL_CHUNK] = { 0.0 };
+
+              if (r0 + SPDGEMV_SELL_CHUNK <= C)
+                {
+                  for (k = 0; k < width; ++k)
+                    {
+                      const size_t q = Ap[s] + k * C + r0;
+
+                      for (r = 0; r < SPDGEMV_SELL_CHUNK; ++r)
+                        sum[r] += Ad[q + r] * X[Aj[q + r] * incX];
+                    }
+                }
+              else
+                {
+                  const size_t nr = C - r0;
+
+                  for (k = 0; k < width; ++k)
+                    {
+                      const size_t q = Ap[s] + k * C + r0;
+
+                      for (r = 0; r < nr; ++r)
+                        sum[r] += Ad[q + r] * X[Aj[q + r] * incX];
+                    }
+                }
+
+              for (r = 0; r < SPDGEMV_SELL_CHUNK && r0 + r < C; ++r)
+                {
+                  const int row = perm[s * C + r0 + r];
+
+                  if (row >= 0)
+                    Y[row * incY] += alpha * sum[r];
+                }
+            }
+        }
+    }
+  else
+    {
+      for (s = 0; s < nslices; ++s)
+        {
+          int q;
+
+          for (q = Ap[s]; q < Ap[s + 1]; ++q)
+            {
+              const int row = perm[s * C + (q - Ap[s]) % C];
+
+              if (row >= 0)
+                Y[Aj[q] * incY] += alpha * Ad[q] * X[row * incX];
+            }
+        }
+    }
+}
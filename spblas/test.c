@@ -18,10 +18,12 @@
  */
 
 #include <config.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
 
 #include <gsl/gsl_math.h>
+#include <gsl/gsl_sys.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_randist.h>
 #include <gsl/gsl_rng.h>
@@ -166,6 +168,23 @@ test_dgemv(const size_t N, const size_t M, const double alpha,
   /* test y_sp = y_gsl */
   test_vectors(y_sp, y_gsl, 1.0e-10, "test_dgemv: CRS format");
 
+  /* compute y = alpha*op(A)*x + beta*y0 with spblas/BSR and SELL */
+  {
+    const size_t bsize = 1 + (M + N) % 4;
+    gsl_spmatrix *S = gsl_spmatrix_bsr(C, bsize);
+
+    gsl_vector_memcpy(y_sp, y);
+    gsl_spblas_dgemv(TransA, alpha, S, x, beta, y_sp);
+    test_vectors(y_sp, y_gsl, 1.0e-10, "test_dgemv: BSR format");
+    gsl_spmatrix_free(S);
+
+    S = gsl_spmatrix_sell(C, 1 + (M * N) % 13, 1 + (M + N) % 20);
+    gsl_vector_memcpy(y_sp, y);
+    gsl_spblas_dgemv(TransA, alpha, S, x, beta, y_sp);
+    test_vectors(y_sp, y_gsl, 1.0e-10, "test_dgemv: SELL format");
+    gsl_spmatrix_free(S);
+  }
+
   gsl_spmatrix_free(A);
   gsl_spmatrix_free(B);
   gsl_spmatrix_free(C);
@@ -176,6 +195,188 @@ test_dgemv(const size_t N, const size_t M, const double alpha,
   gsl_vector_free(y_sp);
 } /* test_dgemv() */
 
+/* compare gsl_spblas_dgemv_plan with the dense product, for both
+   compressed formats and both transposes, with the plan reused */
+static void
+test_dgemv_plan(const gsl_spmatrix *T, const int nthreads, const char *desc,
+                const gsl_rng *r)
+{
+  const int nthreads_orig = gsl_get_num_threads();
+  const size_t M = T->size1;
+  const size_t N = T->size2;
+  const double alpha = 1.3, beta = -0.7;
+  gsl_matrix *A_dense = gsl_matrix_alloc(M, N);
+  size_t fmt, t, k;
+
+  gsl_spmatrix_sp2d(A_dense, T);
+  gsl_set_num_threads(nthreads);
+
+  for (fmt = 0; fmt < 2; ++fmt)
+    {
+      gsl_spmatrix *A = (fmt == 0) ? gsl_spmatrix_crs(T) : gsl_spmatrix_ccs(T);
+      gsl_spblas_plan *plan = gsl_spblas_plan_alloc(A);
+
+      for (t = 0; t < 2; ++t)
+        {
+          const CBLAS_TRANSPOSE_t TransA = (t == 0) ? CblasNoTrans : CblasTrans;
+          const size_t lenX = (t == 0) ? N : M;
+          const size_t lenY = (t == 0) ? M : N;
+          gsl_vector *x = gsl_vector_alloc(lenX);
+          gsl_vector *y = gsl_vector_alloc(lenY);
+          gsl_vector *y_gsl = gsl_vector_alloc(lenY);
+          gsl_vector *y_sp = gsl_vector_alloc(lenY);
+          char str[128];
+
+          sprintf(str, "test_dgemv_plan: %s %s trans=%zu threads=%d",
+                  desc, (fmt == 0) ? "CSR" : "CSC", t, nthreads);
+
+          for (k = 0; k < 2; ++k)
+            {
+              const double b = (k == 0) ? 0.0 : beta;
+
+              create_random_vector(x, r);
+              create_random_vector(y, r);
+
+              gsl_vector_memcpy(y_gsl, y);
+              gsl_blas_dgemv(TransA, alpha, A_dense, x, b, y_gsl);
+
+              gsl_vector_memcpy(y_sp, y);
+              gsl_spblas_dgemv_plan(TransA, alpha, A, x, b, y_sp, plan);
+              test_vectors(y_sp, y_gsl, 1.0e-10, str);
+
+              /* parallel gsl_spblas_dgemv */
+              gsl_vector_memcpy(y_sp, y);
+              gsl_spblas_dgemv(TransA, alpha, A, x, b, y_sp);
+              test_vectors(y_sp, y_gsl, 1.0e-10, str);
+            }
+
+          gsl_vector_free(x);
+          gsl_vector_free(y);
+          gsl_vector_free(y_gsl);
+          gsl_vector_free(y_sp);
+        }
+
+      /* the parts cover all rows or columns in order */
+      {
+        const size_t n = (fmt == 0) ? M : N;
+        int status = (plan->part[0] != 0 || plan->part[plan->nparts] != n);
+
+        for (k = 0; k < plan->nparts; ++k)
+          status |= (plan->part[k] > plan->part[k + 1]);
+
+        gsl_test(status, "test_dgemv_plan: %s partition", desc);
+      }
+
+      gsl_spblas_plan_free(plan);
+      gsl_spmatrix_free(A);
+    }
+
+  /* parallel gsl_spblas_dgemv with BSR and SELL formats */
+  {
+    gsl_spmatrix *A = gsl_spmatrix_crs(T);
+    gsl_spmatrix *S[2];
+
+    S[0] = gsl_spmatrix_bsr(A, 3);
+    S[1] = gsl_spmatrix_sell(A, 16, 128);
+
+    for (fmt = 0; fmt < 2; ++fmt)
+      {
+        for (t = 0; t < 2; ++t)
+          {
+            const CBLAS_TRANSPOSE_t TransA = (t == 0) ? CblasNoTrans : CblasTrans;
+            const size_t lenX = (t == 0) ? N : M;
+            const size_t lenY = (t == 0) ? M : N;
+            gsl_vector *x = gsl_vector_alloc(lenX);
+            gsl_vector *y = gsl_vector_alloc(lenY);
+            gsl_vector *y_gsl = gsl_vector_alloc(lenY);
+            char str[128];
+
+            sprintf(str, "test_dgemv_par: %s %s trans=%zu threads=%d",
+                    desc, gsl_spmatrix_type(S[fmt]), t, nthreads);
+
+            create_random_vector(x, r);
+            create_random_vector(y, r);
+
+            gsl_vector_memcpy(y_gsl, y);
+            gsl_blas_dgemv(TransA, alpha, A_dense, x, beta, y_gsl);
+
+            gsl_spblas_dgemv(TransA, alpha, S[fmt], x, beta, y);
+            test_vectors(y, y_gsl, 1.0e-10, str);
+
+            gsl_vector_free(x);
+            gsl_vector_free(y);
+            gsl_vector_free(y_gsl);
+          }
+
+        /* a zeroed matrix must not reach its old blocks */
+        {
+          gsl_vector *x = gsl_vector_alloc(N);
+          gsl_vector *y = gsl_vector_alloc(M);
+          gsl_vector *y0 = gsl_vector_alloc(M);
+          char str[128];
+
+          sprintf(str, "test_dgemv_par: %s %s set_zero", desc,
+                  gsl_spmatrix_type(S[fmt]));
+
+          create_random_vector(x, r);
+          create_random_vector(y, r);
+          gsl_vector_memcpy(y0, y);
+
+          gsl_spmatrix_set_zero(S[fmt]);
+          gsl_spblas_dgemv(CblasNoTrans, 1.0, S[fmt], x, 1.0, y);
+          test_vectors(y, y0, 0.0, str);
+
+          gsl_vector_free(x);
+          gsl_vector_free(y);
+          gsl_vector_free(y0);
+        }
+
+        gsl_spmatrix_free(S[fmt]);
+      }
+
+    gsl_spmatrix_free(A);
+  }
+
+  gsl_set_num_threads(nthreads_orig);
+  gsl_matrix_free(A_dense);
+} /* test_dgemv_plan() */
+
+static void
+test_dgemv_par(const gsl_rng *r)
+{
+  const int nthreads[] = { 1, 2, 3, 7 };
+  size_t i, k;
+
+  for (k = 0; k < sizeof(nthreads) / sizeof(nthreads[0]); ++k)
+    {
+      gsl_spmatrix *T;
+
+      T = create_random_sparse(50, 37, 0.2, r);
+      test_dgemv_plan(T, nthreads[k], "random", r);
+      gsl_spmatrix_free(T);
+
+      T = create_random_sparse(3, 60, 0.5, r);
+      test_dgemv_plan(T, nthreads[k], "wide", r);
+      gsl_spmatrix_free(T);
+
+      /* one dense row and column among nearly empty ones */
+      T = gsl_spmatrix_alloc(80, 80);
+      for (i = 0; i < 80; ++i)
+        {
+          gsl_spmatrix_set(T, 5, i, 1.0 + i);
+          gsl_spmatrix_set(T, i, 70, 2.0 - i);
+        }
+      gsl_spmatrix_set(T, 79, 0, 3.0);
+      test_dgemv_plan(T, nthreads[k], "skewed", r);
+      gsl_spmatrix_free(T);
+
+      /* large enough for gsl_spblas_dgemv to split the rows */
+      T = create_random_sparse(600, 500, 0.3, r);
+      test_dgemv_plan(T, nthreads[k], "large", r);
+      gsl_spmatrix_free(T);
+    }
+} /* test_dgemv_par() */
+
 static void
 test_dgemm(const double alpha, const size_t M, const size_t N,
            const gsl_rng *r)
@@ -251,6 +452,8 @@ main()
         }
     }
 
+  test_dgemv_par(r);
+
   test_dgemm(1.0, 10, 10, r);
   test_dgemm(2.3, 20, 15, r);
   test_dgemm(1.8, 12, 30, r);
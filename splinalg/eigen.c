@@ -0,0 +1,984 @@
+/* splinalg/eigen.c
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
+#include <gsl/gsl_complex.h>
+#include <gsl/gsl_complex_math.h>
+#include <gsl/gsl_vector.h>
+#include <gsl/gsl_matrix.h>
+#include <gsl/gsl_errno.h>
+#include <gsl/gsl_blas.h>
+#include <gsl/gsl_eigen.h>
+#include <gsl/gsl_spmatrix.h>
+#include <gsl/gsl_spblas.h>
+#include <gsl/gsl_splinalg.h>
+
+/*
+ * This module computes a few eigenvalues and eigenvectors of a large
+ * sparse matrix A, which is accessed only through products A x, or
+ * solves (A - sigma I) y = x in shift-invert mode.
+ *
+ * An orthonormal basis V_m of the Krylov subspace of dimension m = ncv
+ * is built with the Arnoldi process, with full reorthogonalization,
+ *
+ * op V_m = V_m H_m + f e_m^T
+ *
+ * and the eigenvalues of the small matrix H_m (Ritz values) approximate
+ * those of op. For symmetric A this is the Lanczos process, and H_m is
+ * symmetric tridiagonal up to rounding. The subspace is restarted by
+ * keeping the Ritz vectors of the wanted eigenvalues, which gives the
+ * same subspace as implicit restarting with exact shifts, in the form of
+ * the Krylov-Schur method and of thick restart Lanczos:
+ *
+ * [1] G. W. Stewart, A Krylov-Schur algorithm for large eigenproblems,
+ *     SIAM J. Matrix Anal. Appl. 23(3), 2001.
+ *
+ * [2] K. Wu and H. Simon, Thick-restart Lanczos method for large
+ *     symmetric eigenvalue problems, SIAM J. Matrix Anal. Appl. 22(2),
+ *     2000.
+ *
+ * [3] R. B. Lehoucq, D. C. Sorensen and C. Yang, ARPACK Users' Guide,
+ *     SIAM, 1998.
+ *
+ * The basis vectors are stored in the rows of V, so that each is
+ * contiguous in memory.
+ */
+
+static int eigen_iterate (const int symm, gsl_splinalg_eigen_op * op,
+                          const gsl_splinalg_eigen_t which, const double sigma,
+                          gsl_splinalg_eigen_workspace * w);
+static int eigen_apply (gsl_splinalg_eigen_op * op, const gsl_splinalg_eigen_t which,
+                        const double sigma, const gsl_vector * x, gsl_vector * y);
+static size_t eigen_expand (gsl_splinalg_eigen_op * op,
+                            const gsl_splinalg_eigen_t which, const double sigma,
+                            const size_t k, gsl_splinalg_eigen_workspace * w, int * status);
+static int eigen_ritz (const int symm, const gsl_splinalg_eigen_t which,
+                       gsl_splinalg_eigen_workspace * w);
+static size_t eigen_restart (const int symm, gsl_splinalg_eigen_workspace * w);
+static void eigen_random_vector (gsl_vector * v, gsl_splinalg_eigen_workspace * w);
+static int eigen_orthonormalize (gsl_matrix * Y);
+
+/*
+gsl_splinalg_eigen_alloc()
+  Allocate a workspace for computing nev eigenvalues of an n-by-n matrix
+
+Inputs: n   - size of matrix
+        nev - number of eigenvalues wanted
+        ncv - dimension of the Krylov subspace, nev < ncv <= n; if 0,
+              min(n, max(2 nev + 1, 20)) is used
+
+Return: pointer to workspace
+*/
+
+gsl_splinalg_eigen_workspace *
+gsl_splinalg_eigen_alloc (const size_t n, const size_t nev, const size_t ncv)
+{
+  gsl_splinalg_eigen_workspace *w;
+  size_t m;
+
+  if (n == 0)
+    {
+      GSL_ERROR_NULL ("matrix dimension n must be a positive integer", GSL_EINVAL);
+    }
+  else if (nev == 0 || nev >= n)
+    {
+      GSL_ERROR_NULL ("number of eigenvalues must satisfy 0 < nev < n", GSL_EINVAL);
+    }
+
+  m = (ncv == 0) ? GSL_MIN (n, GSL_MAX (2 * nev + 1, 20)) : ncv;
+
+  if (m <= nev || m > n)
+    {
+      GSL_ERROR_NULL ("subspace dimension must satisfy nev < ncv <= n", GSL_EINVAL);
+    }
+
+  w = calloc (1, sizeof (gsl_splinalg_eigen_workspace));
+  if (w == NULL)
+    {
+      GSL_ERROR_NULL ("failed to allocate space for eigen workspace", GSL_ENOMEM);
+    }
+
+  w->n = n;
+  w->nev = nev;
+  w->ncv = m;
+
+  w->V = gsl_matrix_alloc (m + 1, n);
+  w->W = gsl_matrix_alloc (m, n);
+  w->H = gsl_matrix_alloc (m + 1, m);
+  w->Hwork = gsl_matrix_alloc (m, m);
+  w->S = gsl_matrix_alloc (m, m);
+  w->Y = gsl_matrix_alloc (m, m);
+  w->Z = gsl_matrix_alloc (m, m);
+  w->h = gsl_vector_alloc (m + 1);
+  w->c = gsl_vector_alloc (m + 1);
+  w->work = gsl_vector_alloc (n);
+  w->theta = gsl_vector_complex_alloc (m);
+  w->cS = gsl_matrix_complex_alloc (m, m);
+  w->resid = gsl_vector_alloc (m);
+  w->order = malloc (m * sizeof (size_t));
+  w->symm_p = gsl_eigen_symmv_alloc (m);
+  w->nonsymm_p = gsl_eigen_nonsymmv_alloc (m);
+
+  if (w->V == NULL || w->W == NULL || w->H == NULL || w->Hwork == NULL ||
+      w->S == NULL || w->Y == NULL || w->Z == NULL || w->h == NULL ||
+      w->c == NULL || w->work == NULL || w->theta == NULL || w->cS == NULL ||
+      w->resid == NULL || w->order == NULL || w->symm_p == NULL ||
+      w->nonsymm_p == NULL)
+    {
+      gsl_splinalg_eigen_free (w);
+      GSL_ERROR_NULL ("failed to allocate space for eigen workspace", GSL_ENOMEM);
+    }
+
+  w->tol = GSL_DBL_EPSILON;
+  w->maxiter = 300;
+  w->nconv = 0;
+  w->niter = 0;
+
+  return w;
+}
+
+void
+gsl_splinalg_eigen_free (gsl_splinalg_eigen_workspace * w)
+{
+  RETURN_IF_NULL (w);
+
+  if (w->V)
+    gsl_matrix_free (w->V);
+
+  if (w->W)
+    gsl_matrix_free (w->W);
+
+  if (w->H)
+    gsl_matrix_free (w->H);
+
+  if (w->Hwork)
+    gsl_matrix_free (w->Hwork);
+
+  if (w->S)
+    gsl_matrix_free (w->S);
+
+  if (w->Y)
+    gsl_matrix_free (w->Y);
+
+  if (w->Z)
+    gsl_matrix_free (w->Z);
+
+  if (w->h)
+    gsl_vector_free (w->h);
+
+  if (w->c)
+    gsl_vector_free (w->c);
+
+  if (w->work)
+    gsl_vector_free (w->work);
+
+  if (w->theta)
+    gsl_vector_complex_free (w->theta);
+
+  if (w->cS)
+    gsl_matrix_complex_free (w->cS);
+
+  if (w->resid)
+    gsl_vector_free (w->resid);
+
+  if (w->order)
+    free (w->order);
+
+  if (w->symm_p)
+    gsl_eigen_symmv_free (w->symm_p);
+
+  if (w->nonsymm_p)
+    gsl_eigen_nonsymmv_free (w->nonsymm_p);
+
+  free (w);
+}
+
+/*
+gsl_splinalg_eigen_params()
+  Set the convergence parameters
+
+Inputs: tol     - relative accuracy of the Ritz values; a Ritz pair
+                  (theta, x) of op is accepted once
+                  || op x - theta x || <= tol * ||op||
+        maxiter - maximum number of restarts
+        w       - workspace
+*/
+
+int
+gsl_splinalg_eigen_params (const double tol, const size_t maxiter,
+                           gsl_splinalg_eigen_workspace * w)
+{
+  if (tol <= 0.0)
+    {
+      GSL_ERROR ("tolerance must be positive", GSL_EINVAL);
+    }
+  else
+    {
+      w->tol = GSL_MAX (tol, GSL_DBL_EPSILON);
+      w->maxiter = maxiter;
+      return GSL_SUCCESS;
+    }
+}
+
+/*
+gsl_splinalg_eigen_symm()
+  Compute nev eigenvalues and eigenvectors of a symmetric matrix with
+the restarted Lanczos method
+
+Inputs: op    - operator, providing y = A x, and y = (A - sigma I)^{-1} x
+                if which = GSL_SPLINALG_EIGEN_NEAREST
+        which - eigenvalues wanted: largest, smallest, or nearest to sigma
+        sigma - shift for GSL_SPLINALG_EIGEN_NEAREST
+        eval  - (output) eigenvalues, length nev, in order of preference
+        evec  - (output) eigenvectors, n-by-nev, or NULL
+        w     - workspace
+
+Return: GSL_SUCCESS if all nev eigenpairs converged, GSL_EMAXITER if
+they did not within maxiter restarts, in which case w->nconv gives the
+number which did, or an error code returned by op
+*/
+
+int
+gsl_splinalg_eigen_symm (gsl_splinalg_eigen_op * op, const gsl_splinalg_eigen_t which,
+                         const double sigma, gsl_vector * eval, gsl_matrix * evec,
+                         gsl_splinalg_eigen_workspace * w)
+{
+  if (eval->size != w->nev)
+    {
+      GSL_ERROR ("eval vector must have length nev", GSL_EBADLEN);
+    }
+  else if (evec != NULL && (evec->size1 != w->n || evec->size2 != w->nev))
+    {
+      GSL_ERROR ("evec matrix must be n-by-nev", GSL_EBADLEN);
+    }
+  else if (which == GSL_SPLINALG_EIGEN_NEAREST && op->solve == NULL)
+    {
+      GSL_ERROR ("shift-invert mode requires a solve function", GSL_EINVAL);
+    }
+  else
+    {
+      const size_t m = w->ncv;
+      int status = eigen_iterate (1, op, which, sigma, w);
+      size_t i;
+
+      if (status != GSL_SUCCESS && status != GSL_EMAXITER)
+        return status;
+
+      for (i = 0; i < w->nev; ++i)
+        {
+          const size_t idx = w->order[i];
+          const double theta = GSL_REAL (gsl_vector_complex_get (w->theta, idx));
+
+          gsl_vector_set (eval, i, (which == GSL_SPLINALG_EIGEN_NEAREST) ? sigma + 1.0 / theta : theta);
+
+          if (evec != NULL)
+            {
+              gsl_matrix_const_view Vm = gsl_matrix_const_submatrix (w->V, 0, 0, m, w->n);
+              gsl_vector_const_view s = gsl_matrix_const_column (w->S, idx);
+              gsl_vector_view x = gsl_matrix_column (evec, i);
+              double norm;
+
+              gsl_blas_dgemv (CblasTrans, 1.0, &Vm.matrix, &s.vector, 0.0, &x.vector);
+              norm = gsl_blas_dnrm2 (&x.vector);
+              gsl_blas_dscal (1.0 / norm, &x.vector);
+            }
+        }
+
+      return status;
+    }
+}
+
+/*
+gsl_splinalg_eigen_nonsymm()
+  Compute nev eigenvalues and eigenvectors of a general real matrix with
+the restarted Arnoldi method
+
+Inputs: op    - operator, providing y = A x, and y = (A - sigma I)^{-1} x
+                if which = GSL_SPLINALG_EIGEN_NEAREST
+        which - eigenvalues wanted: largest or smallest real part, or
+                nearest to sigma
+        sigma - shift for GSL_SPLINALG_EIGEN_NEAREST
+        eval  - (output) eigenvalues, length nev, in order of preference
+        evec  - (output) eigenvectors, n-by-nev, or NULL
+        w     - workspace, with ncv >= nev + 2
+
+Return: as gsl_splinalg_eigen_symm
+*/
+
+int
+gsl_splinalg_eigen_nonsymm (gsl_splinalg_eigen_op * op, const gsl_splinalg_eigen_t which,
+                            const double sigma, gsl_vector_complex * eval,
+                            gsl_matrix_complex * evec, gsl_splinalg_eigen_workspace * w)
+{
+  if (eval->size != w->nev)
+    {
+      GSL_ERROR ("eval vector must have length nev", GSL_EBADLEN);
+    }
+  else if (evec != NULL && (evec->size1 != w->n || evec->size2 != w->nev))
+    {
+      GSL_ERROR ("evec matrix must be n-by-nev", GSL_EBADLEN);
+    }
+  else if (w->ncv < w->nev + 2)
+    {
+      GSL_ERROR ("nonsymmetric problems require ncv >= nev + 2", GSL_EINVAL);
+    }
+  else if (which == GSL_SPLINALG_EIGEN_NEAREST && op->solve == NULL)
+    {
+      GSL_ERROR ("shift-invert mode requires a solve function", GSL_EINVAL);
+    }
+  else
+    {
+      const size_t m = w->ncv;
+      int status = eigen_iterate (0, op, which, sigma, w);
+      size_t i, j;
+
+      if (status != GSL_SUCCESS && status != GSL_EMAXITER)
+        return status;
+
+      for (i = 0; i < w->nev; ++i)
+        {
+          const size_t idx = w->order[i];
+          gsl_complex theta = gsl_vector_complex_get (w->theta, idx);
+
+          if (which == GSL_SPLINALG_EIGEN_NEAREST)
+            theta = gsl_complex_add_real (gsl_complex_inverse (theta), sigma);
+
+          gsl_vector_complex_set (eval, i, theta);
+
+          if (evec != NULL)
+            {
+              gsl_matrix_const_view Vm = gsl_matrix_const_submatrix (w->V, 0, 0, m, w->n);
+              gsl_vector_complex_const_view s = gsl_matrix_complex_const_column (w->cS, idx);
+              gsl_vector_const_view sr = gsl_vector_complex_const_real (&s.vector);
+              gsl_vector_const_view si = gsl_vector_complex_const_imag (&s.vector);
+              gsl_vector_complex_view x = gsl_matrix_complex_column (evec, i);
+              gsl_vector_view xr = gsl_vector_complex_real (&x.vector);
+              gsl_vector_view xi = gsl_vector_complex_imag (&x.vector);
+              double norm;
+
+              gsl_blas_dgemv (CblasTrans, 1.0, &Vm.matrix, &sr.vector, 0.0, &xr.vector);
+              gsl_blas_dgemv (CblasTrans, 1.0, &Vm.matrix, &si.vector, 0.0, &xi.vector);
+
+              norm = gsl_blas_dznrm2 (&x.vector);
+              for (j = 0; j < w->n; ++j)
+                {
+                  gsl_complex * xj = gsl_vector_complex_ptr (&x.vector, j);
+                  *xj = gsl_complex_div_real (*xj, norm);
+                }
+            }
+        }
+
+      return status;
+    }
+}
+
+/* y = op(x) */
+static int
+eigen_apply (gsl_splinalg_eigen_op * op, const gsl_splinalg_eigen_t which,
+             const double sigma, const gsl_vector * x, gsl_vector * y)
+{
+  if (which == GSL_SPLINALG_EIGEN_NEAREST)
+    return op->solve (sigma, x, y, op->params);
+  else
+    return op->matvec (x, y, op->params);
+}
+
+/*
+eigen_iterate()
+  Main loop: expand the Krylov decomposition to ncv vectors, compute the
+Ritz pairs, and restart with the wanted ones until nev have converged
+
+On output, w->theta, w->S (symmetric) or w->cS (nonsymmetric) and w->order
+contain the Ritz pairs of H_m, and V_m the basis
+*/
+
+static int
+eigen_iterate (const int symm, gsl_splinalg_eigen_op * op,
+               const gsl_splinalg_eigen_t which, const double sigma,
+               gsl_splinalg_eigen_workspace * w)
+{
+  int status = GSL_SUCCESS;
+  size_t k = 0;
+
+  w->seed = 1;
+  w->niter = 0;
+  w->nconv = 0;
+
+  gsl_matrix_set_zero (w->H);
+
+  /* starting vector */
+  {
+    gsl_vector_view v0 = gsl_matrix_row (w->V, 0);
+    eigen_random_vector (&v0.vector, w);
+  }
+
+  while (1)
+    {
+      k = eigen_expand (op, which, sigma, k, w, &status);
+      if (status)
+        return status;
+
+      status = eigen_ritz (symm, which, w);
+      if (status)
+        return status;
+
+      if (w->nconv >= w->nev)
+        return GSL_SUCCESS;
+
+      if (w->niter >= w->maxiter)
+        return GSL_EMAXITER;
+
+      k = eigen_restart (symm, w);
+      ++(w->niter);
+    }
+}
+
+/*
+eigen_expand()
+  Extend the Krylov decomposition op V_k = V_k H_k + f e_k^T, with f
+stored in row k of V and its norm in row k of H, to ncv vectors, with
+classical Gram-Schmidt applied twice
+
+Return: ncv
+*/
+
+static size_t
+eigen_expand (gsl_splinalg_eigen_op * op, const gsl_splinalg_eigen_t which,
+              const double sigma, const size_t k, gsl_splinalg_eigen_workspace * w, int * status)
+{
+  const size_t m = w->ncv;
+  gsl_vector * y = w->work;
+  size_t j;
+
+  for (j = k; j < m; ++j)
+    {
+      gsl_matrix_view Vj = gsl_matrix_submatrix (w->V, 0, 0, j + 1, w->n);
+      gsl_vector_view vj = gsl_matrix_row (w->V, j);
+      gsl_vector_view vj1 = gsl_matrix_row (w->V, j + 1);
+      gsl_vector_view h = gsl_vector_subvector (w->h, 0, j + 1);
+      gsl_vector_view c = gsl_vector_subvector (w->c, 0, j + 1);
+      gsl_vector_view Hj = gsl_matrix_subcolumn (w->H, j, 0, j + 1);
+      double beta, hnorm;
+
+      *status = eigen_apply (op, which, sigma, &vj.vector, y);
+      if (*status)
+        return j;
+
+      /* h = V_j y, y = y - V_j^T h, twice */
+      gsl_blas_dgemv (CblasNoTrans, 1.0, &Vj.matrix, y, 0.0, &h.vector);
+      gsl_blas_dgemv (CblasTrans, -1.0, &Vj.matrix, &h.vector, 1.0, y);
+      gsl_blas_dgemv (CblasNoTrans, 1.0, &Vj.matrix, y, 0.0, &c.vector);
+      gsl_blas_dgemv (CblasTrans, -1.0, &Vj.matrix, &c.vector, 1.0, y);
+      gsl_vector_add (&h.vector, &c.vector);
+
+      gsl_vector_memcpy (&Hj.vector, &h.vector);
+
+      beta = gsl_blas_dnrm2 (y);
+      hnorm = gsl_blas_dnrm2 (&h.vector);
+
+      if (beta > GSL_DBL_EPSILON * hnorm)
+        {
+          gsl_matrix_set (w->H, j + 1, j, beta);
+          gsl_vector_memcpy (&vj1.vector, y);
+          gsl_blas_dscal (1.0 / beta, &vj1.vector);
+        }
+      else
+        {
+          /* V_j spans an invariant subspace; continue with a random
+           * vector orthogonal to it */
+          gsl_matrix_set (w->H, j + 1, j, 0.0);
+          eigen_random_vector (&vj1.vector, w);
+          gsl_blas_dgemv (CblasNoTrans, 1.0, &Vj.matrix, &vj1.vector, 0.0, &c.vector);
+          gsl_blas_dgemv (CblasTrans, -1.0, &Vj.matrix, &c.vector, 1.0, &vj1.vector);
+          gsl_blas_dgemv (CblasNoTrans, 1.0, &Vj.matrix, &vj1.vector, 0.0, &c.vector);
+          gsl_blas_dgemv (CblasTrans, -1.0, &Vj.matrix, &c.vector, 1.0, &vj1.vector);
+          gsl_blas_dscal (1.0 / gsl_blas_dnrm2 (&vj1.vector), &vj1.vector);
+        }
+    }
+
+  return m;
+}
+
+/*
+eigen_ritz()
+  Compute the Ritz pairs (theta_i, s_i) of H_m, sort them in order of
+preference into w->order, and count the converged ones among the first
+nev. The residual of a Ritz pair is || op V s - theta V s || = |beta s_m|,
+with beta = H(m,m-1), and it is compared with tol ||op||, estimated by
+the largest |theta_i|; a test relative to |theta_i| alone can not be met
+by small eigenvalues, whose residuals stagnate at the rounding level of op
+
+Return: success or the error code of the dense eigensolver
+*/
+
+static int
+eigen_ritz (const int symm, const gsl_splinalg_eigen_t which,
+            gsl_splinalg_eigen_workspace * w)
+{
+  const size_t m = w->ncv;
+  const double beta = gsl_matrix_get (w->H, m, m - 1);
+  double opnorm = 0.0;
+  gsl_matrix_const_view Hm = gsl_matrix_const_submatrix (w->H, 0, 0, m, m);
+  double *key = w->Z->data; /* m doubles of scratch, Z is not in use */
+  size_t i, j;
+  int status;
+
+  if (symm)
+    {
+      gsl_vector_view theta = gsl_vector_complex_real (w->theta);
+
+      /* symmetrize H_m, which differs from its transpose by rounding */
+      gsl_matrix_transpose_memcpy (w->Hwork, &Hm.matrix);
+      gsl_matrix_add (w->Hwork, &Hm.matrix);
+      gsl_matrix_scale (w->Hwork, 0.5);
+
+      status = gsl_eigen_symmv (w->Hwork, &theta.vector, w->S, w->symm_p);
+      if (status)
+        return status;
+
+      for (i = 0; i < m; ++i)
+        {
+          GSL_IMAG (*gsl_vector_complex_ptr (w->theta, i)) = 0.0;
+          gsl_vector_set (w->resid, i, fabs (beta * gsl_matrix_get (w->S, m - 1, i)));
+        }
+    }
+  else
+    {
+      gsl_matrix_memcpy (w->Hwork, &Hm.matrix);
+      status = gsl_eigen_nonsymmv (w->Hwork, w->theta, w->cS, w->nonsymm_p);
+      if (status)
+        return status;
+
+      for (i = 0; i < m; ++i)
+        {
+          gsl_complex sm = gsl_matrix_complex_get (w->cS, m - 1, i);
+          gsl_vector_set (w->resid, i, fabs (beta) * gsl_complex_abs (sm));
+        }
+    }
+
+  /* sort in order of preference, keeping complex conjugate pairs
+   * together since they have the same key */
+  for (i = 0; i < m; ++i)
+    {
+      gsl_complex theta = gsl_vector_complex_get (w->theta, i);
+
+      if (which == GSL_SPLINALG_EIGEN_LARGEST)
+        key[i] = GSL_REAL (theta);
+      else if (which == GSL_SPLINALG_EIGEN_SMALLEST)
+        key[i] = -GSL_REAL (theta);
+      else
+        key[i] = gsl_complex_abs (theta);
+
+      w->order[i] = i;
+      opnorm = GSL_MAX (opnorm, gsl_complex_abs (theta));
+    }
+
+  for (i = 1; i < m; ++i)
+    {
+      const size_t oi = w->order[i];
+
+      for (j = i; j > 0 && key[w->order[j - 1]] < key[oi]; --j)
+        w->order[j] = w->order[j - 1];
+
+      w->order[j] = oi;
+    }
+
+  w->nconv = 0;
+  for (i = 0; i < w->nev; ++i)
+    {
+      const size_t idx = w->order[i];
+
+      if (gsl_vector_get (w->resid, idx) <= w->tol * opnorm)
+        ++(w->nconv);
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+eigen_restart()
+  Restart the decomposition with the k wanted Ritz vectors of H_m: with
+Y an orthonormal basis of these Ritz vectors,
+
+op (V_m Y) = (V_m Y) (Y^T H_m Y) + f (e_m^T Y)
+
+so the new basis is V_k = V_m Y, H_k = Y^T H_m Y with the row
+beta e_m^T Y below it, and the next basis vector is f / beta.
+
+Return: k
+*/
+
+static size_t
+eigen_restart (const int symm, gsl_splinalg_eigen_workspace * w)
+{
+  const size_t m = w->ncv;
+  const size_t n = w->n;
+  const double beta = gsl_matrix_get (w->H, m, m - 1);
+  size_t k = w->nev + (m - w->nev) / 2;
+  size_t i, col = 0;
+
+  if (!symm)
+    {
+      /* do not split a complex conjugate pair */
+      size_t last = w->order[k - 1];
+
+      if (GSL_IMAG (gsl_vector_complex_get (w->theta, last)) != 0.0)
+        {
+          size_t npair = 0;
+
+          for (i = 0; i < k; ++i)
+            {
+              if (GSL_IMAG (gsl_vector_complex_get (w->theta, w->order[i])) != 0.0)
+                ++npair;
+            }
+
+          /* an odd number of complex Ritz values means the last pair is split */
+          if (npair % 2 == 1)
+            k = (k + 1 < m) ? k + 1 : k - 1;
+        }
+    }
+
+  /* Y = real basis of the kept Ritz vectors */
+  for (i = 0; i < k; ++i)
+    {
+      const size_t idx = w->order[i];
+      gsl_vector_view y = gsl_matrix_column (w->Y, col);
+
+      if (symm)
+        {
+          gsl_vector_const_view s = gsl_matrix_const_column (w->S, idx);
+          gsl_vector_memcpy (&y.vector, &s.vector);
+          ++col;
+        }
+      else
+        {
+          gsl_vector_complex_const_view s = gsl_matrix_complex_const_column (w->cS, idx);
+          gsl_vector_const_view sr = gsl_vector_complex_const_real (&s.vector);
+          gsl_vector_const_view si = gsl_vector_complex_const_imag (&s.vector);
+
+          gsl_vector_memcpy (&y.vector, &sr.vector);
+          ++col;
+
+          if (GSL_IMAG (gsl_vector_complex_get (w->theta, idx)) != 0.0)
+            {
+              /* the conjugate follows and spans the same real subspace */
+              y = gsl_matrix_column (w->Y, col);
+              gsl_vector_memcpy (&y.vector, &si.vector);
+              ++col;
+              ++i;
+            }
+        }
+    }
+
+  k = col;
+
+  {
+    gsl_matrix_view Y = gsl_matrix_submatrix (w->Y, 0, 0, m, k);
+    gsl_matrix_view Hm = gsl_matrix_submatrix (w->H, 0, 0, m, m);
+    gsl_matrix_view HY = gsl_matrix_submatrix (w->Z, 0, 0, m, k);
+    gsl_matrix_view Hk = gsl_matrix_submatrix (w->Hwork, 0, 0, k, k);
+    gsl_matrix_view Vm = gsl_matrix_submatrix (w->V, 0, 0, m, n);
+    gsl_matrix_view Wk = gsl_matrix_submatrix (w->W, 0, 0, k, n);
+    gsl_matrix_view Vk = gsl_matrix_submatrix (w->V, 0, 0, k, n);
+    gsl_vector_view vk = gsl_matrix_row (w->V, k);
+    gsl_vector_view vm = gsl_matrix_row (w->V, m);
+
+    if (!symm)
+      eigen_orthonormalize (&Y.matrix);
+
+    /* H_k = Y^T H_m Y */
+    gsl_blas_dgemm (CblasNoTrans, CblasNoTrans, 1.0, &Hm.matrix, &Y.matrix, 0.0, &HY.matrix);
+    gsl_blas_dgemm (CblasTrans, CblasNoTrans, 1.0, &Y.matrix, &HY.matrix, 0.0, &Hk.matrix);
+
+    gsl_matrix_set_zero (w->H);
+
+    {
+      gsl_matrix_view H11 = gsl_matrix_submatrix (w->H, 0, 0, k, k);
+      gsl_matrix_memcpy (&H11.matrix, &Hk.matrix);
+    }
+
+    for (i = 0; i < k; ++i)
+      gsl_matrix_set (w->H, k, i, beta * gsl_matrix_get (&Y.matrix, m - 1, i));
+
+    /* V_k = Y^T V_m, one basis vector per row */
+    gsl_blas_dgemm (CblasTrans, CblasNoTrans, 1.0, &Y.matrix, &Vm.matrix, 0.0, &Wk.matrix);
+    gsl_matrix_memcpy (&Vk.matrix, &Wk.matrix);
+    gsl_vector_memcpy (&vk.vector, &vm.vector);
+  }
+
+  return k;
+}
+
+/* orthonormalize the columns of Y with modified Gram-Schmidt, twice */
+static int
+eigen_orthonormalize (gsl_matrix * Y)
+{
+  const size_t k = Y->size2;
+  size_t i, j, pass;
+
+  for (j = 0; j < k; ++j)
+    {
+      gsl_vector_view yj = gsl_matrix_column (Y, j);
+
+      for (pass = 0; pass < 2; ++pass)
+        {
+          for (i = 0; i < j; ++i)
+            {
+              gsl_vector_view yi = gsl_matrix_column (Y, i);
+              double r;
+
+              gsl_blas_ddot (&yi.vector, &yj.vector, &r);
+              gsl_blas_daxpy (-r, &yi.vector, &yj.vector);
+            }
+        }
+
+      gsl_blas_dscal (1.0 / gsl_blas_dnrm2 (&yj.vector), &yj.vector);
+    }
+
+  return GSL_SUCCESS;
+}
+
+/* unit vector with reproducible pseudo-random elements */
+static void
+eigen_random_vector (gsl_vector * v, gsl_splinalg_eigen_workspace * w)
+{
+  size_t i;
+
+  for (i = 0; i < v->size; ++i)
+    {
+      /* 32-bit linear congruential generator of Marsaglia */
+      w->seed = (69069UL * w->seed + 1UL) & 0xffffffffUL;
+      gsl_vector_set (v, i, w->seed / 4294967296.0 - 0.5);
+    }
+
+  gsl_blas_dscal (1.0 / gsl_blas_dnrm2 (v), v);
+}
+
+/*
+ * sparse matrix interface: products with gsl_spblas_dgemv, and shift-invert
+ * solves with GMRES on A - sigma I
+ */
+
+/* the relative residual of the inner GMRES solves is tied to the
+ * requested accuracy, but never made smaller than EIGEN_SP_SOLVE_MINTOL,
+ * below which GMRES may stagnate */
+#define EIGEN_SP_SOLVE_MINTOL 1.0e-12
+
+typedef struct
+{
+  const gsl_spmatrix * A;
+  gsl_spmatrix * B;                /* A - sigma I, compressed */
+  gsl_splinalg_itersolve * solver; /* GMRES workspace */
+  double tol;                      /* GMRES tolerance */
+} eigen_sp_params;
+
+static int
+eigen_sp_matvec (const gsl_vector * x, gsl_vector * y, void * params)
+{
+  eigen_sp_params * p = (eigen_sp_params *) params;
+  return gsl_spblas_dgemv (CblasNoTrans, 1.0, p->A, x, 0.0, y);
+}
+
+static int
+eigen_sp_solve (const double sigma, const gsl_vector * x, gsl_vector * y, void * params)
+{
+  eigen_sp_params * p = (eigen_sp_params *) params;
+  const size_t max_iter = 1000;
+  size_t iter = 0;
+  int status;
+
+  (void) sigma;
+
+  gsl_vector_set_zero (y);
+
+  do
+    status = gsl_splinalg_itersolve_iterate (p->B, x, p->tol, y, p->solver);
+  while (status == GSL_CONTINUE && ++iter < max_iter);
+
+  if (status != GSL_SUCCESS)
+    {
+      GSL_ERROR ("shift-invert solve did not converge", GSL_EMAXITER);
+    }
+
+  return GSL_SUCCESS;
+}
+
+static void
+eigen_sp_free (eigen_sp_params * p)
+{
+  if (p->B)
+    gsl_spmatrix_free (p->B);
+
+  if (p->solver)
+    gsl_splinalg_itersolve_free (p->solver);
+}
+
+/* initialize the parameters, with B = A - sigma I and a GMRES workspace
+ * in shift-invert mode; tol is the accuracy requested of the eigenpairs */
+static int
+eigen_sp_init (const gsl_spmatrix * A, const gsl_splinalg_eigen_t which,
+               const double sigma, const double tol, eigen_sp_params * p)
+{
+  const size_t n = A->size1;
+
+  p->A = A;
+  p->B = NULL;
+  p->solver = NULL;
+  p->tol = GSL_MAX (0.1 * tol, EIGEN_SP_SOLVE_MINTOL);
+
+  if (which == GSL_SPLINALG_EIGEN_NEAREST &&
+      (GSL_SPMATRIX_ISBSR (A) || GSL_SPMATRIX_ISSELL (A)))
+    {
+      GSL_ERROR ("shift-invert mode requires a COO, CSC or CSR matrix", GSL_EINVAL);
+    }
+  else if (which == GSL_SPLINALG_EIGEN_NEAREST)
+    {
+      /* the sum of compressed matrices requires a common format */
+      const int sptype = GSL_SPMATRIX_ISCSR (A) ? GSL_SPMATRIX_CSR : GSL_SPMATRIX_CSC;
+      gsl_spmatrix * S, * Sc, * Ac = NULL;
+      int status;
+      size_t i;
+
+      S = gsl_spmatrix_alloc_nzmax (n, n, n, GSL_SPMATRIX_COO);
+      if (S == NULL)
+        {
+          GSL_ERROR ("failed to allocate space for shifted matrix", GSL_ENOMEM);
+        }
+
+      for (i = 0; i < n; ++i)
+        gsl_spmatrix_set (S, i, i, -sigma);
+
+      Sc = gsl_spmatrix_compress (S, sptype);
+      gsl_spmatrix_free (S);
+
+      if (Sc == NULL)
+        {
+          GSL_ERROR ("failed to allocate space for shifted matrix", GSL_ENOMEM);
+        }
+
+      if (GSL_SPMATRIX_ISCOO (A))
+        {
+          Ac = gsl_spmatrix_compress (A, sptype);
+          if (Ac == NULL)
+            {
+              gsl_spmatrix_free (Sc);
+              GSL_ERROR ("failed to allocate space for compressed matrix", GSL_ENOMEM);
+            }
+        }
+
+      p->B = gsl_spmatrix_alloc_nzmax (n, n, gsl_spmatrix_nnz (A) + n, sptype);
+      if (p->B == NULL)
+        status = GSL_ENOMEM;
+      else
+        status = gsl_spmatrix_add (p->B, Ac ? Ac : A, Sc);
+
+      gsl_spmatrix_free (Sc);
+      if (Ac)
+        gsl_spmatrix_free (Ac);
+
+      if (status)
+        {
+          eigen_sp_free (p);
+          GSL_ERROR ("failed to form shifted matrix A - sigma I", status);
+        }
+
+      p->solver = gsl_splinalg_itersolve_alloc (gsl_splinalg_itersolve_gmres, n, GSL_MIN (n, 50));
+      if (p->solver == NULL)
+        {
+          eigen_sp_free (p);
+          GSL_ERROR ("failed to allocate GMRES workspace", GSL_ENOMEM);
+        }
+    }
+
+  return GSL_SUCCESS;
+}
+
+/*
+gsl_splinalg_eigen_symm_sp()
+  Compute nev eigenvalues and eigenvectors of a symmetric sparse matrix;
+see gsl_splinalg_eigen_symm
+*/
+
+int
+gsl_splinalg_eigen_symm_sp (const gsl_spmatrix * A, const gsl_splinalg_eigen_t which,
+                            const double sigma, gsl_vector * eval, gsl_matrix * evec,
+                            gsl_splinalg_eigen_workspace * w)
+{
+  if (A->size1 != w->n || A->size2 != w->n)
+    {
+      GSL_ERROR ("matrix size does not match workspace", GSL_EBADLEN);
+    }
+  else
+    {
+      eigen_sp_params p;
+      gsl_splinalg_eigen_op op;
+      int status;
+
+      status = eigen_sp_init (A, which, sigma, w->tol, &p);
+      if (status)
+        return status;
+
+      op.matvec = eigen_sp_matvec;
+      op.solve = eigen_sp_solve;
+      op.params = &p;
+
+      status = gsl_splinalg_eigen_symm (&op, which, sigma, eval, evec, w);
+
+      eigen_sp_free (&p);
+
+      return status;
+    }
+}
+
+/*
+gsl_splinalg_eigen_nonsymm_sp()
+  Compute nev eigenvalues and eigenvectors of a general sparse matrix;
+see gsl_splinalg_eigen_nonsymm
+*/
+
+int
+gsl_splinalg_eigen_nonsymm_sp (const gsl_spmatrix * A, const gsl_splinalg_eigen_t which,
+                               const double sigma, gsl_vector_complex * eval,
+                               gsl_matrix_complex * evec, gsl_splinalg_eigen_workspace * w)
+{
+  if (A->size1 != w->n || A->size2 != w->n)
+    {
+      GSL_ERROR ("matrix size does not match workspace", GSL_EBADLEN);
+    }
+  else
+    {
+      eigen_sp_params p;
+      gsl_splinalg_eigen_op op;
+      int status;
+
+      status = eigen_sp_init (A, which, sigma, w->tol, &p);
+      if (status)
+        return status;
+
+      op.matvec = eigen_sp_matvec;
+      op.solve = eigen_sp_solve;
+      op.params = &p;
+
+      status = gsl_splinalg_eigen_nonsymm (&op, which, sigma, eval, evec, w);
+
+      eigen_sp_free (&p);
+
+      return status;
+    }
+}
@@ -25,6 +25,7 @@
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_spmatrix.h>
 #include <gsl/gsl_linalg.h>
+#include <gsl/gsl_eigen.h>
 #include <gsl/gsl_types.h>
 
 #undef __BEGIN_DECLS
@@ -74,6 +75,80 @@ int gsl_splinalg_itersolve_iterate(const gsl_spmatrix *A,
                                    gsl_splinalg_itersolve *w);
 double gsl_splinalg_itersolve_normr(const gsl_splinalg_itersolve *w);
 
+/* sparse eigensolvers */
+
+typedef enum
+{
+  GSL_SPLINALG_EIGEN_LARGEST,  /* largest (real part of) eigenvalues */
+  GSL_SPLINALG_EIGEN_SMALLEST, /* smallest (real part of) eigenvalues */
+  GSL_SPLINALG_EIGEN_NEAREST   /* eigenvalues nearest to sigma, shift-invert */
+} gsl_splinalg_eigen_t;
+
+typedef struct
+{
+  /* y = A x */
+  int (*matvec) (const gsl_vector *x, gsl_vector *y, void *params);
+
+  /* solve (A - sigma I) y = x, for GSL_SPLINALG_EIGEN_NEAREST only */
+  int (*solve) (const double sigma, const gsl_vector *x, gsl_vector *y, void *params);
+
+  void *params;
+} gsl_splinalg_eigen_op;
+
+typedef struct
+{
+  size_t n;                     /* size of matrix */
+  size_t nev;                   /* number of eigenvalues wanted */
+  size_t ncv;                   /* dimension of Krylov subspace */
+  gsl_matrix *V;                /* Krylov basis, (ncv+1)-by-n, one vector per row */
+  gsl_matrix *W;                /* workspace, ncv-by-n */
+  gsl_matrix *H;                /* projection of operator, (ncv+1)-by-ncv */
+  gsl_matrix *Hwork;            /* workspace, ncv-by-ncv */
+  gsl_matrix *S;                /* Ritz vectors of H, symmetric case */
+  gsl_matrix *Y;                /* basis of kept Ritz vectors at restart */
+  gsl_matrix *Z;                /* workspace, ncv-by-ncv */
+  gsl_vector *h;                /* workspace, ncv+1 */
+  gsl_vector *c;                /* workspace, ncv+1 */
+  gsl_vector *work;             /* workspace, n */
+  gsl_vector_complex *theta;    /* Ritz values */
+  gsl_matrix_complex *cS;       /* Ritz vectors of H, nonsymmetric case */
+  gsl_vector *resid;            /* Ritz residual estimates */
+  size_t *order;                /* Ritz values in order of preference */
+  gsl_eigen_symmv_workspace *symm_p;
+  gsl_eigen_nonsymmv_workspace *nonsymm_p;
+  double tol;                   /* relative tolerance */
+  size_t maxiter;               /* maximum number of restarts */
+  size_t nconv;                 /* number of converged eigenvalues */
+  size_t niter;                 /* number of restarts performed */
+  unsigned long seed;           /* state of generator for starting vectors */
+} gsl_splinalg_eigen_workspace;
+
+gsl_splinalg_eigen_workspace *
+gsl_splinalg_eigen_alloc(const size_t n, const size_t nev, const size_t ncv);
+void gsl_splinalg_eigen_free(gsl_splinalg_eigen_workspace *w);
+int gsl_splinalg_eigen_params(const double tol, const size_t maxiter,
+                              gsl_splinalg_eigen_workspace *w);
+int gsl_splinalg_eigen_symm(gsl_splinalg_eigen_op *op,
+                            const gsl_splinalg_eigen_t which,
+                            const double sigma, gsl_vector *eval,
+                            gsl_matrix *evec,
+                            gsl_splinalg_eigen_workspace *w);
+int gsl_splinalg_eigen_nonsymm(gsl_splinalg_eigen_op *op,
+                               const gsl_splinalg_eigen_t which,
+                               const double sigma, gsl_vector_complex *eval,
+                               gsl_matrix_complex *evec,
+                               gsl_splinalg_eigen_workspace *w);
+int gsl_splinalg_eigen_symm_sp(const gsl_spmatrix *A,
+                               const gsl_splinalg_eigen_t which,
+                               const double sigma, gsl_vector *eval,
+                               gsl_matrix *evec,
+                               gsl_splinalg_eigen_workspace *w);
+int gsl_splinalg_eigen_nonsymm_sp(const gsl_spmatrix *A,
+                                  const gsl_splinalg_eigen_t which,
+                                  const double sigma, gsl_vector_complex *eval,
+                                  gsl_matrix_complex *evec,
+                                  gsl_splinalg_eigen_workspace *w);
+
 __END_DECLS
 
 #endif /* __GSL_SPLINALG_H__ */
@@ -24,6 +24,7 @@
 #include <gsl/gsl_math.h>
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_randist.h>
+#include <gsl/gsl_sort.h>
 #include <gsl/gsl_rng.h>
 #include <gsl/gsl_matrix.h>
 #include <gsl/gsl_vector.h>
@@ -32,6 +33,8 @@
 #include <gsl/gsl_spmatrix.h>
 #include <gsl/gsl_spblas.h>
 #include <gsl/gsl_splinalg.h>
+#include <gsl/gsl_eigen.h>
+#include <gsl/gsl_complex_math.h>
 
 /*
 create_random_sparse()
@@ -98,6 +101,7 @@ create_random_vector(gsl_vector *v, const gsl_rng *r)
 test_poisson()
   Solve u''(x) = -pi^2 sin(pi*x), u(x) = sin(pi*x)
   epsrel is the relative error threshold with the exact solution
+  compress selects the matrix format: 0 = COO, 1 = CSC, 2 = BSR, 3 = SELL
 */
 static void
 test_poisson(const size_t N, const double epsrel, const int compress)
@@ -146,8 +150,15 @@ test_poisson(const size_t N, const double epsrel, const int compress)
       gsl_vector_set(b, i, bi);
     }
 
-  if (compress)
+  if (compress == 1)
     B = gsl_spmatrix_compcol(A);
+  else if (compress > 1)
+    {
+      gsl_spmatrix *C = gsl_spmatrix_crs(A);
+
+      B = (compress == 2) ? gsl_spmatrix_bsr(C, 2) : gsl_spmatrix_sell(C, 8, 32);
+      gsl_spmatrix_free(C);
+    }
   else
     B = A;
 
@@ -158,7 +169,8 @@ test_poisson(const size_t N, const double epsrel, const int compress)
     }
   while (status == GSL_CONTINUE && ++iter < max_iter);
 
-  gsl_test(status, "%s poisson status s=%d N=%zu", desc, status, N);
+  gsl_test(status, "%s poisson status s=%d N=%zu %s", desc, status, N,
+           gsl_spmatrix_type(B));
 
   /* check solution against analytic */
   for (i = 0; i < n; ++i)
@@ -302,8 +314,15 @@ test_random(const size_t N, const gsl_rng *r, const int compress)
 
   create_random_vector(b, r);
 
-  if (compress)
+  if (compress == 1)
     B = gsl_spmatrix_compcol(A);
+  else if (compress > 1)
+    {
+      gsl_spmatrix *C = gsl_spmatrix_crs(A);
+
+      B = (compress == 2) ? gsl_spmatrix_bsr(C, 2) : gsl_spmatrix_sell(C, 8, 32);
+      gsl_spmatrix_free(C);
+    }
   else
     B = A;
 
@@ -337,6 +356,325 @@ test_random(const size_t N, const gsl_rng *r, const int compress)
     gsl_spmatrix_free(B);
 } /* test_random() */
 
+/* 1D Laplacian tridiag(-1,2,-1), with y = A x and (A - sigma I)^{-1} x */
+
+static int
+laplace_matvec(const gsl_vector *x, gsl_vector *y, void *params)
+{
+  const size_t n = x->size;
+  size_t i;
+
+  (void) params;
+
+  for (i = 0; i < n; ++i)
+    {
+      double yi = 2.0 * gsl_vector_get(x, i);
+
+      if (i > 0)
+        yi -= gsl_vector_get(x, i - 1);
+      if (i + 1 < n)
+        yi -= gsl_vector_get(x, i + 1);
+
+      gsl_vector_set(y, i, yi);
+    }
+
+  return GSL_SUCCESS;
+}
+
+static int
+laplace_solve(const double sigma, const gsl_vector *x, gsl_vector *y, void *params)
+{
+  const size_t n = x->size;
+  gsl_vector *diag = gsl_vector_alloc(n);
+  gsl_vector *offdiag = gsl_vector_alloc(n - 1);
+  int status;
+
+  (void) params;
+
+  gsl_vector_set_all(diag, 2.0 - sigma);
+  gsl_vector_set_all(offdiag, -1.0);
+
+  status = gsl_linalg_solve_symm_tridiag(diag, offdiag, x, y);
+
+  gsl_vector_free(diag);
+  gsl_vector_free(offdiag);
+
+  return status;
+}
+
+/*
+test_eigen_laplace()
+  Compute nev eigenvalues of the 1D Laplacian, which are
+2 - 2 cos(k pi / (N+1)), through a user supplied operator
+*/
+
+static void
+test_eigen_laplace(const size_t N, const size_t nev, const gsl_splinalg_eigen_t which,
+                   const double sigma, const double tol)
+{
+  gsl_splinalg_eigen_workspace *w = gsl_splinalg_eigen_alloc(N, nev, 0);
+  gsl_vector *eval = gsl_vector_alloc(nev);
+  gsl_matrix *evec = gsl_matrix_alloc(N, nev);
+  gsl_vector *exact = gsl_vector_alloc(N);
+  gsl_vector *y = gsl_vector_alloc(N);
+  gsl_splinalg_eigen_op op;
+  size_t *idx = malloc(N * sizeof(size_t));
+  double *key = malloc(N * sizeof(double));
+  size_t i;
+  int status;
+
+  op.matvec = laplace_matvec;
+  op.solve = laplace_solve;
+  op.params = NULL;
+
+  status = gsl_splinalg_eigen_symm(&op, which, sigma, eval, evec, w);
+  gsl_test(status, "eigen laplace status s=%d N=%zu which=%d", status, N, which);
+
+  /* exact eigenvalues in order of preference */
+  for (i = 0; i < N; ++i)
+    {
+      double ei = 2.0 - 2.0 * cos((i + 1.0) * M_PI / (N + 1.0));
+
+      gsl_vector_set(exact, i, ei);
+
+      if (which == GSL_SPLINALG_EIGEN_LARGEST)
+        key[i] = -ei;
+      else if (which == GSL_SPLINALG_EIGEN_SMALLEST)
+        key[i] = ei;
+      else
+        key[i] = fabs(ei - sigma);
+    }
+
+  gsl_sort_index(idx, key, 1, N);
+
+  for (i = 0; i < nev; ++i)
+    {
+      gsl_vector_view x = gsl_matrix_column(evec, i);
+      double lambda = gsl_vector_get(eval, i);
+
+      /* ||A|| <= 4 */
+      gsl_test_abs(lambda, gsl_vector_get(exact, idx[i]), 4.0 * tol,
+                   "eigen laplace eval N=%zu which=%d i=%zu", N, which, i);
+
+      /* || A x - lambda x || */
+      laplace_matvec(&x.vector, y, NULL);
+      gsl_blas_daxpy(-lambda, &x.vector, y);
+      gsl_test(gsl_blas_dnrm2(y) > 4.0 * tol, "eigen laplace residual N=%zu which=%d i=%zu",
+               N, which, i);
+    }
+
+  gsl_splinalg_eigen_free(w);
+  gsl_vector_free(eval);
+  gsl_matrix_free(evec);
+  gsl_vector_free(exact);
+  gsl_vector_free(y);
+  free(idx);
+  free(key);
+} /* test_eigen_laplace() */
+
+/*
+test_eigen_symm()
+  Compare nev eigenvalues of a random symmetric sparse matrix with
+those computed by gsl_eigen_symm
+*/
+
+static void
+test_eigen_symm(const size_t N, const size_t nev, const gsl_splinalg_eigen_t which,
+                const double sigma, const gsl_rng *r)
+{
+  const double tol = 1.0e-9;
+  gsl_spmatrix *T = create_random_sparse(N, N, 0.1, r);
+  gsl_spmatrix *A = gsl_spmatrix_alloc_nzmax(N, N, 2 * gsl_spmatrix_nnz(T), GSL_SPMATRIX_TRIPLET);
+  gsl_spmatrix *C;
+  gsl_matrix *D = gsl_matrix_alloc(N, N);
+  gsl_vector *exact = gsl_vector_alloc(N);
+  gsl_vector *eval = gsl_vector_alloc(nev);
+  gsl_matrix *evec = gsl_matrix_alloc(N, nev);
+  gsl_vector *y = gsl_vector_alloc(N);
+  gsl_eigen_symm_workspace *dense_p = gsl_eigen_symm_alloc(N);
+  gsl_splinalg_eigen_workspace *w = gsl_splinalg_eigen_alloc(N, nev, 0);
+  double *key = malloc(N * sizeof(double));
+  size_t *idx = malloc(N * sizeof(size_t));
+  double anorm;
+  size_t i, j;
+  int status;
+
+  /* A = T + T^T - 1/2, with both signs of eigenvalues */
+  for (i = 0; i < N; ++i)
+    {
+      for (j = 0; j <= i; ++j)
+        {
+          double aij = gsl_spmatrix_get(T, i, j) + gsl_spmatrix_get(T, j, i);
+
+          if (aij != 0.0)
+            {
+              aij -= 0.5;
+              gsl_spmatrix_set(A, i, j, aij);
+              gsl_spmatrix_set(A, j, i, aij);
+            }
+        }
+    }
+
+  C = gsl_spmatrix_compress(A, GSL_SPMATRIX_CSC);
+  gsl_spmatrix_sp2d(D, A);
+  anorm = gsl_matrix_norm1(D);
+  gsl_eigen_symm(D, exact, dense_p);
+
+  for (i = 0; i < N; ++i)
+    {
+      double ei = gsl_vector_get(exact, i);
+
+      if (which == GSL_SPLINALG_EIGEN_LARGEST)
+        key[i] = -ei;
+      else if (which == GSL_SPLINALG_EIGEN_SMALLEST)
+        key[i] = ei;
+      else
+        key[i] = fabs(ei - sigma);
+    }
+
+  gsl_sort_index(idx, key, 1, N);
+
+  status = gsl_splinalg_eigen_symm_sp(C, which, sigma, eval, evec, w);
+  gsl_test(status, "eigen symm status s=%d N=%zu which=%d", status, N, which);
+
+  for (i = 0; i < nev; ++i)
+    {
+      gsl_vector_view x = gsl_matrix_column(evec, i);
+      double lambda = gsl_vector_get(eval, i);
+      double expected = gsl_vector_get(exact, idx[i]);
+
+      gsl_test_abs(lambda, expected, tol * anorm,
+                   "eigen symm eval N=%zu which=%d i=%zu", N, which, i);
+
+      gsl_spblas_dgemv(CblasNoTrans, 1.0, C, &x.vector, 0.0, y);
+      gsl_blas_daxpy(-lambda, &x.vector, y);
+      gsl_test(gsl_blas_dnrm2(y) > tol * anorm, "eigen symm residual N=%zu which=%d i=%zu",
+               N, which, i);
+    }
+
+  gsl_spmatrix_free(T);
+  gsl_spmatrix_free(A);
+  gsl_spmatrix_free(C);
+  gsl_matrix_free(D);
+  gsl_vector_free(exact);
+  gsl_vector_free(eval);
+  gsl_matrix_free(evec);
+  gsl_vector_free(y);
+  gsl_eigen_symm_free(dense_p);
+  gsl_splinalg_eigen_free(w);
+  free(key);
+  free(idx);
+} /* test_eigen_symm() */
+
+/*
+test_eigen_nonsymm()
+  Compare nev eigenvalues of a random sparse matrix with those computed
+by gsl_eigen_nonsymm
+*/
+
+static void
+test_eigen_nonsymm(const size_t N, const size_t nev, const gsl_splinalg_eigen_t which,
+                   const double sigma, const gsl_rng *r)
+{
+  const double tol = 1.0e-8;
+  gsl_spmatrix *A = create_random_sparse(N, N, 0.1, r);
+  gsl_spmatrix *C = gsl_spmatrix_compress(A, GSL_SPMATRIX_CSR);
+  gsl_matrix *D = gsl_matrix_alloc(N, N);
+  gsl_vector_complex *exact = gsl_vector_complex_alloc(N);
+  gsl_vector_complex *eval = gsl_vector_complex_alloc(nev);
+  gsl_matrix_complex *evec = gsl_matrix_complex_alloc(N, nev);
+  gsl_eigen_nonsymm_workspace *dense_p = gsl_eigen_nonsymm_alloc(N);
+  gsl_splinalg_eigen_workspace *w = gsl_splinalg_eigen_alloc(N, nev, 0);
+  gsl_vector *xr = gsl_vector_alloc(N);
+  gsl_vector *xi = gsl_vector_alloc(N);
+  gsl_vector *yr = gsl_vector_alloc(N);
+  gsl_vector *yi = gsl_vector_alloc(N);
+  double anorm;
+  size_t i, j;
+  int status;
+
+  gsl_spmatrix_sp2d(D, A);
+  anorm = gsl_matrix_norm1(D);
+  gsl_eigen_nonsymm(D, exact, dense_p);
+
+  status = gsl_splinalg_eigen_nonsymm_sp(C, which, sigma, eval, evec, w);
+  gsl_test(status, "eigen nonsymm status s=%d N=%zu which=%d", status, N, which);
+
+  for (i = 0; i < nev; ++i)
+    {
+      gsl_complex lambda = gsl_vector_complex_get(eval, i);
+      gsl_vector_complex_view x = gsl_matrix_complex_column(evec, i);
+      size_t nbetter = 0;
+      double dmin = GSL_POSINF;
+
+      /* lambda must be an eigenvalue, preceded by fewer than i+1 better ones */
+      for (j = 0; j < N; ++j)
+        {
+          gsl_complex ej = gsl_vector_complex_get(exact, j);
+          double kj, kl;
+
+          dmin = GSL_MIN(dmin, gsl_complex_abs(gsl_complex_sub(ej, lambda)));
+
+          if (which == GSL_SPLINALG_EIGEN_LARGEST)
+            {
+              kj = GSL_REAL(ej);
+              kl = GSL_REAL(lambda);
+            }
+          else if (which == GSL_SPLINALG_EIGEN_SMALLEST)
+            {
+              kj = -GSL_REAL(ej);
+              kl = -GSL_REAL(lambda);
+            }
+          else
+            {
+              kj = -gsl_complex_abs(gsl_complex_sub_real(ej, sigma));
+              kl = -gsl_complex_abs(gsl_complex_sub_real(lambda, sigma));
+            }
+
+          if (kj > kl + tol * anorm)
+            ++nbetter;
+        }
+
+      gsl_test(dmin > tol * anorm, "eigen nonsymm eval N=%zu which=%d i=%zu dist=%e",
+               N, which, i, dmin);
+      gsl_test(nbetter > i, "eigen nonsymm order N=%zu which=%d i=%zu", N, which, i);
+
+      /* || A x - lambda x || in real arithmetic */
+      {
+        gsl_vector_view vr = gsl_vector_complex_real(&x.vector);
+        gsl_vector_view vi = gsl_vector_complex_imag(&x.vector);
+        double res;
+
+        gsl_vector_memcpy(xr, &vr.vector);
+        gsl_vector_memcpy(xi, &vi.vector);
+
+        gsl_spblas_dgemv(CblasNoTrans, 1.0, C, xr, 0.0, yr);
+        gsl_spblas_dgemv(CblasNoTrans, 1.0, C, xi, 0.0, yi);
+        gsl_blas_daxpy(-GSL_REAL(lambda), xr, yr);
+        gsl_blas_daxpy(GSL_IMAG(lambda), xi, yr);
+        gsl_blas_daxpy(-GSL_REAL(lambda), xi, yi);
+        gsl_blas_daxpy(-GSL_IMAG(lambda), xr, yi);
+
+        res = gsl_hypot(gsl_blas_dnrm2(yr), gsl_blas_dnrm2(yi));
+        gsl_test(res > tol * anorm, "eigen nonsymm residual N=%zu which=%d i=%zu res=%e",
+                 N, which, i, res);
+      }
+    }
+
+  gsl_spmatrix_free(A);
+  gsl_spmatrix_free(C);
+  gsl_matrix_free(D);
+  gsl_vector_complex_free(exact);
+  gsl_vector_complex_free(eval);
+  gsl_matrix_complex_free(evec);
+  gsl_eigen_nonsymm_free(dense_p);
+  gsl_splinalg_eigen_free(w);
+  gsl_vector_free(xr);
+  gsl_vector_free(xi);
+  gsl_vector_free(yr);
+  gsl_vector_free(yi);
+} /* test_eigen_nonsymm() */
+
 int
 main()
 {
@@ -351,6 +689,8 @@ main()
 
   test_poisson(1000, 1.0e-6, 0);
   test_poisson(1000, 1.0e-6, 1);
+  test_poisson(1000, 1.0e-6, 2);
+  test_poisson(1000, 1.0e-6, 3);
 
   test_poisson(5000, 1.0e-7, 0);
   test_poisson(5000, 1.0e-7, 1);
@@ -364,6 +704,28 @@ main()
     {
       test_random(n, r, 0);
       test_random(n, r, 1);
+      test_random(n, r, 2);
+      test_random(n, r, 3);
+    }
+
+  test_eigen_laplace(100, 4, GSL_SPLINALG_EIGEN_LARGEST, 0.0, 1.0e-12);
+  test_eigen_laplace(100, 4, GSL_SPLINALG_EIGEN_SMALLEST, 0.0, 1.0e-10);
+  test_eigen_laplace(1000, 6, GSL_SPLINALG_EIGEN_NEAREST, 0.0, 1.0e-12);
+  test_eigen_laplace(1000, 6, GSL_SPLINALG_EIGEN_NEAREST, 1.3, 1.0e-12);
+
+  for (n = 30; n <= 300; n *= 3)
+    {
+      test_eigen_symm(n, 5, GSL_SPLINALG_EIGEN_LARGEST, 0.0, r);
+      test_eigen_symm(n, 5, GSL_SPLINALG_EIGEN_SMALLEST, 0.0, r);
+      test_eigen_nonsymm(n, 5, GSL_SPLINALG_EIGEN_LARGEST, 0.0, r);
+      test_eigen_nonsymm(n, 5, GSL_SPLINALG_EIGEN_SMALLEST, 0.0, r);
+    }
+
+  /* shift-invert with GMRES, which needs few restarts at these sizes */
+  for (n = 30; n <= 100; n *= 3)
+    {
+      test_eigen_symm(n, 3, GSL_SPLINALG_EIGEN_NEAREST, 0.1, r);
+      test_eigen_nonsymm(n, 3, GSL_SPLINALG_EIGEN_NEAREST, -1.0, r);
     }
 
   gsl_rng_free(r);
@@ -1,8 +1,23 @@
 #include <config.h>
 #include <stddef.h>
+#include <stdlib.h>
+#include <gsl/gsl_math.h>
 #include <gsl/gsl_spmatrix.h>
 #include <gsl/gsl_errno.h>
 
+/* order (length, row) pairs by decreasing row length, then by row */
+static int
+compare_rowlen (const void * pa, const void * pb)
+{
+  const int * a = (const int *) pa;
+  const int * b = (const int *) pb;
+
+  if (a[0] != b[0])
+    return (a[0] > b[0]) ? -1 : 1;
+
+  return (a[1] > b[1]) - (a[1] < b[1]);
+}
+
 #define BASE_GSL_COMPLEX_LONG
 #include "templates_on.h"
 #include "compress_source.c"
@@ -186,6 +186,294 @@ FUNCTION (gsl_spmatrix, csr) (TYPE (gsl_spmatrix) * dest, const TYPE (gsl_spmatr
     }
 }
 
+/*
+gsl_spmatrix_bsr()
+  Create a sparse matrix in block compressed row format
+
+Inputs: src   - sparse matrix in CSR format
+        bsize - block size, > 0
+
+Return: pointer to new matrix (should be freed when finished with it)
+
+Notes:
+1) block row I holds rows I*bsize to I*bsize+bsize-1, and p[I] to
+p[I+1]-1 are the indices of its nonzero blocks. Block k has block
+column i[k] and elements data[k*bsize*bsize] to
+data[(k+1)*bsize*bsize-1], stored by rows
+2) the blocks include the zero elements within them and, at the last
+block row and column, beyond the matrix. nz counts all of these
+*/
+
+TYPE (gsl_spmatrix) *
+FUNCTION (gsl_spmatrix, bsr) (const TYPE (gsl_spmatrix) * src, const size_t bsize)
+{
+  if (!GSL_SPMATRIX_ISCSR(src))
+    {
+      GSL_ERROR_NULL("input matrix must be in CSR format", GSL_EINVAL);
+    }
+  else if (bsize == 0)
+    {
+      GSL_ERROR_NULL("block size must be positive", GSL_EINVAL);
+    }
+  else
+    {
+      const size_t b2 = bsize * bsize;
+      const size_t nbrows = (src->size1 + bsize - 1) / bsize;
+      const size_t nbcols = (src->size2 + bsize - 1) / bsize;
+      const int *Sp = src->p;
+      const int *Sj = src->i;
+      TYPE (gsl_spmatrix) * dest;
+      int *w;
+      size_t nblocks = 0;
+      size_t I, i, n, r;
+      int p;
+
+      w = malloc(nbcols * sizeof(int));
+      if (!w)
+        {
+          GSL_ERROR_NULL("failed to allocate space for work", GSL_ENOMEM);
+        }
+
+      /* count the nonzero blocks; w[J] is the last block row with block column J */
+      for (n = 0; n < nbcols; ++n)
+        w[n] = -1;
+
+      for (I = 0; I < nbrows; ++I)
+        {
+          for (i = I * bsize; i < GSL_MIN((I + 1) * bsize, src->size1); ++i)
+            {
+              for (p = Sp[i]; p < Sp[i + 1]; ++p)
+                {
+                  const size_t J = Sj[p] / bsize;
+
+                  if (w[J] != (int) I)
+                    {
+                      w[J] = (int) I;
+                      ++nblocks;
+                    }
+                }
+            }
+        }
+
+      dest = FUNCTION (gsl_spmatrix, alloc_nzmax) (src->size1, src->size2,
+                                                  nblocks * b2, GSL_SPMATRIX_BSR);
+      if (!dest)
+        {
+          free(w);
+          return NULL;
+        }
+
+      dest->bsize = bsize;
+      dest->p = malloc((nbrows + 1) * sizeof(int));
+      if (!dest->p)
+        {
+          free(w);
+          FUNCTION (gsl_spmatrix, free) (dest);
+          GSL_ERROR_NULL("failed to allocate space for block row pointers",
+                         GSL_ENOMEM);
+        }
+
+      /* fill the blocks; w[J] is now the index of block column J in the current block row */
+      for (n = 0; n < nbcols; ++n)
+        w[n] = -1;
+
+      dest->p[0] = 0;
+      nblocks = 0;
+
+      for (I = 0; I < nbrows; ++I)
+        {
+          for (i = I * bsize; i < GSL_MIN((I + 1) * bsize, src->size1); ++i)
+            {
+              for (p = Sp[i]; p < Sp[i + 1]; ++p)
+                {
+                  const size_t J = Sj[p] / bsize;
+                  size_t k;
+
+                  if (w[J] < dest->p[I])
+                    {
+                      w[J] = (int) nblocks;
+                      dest->i[nblocks] = (int) J;
+
+                      for (n = 0; n < MULTIPLICITY * b2; ++n)
+                        dest->data[MULTIPLICITY * nblocks * b2 + n] = (ATOMIC) 0;
+
+                      ++nblocks;
+                    }
+
+                  k = w[J] * b2 + (i - I * bsize) * bsize + (Sj[p] - J * bsize);
+
+                  for (r = 0; r < MULTIPLICITY; ++r)
+                    dest->data[MULTIPLICITY * k + r] = src->data[MULTIPLICITY * p + r];
+                }
+            }
+
+          dest->p[I + 1] = (int) nblocks;
+        }
+
+      dest->nz = nblocks * b2;
+
+      free(w);
+
+      /* only the first nblocks column indices are used, but i keeps its
+         nzmax entries so that nzmax describes every array */
+
+      return dest;
+    }
+}
+
+/*
+gsl_spmatrix_sell()
+  Create a sparse matrix in sliced ELLPACK format with sorted rows
+(SELL-C-sigma)
+
+Inputs: src   - sparse matrix in CSR format
+        C     - slice height, > 0
+        sigma - rows are sorted by decreasing length within windows
+                of sigma rows; 1 keeps the original order
+
+Return: pointer to new matrix (should be freed when finished with it)
+
+Notes:
+1) slice s holds the C rows perm[s*C] to perm[s*C+C-1], with -1 for
+positions beyond the last row. Its elements are stored by columns,
+the k-th element of its r-th row at index p[s] + k*C + r of i and
+data, and rows shorter than the longest of the slice are padded with
+explicit zeros. nz counts the padding
+2) a padding element has the column index of the last element of its
+row, or 0 for an empty row
+*/
+
+TYPE (gsl_spmatrix) *
+FUNCTION (gsl_spmatrix, sell) (const TYPE (gsl_spmatrix) * src, const size_t C,
+                               const size_t sigma)
+{
+  if (!GSL_SPMATRIX_ISCSR(src))
+    {
+      GSL_ERROR_NULL("input matrix must be in CSR format", GSL_EINVAL);
+    }
+  else if (C == 0)
+    {
+      GSL_ERROR_NULL("slice height must be positive", GSL_EINVAL);
+    }
+  else if (sigma == 0)
+    {
+      GSL_ERROR_NULL("sorting window must be positive", GSL_EINVAL);
+    }
+  else
+    {
+      const size_t M = src->size1;
+      const size_t nslices = (M + C - 1) / C;
+      const int *Sp = src->p;
+      const int *Sj = src->i;
+      TYPE (gsl_spmatrix) * dest;
+      int *w;
+      size_t nstored = 0;
+      size_t i, s, k, r, n;
+
+      /* (length, row) pairs, sorted within the windows */
+      w = malloc(2 * M * sizeof(int));
+      if (!w)
+        {
+          GSL_ERROR_NULL("failed to allocate space for work", GSL_ENOMEM);
+        }
+
+      for (i = 0; i < M; ++i)
+        {
+          w[2 * i] = Sp[i + 1] - Sp[i];
+          w[2 * i + 1] = (int) i;
+        }
+
+      if (sigma > 1)
+        {
+          for (i = 0; i < M; i += sigma)
+            qsort(w + 2 * i, GSL_MIN(sigma, M - i), 2 * sizeof(int), compare_rowlen);
+        }
+
+      /* storage needed for each slice */
+      for (s = 0; s < nslices; ++s)
+        {
+          int width = 0;
+
+          for (i = s * C; i < GSL_MIN((s + 1) * C, M); ++i)
+            width = GSL_MAX(width, w[2 * i]);
+
+          nstored += (size_t) width * C;
+        }
+
+      dest = FUNCTION (gsl_spmatrix, alloc_nzmax) (src->size1, src->size2,
+                                                  nstored, GSL_SPMATRIX_SELL);
+      if (!dest)
+        {
+          free(w);
+          return NULL;
+        }
+
+      dest->bsize = C;
+      dest->p = malloc((nslices + 1) * sizeof(int));
+      dest->perm = malloc(nslices * C * sizeof(int));
+      if (!dest->p || !dest->perm)
+        {
+          free(w);
+          FUNCTION (gsl_spmatrix, free) (dest);
+          GSL_ERROR_NULL("failed to allocate space for slices",
+                         GSL_ENOMEM);
+        }
+
+      for (i = 0; i < nslices * C; ++i)
+        dest->perm[i] = (i < M) ? w[2 * i + 1] : -1;
+
+      dest->p[0] = 0;
+
+      for (s = 0; s < nslices; ++s)
+        {
+          const int *perm = dest->perm + s * C;
+          size_t width = 0;
+
+          for (r = 0; r < C; ++r)
+            {
+              if (perm[r] >= 0)
+                width = GSL_MAX(width, (size_t) (Sp[perm[r] + 1] - Sp[perm[r]]));
+            }
+
+          for (r = 0; r < C; ++r)
+            {
+              const int row = perm[r];
+              const size_t len = (row >= 0) ? (size_t) (Sp[row + 1] - Sp[row]) : 0;
+
+              for (k = 0; k < width; ++k)
+                {
+                  const size_t idx = dest->p[s] + k * C + r;
+
+                  if (k < len)
+                    {
+                      const size_t q = Sp[row] + k;
+
+                      dest->i[idx] = Sj[q];
+
+                      for (n = 0; n < MULTIPLICITY; ++n)
+                        dest->data[MULTIPLICITY * idx + n] = src->data[MULTIPLICITY * q + n];
+                    }
+                  else
+                    {
+                      dest->i[idx] = (len > 0) ? Sj[Sp[row] + len - 1] : 0;
+
+                      for (n = 0; n < MULTIPLICITY; ++n)
+                        dest->data[MULTIPLICITY * idx + n] = (ATOMIC) 0;
+                    }
+                }
+            }
+
+          dest->p[s + 1] = dest->p[s] + (int) (width * C);
+        }
+
+      dest->nz = nstored;
+
+      free(w);
+
+      return dest;
+    }
+}
+
 /* XXX deprecated function */
 TYPE (gsl_spmatrix) *
 FUNCTION (gsl_spmatrix, crs) (const TYPE (gsl_spmatrix) * src)
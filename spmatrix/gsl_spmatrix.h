@@ -6,6 +6,8 @@ enum
   GSL_SPMATRIX_COO = 0, /* coordinate/triplet representation */
   GSL_SPMATRIX_CSC = 1, /* compressed sparse column */
   GSL_SPMATRIX_CSR = 2, /* compressed sparse row */
+  GSL_SPMATRIX_BSR = 3, /* block compressed sparse row */
+  GSL_SPMATRIX_SELL = 4, /* sliced ELLPACK with sorted rows (SELL-C-sigma) */
   GSL_SPMATRIX_TRIPLET = GSL_SPMATRIX_COO,
   GSL_SPMATRIX_CCS = GSL_SPMATRIX_CSC,
   GSL_SPMATRIX_CRS = GSL_SPMATRIX_CSR
@@ -24,6 +26,8 @@ typedef struct gsl_spmatrix_pool_node gsl_spmatrix_pool;
 #define GSL_SPMATRIX_ISCOO(m)         ((m)->sptype == GSL_SPMATRIX_COO)
 #define GSL_SPMATRIX_ISCSC(m)         ((m)->sptype == GSL_SPMATRIX_CSC)
 #define GSL_SPMATRIX_ISCSR(m)         ((m)->sptype == GSL_SPMATRIX_CSR)
+#define GSL_SPMATRIX_ISBSR(m)         ((m)->sptype == GSL_SPMATRIX_BSR)
+#define GSL_SPMATRIX_ISSELL(m)        ((m)->sptype == GSL_SPMATRIX_SELL)
 
 #define GSL_SPMATRIX_ISTRIPLET(m)     GSL_SPMATRIX_ISCOO(m)
 #define GSL_SPMATRIX_ISCCS(m)         GSL_SPMATRIX_ISCSC(m)
@@ -70,7 +70,8 @@ typedef struct
   /* i (size nzmax) contains:
    *
    * COO/CSC: row indices
-   * CSR: column indices
+   * CSR/SELL: column indices
+   * BSR: block column indices
    */
   int *i;
 
@@ -80,6 +81,8 @@ typedef struct
    * COO: p[n] = column number of element data[n]
    * CSC: p[j] = index in data of first non-zero element in column j
    * CSR: p[i] = index in data of first non-zero element in row i
+   * BSR: p[i] = index in i of first block in block row i
+   * SELL: p[s] = index in data of first element of slice s
    */
   int *p;
 
@@ -103,6 +106,9 @@ typedef struct
 
   int sptype;                /* sparse storage type */
   size_t spflags;            /* GSL_SPMATRIX_FLG_xxx */
+
+  size_t bsize;              /* BSR: block size, SELL: slice height */
+  int *perm;                 /* SELL: row in each slice position, -1 for padding */
 } gsl_spmatrix_float;
 
 /*
@@ -126,6 +132,8 @@ int gsl_spmatrix_float_tree_rebuild (gsl_spmatrix_float * m);
 int gsl_spmatrix_float_csc (gsl_spmatrix_float * dest, const gsl_spmatrix_float * src);
 int gsl_spmatrix_float_csr (gsl_spmatrix_float * dest, const gsl_spmatrix_float * src);
 gsl_spmatrix_float * gsl_spmatrix_float_compress (const gsl_spmatrix_float * src, const int sptype);
+gsl_spmatrix_float * gsl_spmatrix_float_bsr (const gsl_spmatrix_float * src, const size_t bsize);
+gsl_spmatrix_float * gsl_spmatrix_float_sell (const gsl_spmatrix_float * src, const size_t C, const size_t sigma);
 gsl_spmatrix_float * gsl_spmatrix_float_compcol (const gsl_spmatrix_float * src);
 gsl_spmatrix_float * gsl_spmatrix_float_ccs (const gsl_spmatrix_float * src);
 gsl_spmatrix_float * gsl_spmatrix_float_crs (const gsl_spmatrix_float * src);
@@ -159,6 +159,9 @@ FUNCTION (gsl_spmatrix, free) (TYPE (gsl_spmatrix) * m)
   if (m->data)
     free(m->data);
 
+  if (m->perm)
+    free(m->perm);
+
   if (m->work.work_void)
     free(m->work.work_void);
 
@@ -273,6 +276,10 @@ FUNCTION (gsl_spmatrix, type) (const TYPE (gsl_spmatrix) * m)
     return "CSR";
   else if (GSL_SPMATRIX_ISCSC(m))
     return "CSC";
+  else if (GSL_SPMATRIX_ISBSR(m))
+    return "BSR";
+  else if (GSL_SPMATRIX_ISSELL(m))
+    return "SELL";
   else
     return "unknown";
 }
@@ -291,6 +298,16 @@ FUNCTION (gsl_spmatrix, set_zero) (TYPE (gsl_spmatrix) * m)
       FUNCTION (spmatrix, pool_free) (m);
       FUNCTION (spmatrix, pool_init) (m);
     }
+  else if (GSL_SPMATRIX_ISBSR(m) || GSL_SPMATRIX_ISSELL(m))
+    {
+      /* empty every block row or slice so no stored block is reached */
+      const size_t b = m->bsize;
+      const size_t n = (m->size1 + b - 1) / b;
+      size_t i;
+
+      for (i = 0; i <= n; ++i)
+        m->p[i] = 0;
+    }
 
   return GSL_SUCCESS;
 }
@@ -367,6 +367,10 @@ FUNCTION (gsl_spmatrix, dense_add) (TYPE (gsl_matrix) * a, const TYPE (gsl_spmat
                 }
             }
         }
+      else
+        {
+          GSL_ERROR("unknown sparse matrix type", GSL_EINVAL);
+        }
 
       return GSL_SUCCESS;
     }
@@ -458,6 +462,10 @@ FUNCTION (gsl_spmatrix, dense_sub) (TYPE (gsl_matrix) * a, const TYPE (gsl_spmat
                 }
             }
         }
+      else
+        {
+          GSL_ERROR("unknown sparse matrix type", GSL_EINVAL);
+        }
 
       return GSL_SUCCESS;
     }
@@ -568,6 +576,64 @@ FUNCTION (gsl_spmatrix, sp2d) (TYPE (gsl_matrix) * A, const TYPE (gsl_spmatrix)
                 }
             }
         }
+      else if (GSL_SPMATRIX_ISBSR(S))
+        {
+          const size_t b = S->bsize;
+          const size_t nbrows = (S->size1 + b - 1) / b;
+          const int *Sj = S->i;
+          const int *Sp = S->p;
+          const ATOMIC *Sd = S->data;
+          size_t I, r, c;
+          int k;
+
+          for (I = 0; I < nbrows; ++I)
+            {
+              for (k = Sp[I]; k < Sp[I + 1]; ++k)
+                {
+                  const ATOMIC *block = Sd + MULTIPLICITY * k * b * b;
+
+                  for (r = 0; r < b && I * b + r < S->size1; ++r)
+                    {
+                      for (c = 0; c < b && Sj[k] * b + c < S->size2; ++c)
+                        {
+                          BASE x;
+                          const ATOMIC *z = block + MULTIPLICITY * (r * b + c);
+                          GSL_SET_COMPLEX(&x, z[0], z[1]);
+                          FUNCTION (gsl_matrix, set) (A, I * b + r, Sj[k] * b + c, x);
+                        }
+                    }
+                }
+            }
+        }
+      else if (GSL_SPMATRIX_ISSELL(S))
+        {
+          const size_t C = S->bsize;
+          const size_t nslices = (S->size1 + C - 1) / C;
+          const int *Sj = S->i;
+          const int *Sp = S->p;
+          const ATOMIC *Sd = S->data;
+          size_t s, r;
+          int q;
+
+          /* padding elements are zero, but may share a position with an element */
+          for (s = 0; s < nslices; ++s)
+            {
+              for (r = 0; r < C; ++r)
+                {
+                  const int row = S->perm[s * C + r];
+
+                  if (row < 0)
+                    continue;
+
+                  for (q = Sp[s] + (int) r; q < Sp[s + 1]; q += (int) C)
+                    {
+                      ATOMIC *x = (ATOMIC *) FUNCTION (gsl_matrix, ptr) (A, row, Sj[q]);
+                      x[0] += Sd[MULTIPLICITY * q];
+                      x[1] += Sd[MULTIPLICITY * q + 1];
+                    }
+                }
+            }
+        }
       else
         {
           GSL_ERROR("unknown sparse matrix type", GSL_EINVAL);
@@ -177,6 +177,10 @@ FUNCTION (gsl_spmatrix, norm1) (const TYPE (gsl_spmatrix) * A)
           for (j = 0; j < A->nz; ++j)
             colsum[Aj[j]] += (Ad[j] >= (ATOMIC) 0) ? Ad[j] : -Ad[j];
         }
+      else
+        {
+          GSL_ERROR_VAL("unknown sparse matrix type", GSL_EINVAL, (ATOMIC) 0);
+        }
 
       for (j = 0; j < N; ++j)
         {
@@ -716,6 +716,53 @@ FUNCTION (test, convert) (const size_t M, const size_t N, const int sptype,
   FUNCTION (gsl_matrix, free) (D);
 }
 
+static void
+FUNCTION (test, convert_blocked) (const size_t M, const size_t N,
+                                  const double density, gsl_rng * r)
+{
+  const size_t bsizes[] = { 1, 2, 3, 4 };
+  const size_t sell[][2] = { { 1, 1 }, { 4, 1 }, { 4, 16 }, { 8, 32 }, { 3, 1000 } };
+  TYPE (gsl_spmatrix) * A = FUNCTION (test, random) (M, N, density, 1.0, 20.0, r);
+  TYPE (gsl_spmatrix) * B = FUNCTION (gsl_spmatrix, compress) (A, GSL_SPMATRIX_CSR);
+  TYPE (gsl_matrix) * D = FUNCTION (gsl_matrix, alloc) (M, N);
+  TYPE (gsl_matrix) * E = FUNCTION (gsl_matrix, alloc) (M, N);
+  size_t k;
+
+  FUNCTION (gsl_spmatrix, sp2d) (D, B);
+
+  for (k = 0; k < sizeof(bsizes) / sizeof(bsizes[0]); ++k)
+    {
+      TYPE (gsl_spmatrix) * S = FUNCTION (gsl_spmatrix, bsr) (B, bsizes[k]);
+
+      FUNCTION (gsl_spmatrix, sp2d) (E, S);
+
+      status = FUNCTION (gsl_matrix, equal) (D, E) != 1 ||
+               S->nz % (bsizes[k] * bsizes[k]) != 0 || S->nz < B->nz;
+      gsl_test (status, NAME (gsl_spmatrix) "_bsr[%zu,%zu](%s) bsize=%zu",
+                M, N, FUNCTION (gsl_spmatrix, type) (S), bsizes[k]);
+
+      FUNCTION (gsl_spmatrix, free) (S);
+    }
+
+  for (k = 0; k < sizeof(sell) / sizeof(sell[0]); ++k)
+    {
+      TYPE (gsl_spmatrix) * S = FUNCTION (gsl_spmatrix, sell) (B, sell[k][0], sell[k][1]);
+
+      FUNCTION (gsl_spmatrix, sp2d) (E, S);
+
+      status = FUNCTION (gsl_matrix, equal) (D, E) != 1 || S->nz < B->nz;
+      gsl_test (status, NAME (gsl_spmatrix) "_sell[%zu,%zu](%s) C=%zu sigma=%zu",
+                M, N, FUNCTION (gsl_spmatrix, type) (S), sell[k][0], sell[k][1]);
+
+      FUNCTION (gsl_spmatrix, free) (S);
+    }
+
+  FUNCTION (gsl_spmatrix, free) (A);
+  FUNCTION (gsl_spmatrix, free) (B);
+  FUNCTION (gsl_matrix, free) (D);
+  FUNCTION (gsl_matrix, free) (E);
+}
+
 static void
 FUNCTION (test, io_ascii) (const size_t M, const size_t N, const int sptype,
                            const double density, gsl_rng * r)
@@ -813,6 +860,7 @@ FUNCTION (test, all) (const size_t M, const size_t N, const double density, gsl_
   FUNCTION (test, convert) (M, N, GSL_SPMATRIX_COO, density, r);
   FUNCTION (test, convert) (M, N, GSL_SPMATRIX_CSC, density, r);
   FUNCTION (test, convert) (M, N, GSL_SPMATRIX_CSR, density, r);
+  FUNCTION (test, convert_blocked) (M, N, density, r);
 
   FUNCTION (test, io_ascii) (M, N, GSL_SPMATRIX_COO, density, r);
   FUNCTION (test, io_ascii) (M, N, GSL_SPMATRIX_CSC, density, r);
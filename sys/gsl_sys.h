@@ -58,6 +58,9 @@ double gsl_frexp(const double x, int * e);
 
 int gsl_fcmp (const double x1, const double x2, const double epsilon);
 
+void gsl_set_num_threads (const int n);
+int gsl_get_num_threads (void);
+
 __END_DECLS
 
 #endif /* __GSL_SYS_H__ */
@@ -0,0 +1,39 @@
+/* sys/threads.c
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <config.h>
+#include <gsl/gsl_sys.h>
+
+#include "threads_source.c"
+
+/* maximum number of threads used by the multithreaded routines of the
+   library, 0 until the first call which reads the default from the
+   environment */
+
+static int num_threads = 0;
+
+void
+gsl_set_num_threads (const int n)
+{
+  threads_set (&num_threads, n);
+}
+
+int
+gsl_get_num_threads (void)
+{
+  return threads_get (&num_threads);
+}
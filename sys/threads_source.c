@@ -0,0 +1,93 @@
+/* sys/threads_source.c
+ * 
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3 of the License, or (at
+ * your option) any later version.
+ * 
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ * 
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/* Thread count settings, included by sys/threads.c and by
+ * cblas/parallel.c since libgslcblas cannot depend on libgsl.
+ *
+ * A count of 0 means not yet initialised.  The first read takes the
+ * default from GSL_NUM_THREADS, or from OpenMP, inside a critical
+ * section so that concurrent first calls initialise the count once;
+ * later reads and all writes are atomic. */
+
+#include <stdlib.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef _OPENMP
+static int
+threads_default (void)
+{
+  const char *s = getenv ("GSL_NUM_THREADS");
+
+  if (s != 0)
+    {
+      const int n = atoi (s);
+
+      if (n > 0)
+        return n;
+    }
+
+  return omp_get_max_threads ();
+}
+#endif
+
+static void
+threads_set (int *num_threads, const int n)
+{
+#ifdef _OPENMP
+#pragma omp atomic write
+  *num_threads = (n > 0) ? n : threads_default ();
+#else
+  (void) num_threads;
+  (void) n;
+#endif
+}
+
+static int
+threads_get (int *num_threads)
+{
+#ifdef _OPENMP
+  int n;
+
+#pragma omp atomic read
+  n = *num_threads;
+
+  if (n == 0)
+    {
+#pragma omp critical (gsl_threads_init)
+      {
+#pragma omp atomic read
+        n = *num_threads;
+
+        if (n == 0)
+          {
+            n = threads_default ();
+
+#pragma omp atomic write
+            *num_threads = n;
+          }
+      }
+    }
+
+  return n;
+#else
+  (void) num_threads;
+  return 1;
+#endif
+}